@@ -31,8 +31,6 @@ using json = nlohmann::json;
 int gBatchSize = 0;
 bool gSwssRecord = false;
 bool gLogRotate = false;
-ofstream gRecordOfs;
-string gRecordFile;
 /* Global database mutex */
 mutex gDbMutex;
 
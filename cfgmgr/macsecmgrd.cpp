@@ -36,8 +36,6 @@ MacAddress gMacAddress;
 int gBatchSize = 0;
 bool gSwssRecord = false;
 bool gLogRotate = false;
-ofstream gRecordOfs;
-string gRecordFile;
 /* Global database mutex */
 mutex gDbMutex;
 
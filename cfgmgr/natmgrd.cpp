@@ -50,8 +50,6 @@ using namespace swss;
 int       gBatchSize = 0;
 bool      gSwssRecord = false;
 bool      gLogRotate = false;
-ofstream  gRecordOfs;
-string    gRecordFile;
 mutex     gDbMutex;
 NatMgr    *natmgr = NULL;
 
@@ -29,8 +29,6 @@ using namespace swss;
 int gBatchSize = 0;
 bool gSwssRecord = false;
 bool gLogRotate = false;
-ofstream gRecordOfs;
-string gRecordFile;
 /* Global database mutex */
 mutex gDbMutex;
 
@@ -1,9 +1,9 @@
 #include <string.h>
 #include <errno.h>
+#include <sys/eventfd.h>
 #include <system_error>
 #include "logger.h"
 #include "netmsg.h"
-#include "netdispatcher.h"
 #include "fpmsyncd/fpmlink.h"
 
 using namespace swss;
@@ -34,91 +34,17 @@ void netlink_parse_rtattr(struct rtattr **tb, int max, struct rtattr *rta,
     }
 }
 
-bool FpmLink::isRawProcessing(struct nlmsghdr *h)
-{
-    int len;
-    short encap_type = 0;
-    struct rtmsg *rtm;
-    struct rtattr *tb[RTA_MAX + 1];
-
-    rtm = (struct rtmsg *)NLMSG_DATA(h);
-
-    if (h->nlmsg_type != RTM_NEWROUTE && h->nlmsg_type != RTM_DELROUTE)
-    {
-        return false;
-    }
-
-    len = (int)(h->nlmsg_len - NLMSG_LENGTH(sizeof(struct rtmsg)));
-    if (len < 0) 
-    {
-        return false;
-    }
-
-    memset(tb, 0, sizeof(tb));
-    netlink_parse_rtattr(tb, RTA_MAX, RTM_RTA(rtm), len);
-
-    if (!tb[RTA_MULTIPATH])
-    {
-        if (tb[RTA_ENCAP_TYPE])
-        {
-            encap_type = *(short *)RTA_DATA(tb[RTA_ENCAP_TYPE]);
-        }
-    }
-    else
-    {
-        /* This is a multipath route */
-        int len;            
-        struct rtnexthop *rtnh = (struct rtnexthop *)RTA_DATA(tb[RTA_MULTIPATH]);
-        len = (int)RTA_PAYLOAD(tb[RTA_MULTIPATH]);
-        struct rtattr *subtb[RTA_MAX + 1];
-        
-        for (;;) 
-        {
-            if (len < (int)sizeof(*rtnh) || rtnh->rtnh_len > len)
-            {
-                break;
-            }
-
-            if (rtnh->rtnh_len > sizeof(*rtnh)) 
-            {
-                memset(subtb, 0, sizeof(subtb));
-                netlink_parse_rtattr(subtb, RTA_MAX, RTNH_DATA(rtnh),
-                                      (int)(rtnh->rtnh_len - sizeof(*rtnh)));
-                if (subtb[RTA_ENCAP_TYPE])
-                {
-                    encap_type = *(uint16_t *)RTA_DATA(subtb[RTA_ENCAP_TYPE]);
-                    break;
-                }
-            }
-
-            if (rtnh->rtnh_len == 0)
-            {
-                break;
-            }
-
-            len -= NLMSG_ALIGN(rtnh->rtnh_len);
-            rtnh = RTNH_NEXT(rtnh);                
-        }
-    }
-
-    SWSS_LOG_INFO("Rx MsgType:%d Encap:%d", h->nlmsg_type, encap_type);
-
-    if (encap_type > 0)
-    {
-        return true;
-    }
-
-    return false;
-}
-
-FpmLink::FpmLink(RouteSync *rsync, unsigned short port) :
+FpmLink::FpmLink(RouteSync *rsync, unsigned short port, unsigned int maxConnections) :
     MSG_BATCH_SIZE(256),
     m_bufSize(FPM_MAX_MSG_LEN * MSG_BATCH_SIZE),
     m_messageBuffer(NULL),
     m_pos(0),
     m_connected(false),
     m_server_up(false),
-    m_routesync(rsync)
+    m_routesync(rsync),
+    m_maxConnections(maxConnections),
+    m_event_fd(-1),
+    m_stopping(false)
 {
     struct sockaddr_in addr;
     int true_val = 1;
@@ -164,14 +90,31 @@ FpmLink::FpmLink(RouteSync *rsync, unsigned short port) :
 
 FpmLink::~FpmLink()
 {
+    m_stopping = true;
+
+    /* Wake up the threads blocked in accept() or read() */
+    if (m_acceptor.joinable())
+    {
+        shutdown(m_server_socket, SHUT_RDWR);
+        m_acceptor.join();
+    }
+    for (auto &reader : m_readers)
+    {
+        shutdown(reader->socket, SHUT_RDWR);
+        reader->thread.join();
+        close(reader->socket);
+    }
+
     delete[] m_messageBuffer;
     if (m_connected)
         close(m_connection_socket);
     if (m_server_up)
         close(m_server_socket);
+    if (m_event_fd >= 0)
+        close(m_event_fd);
 }
 
-void FpmLink::accept()
+int FpmLink::acceptConnection()
 {
     struct sockaddr_in client_addr;
 
@@ -179,38 +122,196 @@ void FpmLink::accept()
     // address_len argument, on input, specifies the length of the supplied sockaddr structure
     socklen_t client_len = sizeof(struct sockaddr_in);
 
-    m_connection_socket = ::accept(m_server_socket, (struct sockaddr *)&client_addr,
-                                   &client_len);
-    if (m_connection_socket < 0)
+    int connection_socket = ::accept(m_server_socket, (struct sockaddr *)&client_addr,
+                                     &client_len);
+    if (connection_socket < 0)
         throw system_error(errno, system_category());
 
     SWSS_LOG_INFO("New connection accepted from: %s\n", inet_ntoa(client_addr.sin_addr));
+    return connection_socket;
+}
+
+void FpmLink::accept()
+{
+    m_connection_socket = acceptConnection();
+    m_connected = true;
+}
+
+void FpmLink::start()
+{
+    if (m_maxConnections <= 1)
+    {
+        return;
+    }
+
+    m_event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_event_fd < 0)
+        throw system_error(errno, system_category());
+
+    /* The accepted connection is handed over to a reader */
+    startReader(m_connection_socket);
+    m_connected = false;
+
+    m_acceptor = thread(&FpmLink::runAcceptor, this);
+}
+
+void FpmLink::startReader(int socket)
+{
+    unique_ptr<Reader> reader(new Reader());
+    reader->socket = socket;
+    reader->buffer.reset(new char[m_bufSize]);
+    reader->pos = 0;
+    reader->done = false;
+
+    Reader *r = reader.get();
+    lock_guard<mutex> lock(m_readersMutex);
+    m_readers.push_back(move(reader));
+    r->thread = thread(&FpmLink::runReader, this, r);
+}
+
+void FpmLink::runAcceptor()
+{
+    while (!m_stopping)
+    {
+        int socket;
+        try
+        {
+            socket = acceptConnection();
+        }
+        catch (const system_error &e)
+        {
+            if (!m_stopping)
+            {
+                SWSS_LOG_ERROR("Failed to accept FPM connection: %s", e.what());
+            }
+            return;
+        }
+
+        size_t active = 0;
+        {
+            lock_guard<mutex> lock(m_readersMutex);
+            for (const auto &reader : m_readers)
+            {
+                active += !reader->done;
+            }
+        }
+
+        if (active >= m_maxConnections)
+        {
+            SWSS_LOG_WARN("Rejecting FPM connection, %u connections already open", m_maxConnections);
+            close(socket);
+            continue;
+        }
+
+        startReader(socket);
+    }
+}
+
+void FpmLink::runReader(Reader *reader)
+{
+    try
+    {
+        while (readMessages(reader->socket, reader->buffer.get(), reader->pos))
+        {
+            notify();
+        }
+    }
+    catch (...)
+    {
+        lock_guard<mutex> lock(m_readersMutex);
+        if (!m_stopping && !m_readerError)
+        {
+            m_readerError = current_exception();
+        }
+    }
+
+    reader->done = true;
+    notify();
+}
+
+void FpmLink::notify()
+{
+    uint64_t one = 1;
+    if (::write(m_event_fd, &one, sizeof(one)) < 0 && errno != EAGAIN)
+    {
+        SWSS_LOG_ERROR("Failed to signal FPM messages: %s", strerror(errno));
+    }
 }
 
 int FpmLink::getFd()
 {
-    return m_connection_socket;
+    return m_maxConnections > 1 ? m_event_fd : m_connection_socket;
 }
 
 uint64_t FpmLink::readData()
+{
+    if (m_maxConnections <= 1)
+    {
+        if (!readMessages(m_connection_socket, m_messageBuffer, m_pos))
+            throw FpmConnectionClosedException();
+        return 0;
+    }
+
+    uint64_t events;
+    if (::read(m_event_fd, &events, sizeof(events)) < 0 && errno != EAGAIN)
+        throw system_error(errno, system_category());
+
+    /* Reap the readers of closed connections */
+    list<unique_ptr<Reader>> closed;
+    size_t remaining;
+    {
+        lock_guard<mutex> lock(m_readersMutex);
+        if (m_readerError)
+        {
+            rethrow_exception(m_readerError);
+        }
+
+        for (auto it = m_readers.begin(); it != m_readers.end();)
+        {
+            if ((*it)->done)
+            {
+                closed.splice(closed.end(), m_readers, it++);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        remaining = m_readers.size();
+    }
+
+    for (auto &reader : closed)
+    {
+        reader->thread.join();
+        close(reader->socket);
+        SWSS_LOG_NOTICE("FPM connection closed, %zu connections left", remaining);
+    }
+
+    if (!closed.empty() && !remaining)
+        throw FpmConnectionClosedException();
+
+    return 0;
+}
+
+bool FpmLink::readMessages(int socket, char *buffer, unsigned int &pos)
 {
     fpm_msg_hdr_t *hdr;
     size_t msg_len;
     size_t start = 0, left;
     ssize_t read;
 
-    read = ::read(m_connection_socket, m_messageBuffer + m_pos, m_bufSize - m_pos);
+    read = ::read(socket, buffer + pos, m_bufSize - pos);
     if (read == 0)
-        throw FpmConnectionClosedException();
+        return false;
     if (read < 0)
         throw system_error(errno, system_category());
-    m_pos+= (uint32_t)read;
+    pos+= (uint32_t)read;
 
     /* Check for complete messages */
     while (true)
     {
-        hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(m_messageBuffer + start));
-        left = m_pos - start;
+        hdr = reinterpret_cast<fpm_msg_hdr_t *>(static_cast<void *>(buffer + start));
+        left = pos - start;
         if (left < FPM_MSG_HDR_LEN)
             break;
         /* fpm_msg_len includes header size */
@@ -223,41 +324,22 @@ uint64_t FpmLink::readData()
 
         if (hdr->msg_type == FPM_MSG_TYPE_NETLINK)
         {
-            bool isRaw = false;
-
             nlmsghdr *nl_hdr = (nlmsghdr *)fpm_msg_data(hdr);
 
             /*
-             * EVPN Type5 Add Routes need to be process in Raw mode as they contain 
-             * RMAC, VLAN and L3VNI information.
-             * Where as all other route will be using rtnl api to extract information 
-             * from the netlink msg.
-           * */
-            isRaw = isRawProcessing(nl_hdr);
-
-            nl_msg *msg = nlmsg_convert(nl_hdr);
-            if (msg == NULL)
+             * Route messages are decoded in place by RouteSync, without the
+             * conversion to libnl objects. EVPN Type5 routes are recognized
+             * there by their RMAC, VLAN and L3VNI attributes.
+             */
+            if (nl_hdr->nlmsg_type == RTM_NEWROUTE || nl_hdr->nlmsg_type == RTM_DELROUTE)
             {
-                throw system_error(make_error_code(errc::bad_message), "Unable to convert nlmsg");
+                m_routesync->onMsgRaw(nl_hdr);
             }
-
-            nlmsg_set_proto(msg, NETLINK_ROUTE);
-
-            if (isRaw)
-            {
-                /* EVPN Type5 Add route processing */
-                processRawMsg(nl_hdr);
-            }
-            else
-            {
-                NetDispatcher::getInstance().onNetlinkMessage(msg);
-            }
-            nlmsg_free(msg);
         }
         start += msg_len;
     }
 
-    memmove(m_messageBuffer, m_messageBuffer + start, m_pos - start);
-    m_pos = m_pos - (uint32_t)start;
-    return 0;
+    memmove(buffer, buffer + start, pos - start);
+    pos = pos - (uint32_t)start;
+    return true;
 }
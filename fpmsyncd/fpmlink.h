@@ -10,6 +10,11 @@
 #include <assert.h>
 #include <unistd.h>
 #include <exception>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 #include "selectable.h"
 #include "fpm/fpm.h"
@@ -17,15 +22,29 @@
 
 namespace swss {
 
+/*
+ * FPM server of fpmsyncd.
+ *
+ * With one connection, the connection is read by readData() on the select
+ * loop. With more, e.g. one per zebra dataplane thread, each connection is
+ * read and decoded on its own thread while further connections are accepted
+ * in the background, and the selectable is signalled after each batch so
+ * that the select loop flushes them. Updates keep their order within a
+ * connection only: the FPM clients must not send updates of the same prefix
+ * on different connections, as nothing orders such updates between them.
+ */
 class FpmLink : public Selectable {
 public:
     const int MSG_BATCH_SIZE;
-    FpmLink(RouteSync *rsync, unsigned short port = FPM_DEFAULT_PORT);
+    FpmLink(RouteSync *rsync, unsigned short port = FPM_DEFAULT_PORT, unsigned int maxConnections = 1);
     virtual ~FpmLink();
 
     /* Wait for connection (blocking) */
     void accept();
 
+    /* Start reading the accepted connection, on threads when there are several */
+    void start();
+
     int getFd() override;
     uint64_t readData() override;
     /* readMe throws FpmConnectionClosedException when connection is lost */
@@ -33,13 +52,17 @@ public:
     {
     };
 
-    bool isRawProcessing(struct nlmsghdr *h);
-    void processRawMsg(struct nlmsghdr *h)
+private:
+    /* Connection read on its own thread */
+    struct Reader
     {
-        m_routesync->onMsgRaw(h);
+        int socket;
+        std::unique_ptr<char[]> buffer;
+        unsigned int pos;
+        std::thread thread;
+        std::atomic<bool> done;
     };
 
-private:
     RouteSync *m_routesync;
     unsigned int m_bufSize;
     char *m_messageBuffer;
@@ -49,6 +72,24 @@ private:
     bool m_server_up;
     int m_server_socket;
     int m_connection_socket;
+
+    unsigned int m_maxConnections;
+    /* Signalled by the readers after each batch of messages */
+    int m_event_fd;
+    std::thread m_acceptor;
+    std::atomic<bool> m_stopping;
+    std::mutex m_readersMutex;
+    std::list<std::unique_ptr<Reader>> m_readers;
+    std::exception_ptr m_readerError;
+
+    int acceptConnection();
+    void startReader(int socket);
+    void runReader(Reader *reader);
+    void runAcceptor();
+    void notify();
+
+    /* Read and dispatch the messages of a connection, false when it is closed */
+    bool readMessages(int socket, char *buffer, unsigned int &pos);
 };
 
 }
@@ -1,9 +1,10 @@
 #include <iostream>
 #include <inttypes.h>
+#include <getopt.h>
+#include <stdlib.h>
 #include "logger.h"
 #include "select.h"
 #include "selectabletimer.h"
-#include "netdispatcher.h"
 #include "warmRestartHelper.h"
 #include "fpmsyncd/fpmlink.h"
 #include "fpmsyncd/routesync.h"
@@ -23,6 +24,31 @@ const uint32_t DEFAULT_ROUTING_RESTART_INTERVAL = 120;
 // TODO: support eoiu hold interval config
 const uint32_t DEFAULT_EOIU_HOLD_INTERVAL = 3;
 
+void usage()
+{
+    cout << "Usage: fpmsyncd [-w coalesce_usecs] [-c connections]" << endl;
+    cout << "    -w coalesce_usecs: time route updates are coalesced before being written to APPL_DB," << endl;
+    cout << "                       0 writes them after each batch of FPM messages (default 0)" << endl;
+    cout << "    -c connections: FPM connections accepted, each read on its own thread when" << endl;
+    cout << "                    more than 1 (default 1). Updates are only ordered within a" << endl;
+    cout << "                    connection, a prefix must always be sent on the same one" << endl;
+}
+
+/*
+ * Write the coalesced route updates to the pipeline, and flush the pipeline
+ * unless the updates are held for warm-restart reconciliation.
+ */
+static void flushRoutes(RouteSync &sync, RedisPipeline &pipeline, bool warmStartEnabled)
+{
+    sync.flushRoutes();
+
+    if (!warmStartEnabled || sync.m_warmStartHelper.isReconciled())
+    {
+        pipeline.flush();
+        SWSS_LOG_DEBUG("Pipeline flushed");
+    }
+}
+
 // Check if eoiu state reached by both ipv4 and ipv6
 static bool eoiuFlagsSet(Table &bgpStateTable)
 {
@@ -46,6 +72,39 @@ static bool eoiuFlagsSet(Table &bgpStateTable)
 
 int main(int argc, char **argv)
 {
+    int opt;
+    long coalesce_usecs = 0;
+    long connections = 1;
+
+    while ((opt = getopt(argc, argv, "w:c:h")) != -1 )
+    {
+        switch (opt)
+        {
+        case 'w':
+            coalesce_usecs = strtol(optarg, NULL, 10);
+            if (coalesce_usecs < 0)
+            {
+                usage();
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'c':
+            connections = strtol(optarg, NULL, 10);
+            if (connections < 1)
+            {
+                usage();
+                return EXIT_FAILURE;
+            }
+            break;
+        case 'h':
+            usage();
+            return 1;
+        default: /* '?' */
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     swss::Logger::linkToDbNative("fpmsyncd");
     DBConnector db("APPL_DB", 0);
     RedisPipeline pipeline(&db);
@@ -54,33 +113,32 @@ int main(int argc, char **argv)
     DBConnector stateDb("STATE_DB", 0);
     Table bgpStateTable(&stateDb, STATE_BGP_TABLE_NAME);
 
-    NetDispatcher::getInstance().registerMessageHandler(RTM_NEWROUTE, &sync);
-    NetDispatcher::getInstance().registerMessageHandler(RTM_DELROUTE, &sync);
-
     while (true)
     {
         try
         {
-            FpmLink fpm(&sync);
+            FpmLink fpm(&sync, FPM_DEFAULT_PORT, static_cast<unsigned int>(connections));
             Select s;
             SelectableTimer warmStartTimer(timespec{0, 0});
             // Before eoiu flags detected, check them periodically. It also stop upon detection of reconciliation done.
             SelectableTimer eoiuCheckTimer(timespec{0, 0});
             // After eoiu flags are detected, start a hold timer before starting reconciliation.
             SelectableTimer eoiuHoldTimer(timespec{0, 0});
+            // Route updates read within the window are coalesced before being flushed.
+            SelectableTimer flushTimer(timespec{coalesce_usecs / 1000000, (coalesce_usecs % 1000000) * 1000});
+            bool flushPending = false;
            
             /*
              * Pipeline should be flushed right away to deal with state pending
              * from previous try/catch iterations.
              */
+            sync.flushRoutes();
             pipeline.flush();
 
             cout << "Waiting for fpm-client connection..." << endl;
             fpm.accept();
             cout << "Connected!" << endl;
 
-            s.addSelectable(&fpm);
-
             /* If warm-restart feature is enabled, execute 'restoration' logic */
             bool warmStartEnabled = sync.m_warmStartHelper.checkAndStart();
             if (warmStartEnabled)
@@ -115,6 +173,14 @@ int main(int argc, char **argv)
                 sync.m_warmStartHelper.setState(WarmStart::WSDISABLED);
             }
 
+            /* Route messages are handled from here on */
+            fpm.start();
+            s.addSelectable(&fpm);
+            if (coalesce_usecs)
+            {
+                s.addSelectable(&flushTimer);
+            }
+
             while (true)
             {
                 Selectable *temps;
@@ -141,7 +207,8 @@ int main(int argc, char **argv)
 
                     if (sync.m_warmStartHelper.inProgress())
                     {
-                        sync.m_warmStartHelper.reconcile();
+                        sync.flushRoutes();
+                        sync.reconcile();
                         SWSS_LOG_NOTICE("Warm-Restart reconciliation processed.");
                     }
                     // remove the one-shot timer.
@@ -182,10 +249,21 @@ int main(int argc, char **argv)
                         s.removeSelectable(&eoiuCheckTimer);
                     }
                 }
-                else if (!warmStartEnabled || sync.m_warmStartHelper.isReconciled())
+                else if (temps == &flushTimer)
                 {
-                    pipeline.flush();
-                    SWSS_LOG_DEBUG("Pipeline flushed");
+                    flushTimer.stop();
+                    flushPending = false;
+                    flushRoutes(sync, pipeline, warmStartEnabled);
+                }
+                else if (!coalesce_usecs)
+                {
+                    flushRoutes(sync, pipeline, warmStartEnabled);
+                }
+                else if (!flushPending)
+                {
+                    /* First batch of the window, later ones are coalesced with it */
+                    flushTimer.start();
+                    flushPending = true;
                 }
             }
         }
@@ -0,0 +1,82 @@
+#include "fpmsyncd/routecoalescer.h"
+
+using namespace std;
+using namespace swss;
+
+RouteCoalescer::PendingUpdate &RouteCoalescer::getPending(const string &key)
+{
+    m_updates++;
+
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        m_suppressed++;
+        return m_pending[it->second];
+    }
+
+    m_index.emplace(key, m_pending.size());
+    m_pending.push_back({ key, false, false, {} });
+    return m_pending.back();
+}
+
+void RouteCoalescer::set(const string &key, const vector<FieldValueTuple> &fvs)
+{
+    lock_guard<mutex> lock(m_mutex);
+    PendingUpdate &update = getPending(key);
+    update.set = true;
+    update.fvs = fvs;
+}
+
+void RouteCoalescer::del(const string &key)
+{
+    lock_guard<mutex> lock(m_mutex);
+    PendingUpdate &update = getPending(key);
+    update.del = true;
+    update.set = false;
+    update.fvs.clear();
+}
+
+size_t RouteCoalescer::flush()
+{
+    vector<KeyOpFieldsValuesTuple> kfvs;
+    size_t writes = flush(kfvs);
+
+    for (const auto &kfv : kfvs)
+    {
+        if (kfvOp(kfv) == DEL_COMMAND)
+        {
+            m_table->del(kfvKey(kfv));
+        }
+        else
+        {
+            m_table->set(kfvKey(kfv), kfvFieldsValues(kfv));
+        }
+    }
+
+    return writes;
+}
+
+size_t RouteCoalescer::flush(vector<KeyOpFieldsValuesTuple> &kfvs)
+{
+    lock_guard<mutex> lock(m_mutex);
+    size_t writes = 0;
+
+    for (auto &update : m_pending)
+    {
+        if (update.del)
+        {
+            kfvs.emplace_back(update.key, DEL_COMMAND, vector<FieldValueTuple>());
+            writes++;
+        }
+        if (update.set)
+        {
+            kfvs.emplace_back(move(update.key), SET_COMMAND, move(update.fvs));
+            writes++;
+        }
+    }
+
+    m_pending.clear();
+    m_index.clear();
+
+    return writes;
+}
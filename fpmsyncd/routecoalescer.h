@@ -0,0 +1,89 @@
+#ifndef __ROUTECOALESCER__
+#define __ROUTECOALESCER__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+#include "producerstatetable.h"
+
+namespace swss {
+
+/*
+ * Holds the route updates of one batch of FPM messages and writes only the
+ * final state of each key to the table when the batch is flushed. A prefix
+ * that flaps several times within a batch then costs one Redis write and
+ * one orchagent wake up instead of one per update.
+ *
+ * A delete followed by a set within the batch is written as both, so that
+ * fields of the previous route are removed as they would be without
+ * coalescing. Keys are written in the order of their first update.
+ *
+ * Updates may come from several FPM connection threads, and are flushed by
+ * the select loop. The lock keeps the coalescer consistent, it does not
+ * order the updates of a key coming from different threads.
+ */
+class RouteCoalescer
+{
+public:
+    RouteCoalescer(ProducerStateTable *table) :
+        m_table(table),
+        m_updates(0),
+        m_suppressed(0)
+    {
+    }
+
+    void set(const std::string &key, const std::vector<FieldValueTuple> &fvs);
+    void del(const std::string &key);
+
+    /* Write the pending updates to the table, returns the number of writes */
+    size_t flush();
+
+    /* Move the pending updates to kfvs in the order they are written */
+    size_t flush(std::vector<KeyOpFieldsValuesTuple> &kfvs);
+
+    size_t getPendingCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pending.size();
+    }
+
+    /* Updates received, and updates overwritten by a later one of the same key */
+    uint64_t getUpdates()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_updates;
+    }
+
+    uint64_t getSuppressed()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_suppressed;
+    }
+
+private:
+    struct PendingUpdate
+    {
+        std::string key;
+        bool del;
+        bool set;
+        std::vector<FieldValueTuple> fvs;
+    };
+
+    ProducerStateTable *m_table;
+    std::mutex m_mutex;
+
+    /* Pending updates in arrival order, and their index by key */
+    std::vector<PendingUpdate> m_pending;
+    std::unordered_map<std::string, size_t> m_index;
+
+    uint64_t m_updates;
+    uint64_t m_suppressed;
+
+    PendingUpdate &getPending(const std::string &key);
+};
+
+}
+
+#endif
@@ -0,0 +1,250 @@
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "fpmsyncd/routedecoder.h"
+
+using namespace std;
+using namespace swss;
+
+#define IPV4_MAX_BYTE       4
+#define IPV6_MAX_BYTE      16
+#define IPV4_MAX_BITLEN    32
+#define IPV6_MAX_BITLEN    128
+
+/* Attribute type without the NLA_F_NESTED bit FRR 7.5 sets on RTA_ENCAP */
+static inline unsigned short rtaType(const struct rtattr *rta)
+{
+    return static_cast<unsigned short>(rta->rta_type & ~NLA_F_NESTED);
+}
+
+static inline const uint8_t *rtaData(const struct rtattr *rta)
+{
+    return reinterpret_cast<const uint8_t *>(rta) + RTA_LENGTH(0);
+}
+
+static inline size_t rtaPayload(const struct rtattr *rta)
+{
+    return rta->rta_len - RTA_LENGTH(0);
+}
+
+static inline bool hasEncapType(const struct rtattr *rta)
+{
+    uint16_t encap_type;
+    if (rtaPayload(rta) < sizeof(encap_type))
+    {
+        return false;
+    }
+    memcpy(&encap_type, rtaData(rta), sizeof(encap_type));
+    return encap_type > 0;
+}
+
+static inline size_t addrLen(uint8_t family)
+{
+    return family == AF_INET6 ? IPV6_MAX_BYTE : IPV4_MAX_BYTE;
+}
+
+RouteDecoder::NextHop &RouteDecoder::addNextHop()
+{
+    if (m_nhCount == m_nexthops.size())
+    {
+        m_nexthops.emplace_back();
+    }
+
+    NextHop &nh = m_nexthops[m_nhCount++];
+    nh.gateway = NULL;
+    nh.gateway_len = 0;
+    nh.ifindex = 0;
+    return nh;
+}
+
+bool RouteDecoder::decode(const struct nlmsghdr *h)
+{
+    if (h->nlmsg_type != RTM_NEWROUTE && h->nlmsg_type != RTM_DELROUTE)
+    {
+        return false;
+    }
+
+    if (h->nlmsg_len < NLMSG_LENGTH(sizeof(struct rtmsg)))
+    {
+        return false;
+    }
+
+    m_msgType = h->nlmsg_type;
+    m_rtm = static_cast<const struct rtmsg *>(NLMSG_DATA(h));
+    m_dst = m_zeroDst;
+    m_table = m_rtm->rtm_table;
+    m_encap = false;
+    m_nhCount = 0;
+
+    if ((m_rtm->rtm_family == AF_INET && m_rtm->rtm_dst_len > IPV4_MAX_BITLEN) ||
+        (m_rtm->rtm_family == AF_INET6 && m_rtm->rtm_dst_len > IPV6_MAX_BITLEN))
+    {
+        return false;
+    }
+
+    const struct rtattr *gateway = NULL;
+    const struct rtattr *oif = NULL;
+    const struct rtattr *multipath = NULL;
+    const struct rtattr *encap_type = NULL;
+
+    int len = static_cast<int>(h->nlmsg_len - NLMSG_LENGTH(sizeof(struct rtmsg)));
+    for (const struct rtattr *rta = RTM_RTA(m_rtm); RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+    {
+        switch (rtaType(rta))
+        {
+            case RTA_DST:
+                if (rtaPayload(rta) >= addrLen(m_rtm->rtm_family))
+                {
+                    m_dst = rtaData(rta);
+                }
+                break;
+            case RTA_TABLE:
+                if (rtaPayload(rta) >= sizeof(m_table))
+                {
+                    memcpy(&m_table, rtaData(rta), sizeof(m_table));
+                }
+                break;
+            case RTA_GATEWAY:
+                gateway = rta;
+                break;
+            case RTA_OIF:
+                oif = rta;
+                break;
+            case RTA_MULTIPATH:
+                multipath = rta;
+                break;
+            case RTA_ENCAP_TYPE:
+                encap_type = rta;
+                break;
+            default:
+                break;
+        }
+    }
+
+    if (multipath)
+    {
+        int mp_len = static_cast<int>(rtaPayload(multipath));
+        const struct rtnexthop *rtnh = reinterpret_cast<const struct rtnexthop *>(rtaData(multipath));
+
+        while (mp_len >= static_cast<int>(sizeof(*rtnh)) && rtnh->rtnh_len >= sizeof(*rtnh) &&
+               static_cast<int>(rtnh->rtnh_len) <= mp_len)
+        {
+            NextHop &nh = addNextHop();
+            nh.ifindex = rtnh->rtnh_ifindex;
+
+            int attr_len = static_cast<int>(rtnh->rtnh_len - sizeof(*rtnh));
+            const struct rtattr *rta = RTNH_DATA(rtnh);
+            for (; RTA_OK(rta, attr_len); rta = RTA_NEXT(rta, attr_len))
+            {
+                if (rtaType(rta) == RTA_GATEWAY)
+                {
+                    nh.gateway = rtaData(rta);
+                    nh.gateway_len = rtaPayload(rta);
+                }
+                else if (rtaType(rta) == RTA_ENCAP_TYPE && hasEncapType(rta))
+                {
+                    m_encap = true;
+                }
+            }
+
+            mp_len -= RTNH_ALIGN(rtnh->rtnh_len);
+            rtnh = RTNH_NEXT(rtnh);
+        }
+    }
+    else
+    {
+        m_encap = encap_type && hasEncapType(encap_type);
+
+        /* Single next hop given by the route attributes, as libnl does */
+        if (gateway || oif)
+        {
+            NextHop &nh = addNextHop();
+            if (gateway)
+            {
+                nh.gateway = rtaData(gateway);
+                nh.gateway_len = rtaPayload(gateway);
+            }
+            if (oif && rtaPayload(oif) >= sizeof(nh.ifindex))
+            {
+                memcpy(&nh.ifindex, rtaData(oif), sizeof(nh.ifindex));
+            }
+        }
+    }
+
+    return true;
+}
+
+size_t RouteDecoder::formatAddress(uint8_t family, const uint8_t *addr, size_t len, char *buf)
+{
+    if (family == AF_INET && len >= IPV4_MAX_BYTE)
+    {
+        /* Hot path of route loads, inet_ntop() is several times slower */
+        char *pos = buf;
+        for (int i = 0; i < IPV4_MAX_BYTE; i++)
+        {
+            uint8_t byte = addr[i];
+            if (byte >= 100)
+            {
+                *pos++ = static_cast<char>('0' + byte / 100);
+                byte = static_cast<uint8_t>(byte % 100);
+                *pos++ = static_cast<char>('0' + byte / 10);
+                byte = static_cast<uint8_t>(byte % 10);
+            }
+            else if (byte >= 10)
+            {
+                *pos++ = static_cast<char>('0' + byte / 10);
+                byte = static_cast<uint8_t>(byte % 10);
+            }
+            *pos++ = static_cast<char>('0' + byte);
+            *pos++ = '.';
+        }
+        *--pos = '\0';
+        return static_cast<size_t>(pos - buf);
+    }
+
+    if (family == AF_INET6 && len >= IPV6_MAX_BYTE && inet_ntop(AF_INET6, addr, buf, ADDR_STRLEN))
+    {
+        return strlen(buf);
+    }
+
+    buf[0] = '\0';
+    return 0;
+}
+
+size_t RouteDecoder::formatPrefix(char *buf) const
+{
+    uint8_t family = getFamily();
+    size_t len = formatAddress(family, m_dst, addrLen(family), buf);
+
+    unsigned int bitlen = family == AF_INET6 ? IPV6_MAX_BITLEN : IPV4_MAX_BITLEN;
+    if (getDstLen() != bitlen)
+    {
+        len += static_cast<size_t>(snprintf(buf + len, ADDR_STRLEN - len, "/%u", getDstLen()));
+    }
+
+    return len;
+}
+
+void RouteDecoder::formatGateways(string &out) const
+{
+    char buf[ADDR_STRLEN];
+    uint8_t family = getFamily();
+
+    for (size_t i = 0; i < m_nhCount; i++)
+    {
+        if (i)
+        {
+            out += ',';
+        }
+
+        const NextHop &nh = m_nexthops[i];
+        if (nh.gateway)
+        {
+            out.append(buf, formatAddress(family, nh.gateway, nh.gateway_len, buf));
+        }
+        else
+        {
+            out += family == AF_INET ? "0.0.0.0" : "::";
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#ifndef __ROUTEDECODER__
+#define __ROUTEDECODER__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+
+namespace swss {
+
+/*
+ * Decoder of the RTM_NEWROUTE/RTM_DELROUTE messages received from FPM.
+ *
+ * Attributes are read in place from the netlink message instead of being
+ * converted to libnl route objects, and addresses are formatted into
+ * caller buffers. One decoder is reused for all messages so that the next
+ * hop array keeps its capacity. Decoded fields point into the message and
+ * are only valid until the next decode().
+ */
+class RouteDecoder
+{
+public:
+    enum { MAX_ADDR_LEN = 16 };
+
+    /* Large enough for an IPv6 address with a prefix length */
+    enum { ADDR_STRLEN = 64 };
+
+    struct NextHop
+    {
+        const uint8_t *gateway;     // NULL when the next hop has no gateway
+        size_t gateway_len;
+        int ifindex;
+    };
+
+    RouteDecoder() : m_nhCount(0) { }
+
+    /* Returns false when the message is not a well formed route message */
+    bool decode(const struct nlmsghdr *h);
+
+    uint16_t getMsgType() const { return m_msgType; }
+    uint8_t getFamily() const { return m_rtm->rtm_family; }
+    uint8_t getRouteType() const { return m_rtm->rtm_type; }
+    uint8_t getDstLen() const { return m_rtm->rtm_dst_len; }
+    const uint8_t *getDst() const { return m_dst; }
+
+    /* RTA_TABLE when present, the table of the rtmsg otherwise */
+    uint32_t getTable() const { return m_table; }
+
+    /* Routes with an encapsulation (EVPN type 5) carry RMAC, VLAN and L3VNI */
+    bool hasEncap() const { return m_encap; }
+
+    size_t getNextHopCount() const { return m_nhCount; }
+    const NextHop &getNextHop(size_t i) const { return m_nexthops[i]; }
+
+    /*
+     * Format the destination as nl_addr2str() does, the prefix length is
+     * only appended to network routes. Returns the string length.
+     */
+    size_t formatPrefix(char *buf) const;
+
+    /* Append "gw0,gw1,...", next hops without a gateway as 0.0.0.0 or :: */
+    void formatGateways(std::string &out) const;
+
+    /* Format an address of ADDR_STRLEN bytes at most, returns its length */
+    static size_t formatAddress(uint8_t family, const uint8_t *addr, size_t len, char *buf);
+
+private:
+    uint16_t m_msgType;
+    const struct rtmsg *m_rtm;
+    const uint8_t *m_dst;
+    uint8_t m_zeroDst[MAX_ADDR_LEN] = {};
+    uint32_t m_table;
+    bool m_encap;
+
+    std::vector<NextHop> m_nexthops;
+    size_t m_nhCount;
+
+    NextHop &addNextHop();
+};
+
+}
+
+#endif
@@ -12,6 +12,7 @@
 #include "macaddress.h"
 #include <string.h>
 #include <arpa/inet.h>
+#include <inttypes.h>
 
 using namespace std;
 using namespace swss;
@@ -45,12 +46,58 @@ RouteSync::RouteSync(RedisPipeline *pipeline) :
     m_routeTable(pipeline, APP_ROUTE_TABLE_NAME, true),
     m_vnet_routeTable(pipeline, APP_VNET_RT_TABLE_NAME, true),
     m_vnet_tunnelTable(pipeline, APP_VNET_RT_TUNNEL_TABLE_NAME, true),
-    m_warmStartHelper(pipeline, &m_routeTable, APP_ROUTE_TABLE_NAME, "bgp", "bgp"),
-    m_nl_sock(NULL), m_link_cache(NULL)
+    m_routeUpdates(&m_routeTable),
+    m_vnetRouteUpdates(&m_vnet_routeTable),
+    m_vnetTunnelUpdates(&m_vnet_tunnelTable),
+    m_warmStartHelper(pipeline, &m_routeTable, APP_ROUTE_TABLE_NAME, "bgp", "bgp")
 {
-    m_nl_sock = nl_socket_alloc();
-    nl_connect(m_nl_sock, NETLINK_ROUTE);
-    rtnl_link_alloc_cache(m_nl_sock, AF_UNSPEC, &m_link_cache);
+    getThreadState();
+}
+
+/* Route decoder and link cache of the thread handling route messages */
+struct RouteSync::ThreadState
+{
+    RouteDecoder        decoder;
+    struct nl_cache    *link_cache;
+    struct nl_sock     *nl_sock;
+
+    ThreadState() : link_cache(NULL)
+    {
+        nl_sock = nl_socket_alloc();
+        nl_connect(nl_sock, NETLINK_ROUTE);
+        rtnl_link_alloc_cache(nl_sock, AF_UNSPEC, &link_cache);
+    }
+
+    ~ThreadState()
+    {
+        if (link_cache)
+        {
+            nl_cache_free(link_cache);
+        }
+        nl_socket_free(nl_sock);
+    }
+};
+
+RouteSync::ThreadState &RouteSync::getThreadState()
+{
+    static thread_local unique_ptr<ThreadState> state;
+    if (!state)
+    {
+        state.reset(new ThreadState());
+    }
+    return *state;
+}
+
+void RouteSync::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
+{
+    lock_guard<mutex> lock(m_refreshMutex);
+    m_warmStartHelper.insertRefreshMap(kfv);
+}
+
+void RouteSync::reconcile()
+{
+    unique_lock<shared_timed_mutex> lock(m_reconcileMutex);
+    m_warmStartHelper.reconcile();
 }
 
 char *RouteSync::prefixMac2Str(char *mac, char *buf, int size)
@@ -445,7 +492,7 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
     {
         if (!warmRestartInProgress)
         {
-            m_routeTable.del(destipprefix);
+            m_routeUpdates.del(destipprefix);
             return;
         }
         else
@@ -457,7 +504,7 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
             const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
                                                                DEL_COMMAND,
                                                                fvVector);
-            m_warmStartHelper.insertRefreshMap(kfv);
+            insertRefreshMap(kfv);
             return;
         }
     }
@@ -522,7 +569,7 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
 
     if (!warmRestartInProgress)
     {
-        m_routeTable.set(destipprefix, fvVector);
+        m_routeUpdates.set(destipprefix, fvVector);
         SWSS_LOG_DEBUG("RouteTable set msg: %s vtep:%s vni:%s mac:%s intf:%s",
                        destipprefix, nexthops.c_str(), vni_list.c_str(), mac_list.c_str(), intf_list.c_str());
     }
@@ -539,83 +586,112 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
         const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
                                                            SET_COMMAND,
                                                            fvVector);
-        m_warmStartHelper.insertRefreshMap(kfv);
+        insertRefreshMap(kfv);
     }
     return;
 }
 
+void RouteSync::flushRoutes()
+{
+    size_t pending = m_routeUpdates.getPendingCount() +
+                     m_vnetRouteUpdates.getPendingCount() +
+                     m_vnetTunnelUpdates.getPendingCount();
+    if (!pending)
+    {
+        return;
+    }
+
+    size_t writes = m_routeUpdates.flush();
+    writes += m_vnetRouteUpdates.flush();
+    writes += m_vnetTunnelUpdates.flush();
+
+    SWSS_LOG_INFO("Flushed %zu route writes, %" PRIu64 " of %" PRIu64 " route updates suppressed so far",
+                  writes,
+                  m_routeUpdates.getSuppressed() + m_vnetRouteUpdates.getSuppressed() +
+                  m_vnetTunnelUpdates.getSuppressed(),
+                  m_routeUpdates.getUpdates() + m_vnetRouteUpdates.getUpdates() +
+                  m_vnetTunnelUpdates.getUpdates());
+}
+
 void RouteSync::onMsgRaw(struct nlmsghdr *h)
 {
     int len;
+    RouteDecoder &decoder = getThreadState().decoder;
 
     if ((h->nlmsg_type != RTM_NEWROUTE)
         && (h->nlmsg_type != RTM_DELROUTE))
         return;
     /* Length validity. */
     len = (int)(h->nlmsg_len - NLMSG_LENGTH(sizeof(struct ndmsg)));
-    if (len < 0) 
+    if (len < 0 || !decoder.decode(h))
     {
         SWSS_LOG_ERROR("%s: Message received from netlink is of a broken size %d %zu",
             __PRETTY_FUNCTION__, h->nlmsg_len,
             (size_t)NLMSG_LENGTH(sizeof(struct ndmsg)));
         return;
     }
-    onEvpnRouteMsg(h, len);
-    return;
-}
 
-void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
-{
-    struct rtnl_route *route_obj = (struct rtnl_route *)obj;
+    shared_lock<shared_timed_mutex> lock(m_reconcileMutex);
+
+    if (decoder.hasEncap())
+    {
+        onEvpnRouteMsg(h, len);
+        return;
+    }
 
     /* Supports IPv4 or IPv6 address, otherwise return immediately */
-    auto family = rtnl_route_get_family(route_obj);
+    auto family = decoder.getFamily();
     if (family != AF_INET && family != AF_INET6)
     {
-        SWSS_LOG_INFO("Unknown route family support (object: %s)", nl_object_get_type(obj));
+        SWSS_LOG_INFO("Unknown route family support (family: %d)", family);
         return;
     }
 
     /* Get the index of the master device */
-    unsigned int master_index = rtnl_route_get_table(route_obj);
+    unsigned int master_index = decoder.getTable();
     char master_name[IFNAMSIZ] = {0};
 
-    /* if the table_id is not set in the route obj then route is for default vrf. */
+    /* if the table_id is not set in the route msg then route is for default vrf. */
     if (master_index)
     {
         /* Get the name of the master device */
         getIfName(master_index, master_name, IFNAMSIZ);
-    
+
         /* If the master device name starts with VNET_PREFIX, it is a VNET route.
            The VNET name is exactly the name of the associated master device. */
         if (string(master_name).find(VNET_PREFIX) == 0)
         {
-            onVnetRouteMsg(nlmsg_type, obj, string(master_name));
+            onVnetRouteMsg(decoder, string(master_name));
         }
         /* Otherwise, it is a regular route (include VRF route). */
         else
         {
-            onRouteMsg(nlmsg_type, obj, master_name);
+            onRouteMsg(decoder, master_name);
         }
 
     }
     else
     {
-        onRouteMsg(nlmsg_type, obj, NULL);
+        onRouteMsg(decoder, NULL);
     }
 }
 
+void RouteSync::onMsg(int nlmsg_type, struct nl_object *obj)
+{
+    /* Route messages are decoded from the raw netlink message by onMsgRaw() */
+    SWSS_LOG_INFO("Ignore libnl route object, message-type: %d", nlmsg_type);
+}
+
 /* 
  * Handle regular route (include VRF route) 
- * @arg nlmsg_type      Netlink message type
- * @arg obj             Netlink object
+ * @arg route           Decoded route message
  * @arg vrf             Vrf name
  */
-void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
+void RouteSync::onRouteMsg(const RouteDecoder &route, char *vrf)
 {
-    struct rtnl_route *route_obj = (struct rtnl_route *)obj;
-    struct nl_addr *dip;
+    int nlmsg_type = route.getMsgType();
     char destipprefix[IFNAMSIZ + MAX_ADDR_SIZE + 2] = {0};
+    size_t vrf_len = 0;
 
     if (vrf)
     {
@@ -625,15 +701,15 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
          */
         if (memcmp(vrf, VRF_PREFIX, strlen(VRF_PREFIX)))
         {
-            SWSS_LOG_ERROR("Invalid VRF name %s (ifindex %u)", vrf, rtnl_route_get_table(route_obj));
+            SWSS_LOG_ERROR("Invalid VRF name %s (ifindex %u)", vrf, route.getTable());
             return;
         }
-        memcpy(destipprefix, vrf, strlen(vrf));
-        destipprefix[strlen(vrf)] = ':';
+        vrf_len = strlen(vrf);
+        memcpy(destipprefix, vrf, vrf_len);
+        destipprefix[vrf_len++] = ':';
     }
 
-    dip = rtnl_route_get_dst(route_obj);
-    nl_addr2str(dip, destipprefix + strlen(destipprefix), MAX_ADDR_SIZE);
+    route.formatPrefix(destipprefix + vrf_len);
 
     /*
      * Upon arrival of a delete msg we could either push the change right away,
@@ -645,7 +721,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     {
         if (!warmRestartInProgress)
         {
-            m_routeTable.del(destipprefix);
+            m_routeUpdates.del(destipprefix);
             return;
         }
         else
@@ -657,7 +733,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
             const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
                                                                DEL_COMMAND,
                                                                fvVector);
-            m_warmStartHelper.insertRefreshMap(kfv);
+            insertRefreshMap(kfv);
             return;
         }
     }
@@ -667,14 +743,14 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
         return;
     }
 
-    switch (rtnl_route_get_type(route_obj))
+    switch (route.getRouteType())
     {
         case RTN_BLACKHOLE:
         {
             vector<FieldValueTuple> fvVector;
             FieldValueTuple fv("blackhole", "true");
             fvVector.push_back(fv);
-            m_routeTable.set(destipprefix, fvVector);
+            m_routeUpdates.set(destipprefix, fvVector);
             return;
         }
         case RTN_UNICAST:
@@ -690,30 +766,27 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
             return;
     }
 
-    struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
-    if (!nhs)
+    if (!route.getNextHopCount())
     {
         SWSS_LOG_INFO("Nexthop list is empty for %s", destipprefix);
         return;
     }
 
     /* Get nexthop lists */
-    string nexthops = getNextHopGw(route_obj);
-    string ifnames = getNextHopIf(route_obj);
+    string nexthops;
+    string ifnames;
+    route.formatGateways(nexthops);
+    getNextHopIf(route, ifnames);
 
-    vector<string> alsv = tokenize(ifnames, ',');
-    for (auto alias : alsv)
+    /*
+     * An FRR behavior change from 7.2 to 7.5 makes FRR update default route to eth0 in interface
+     * up/down events. Skipping routes to eth0 or docker0 to avoid such behavior
+     */
+    if (hasIfName(ifnames, "eth0") || hasIfName(ifnames, "docker0"))
     {
-        /*
-         * An FRR behavior change from 7.2 to 7.5 makes FRR update default route to eth0 in interface
-         * up/down events. Skipping routes to eth0 or docker0 to avoid such behavior
-         */
-        if (alias == "eth0" || alias == "docker0")
-        {
-            SWSS_LOG_DEBUG("Skip routes to eth0 or docker0: %s %s %s",
-                    destipprefix, nexthops.c_str(), ifnames.c_str());
-            return;
-        }
+        SWSS_LOG_DEBUG("Skip routes to eth0 or docker0: %s %s %s",
+                destipprefix, nexthops.c_str(), ifnames.c_str());
+        return;
     }
 
     vector<FieldValueTuple> fvVector;
@@ -725,7 +798,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
 
     if (!warmRestartInProgress)
     {
-        m_routeTable.set(destipprefix, fvVector);
+        m_routeUpdates.set(destipprefix, fvVector);
         SWSS_LOG_DEBUG("RouteTable set msg: %s %s %s",
                        destipprefix, nexthops.c_str(), ifnames.c_str());
     }
@@ -742,32 +815,31 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
         const KeyOpFieldsValuesTuple kfv = std::make_tuple(destipprefix,
                                                            SET_COMMAND,
                                                            fvVector);
-        m_warmStartHelper.insertRefreshMap(kfv);
+        insertRefreshMap(kfv);
     }
 }
 
 /* 
  * Handle vnet route 
- * @arg nlmsg_type      Netlink message type
- * @arg obj             Netlink object
+ * @arg route           Decoded route message
  * @arg vnet            Vnet name
  */     
-void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vnet)
+void RouteSync::onVnetRouteMsg(const RouteDecoder &route, string vnet)
 {
-    struct rtnl_route *route_obj = (struct rtnl_route *)obj;
+    int nlmsg_type = route.getMsgType();
 
     /* Get the destination IP prefix */
-    struct nl_addr *dip = rtnl_route_get_dst(route_obj);
     char destipprefix[MAX_ADDR_SIZE + 1] = {0};
-    nl_addr2str(dip, destipprefix, MAX_ADDR_SIZE);
+    route.formatPrefix(destipprefix);
 
     string vnet_dip =  vnet + string(":") + destipprefix;
     SWSS_LOG_DEBUG("Receive new vnet route message %s", vnet_dip.c_str());
 
     /* Ignore IPv6 link-local and mc addresses as Vnet routes */
-    auto family = rtnl_route_get_family(route_obj);
+    auto family = route.getFamily();
+    const struct in6_addr *dip = reinterpret_cast<const struct in6_addr *>(route.getDst());
     if (family == AF_INET6 &&
-       (IN6_IS_ADDR_LINKLOCAL(nl_addr_get_binary_addr(dip)) || IN6_IS_ADDR_MULTICAST(nl_addr_get_binary_addr(dip))))
+       (IN6_IS_ADDR_LINKLOCAL(dip) || IN6_IS_ADDR_MULTICAST(dip)))
     {
         SWSS_LOG_INFO("Ignore linklocal vnet routes %d for %s", nlmsg_type, vnet_dip.c_str());
         return;
@@ -776,8 +848,8 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vne
     if (nlmsg_type == RTM_DELROUTE)
     {
         /* Duplicated delete as we do not know if it is a VXLAN tunnel route*/
-        m_vnet_routeTable.del(vnet_dip);
-        m_vnet_tunnelTable.del(vnet_dip);
+        m_vnetRouteUpdates.del(vnet_dip);
+        m_vnetTunnelUpdates.del(vnet_dip);
         return;
     }
     else if (nlmsg_type != RTM_NEWROUTE)
@@ -786,7 +858,7 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vne
         return;
     }
 
-    switch (rtnl_route_get_type(route_obj))
+    switch (route.getRouteType())
     {
         case RTN_UNICAST:
             break;
@@ -806,16 +878,17 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vne
             return;
     }
 
-    struct nl_list_head *nhs = rtnl_route_get_nexthops(route_obj);
-    if (!nhs)
+    if (!route.getNextHopCount())
     {
         SWSS_LOG_INFO("Nexthop list is empty for %s", vnet_dip.c_str());
         return;
     }
 
     /* Get nexthop lists */
-    string nexthops = getNextHopGw(route_obj);
-    string ifnames = getNextHopIf(route_obj);
+    string nexthops;
+    string ifnames;
+    route.formatGateways(nexthops);
+    getNextHopIf(route, ifnames);
 
     /* If the the first interface name starts with VXLAN_IF_NAME_PREFIX,
        the route is a VXLAN tunnel route. */
@@ -825,7 +898,7 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vne
         FieldValueTuple ep("endpoint", nexthops);
         fvVector.push_back(ep);
 
-        m_vnet_tunnelTable.set(vnet_dip, fvVector);
+        m_vnetTunnelUpdates.set(vnet_dip, fvVector);
         SWSS_LOG_DEBUG("%s set msg: %s %s",
                        APP_VNET_RT_TUNNEL_TABLE_NAME, vnet_dip.c_str(), nexthops.c_str());
         return;
@@ -838,7 +911,7 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vne
         fvVector.push_back(idx);
 
         /* If the route has at least one next hop gateway, e.g., nexthops does not only have ',' */
-        if (nexthops.length() + 1 > (unsigned int)rtnl_route_get_nnexthops(route_obj))
+        if (nexthops.length() + 1 > route.getNextHopCount())
         {
             FieldValueTuple nh("nexthop", nexthops);
             fvVector.push_back(nh);
@@ -851,7 +924,7 @@ void RouteSync::onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vne
                            APP_VNET_RT_TABLE_NAME, vnet_dip.c_str(), ifnames.c_str());
         }
 
-        m_vnet_routeTable.set(vnet_dip, fvVector);
+        m_vnetRouteUpdates.set(vnet_dip, fvVector);
     }
 }
 
@@ -873,11 +946,12 @@ bool RouteSync::getIfName(int if_index, char *if_name, size_t name_len)
     memset(if_name, 0, name_len);
 
     /* Cannot get interface name. Possibly the interface gets re-created. */
-    if (!rtnl_link_i2name(m_link_cache, if_index, if_name, name_len))
+    ThreadState &state = getThreadState();
+    if (!rtnl_link_i2name(state.link_cache, if_index, if_name, name_len))
     {
         /* Trying to refill cache */
-        nl_cache_refill(m_nl_sock, m_link_cache);
-        if (!rtnl_link_i2name(m_link_cache, if_index, if_name, name_len))
+        nl_cache_refill(state.nl_sock, state.link_cache);
+        if (!rtnl_link_i2name(state.link_cache, if_index, if_name, name_len))
         {
             return false;
         }
@@ -887,78 +961,60 @@ bool RouteSync::getIfName(int if_index, char *if_name, size_t name_len)
 }
 
 /*
- * Get next hop gateway IP addresses
- * @arg route_obj     route object
+ * Get next hop interface names
+ * @arg route         decoded route message
+ * @arg result        string the names are appended to
  *
- * Return concatenation of IP addresses: gw0 + "," + gw1 + .... + "," + gwN
+ * Append concatenation of interface names: if0 + "," + if1 + .... + "," + ifN
  */
-string RouteSync::getNextHopGw(struct rtnl_route *route_obj)
+void RouteSync::getNextHopIf(const RouteDecoder &route, string &result)
 {
-    string result = "";
-
-    for (int i = 0; i < rtnl_route_get_nnexthops(route_obj); i++)
+    for (size_t i = 0; i < route.getNextHopCount(); i++)
     {
-        struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
-        struct nl_addr *addr = rtnl_route_nh_get_gateway(nexthop);
+        /* Get the ID of next hop interface */
+        int if_index = route.getNextHop(i).ifindex;
+        char if_name[IFNAMSIZ] = "0";
 
-        /* Next hop gateway is not empty */
-        if (addr)
+        if (i)
         {
-            char gw_ip[MAX_ADDR_SIZE + 1] = {0};
-            nl_addr2str(addr, gw_ip, MAX_ADDR_SIZE);
-            result += gw_ip;
+            result += ',';
         }
-        else
+
+        /* If we cannot get the interface name */
+        if (!getIfName(if_index, if_name, IFNAMSIZ))
         {
-            if (rtnl_route_get_family(route_obj) == AF_INET)
-            {
-                result += "0.0.0.0";
-            }
-            else
-            {
-                result += "::";
-            }
+            result += "unknown";
         }
-
-        if (i + 1 < rtnl_route_get_nnexthops(route_obj))
+        else
         {
-            result += string(",");
+            result += if_name;
         }
     }
-
-    return result;
 }
 
 /*
- * Get next hop interface names
- * @arg route_obj     route object
- *
- * Return concatenation of interface names: if0 + "," + if1 + .... + "," + ifN
+ * Check if a list of interface names contains an interface
+ * @arg ifnames       concatenation of interface names: if0 + "," + if1 + ....
+ * @arg name          interface name
  */
-string RouteSync::getNextHopIf(struct rtnl_route *route_obj)
+bool RouteSync::hasIfName(const string &ifnames, const char *name)
 {
-    string result = "";
+    size_t len = strlen(name);
 
-    for (int i = 0; i < rtnl_route_get_nnexthops(route_obj); i++)
+    for (size_t pos = 0; pos < ifnames.size(); pos++)
     {
-        struct rtnl_nexthop *nexthop = rtnl_route_nexthop_n(route_obj, i);
-        /* Get the ID of next hop interface */
-        unsigned if_index = rtnl_route_nh_get_ifindex(nexthop);
-        char if_name[IFNAMSIZ] = "0";
-
-        /* If we cannot get the interface name */
-        if (!getIfName(if_index, if_name, IFNAMSIZ))
+        size_t end = ifnames.find(',', pos);
+        if (end == string::npos)
         {
-            strcpy(if_name, "unknown");
+            end = ifnames.size();
         }
 
-        result += if_name;
-
-        if (i + 1 < rtnl_route_get_nnexthops(route_obj))
+        if (end - pos == len && !ifnames.compare(pos, len, name))
         {
-            result += string(",");
+            return true;
         }
+        pos = end;
     }
 
-    return result;
+    return false;
 }
@@ -5,8 +5,11 @@
 #include "producerstatetable.h"
 #include "netmsg.h"
 #include "warmRestartHelper.h"
+#include "fpmsyncd/routedecoder.h"
+#include "fpmsyncd/routecoalescer.h"
 #include <string.h>
 #include <bits/stdc++.h>
+#include <shared_mutex>
 
 using namespace std;
 
@@ -26,6 +29,13 @@ public:
     virtual void onMsg(int nlmsg_type, struct nl_object *obj);
 
     virtual void onMsgRaw(struct nlmsghdr *obj);
+
+    /* Write the coalesced updates of the current batch to the pipeline */
+    void flushRoutes();
+
+    /* Run the warm-restart reconciliation, while no route message is handled */
+    void reconcile();
+
     WarmStartHelper  m_warmStartHelper;
 
 private:
@@ -35,11 +45,26 @@ private:
     ProducerStateTable  m_vnet_routeTable;
     /* vnet vxlan tunnel table */  
     ProducerStateTable  m_vnet_tunnelTable; 
-    struct nl_cache    *m_link_cache;
-    struct nl_sock     *m_nl_sock;
+    /* updates of the tables above, coalesced per batch */
+    RouteCoalescer      m_routeUpdates;
+    RouteCoalescer      m_vnetRouteUpdates;
+    RouteCoalescer      m_vnetTunnelUpdates;
+    /*
+     * onMsgRaw() may be called by several FPM connection threads. Each of
+     * them decodes with its own ThreadState, updates are serialized by the
+     * coalescers, and reconcile() excludes the route message handlers. The
+     * updates of a prefix are ordered only within one connection.
+     */
+    struct ThreadState;
+    std::shared_timed_mutex m_reconcileMutex;
+    std::mutex          m_refreshMutex;
+
+    static ThreadState &getThreadState();
+
+    void insertRefreshMap(const KeyOpFieldsValuesTuple &kfv);
 
     /* Handle regular route (include VRF route) */
-    void onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf);
+    void onRouteMsg(const RouteDecoder &route, char *vrf);
 
     void parseEncap(struct rtattr *tb, uint32_t &encap_value, string &rmac);
 
@@ -53,7 +78,7 @@ private:
     void onEvpnRouteMsg(struct nlmsghdr *h, int len);
 
     /* Handle vnet route */
-    void onVnetRouteMsg(int nlmsg_type, struct nl_object *obj, string vnet);
+    void onVnetRouteMsg(const RouteDecoder &route, string vnet);
 
     /* Get interface name based on interface index */
     bool getIfName(int if_index, char *if_name, size_t name_len);
@@ -70,11 +95,11 @@ private:
                         string& nexthops, string& vni_list, string& mac_list,
                         string& intf_list);
 
-    /* Get next hop gateway IP addresses */
-    string getNextHopGw(struct rtnl_route *route_obj);
-
     /* Get next hop interfaces */
-    string getNextHopIf(struct rtnl_route *route_obj);
+    void getNextHopIf(const RouteDecoder &route, string &result);
+
+    /* Check if an interface is in a list of next hop interfaces */
+    static bool hasIfName(const string &ifnames, const char *name);
 };
 
 }
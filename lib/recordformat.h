@@ -0,0 +1,235 @@
+#ifndef SWSS_COMMON_RECORD_FORMAT_H
+#define SWSS_COMMON_RECORD_FORMAT_H
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <istream>
+
+#include "table.h"
+
+/*
+ * Binary swss.rec format.
+ *
+ * The file starts with a RecordFileHeader, followed by records made of a
+ * RecordHeader, the lengths of the fields and values of the tuple, then the
+ * DB name, table name separator, table name, key, operation, fields and
+ * values back to back, without terminators. Text records (e.g. "recording
+ * started") carry their text as key. Integers are in host byte order, the
+ * file is meant to be replayed on the kind of host which recorded it.
+ */
+
+namespace swss {
+
+#define RECORD_FILE_MAGIC   "SWSSREC"
+#define RECORD_FILE_VERSION 1
+
+struct RecordFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+enum RecordType : uint8_t
+{
+    RECORD_TUPLE = 1,
+    RECORD_TEXT = 2,
+};
+
+struct RecordHeader
+{
+    uint32_t size;          // record size, header included
+    uint8_t type;
+    uint8_t db_len;
+    uint8_t separator_len;
+    uint8_t op_len;
+    uint64_t timestamp;     // microseconds since the epoch
+    uint32_t table_len;
+    uint32_t key_len;
+    uint32_t fv_count;
+    uint32_t reserved;
+};
+
+struct Record
+{
+    RecordType type;
+    uint64_t timestamp;
+    std::string db;
+    std::string separator;
+    std::string table;
+    std::string key;
+    std::string op;
+    std::vector<FieldValueTuple> fvs;
+};
+
+inline void initRecordFileHeader(RecordFileHeader &header)
+{
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, RECORD_FILE_MAGIC, sizeof(RECORD_FILE_MAGIC));
+    header.version = RECORD_FILE_VERSION;
+}
+
+inline bool isRecordFileHeader(const RecordFileHeader &header)
+{
+    return memcmp(header.magic, RECORD_FILE_MAGIC, sizeof(RECORD_FILE_MAGIC)) == 0 &&
+           header.version == RECORD_FILE_VERSION;
+}
+
+inline size_t recordSize(const std::string &db, const std::string &separator,
+                         const std::string &table, const KeyOpFieldsValuesTuple &tuple)
+{
+    size_t size = sizeof(RecordHeader) + db.size() + separator.size() + table.size() +
+                  kfvKey(tuple).size() + kfvOp(tuple).size();
+    for (const auto &fv : kfvFieldsValues(tuple))
+    {
+        size += 2 * sizeof(uint32_t) + fvField(fv).size() + fvValue(fv).size();
+    }
+    return size;
+}
+
+/*
+ * Encode a tuple record of recordSize() bytes through
+ * write(const void *data, size_t len), which lets the recorder copy the
+ * strings straight to their destination.
+ */
+template <typename Writer>
+void encodeRecord(Writer &&write, size_t size, uint64_t timestamp,
+                  const std::string &db, const std::string &separator,
+                  const std::string &table, const KeyOpFieldsValuesTuple &tuple)
+{
+    const auto &fvs = kfvFieldsValues(tuple);
+
+    RecordHeader header;
+    memset(&header, 0, sizeof(header));
+    header.size = static_cast<uint32_t>(size);
+    header.type = RECORD_TUPLE;
+    header.db_len = static_cast<uint8_t>(db.size());
+    header.separator_len = static_cast<uint8_t>(separator.size());
+    header.op_len = static_cast<uint8_t>(kfvOp(tuple).size());
+    header.timestamp = timestamp;
+    header.table_len = static_cast<uint32_t>(table.size());
+    header.key_len = static_cast<uint32_t>(kfvKey(tuple).size());
+    header.fv_count = static_cast<uint32_t>(fvs.size());
+    write(&header, sizeof(header));
+
+    for (const auto &fv : fvs)
+    {
+        uint32_t lens[2] = {
+            static_cast<uint32_t>(fvField(fv).size()),
+            static_cast<uint32_t>(fvValue(fv).size())
+        };
+        write(lens, sizeof(lens));
+    }
+
+    write(db.data(), db.size());
+    write(separator.data(), separator.size());
+    write(table.data(), table.size());
+    write(kfvKey(tuple).data(), kfvKey(tuple).size());
+    write(kfvOp(tuple).data(), kfvOp(tuple).size());
+    for (const auto &fv : fvs)
+    {
+        write(fvField(fv).data(), fvField(fv).size());
+        write(fvValue(fv).data(), fvValue(fv).size());
+    }
+}
+
+template <typename Writer>
+void encodeTextRecord(Writer &&write, uint64_t timestamp, const std::string &text)
+{
+    RecordHeader header;
+    memset(&header, 0, sizeof(header));
+    header.size = static_cast<uint32_t>(sizeof(header) + text.size());
+    header.type = RECORD_TEXT;
+    header.timestamp = timestamp;
+    header.key_len = static_cast<uint32_t>(text.size());
+    write(&header, sizeof(header));
+    write(text.data(), text.size());
+}
+
+/* Decode a complete record, returns false when it is malformed */
+inline bool decodeRecord(const char *data, size_t size, Record &record)
+{
+    RecordHeader header;
+    if (size < sizeof(header))
+    {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.size != size || (header.type != RECORD_TUPLE && header.type != RECORD_TEXT))
+    {
+        return false;
+    }
+
+    const char *pos = data + sizeof(header);
+    const char *end = data + size;
+
+    if (static_cast<size_t>(end - pos) / (2 * sizeof(uint32_t)) < header.fv_count)
+    {
+        return false;
+    }
+    std::vector<uint32_t> lens(2 * header.fv_count);
+    if (!lens.empty())
+    {
+        memcpy(lens.data(), pos, lens.size() * sizeof(uint32_t));
+        pos += lens.size() * sizeof(uint32_t);
+    }
+
+    auto take = [&pos, end](std::string &s, size_t len) {
+        if (static_cast<size_t>(end - pos) < len)
+        {
+            return false;
+        }
+        s.assign(pos, len);
+        pos += len;
+        return true;
+    };
+
+    record.type = static_cast<RecordType>(header.type);
+    record.timestamp = header.timestamp;
+    record.fvs.resize(header.fv_count);
+
+    if (!take(record.db, header.db_len) ||
+        !take(record.separator, header.separator_len) ||
+        !take(record.table, header.table_len) ||
+        !take(record.key, header.key_len) ||
+        !take(record.op, header.op_len))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < header.fv_count; i++)
+    {
+        if (!take(fvField(record.fvs[i]), lens[2 * i]) ||
+            !take(fvValue(record.fvs[i]), lens[2 * i + 1]))
+        {
+            return false;
+        }
+    }
+
+    return pos == end;
+}
+
+/* Read the next record of a binary recording, after its file header */
+inline bool readRecord(std::istream &in, std::vector<char> &buffer, Record &record)
+{
+    RecordHeader header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)) || header.size < sizeof(header))
+    {
+        return false;
+    }
+
+    buffer.resize(header.size);
+    memcpy(buffer.data(), &header, sizeof(header));
+    if (!in.read(buffer.data() + sizeof(header), static_cast<std::streamsize>(header.size - sizeof(header))))
+    {
+        return false;
+    }
+
+    return decodeRecord(buffer.data(), buffer.size(), record);
+}
+
+}
+
+#endif /* SWSS_COMMON_RECORD_FORMAT_H */
@@ -0,0 +1,82 @@
+#include "neighsyncd/neighshadow.h"
+
+using namespace std;
+using namespace swss;
+
+NeighShadow::Key::Key(int ifindex, uint8_t family, const void *addr, size_t len) :
+    ifindex(ifindex),
+    family(family)
+{
+    memset(this->addr, 0, sizeof(this->addr));
+    memcpy(this->addr, addr, min(len, sizeof(this->addr)));
+}
+
+size_t NeighShadow::KeyHash::operator()(const Key &key) const
+{
+    /* FNV-1a over the key fields */
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    auto add = [&hash](const uint8_t *data, size_t len) {
+        for (size_t i = 0; i < len; i++)
+        {
+            hash ^= data[i];
+            hash *= 0x100000001b3ULL;
+        }
+    };
+
+    add(key.addr, sizeof(key.addr));
+    add(reinterpret_cast<const uint8_t *>(&key.ifindex), sizeof(key.ifindex));
+    add(&key.family, sizeof(key.family));
+    return static_cast<size_t>(hash);
+}
+
+bool NeighShadow::set(const Key &key, const uint8_t *mac, size_t mac_len)
+{
+    if (mac_len != MAC_LEN)
+    {
+        m_entries.erase(key);
+        m_published++;
+        return true;
+    }
+
+    auto it = m_entries.find(key);
+    if (it != m_entries.end() && !it->second.deleted && !memcmp(it->second.mac, mac, MAC_LEN))
+    {
+        m_suppressed++;
+        return false;
+    }
+
+    Entry &entry = m_entries[key];
+    memcpy(entry.mac, mac, MAC_LEN);
+    entry.deleted = false;
+    m_published++;
+    return true;
+}
+
+bool NeighShadow::del(const Key &key, bool removed)
+{
+    auto it = m_entries.find(key);
+    bool publish = it == m_entries.end() || !it->second.deleted;
+
+    if (removed)
+    {
+        if (it != m_entries.end())
+        {
+            m_entries.erase(it);
+        }
+    }
+    else if (publish)
+    {
+        Entry &entry = it == m_entries.end() ? m_entries[key] : it->second;
+        entry.deleted = true;
+    }
+
+    if (publish)
+    {
+        m_published++;
+    }
+    else
+    {
+        m_suppressed++;
+    }
+    return publish;
+}
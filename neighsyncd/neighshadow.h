@@ -0,0 +1,77 @@
+#ifndef __NEIGHSHADOW__
+#define __NEIGHSHADOW__
+
+#include <stdint.h>
+#include <string.h>
+#include <unordered_map>
+
+namespace swss {
+
+/*
+ * Shadow of the neighbors published to APPL_DB, keyed by (ifindex, IP).
+ *
+ * The kernel sends a NEWNEIGH for every state refresh of a neighbor, most of
+ * them without any change to the MAC published for it. The shadow tells
+ * which events change the published state, so that the others are dropped
+ * before any key string is built or any ProducerStateTable operation issued.
+ */
+class NeighShadow
+{
+public:
+    enum { ADDR_LEN = 16, MAC_LEN = 6 };
+
+    struct Key
+    {
+        int ifindex;
+        uint8_t family;
+        uint8_t addr[ADDR_LEN];
+
+        Key(int ifindex, uint8_t family, const void *addr, size_t len);
+
+        bool operator==(const Key &other) const
+        {
+            return ifindex == other.ifindex && family == other.family &&
+                   !memcmp(addr, other.addr, sizeof(addr));
+        }
+    };
+
+    NeighShadow() : m_published(0), m_suppressed(0) { }
+
+    /*
+     * Returns true when the neighbor must be published with this MAC, false
+     * when it is already published with it. MACs that are not Ethernet
+     * addresses are not shadowed and always published.
+     */
+    bool set(const Key &key, const uint8_t *mac, size_t mac_len);
+
+    /*
+     * Returns true when the delete of the neighbor must be published. A
+     * neighbor deleted because it became unreachable is remembered until the
+     * kernel removes it, so that repeated failures are published once.
+     */
+    bool del(const Key &key, bool removed);
+
+    size_t size() const { return m_entries.size(); }
+    uint64_t getPublished() const { return m_published; }
+    uint64_t getSuppressed() const { return m_suppressed; }
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const;
+    };
+
+    struct Entry
+    {
+        uint8_t mac[MAC_LEN];
+        bool deleted;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> m_entries;
+    uint64_t m_published;
+    uint64_t m_suppressed;
+};
+
+}
+
+#endif
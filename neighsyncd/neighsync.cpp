@@ -1,4 +1,6 @@
 #include <string>
+#include <string.h>
+#include <inttypes.h>
 #include <netinet/in.h>
 #include <netlink/route/link.h>
 #include <netlink/route/neighbour.h>
@@ -9,7 +11,6 @@
 #include "ipaddress.h"
 #include "netmsg.h"
 #include "linkcache.h"
-#include "macaddress.h"
 
 #include "neighsync.h"
 #include "warm_restart.h"
@@ -17,9 +18,13 @@
 using namespace std;
 using namespace swss;
 
+static const uint8_t BROADCAST_MAC[] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+
 NeighSync::NeighSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb) :
-    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME),
-    m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME)
+    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME, true),
+    m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME),
+    m_pipeline(pipelineAppDB),
+    m_reportedSuppressed(0)
 {
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "neighsyncd", "swss", DEFAULT_NEIGHSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
@@ -62,24 +67,21 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
         (nlmsg_type != RTM_DELNEIGH))
         return;
 
-    if (rtnl_neigh_get_family(neigh) == AF_INET)
+    int addr_family = rtnl_neigh_get_family(neigh);
+    if (addr_family == AF_INET)
         family = IPV4_NAME;
-    else if (rtnl_neigh_get_family(neigh) == AF_INET6)
+    else if (addr_family == AF_INET6)
         family = IPV6_NAME;
     else
         return;
 
-    key+= LinkCache::getInstance().ifindexToName(rtnl_neigh_get_ifindex(neigh));
-    key+= ":";
-
-    nl_addr2str(rtnl_neigh_get_dst(neigh), ipStr, MAX_ADDR_SIZE);
+    struct nl_addr *dst = rtnl_neigh_get_dst(neigh);
     /* Ignore IPv6 link-local addresses as neighbors */
-    if (family == IPV6_NAME && IN6_IS_ADDR_LINKLOCAL(nl_addr_get_binary_addr(rtnl_neigh_get_dst(neigh))))
+    if (addr_family == AF_INET6 && IN6_IS_ADDR_LINKLOCAL(nl_addr_get_binary_addr(dst)))
         return;
     /* Ignore IPv6 multicast link-local addresses as neighbors */
-    if (family == IPV6_NAME && IN6_IS_ADDR_MC_LINKLOCAL(nl_addr_get_binary_addr(rtnl_neigh_get_dst(neigh))))
+    if (addr_family == AF_INET6 && IN6_IS_ADDR_MC_LINKLOCAL(nl_addr_get_binary_addr(dst)))
         return;
-    key+= ipStr;
 
     int state = rtnl_neigh_get_state(neigh);
     if (state == NUD_NOARP)
@@ -94,15 +96,41 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
 	    delete_key = true;
     }
 
-    nl_addr2str(rtnl_neigh_get_lladdr(neigh), macStr, MAX_ADDR_SIZE);
+    struct nl_addr *lladdr = rtnl_neigh_get_lladdr(neigh);
+    const uint8_t *mac = lladdr ? static_cast<const uint8_t *>(nl_addr_get_binary_addr(lladdr)) : NULL;
+    size_t mac_len = lladdr ? nl_addr_get_len(lladdr) : 0;
 
     /* Ignore neighbor entries with Broadcast Mac - Trigger for directed broadcast */
-    if (!delete_key && (MacAddress(macStr) == MacAddress("ff:ff:ff:ff:ff:ff")))
+    if (!delete_key && mac_len == sizeof(BROADCAST_MAC) && !memcmp(mac, BROADCAST_MAC, mac_len))
     {
+        nl_addr2str(dst, ipStr, MAX_ADDR_SIZE);
         SWSS_LOG_INFO("Broadcast Mac received, ignoring for %s", ipStr);
         return;
     }
 
+    /*
+     * Drop the refreshes of neighbors already published with the same MAC.
+     * During warm start every change goes to the cache map, the shadow is
+     * only kept up to date.
+     */
+    NeighShadow::Key shadowKey(rtnl_neigh_get_ifindex(neigh), static_cast<uint8_t>(addr_family),
+                               nl_addr_get_binary_addr(dst), nl_addr_get_len(dst));
+    bool publish = delete_key ? m_shadow.del(shadowKey, nlmsg_type == RTM_DELNEIGH)
+                              : m_shadow.set(shadowKey, mac, mac_len);
+    bool warmStartInProgress = m_AppRestartAssist->isWarmStartInProgress();
+    if (!publish && !warmStartInProgress)
+    {
+        return;
+    }
+
+    key+= LinkCache::getInstance().ifindexToName(rtnl_neigh_get_ifindex(neigh));
+    key+= ":";
+
+    nl_addr2str(dst, ipStr, MAX_ADDR_SIZE);
+    key+= ipStr;
+
+    nl_addr2str(lladdr, macStr, MAX_ADDR_SIZE);
+
     std::vector<FieldValueTuple> fvVector;
     FieldValueTuple f("family", family);
     FieldValueTuple nh("neigh", macStr);
@@ -110,7 +138,7 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     fvVector.push_back(f);
 
     // If warmstart is in progress, we take all netlink changes into the cache map
-    if (m_AppRestartAssist->isWarmStartInProgress())
+    if (warmStartInProgress)
     {
         m_AppRestartAssist->insertToMap(APP_NEIGH_TABLE_NAME, key, fvVector, delete_key);
     }
@@ -124,3 +152,19 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
         m_neighTable.set(key, fvVector);
     }
 }
+
+/*
+ * Write the operations of the netlink messages read so far, once per read
+ * instead of once per message.
+ */
+void NeighSync::flush()
+{
+    m_pipeline->flush();
+
+    if (m_shadow.getSuppressed() != m_reportedSuppressed)
+    {
+        SWSS_LOG_INFO("%" PRIu64 " neighbor updates published, %" PRIu64 " suppressed, %zu neighbors",
+                      m_shadow.getPublished(), m_shadow.getSuppressed(), m_shadow.size());
+        m_reportedSuppressed = m_shadow.getSuppressed();
+    }
+}
@@ -5,6 +5,7 @@
 #include "producerstatetable.h"
 #include "netmsg.h"
 #include "warmRestartAssist.h"
+#include "neighsyncd/neighshadow.h"
 
 // The timeout value (in seconds) for neighsyncd reconcilation logic
 #define DEFAULT_NEIGHSYNC_WARMSTART_TIMER 5
@@ -30,6 +31,9 @@ public:
 
     bool isNeighRestoreDone();
 
+    /* Flush the neighbor operations of the last netlink read */
+    void flush();
+
     AppRestartAssist *getRestartAssist()
     {
         return m_AppRestartAssist;
@@ -39,6 +43,9 @@ private:
     Table m_stateNeighRestoreTable;
     ProducerStateTable m_neighTable;
     AppRestartAssist  *m_AppRestartAssist;
+    RedisPipeline     *m_pipeline;
+    NeighShadow        m_shadow;
+    uint64_t           m_reportedSuppressed;
 };
 
 }
@@ -82,6 +82,8 @@ int main(int argc, char **argv)
                         sync.getRestartAssist()->reconcile();
                     }
                 }
+
+                sync.flush();
             }
         }
         catch (const std::exception& e)
@@ -11,6 +11,7 @@
 #include "timer.h"
 #include "crmorch.h"
 #include "sai_serialize.h"
+#include "redispipeline.h"
 
 using namespace std;
 using namespace swss;
@@ -675,6 +676,12 @@ AclRuleCounters AclRule::getCounters()
     return AclRuleCounters(counter_attr[0].value.u64, counter_attr[1].value.u64);
 }
 
+sai_object_id_t AclRule::getCounterSnapshot(AclRuleCounters &base)
+{
+    base = AclRuleCounters();
+    return m_createCounter ? m_counterOid : SAI_NULL_OBJECT_ID;
+}
+
 shared_ptr<AclRule> AclRule::makeShared(acl_table_type_t type, AclOrch *acl, MirrorOrch *mirror, DTelOrch *dtel, const string& rule, const string& table, const KeyOpFieldsValuesTuple& data)
 {
     string action;
@@ -791,6 +798,7 @@ bool AclRule::createCounter()
     }
 
     gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_COUNTER, m_tableOid);
+    m_pAclOrch->invalidateCounters();
 
     return true;
 }
@@ -827,7 +835,7 @@ bool AclRule::removeCounter()
     gCrmOrch->decCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_COUNTER, m_tableOid);
 
     SWSS_LOG_INFO("Removing record about the counter %" PRIx64 " from the DB", m_counterOid);
-    AclOrch::getCountersTable().del(getTableId() + ":" + getId());
+    m_pAclOrch->delCounters(getTableId() + ":" + getId());
 
     m_counterOid = SAI_NULL_OBJECT_ID;
 
@@ -1831,6 +1839,19 @@ AclRuleCounters AclRuleMirror::getCounters()
     return cnt;
 }
 
+sai_object_id_t AclRuleMirror::getCounterSnapshot(AclRuleCounters &base)
+{
+    sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+
+    if (m_state)
+    {
+        oid = AclRule::getCounterSnapshot(base);
+    }
+    base = counters;
+
+    return oid;
+}
+
 AclRuleDTelFlowWatchListEntry::AclRuleDTelFlowWatchListEntry(AclOrch *aclOrch, DTelOrch *dtel, string rule, string table, acl_table_type_t type) :
         AclRule(aclOrch, rule, table, type),
         m_pDTelOrch(dtel)
@@ -2333,6 +2354,9 @@ void AclOrch::init(vector<TableConnector>& connectors, PortsOrch *portOrch, Mirr
     auto executor = new ExecutableTimer(timer, this, "ACL_POLL_TIMER");
     Orch::addExecutor(executor);
     timer->start();
+
+    m_bCollectCounters = true;
+    m_countersThread = thread(AclOrch::collectCountersThread, this);
 }
 
 void AclOrch::queryAclActionCapability()
@@ -2582,8 +2606,15 @@ AclOrch::~AclOrch()
         m_dTelOrch->detach(this);
     }
 
-    m_bCollectCounters = false;
+    {
+        unique_lock<mutex> lock(m_countersMutex);
+        m_bCollectCounters = false;
+    }
     m_sleepGuard.notify_all();
+    if (m_countersThread.joinable())
+    {
+        m_countersThread.join();
+    }
 
     deleteDTelWatchListTables();
 }
@@ -2600,6 +2631,7 @@ void AclOrch::update(SubjectType type, void *cntx)
     }
 
     unique_lock<mutex> lock(m_countersMutex);
+    invalidateCounters();
 
     // ACL table deals with port change
     // ACL rule deals with mirror session change and int session change
@@ -2633,11 +2665,13 @@ void AclOrch::doTask(Consumer &consumer)
     if (table_name == CFG_ACL_TABLE_TABLE_NAME || table_name == APP_ACL_TABLE_TABLE_NAME)
     {
         unique_lock<mutex> lock(m_countersMutex);
+        invalidateCounters();
         doAclTableTask(consumer);
     }
     else if (table_name == CFG_ACL_RULE_TABLE_NAME || table_name == APP_ACL_RULE_TABLE_NAME)
     {
         unique_lock<mutex> lock(m_countersMutex);
+        invalidateCounters();
         doAclRuleTask(consumer);
     }
     else
@@ -2889,6 +2923,7 @@ bool AclOrch::removeAclTable(string table_id)
     }
 
     /* If ACL rules associate with this table, remove the rules first.*/
+    invalidateCounters();
     bool suc = m_AclTables[table_oid].clear();
     if (!suc) return false;
 
@@ -2946,6 +2981,7 @@ bool AclOrch::addAclRule(shared_ptr<AclRule> newRule, string table_id)
         return false;
     }
 
+    invalidateCounters();
     return m_AclTables[table_oid].add(newRule);
 }
 
@@ -2958,6 +2994,7 @@ bool AclOrch::removeAclRule(string table_id, string rule_id)
         return true;
     }
 
+    invalidateCounters();
     return m_AclTables[table_oid].remove(rule_id);
 }
 
@@ -3505,24 +3542,129 @@ void AclOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
-    for (auto& table_it : m_AclTables)
+    shared_ptr<vector<AclCounterRef>> counters;
+
+    // The rules are only walked when they changed since the last poll
+    if (m_countersDirty)
+    {
+        counters = make_shared<vector<AclCounterRef>>();
+        for (auto& table_it : m_AclTables)
+        {
+            for (auto& rule_it : table_it.second.rules)
+            {
+                AclCounterRef ref;
+                ref.key = rule_it.second->getTableId() + ":" + rule_it.second->getId();
+                ref.counterOid = rule_it.second->getCounterSnapshot(ref.base);
+                counters->push_back(move(ref));
+            }
+        }
+        m_countersDirty = false;
+    }
+
+    {
+        unique_lock<mutex> lock(m_countersMutex);
+        if (counters)
+        {
+            m_counterRefs = counters;
+        }
+        m_countersPollDue = true;
+    }
+    m_sleepGuard.notify_all();
+}
+
+void AclOrch::delCounters(const string &key)
+{
+    SWSS_LOG_ENTER();
+
     {
-        vector<swss::FieldValueTuple> values;
+        lock_guard<mutex> lock(m_removedCountersMutex);
+        m_removedCounters.insert(key);
+    }
+    getCountersTable().del(key);
+    invalidateCounters();
+}
+
+void AclOrch::collectCountersThread(AclOrch *pAclOrch)
+{
+    SWSS_LOG_ENTER();
+
+    // DB connectors are not thread safe, the thread has its own
+    DBConnector db("COUNTERS_DB", 0);
+    RedisPipeline pipeline(&db);
+    Table table(&pipeline, "COUNTERS", true);
+
+    while (true)
+    {
+        shared_ptr<const vector<AclCounterRef>> counters;
 
-        for (auto rule_it : table_it.second.rules)
         {
-            AclRuleCounters cnt = rule_it.second->getCounters();
+            unique_lock<mutex> lock(m_countersMutex);
+            m_sleepGuard.wait(lock, [pAclOrch] { return !m_bCollectCounters || pAclOrch->m_countersPollDue; });
+            if (!m_bCollectCounters)
+            {
+                return;
+            }
+            pAclOrch->m_countersPollDue = false;
+            counters = pAclOrch->m_counterRefs;
+        }
 
-            swss::FieldValueTuple fvtp("Packets", to_string(cnt.packets));
-            values.push_back(fvtp);
-            swss::FieldValueTuple fvtb("Bytes", to_string(cnt.bytes));
-            values.push_back(fvtb);
+        if (counters)
+        {
+            pAclOrch->pollCounters(*counters, pipeline, table);
+        }
+    }
+}
+
+void AclOrch::pollCounters(const vector<AclCounterRef> &counters, RedisPipeline &pipeline, Table &table)
+{
+    SWSS_LOG_ENTER();
 
-            AclOrch::getCountersTable().set(rule_it.second->getTableId() + ":"
-                    + rule_it.second->getId(), values, "");
+    auto start = chrono::steady_clock::now();
+
+    for (const auto &ref : counters)
+    {
+        AclRuleCounters cnt(ref.base);
+
+        if (ref.counterOid != SAI_NULL_OBJECT_ID)
+        {
+            sai_attribute_t counter_attr[2];
+            counter_attr[0].id = SAI_ACL_COUNTER_ATTR_PACKETS;
+            counter_attr[1].id = SAI_ACL_COUNTER_ATTR_BYTES;
+
+            // The rule may have been removed since the list was handed over
+            if (sai_acl_api->get_acl_counter_attribute(ref.counterOid, 2, counter_attr) != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_INFO("Failed to get counters for %s rule", ref.key.c_str());
+                continue;
+            }
+
+            cnt += AclRuleCounters(counter_attr[0].value.u64, counter_attr[1].value.u64);
         }
-        values.clear();
+
+        vector<FieldValueTuple> values = {
+            { "Packets", to_string(cnt.packets) },
+            { "Bytes", to_string(cnt.bytes) }
+        };
+        table.set(ref.key, values, "");
     }
+    pipeline.flush();
+
+    // Counters removed meanwhile may have been written again above
+    {
+        lock_guard<mutex> lock(m_removedCountersMutex);
+        for (const auto &key : m_removedCounters)
+        {
+            table.del(key);
+        }
+        m_removedCounters.clear();
+    }
+    pipeline.flush();
+
+    auto usecs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    m_counterPollUsecs = static_cast<uint64_t>(usecs);
+    m_counterPolls++;
+
+    SWSS_LOG_INFO("Polled %zu ACL counters in %" PRId64 " us", counters.size(), static_cast<int64_t>(usecs));
 }
 
 sai_status_t AclOrch::bindAclTable(AclTable &aclTable, bool bind)
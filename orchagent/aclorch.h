@@ -7,6 +7,9 @@
 #include <mutex>
 #include <tuple>
 #include <map>
+#include <set>
+#include <atomic>
+#include <memory>
 #include <condition_variable>
 
 #include "orch.h"
@@ -19,8 +22,8 @@
 #include "acltable.h"
 
 // ACL counters update interval in the DB
-// Value is in seconds. Should not be less than 5 seconds
-// (in worst case update of 1265 counters takes almost 5 sec)
+// Value is in seconds. Counters are read by a thread of their own, the
+// main loop only hands the rules over on each interval
 #define COUNTERS_READ_INTERVAL 10
 
 #define RULE_PRIORITY           "PRIORITY"
@@ -151,6 +154,14 @@ struct AclRuleCounters
     }
 };
 
+// Counters of a rule to be read by the ACL counters thread
+struct AclCounterRef
+{
+    string key;                 // TABLE:RULE in COUNTERS
+    sai_object_id_t counterOid; // SAI_NULL_OBJECT_ID when there is nothing to read
+    AclRuleCounters base;       // added to what the counter reads
+};
+
 class AclRule
 {
 public:
@@ -172,6 +183,10 @@ public:
     virtual void updateInPorts();
     virtual AclRuleCounters getCounters();
 
+    // Counter to read for the rule, SAI_NULL_OBJECT_ID if none, and the
+    // counts kept by the rule which add up to what the counter reads
+    virtual sai_object_id_t getCounterSnapshot(AclRuleCounters &base);
+
     string getId()
     {
         return m_id;
@@ -271,6 +286,7 @@ public:
     bool remove();
     void update(SubjectType, void *);
     AclRuleCounters getCounters();
+    sai_object_id_t getCounterSnapshot(AclRuleCounters &base);
 
 protected:
     bool m_state {false};
@@ -396,6 +412,28 @@ public:
         return m_countersTable;
     }
 
+    // Rules or their counters changed, the rules are handed again to the
+    // counters thread on the next poll
+    void invalidateCounters()
+    {
+        m_countersDirty = true;
+    }
+
+    // Remove the counters of a rule from the DB, also when written by a
+    // poll in progress
+    void delCounters(const string &key);
+
+    // Polls done by the counters thread, and duration of the last one
+    uint64_t getCounterPolls() const
+    {
+        return m_counterPolls.load();
+    }
+
+    uint64_t getCounterPollUsecs() const
+    {
+        return m_counterPollUsecs.load();
+    }
+
     // FIXME: Add getters for them? I'd better to add a common directory of orch objects and use it everywhere
     MirrorOrch *m_mirrorOrch;
     NeighOrch *m_neighOrch;
@@ -447,6 +485,7 @@ private:
                                       const AclActionAttrLookupT lookupMap);
 
     static void collectCountersThread(AclOrch *pAclOrch);
+    void pollCounters(const vector<AclCounterRef> &counters, swss::RedisPipeline &pipeline, Table &table);
 
     bool createBindAclTable(AclTable &aclTable, sai_object_id_t &table_oid);
     sai_status_t bindAclTable(AclTable &aclTable, bool bind = true);
@@ -476,6 +515,23 @@ private:
     static DBConnector m_db;
     static Table m_countersTable;
 
+    /*
+     * Counters of the rules, read and written to the DB by the counters
+     * thread. The main thread rebuilds the list only when rules changed,
+     * and swaps it in under m_countersMutex, while the thread reads the
+     * previous one.
+     */
+    thread m_countersThread;
+    shared_ptr<const vector<AclCounterRef>> m_counterRefs;
+    bool m_countersDirty = true;
+    bool m_countersPollDue = false;
+    atomic<uint64_t> m_counterPolls{0};
+    atomic<uint64_t> m_counterPollUsecs{0};
+
+    // Counters removed from the DB since the last poll
+    mutex m_removedCountersMutex;
+    set<string> m_removedCounters;
+
     map<acl_stage_type_t, string> m_mirrorTableId;
     map<acl_stage_type_t, string> m_mirrorV6TableId;
 
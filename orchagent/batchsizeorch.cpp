@@ -0,0 +1,93 @@
+#include "batchsizeorch.h"
+#include "converter.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+#define BATCH_SIZE_FIELD "batch_size"
+#define MIN_BATCH_SIZE_FIELD "min_batch_size"
+#define MAX_BATCH_SIZE_FIELD "max_batch_size"
+
+BatchSizeOrch::BatchSizeOrch(DBConnector *db) :
+    Orch(db, CFG_ORCH_BATCH_SIZE_TABLE_NAME)
+{
+    SWSS_LOG_ENTER();
+}
+
+vector<BatchSizeRequest> BatchSizeOrch::takeRequests()
+{
+    vector<BatchSizeRequest> requests;
+    requests.swap(m_requests);
+    return requests;
+}
+
+void BatchSizeOrch::doTask(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = consumer.m_toSync.begin();
+    while (it != consumer.m_toSync.end())
+    {
+        KeyOpFieldsValuesTuple t = it->second;
+        string key = kfvKey(t);
+        string op = kfvOp(t);
+
+        if (op == SET_COMMAND)
+        {
+            size_t batch = 0, min = 0, max = 0;
+            bool valid = true;
+
+            for (const auto &fv : kfvFieldsValues(t))
+            {
+                try
+                {
+                    if (fvField(fv) == BATCH_SIZE_FIELD)
+                    {
+                        batch = to_uint<uint32_t>(fvValue(fv));
+                    }
+                    else if (fvField(fv) == MIN_BATCH_SIZE_FIELD)
+                    {
+                        min = to_uint<uint32_t>(fvValue(fv));
+                    }
+                    else if (fvField(fv) == MAX_BATCH_SIZE_FIELD)
+                    {
+                        max = to_uint<uint32_t>(fvValue(fv));
+                    }
+                    else
+                    {
+                        SWSS_LOG_WARN("Unknown batch size attribute %s of %s", fvField(fv).c_str(), key.c_str());
+                    }
+                }
+                catch (const exception &e)
+                {
+                    SWSS_LOG_ERROR("Failed to parse batch size attribute %s of %s: %s",
+                                   fvField(fv).c_str(), key.c_str(), e.what());
+                    valid = false;
+                }
+            }
+
+            if (valid && max && min > max)
+            {
+                SWSS_LOG_ERROR("Invalid batch size of %s, min_batch_size %zu above max_batch_size %zu",
+                               key.c_str(), min, max);
+                valid = false;
+            }
+
+            if (valid)
+            {
+                m_requests.push_back({ key, batch, min, max });
+            }
+        }
+        else if (op == DEL_COMMAND)
+        {
+            m_requests.push_back({ key, 0, 0, 0 });
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
+        }
+
+        consumer.m_toSync.erase(it++);
+    }
+}
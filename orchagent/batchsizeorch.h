@@ -0,0 +1,47 @@
+#ifndef SWSS_BATCHSIZEORCH_H
+#define SWSS_BATCHSIZEORCH_H
+
+#include "orch.h"
+
+#define CFG_ORCH_BATCH_SIZE_TABLE_NAME "ORCH_BATCH_SIZE"
+
+/*
+ * Applies the batch sizes of CONFIG_DB ORCH_BATCH_SIZE to the Consumers of
+ * the Orchs, e.g. for the route table:
+ *
+ *   ORCH_BATCH_SIZE|ROUTE_TABLE
+ *       "batch_size": "1024"
+ *       "min_batch_size": "128"
+ *       "max_batch_size": "16384"
+ *
+ * The key is the name of the table the Consumers pop. The batch adapts
+ * between min_batch_size and max_batch_size when both are set, see
+ * Consumer::setBatchSize(). Removing the entry goes back to a single pop.
+ *
+ * The Consumers of the Orchs on workers adapt their batch sizes while they
+ * run, so the changes are only queued here. OrchDaemon applies them to each
+ * Orch under its guard, see OrchDaemon::applyBatchSizes().
+ */
+struct BatchSizeRequest
+{
+    std::string table;
+    size_t batch;
+    size_t min;
+    size_t max;
+};
+
+class BatchSizeOrch : public Orch
+{
+public:
+    BatchSizeOrch(swss::DBConnector *db);
+
+    /* Returns the changes queued since the last call */
+    std::vector<BatchSizeRequest> takeRequests();
+
+private:
+    std::vector<BatchSizeRequest> m_requests;
+
+    void doTask(Consumer &consumer);
+};
+
+#endif /* SWSS_BATCHSIZEORCH_H */
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <assert.h>
+#include <atomic>
+#include <chrono>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -10,6 +12,47 @@
 #include "sai.h"
 #include "logger.h"
 
+/*
+ * Time spent by this thread in the flush() of the bulkers. Consumer reads it
+ * around doTask(Consumer&) to tell the SAI bulk time of each table, enabled
+ * with the task statistics, see Orch::enableTaskStats().
+ */
+class BulkerFlushTimer
+{
+public:
+    BulkerFlushTimer()
+    {
+        if (enabled().load(std::memory_order_relaxed))
+        {
+            m_begin = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~BulkerFlushTimer()
+    {
+        if (m_begin != std::chrono::steady_clock::time_point())
+        {
+            auto elapsed = std::chrono::steady_clock::now() - m_begin;
+            nsecs() += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+    }
+
+    static std::atomic<bool> &enabled()
+    {
+        static std::atomic<bool> flag(false);
+        return flag;
+    }
+
+    static uint64_t &nsecs()
+    {
+        static thread_local uint64_t total = 0;
+        return total;
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_begin;
+};
+
 static inline bool operator==(const sai_ip_prefix_t& a, const sai_ip_prefix_t& b)
 {
     if (a.addr_family != b.addr_family) return false;
@@ -40,6 +83,55 @@ static inline bool operator==(const sai_route_entry_t& a, const sai_route_entry_
         ;
 }
 
+static inline bool operator==(const sai_ip_address_t& a, const sai_ip_address_t& b)
+{
+    if (a.addr_family != b.addr_family) return false;
+
+    if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        return a.addr.ip4 == b.addr.ip4;
+    }
+    else if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV6)
+    {
+        return memcmp(a.addr.ip6, b.addr.ip6, sizeof(a.addr.ip6)) == 0;
+    }
+    else
+    {
+        throw std::invalid_argument("a has invalid addr_family");
+    }
+}
+
+static inline bool operator==(const sai_neighbor_entry_t& a, const sai_neighbor_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && a.rif_id == b.rif_id
+        && a.ip_address == b.ip_address
+        ;
+}
+
+static inline bool operator==(const sai_fdb_entry_t& a, const sai_fdb_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && a.bv_id == b.bv_id
+        && memcmp(a.mac_address, b.mac_address, sizeof(a.mac_address)) == 0
+        ;
+}
+
+static inline std::size_t hash_value(const sai_ip_address_t& a)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, a.addr_family);
+    if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        boost::hash_combine(seed, a.addr.ip4);
+    }
+    else if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV6)
+    {
+        boost::hash_combine(seed, a.addr.ip6);
+    }
+    return seed;
+}
+
 static inline std::size_t hash_value(const sai_ip_prefix_t& a)
 {
     size_t seed = 0;
@@ -72,6 +164,19 @@ namespace std
         }
     };
 
+    template <>
+    struct hash<sai_neighbor_entry_t>
+    {
+        size_t operator()(const sai_neighbor_entry_t& a) const noexcept
+        {
+            size_t seed = 0;
+            boost::hash_combine(seed, a.switch_id);
+            boost::hash_combine(seed, a.rif_id);
+            boost::hash_combine(seed, a.ip_address);
+            return seed;
+        }
+    };
+
     template <>
     struct hash<sai_fdb_entry_t>
     {
@@ -107,6 +212,27 @@ typedef sai_status_t (*sai_bulk_set_fdb_entry_attribute_fn)(
         _In_ sai_bulk_op_error_mode_t mode,
         _Out_ sai_status_t *object_statuses);
 
+// SAI typedef which is not available in SAI 1.7
+// TODO: remove after available
+typedef sai_status_t (*sai_bulk_create_neighbor_entry_fn)(
+        _In_ uint32_t object_count,
+        _In_ const sai_neighbor_entry_t *neighbor_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses);
+typedef sai_status_t (*sai_bulk_remove_neighbor_entry_fn)(
+        _In_ uint32_t object_count,
+        _In_ const sai_neighbor_entry_t *neighbor_entry,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses);
+typedef sai_status_t (*sai_bulk_set_neighbor_entry_attribute_fn)(
+        _In_ uint32_t object_count,
+        _In_ const sai_neighbor_entry_t *neighbor_entry,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses);
+
 template<typename T>
 struct SaiBulkerTraits { };
 
@@ -136,6 +262,19 @@ struct SaiBulkerTraits<sai_fdb_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_fdb_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_neighbor_api_t>
+{
+    using entry_t = sai_neighbor_entry_t;
+    using api_t = sai_neighbor_api_t;
+    using create_entry_fn = sai_create_neighbor_entry_fn;
+    using remove_entry_fn = sai_remove_neighbor_entry_fn;
+    using set_entry_attribute_fn = sai_set_neighbor_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_create_neighbor_entry_fn;
+    using bulk_remove_entry_fn = sai_bulk_remove_neighbor_entry_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_set_neighbor_entry_attribute_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_next_hop_group_api_t>
 {
@@ -150,6 +289,18 @@ struct SaiBulkerTraits<sai_next_hop_group_api_t>
     //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_next_hop_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_next_hop_api_t;
+    using create_entry_fn = sai_create_next_hop_fn;
+    using remove_entry_fn = sai_remove_next_hop_fn;
+    using set_entry_attribute_fn = sai_set_next_hop_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+};
+
 template <typename T>
 class EntityBulker
 {
@@ -266,6 +417,8 @@ public:
 
     void flush()
     {
+        BulkerFlushTimer timer;
+
         // Removing
         if (!removing_entries.empty())
         {
@@ -282,7 +435,17 @@ public:
             }
             size_t count = rs.size();
             std::vector<sai_status_t> statuses(count);
-            (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            if (remove_entries)
+            {
+                (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            }
+            else
+            {
+                for (size_t ir = 0; ir < count; ir++)
+                {
+                    statuses[ir] = (*remove_single_entry)(&rs[ir]);
+                }
+            }
             SWSS_LOG_INFO("EntityBulker.flush removing_entries %zu\n", removing_entries.size());
 
             for (size_t ir = 0; ir < count; ir++)
@@ -318,8 +481,18 @@ public:
             }
             size_t count = rs.size();
             std::vector<sai_status_t> statuses(count);
-            (*create_entries)((uint32_t)count, rs.data(), cs.data(), tss.data()
-                , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            if (create_entries)
+            {
+                (*create_entries)((uint32_t)count, rs.data(), cs.data(), tss.data()
+                    , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            }
+            else
+            {
+                for (size_t ir = 0; ir < count; ir++)
+                {
+                    statuses[ir] = (*create_single_entry)(&rs[ir], cs[ir], tss[ir]);
+                }
+            }
             SWSS_LOG_INFO("EntityBulker.flush creating_entries %zu\n", creating_entries.size());
 
             for (size_t ir = 0; ir < count; ir++)
@@ -359,8 +532,18 @@ public:
             }
             size_t count = rs.size();
             std::vector<sai_status_t> statuses(count);
-            (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data()
-                , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            if (set_entries_attribute)
+            {
+                (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data()
+                    , SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+            }
+            else
+            {
+                for (size_t ir = 0; ir < count; ir++)
+                {
+                    statuses[ir] = (*set_single_entry_attribute)(&rs[ir], &ts[ir]);
+                }
+            }
             SWSS_LOG_INFO("EntityBulker.flush setting_entries %zu, count %zu\n", setting_entries.size(), count);
 
             for (size_t ir = 0; ir < count; ir++)
@@ -427,9 +610,14 @@ private:
             sai_status_t *                                  // OUT object_status
     >                                                       removing_entries;
 
-    typename Ts::bulk_create_entry_fn                       create_entries;
-    typename Ts::bulk_remove_entry_fn                       remove_entries;
-    typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
+    typename Ts::bulk_create_entry_fn                       create_entries = nullptr;
+    typename Ts::bulk_remove_entry_fn                       remove_entries = nullptr;
+    typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute = nullptr;
+
+    // Used one entry at a time by flush() when the SAI has no bulk API for T
+    typename Ts::create_entry_fn                            create_single_entry = nullptr;
+    typename Ts::remove_entry_fn                            remove_single_entry = nullptr;
+    typename Ts::set_entry_attribute_fn                     set_single_entry_attribute = nullptr;
 };
 
 template <>
@@ -443,13 +631,19 @@ inline EntityBulker<sai_route_api_t>::EntityBulker(sai_route_api_t *api)
 template <>
 inline EntityBulker<sai_fdb_api_t>::EntityBulker(sai_fdb_api_t *api)
 {
-    // TODO: implement after create_fdb_entries() is available in SAI
-    throw std::logic_error("Not implemented");
-    /*
-    create_entries = api->create_fdb_entries;
-    remove_entries = api->remove_fdb_entries;
-    set_entries_attribute = api->set_fdb_entries_attribute;
-    */
+    // TODO: use create_fdb_entries() and friends after available in SAI
+    create_single_entry = api->create_fdb_entry;
+    remove_single_entry = api->remove_fdb_entry;
+    set_single_entry_attribute = api->set_fdb_entry_attribute;
+}
+
+template <>
+inline EntityBulker<sai_neighbor_api_t>::EntityBulker(sai_neighbor_api_t *api)
+{
+    // TODO: use create_neighbor_entries() and friends after available in SAI
+    create_single_entry = api->create_neighbor_entry;
+    remove_single_entry = api->remove_neighbor_entry;
+    set_single_entry_attribute = api->set_neighbor_entry_attribute;
 }
 
 template <typename T>
@@ -528,6 +722,8 @@ public:
 
     void flush()
     {
+        BulkerFlushTimer timer;
+
         // Removing
         if (!removing_entries.empty())
         {
@@ -543,7 +739,23 @@ public:
             }
             size_t count = rs.size();
             std::vector<sai_status_t> statuses(count);
-            sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+            sai_status_t status = SAI_STATUS_SUCCESS;
+            if (remove_entries)
+            {
+                status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+            }
+            else
+            {
+                // Each entry on its own, so one failure does not hold back the others
+                for (size_t i = 0; i < count; i++)
+                {
+                    statuses[i] = (*remove_single_entry)(rs[i]);
+                    if (statuses[i] != SAI_STATUS_SUCCESS)
+                    {
+                        status = statuses[i];
+                    }
+                }
+            }
             SWSS_LOG_INFO("ObjectBulker.flush removing_entries %zu rc=%d statuses[0]=%d\n", removing_entries.size(), status, statuses[0]);
 
             for (size_t i = 0; i < count; i++)
@@ -574,8 +786,19 @@ public:
             size_t count = creating_entries.size();
             std::vector<sai_object_id_t> object_ids(count);
             std::vector<sai_status_t> statuses(count);
-            (*create_entries)(switch_id, (uint32_t)count, cs.data(), tss.data()
-                , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_ids.data(), statuses.data());
+            if (create_entries)
+            {
+                (*create_entries)(switch_id, (uint32_t)count, cs.data(), tss.data()
+                    , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_ids.data(), statuses.data());
+            }
+            else
+            {
+                // Each entry on its own, so one failure does not hold back the others
+                for (size_t i = 0; i < count; i++)
+                {
+                    statuses[i] = (*create_single_entry)(&object_ids[i], switch_id, cs[i], tss[i]);
+                }
+            }
             SWSS_LOG_INFO("ObjectBulker.flush creating_entries %zu\n", creating_entries.size());
 
             for (size_t i = 0; i < count; i++)
@@ -671,10 +894,14 @@ private:
                                                             // object_id -> object_status
     std::unordered_map<sai_object_id_t, sai_status_t *>     removing_entries;
 
-    typename Ts::bulk_create_entry_fn                       create_entries;
-    typename Ts::bulk_remove_entry_fn                       remove_entries;
+    typename Ts::bulk_create_entry_fn                       create_entries = nullptr;
+    typename Ts::bulk_remove_entry_fn                       remove_entries = nullptr;
     // TODO: wait until available in SAI
     //typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
+
+    // Used one object at a time by flush() when the SAI has no bulk API for T
+    typename Ts::create_entry_fn                            create_single_entry = nullptr;
+    typename Ts::remove_entry_fn                            remove_single_entry = nullptr;
 };
 
 template <>
@@ -686,3 +913,12 @@ inline ObjectBulker<sai_next_hop_group_api_t>::ObjectBulker(SaiBulkerTraits<sai_
     // TODO: wait until available in SAI
     //set_entries_attribute = ;
 }
+
+template <>
+inline ObjectBulker<sai_next_hop_api_t>::ObjectBulker(SaiBulkerTraits<sai_next_hop_api_t>::api_t *api, sai_object_id_t switch_id)
+    : switch_id(switch_id)
+{
+    // TODO: use create_next_hops() and remove_next_hops() after available in SAI
+    create_single_entry = api->create_next_hop;
+    remove_single_entry = api->remove_next_hop;
+}
@@ -233,6 +233,7 @@ void CrmOrch::doTask(Consumer &consumer)
 
         if (op == SET_COMMAND)
         {
+            lock_guard<mutex> lock(m_mutex);
             handleSetCommand(key, kfvFieldsValues(t));
         }
         else if (op == DEL_COMMAND)
@@ -272,6 +273,7 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
                 auto thresholdType = crmThreshTypeMap.at(value);
 
                 m_resourcesMap.at(resourceType).thresholdType = thresholdType;
+                markCountersChanged(m_resourcesMap.at(resourceType));
             }
             else if (crmThreshLowResMap.find(field) != crmThreshLowResMap.end())
             {
@@ -279,6 +281,7 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
                 auto thresholdValue = to_uint<uint32_t>(value);
 
                 m_resourcesMap.at(resourceType).lowThreshold = thresholdValue;
+                markCountersChanged(m_resourcesMap.at(resourceType));
             }
             else if (crmThreshHighResMap.find(field) != crmThreshHighResMap.end())
             {
@@ -286,6 +289,7 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
                 auto thresholdValue = to_uint<uint32_t>(value);
 
                 m_resourcesMap.at(resourceType).highThreshold = thresholdValue;
+                markCountersChanged(m_resourcesMap.at(resourceType));
             }
             else
             {
@@ -310,9 +314,13 @@ void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_mutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter++;
+        auto &cnt = m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY];
+        cnt.usedCounter++;
+        cnt.changed = true;
     }
     catch (...)
     {
@@ -325,9 +333,13 @@ void CrmOrch::decCrmResUsedCounter(CrmResourceType resource)
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_mutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter--;
+        auto &cnt = m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY];
+        cnt.usedCounter--;
+        cnt.changed = true;
     }
     catch (...)
     {
@@ -340,9 +352,13 @@ void CrmOrch::incCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_mutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter++;
+        auto &cnt = m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)];
+        cnt.usedCounter++;
+        cnt.changed = true;
     }
     catch (...)
     {
@@ -355,9 +371,13 @@ void CrmOrch::decCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_mutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter--;
+        auto &cnt = m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)];
+        cnt.usedCounter--;
+        cnt.changed = true;
 
         // remove acl_entry and acl_counter in this acl table
         if (resource == CrmResourceType::CRM_ACL_TABLE)
@@ -394,10 +414,14 @@ void CrmOrch::incCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_mutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter++;
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].id = tableId;
+        auto &cnt = m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)];
+        cnt.usedCounter++;
+        cnt.id = tableId;
+        cnt.changed = true;
     }
     catch (...)
     {
@@ -410,9 +434,13 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 {
     SWSS_LOG_ENTER();
 
+    lock_guard<mutex> lock(m_mutex);
+
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter--;
+        auto &cnt = m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)];
+        cnt.usedCounter--;
+        cnt.changed = true;
     }
     catch (...)
     {
@@ -426,15 +454,43 @@ void CrmOrch::doTask(SelectableTimer &timer)
     SWSS_LOG_ENTER();
 
     getResAvailableCounters();
-    updateCrmCountersTable();
-    checkCrmThresholds();
+
+    // COUNTERS_DB is written without the lock, not to block the other threads
+    map<string, vector<FieldValueTuple>> updates;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        getCrmCountersUpdates(updates);
+        checkCrmThresholds();
+    }
+
+    for (const auto &update : updates)
+    {
+        m_countersCrmTable->set(update.first, update.second);
+    }
 }
 
 void CrmOrch::getResAvailableCounters()
 {
     SWSS_LOG_ENTER();
 
-    for (auto &res : m_resourcesMap)
+    // The resources are listed under the lock, queried from SAI without it
+    // and their available counters merged under the lock again
+    CrmAvailableQuery query;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        getAvailableQuery(query);
+    }
+
+    querySwitchAvailableCounters(query);
+    queryAclTableAvailableCounters(query);
+
+    lock_guard<mutex> lock(m_mutex);
+    setAvailableCounters(query);
+}
+
+void CrmOrch::getAvailableQuery(CrmAvailableQuery &query)
+{
+    for (const auto &res : m_resourcesMap)
     {
         // ignore unsupported resources
         if (res.second.resStatus != CrmResourceStatus::CRM_RES_SUPPORTED)
@@ -442,7 +498,65 @@ void CrmOrch::getResAvailableCounters()
             continue;
         }
 
-        switch (res.first)
+        // ACL entries and counters are queried per ACL table
+        if (res.first == CrmResourceType::CRM_ACL_ENTRY || res.first == CrmResourceType::CRM_ACL_COUNTER)
+        {
+            continue;
+        }
+
+        CrmResourceQuery resQuery;
+        resQuery.type = res.first;
+        query.resources.push_back(resQuery);
+    }
+
+    const auto &entryRes = m_resourcesMap.at(CrmResourceType::CRM_ACL_ENTRY);
+    const auto &counterRes = m_resourcesMap.at(CrmResourceType::CRM_ACL_COUNTER);
+
+    for (const auto &entry : entryRes.countersMap)
+    {
+        if (entry.second.id == SAI_NULL_OBJECT_ID)
+        {
+            continue;
+        }
+
+        CrmAclTableQuery tableQuery;
+        tableQuery.key = entry.first;
+        tableQuery.id = entry.second.id;
+        tableQuery.entry = true;
+        tableQuery.counter = counterRes.countersMap.find(entry.first) != counterRes.countersMap.end();
+        query.aclTables.push_back(tableQuery);
+    }
+
+    // ACL tables with counters only
+    for (const auto &counter : counterRes.countersMap)
+    {
+        if (counter.second.id == SAI_NULL_OBJECT_ID || entryRes.countersMap.find(counter.first) != entryRes.countersMap.end())
+        {
+            continue;
+        }
+
+        CrmAclTableQuery tableQuery;
+        tableQuery.key = counter.first;
+        tableQuery.id = counter.second.id;
+        tableQuery.entry = false;
+        tableQuery.counter = true;
+        query.aclTables.push_back(tableQuery);
+    }
+}
+
+void CrmOrch::querySwitchAvailableCounters(CrmAvailableQuery &query)
+{
+    SWSS_LOG_ENTER();
+
+    // Available counters of the switch are queried with a single get
+    vector<sai_attribute_t> attrs;
+
+    for (auto &res : query.resources)
+    {
+        sai_attribute_t &attr = res.attr;
+        attr.id = crmResSaiAvailAttrMap.at(res.type);
+
+        switch (res.type)
         {
             case CrmResourceType::CRM_IPV4_ROUTE:
             case CrmResourceType::CRM_IPV6_ROUTE:
@@ -456,107 +570,240 @@ void CrmOrch::getResAvailableCounters()
             case CrmResourceType::CRM_IPMC_ENTRY:
             case CrmResourceType::CRM_SNAT_ENTRY:
             case CrmResourceType::CRM_DNAT_ENTRY:
-            {
-                sai_attribute_t attr;
-                attr.id = crmResSaiAvailAttrMap.at(res.first);
+                break;
 
-                sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
-                if (status != SAI_STATUS_SUCCESS)
+            case CrmResourceType::CRM_ACL_TABLE:
+            case CrmResourceType::CRM_ACL_GROUP:
+            {
+                auto &resources = m_aclResources[res.type];
+                if (resources.size() < CRM_ACL_RESOURCE_COUNT)
                 {
-                    if((status == SAI_STATUS_NOT_SUPPORTED) ||
-                       (status == SAI_STATUS_NOT_IMPLEMENTED) ||
-                       SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
-                       SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status))
-                    {
-                        // mark unsupported resources
-                        res.second.resStatus = CrmResourceStatus::CRM_RES_NOT_SUPPORTED;
-                        SWSS_LOG_NOTICE("Switch attribute %u not supported", attr.id);
-                        break;
-                    }
-                    SWSS_LOG_ERROR("Failed to get switch attribute %u , rv:%d", attr.id, status);
-                    break;
+                    resources.resize(CRM_ACL_RESOURCE_COUNT);
                 }
-
-                res.second.countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = attr.value.u32;
-
+                attr.value.aclresource.count = static_cast<uint32_t>(resources.size());
+                attr.value.aclresource.list = resources.data();
                 break;
             }
 
-            case CrmResourceType::CRM_ACL_TABLE:
-            case CrmResourceType::CRM_ACL_GROUP:
+            default:
+                SWSS_LOG_ERROR("Failed to get CRM resource type %u. Unknown resource type.\n", (uint32_t)res.type);
+                query.resources.clear();
+                query.aclTables.clear();
+                return;
+        }
+
+        attrs.push_back(attr);
+    }
+
+    if (attrs.empty())
+    {
+        return;
+    }
+
+    sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, static_cast<uint32_t>(attrs.size()), attrs.data());
+    if (status == SAI_STATUS_BUFFER_OVERFLOW)
+    {
+        for (size_t i = 0; i < attrs.size(); i++)
+        {
+            auto it = m_aclResources.find(query.resources[i].type);
+            if (it != m_aclResources.end())
             {
-                sai_attribute_t attr;
-                attr.id = crmResSaiAvailAttrMap.at(res.first);
+                it->second.resize(max<size_t>(it->second.size(), attrs[i].value.aclresource.count));
+                attrs[i].value.aclresource.count = static_cast<uint32_t>(it->second.size());
+                attrs[i].value.aclresource.list = it->second.data();
+            }
+        }
+        status = sai_switch_api->get_switch_attribute(gSwitchId, static_cast<uint32_t>(attrs.size()), attrs.data());
+    }
 
-                vector<sai_acl_resource_t> resources(CRM_ACL_RESOURCE_COUNT);
+    if (status == SAI_STATUS_SUCCESS)
+    {
+        for (size_t i = 0; i < attrs.size(); i++)
+        {
+            query.resources[i].attr = attrs[i];
+            query.resources[i].available = true;
+        }
+    }
+    else
+    {
+        // Query the resources one by one to find the unsupported ones
+        SWSS_LOG_INFO("Failed to get %zu switch attributes, rv:%d, querying them one by one", attrs.size(), status);
+        for (auto &res : query.resources)
+        {
+            querySwitchAvailableCounter(res);
+        }
+    }
+}
 
-                attr.value.aclresource.count = CRM_ACL_RESOURCE_COUNT;
-                attr.value.aclresource.list = resources.data();
-                sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
-                if (status == SAI_STATUS_BUFFER_OVERFLOW)
-                {
-                    resources.resize(attr.value.aclresource.count);
-                    attr.value.aclresource.list = resources.data();
-                    status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
-                }
+void CrmOrch::querySwitchAvailableCounter(CrmResourceQuery &res)
+{
+    SWSS_LOG_ENTER();
 
-                if (status != SAI_STATUS_SUCCESS)
-                {
-                    SWSS_LOG_ERROR("Failed to get switch attribute %u , rv:%d", attr.id, status);
-                    break;
-                }
+    sai_attribute_t &attr = res.attr;
+    attr.id = crmResSaiAvailAttrMap.at(res.type);
 
-                for (uint32_t i = 0; i < attr.value.aclresource.count; i++)
-                {
-                    string key = getCrmAclKey(attr.value.aclresource.list[i].stage, attr.value.aclresource.list[i].bind_point);
-                    res.second.countersMap[key].availableCounter = attr.value.aclresource.list[i].avail_num;
-                }
+    bool aclResource = (res.type == CrmResourceType::CRM_ACL_TABLE) || (res.type == CrmResourceType::CRM_ACL_GROUP);
 
-                break;
-            }
+    if (aclResource)
+    {
+        auto &resources = m_aclResources[res.type];
+        attr.value.aclresource.count = static_cast<uint32_t>(resources.size());
+        attr.value.aclresource.list = resources.data();
+    }
 
-            case CrmResourceType::CRM_ACL_ENTRY:
-            case CrmResourceType::CRM_ACL_COUNTER:
-            {
-                sai_attribute_t attr;
-                attr.id = crmResSaiAvailAttrMap.at(res.first);
+    sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+    if (aclResource && status == SAI_STATUS_BUFFER_OVERFLOW)
+    {
+        auto &resources = m_aclResources[res.type];
+        resources.resize(attr.value.aclresource.count);
+        attr.value.aclresource.list = resources.data();
+        status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+    }
 
-                for (auto &cnt : res.second.countersMap)
-                {
-                    sai_status_t status = sai_acl_api->get_acl_table_attribute(cnt.second.id, 1, &attr);
-                    if (status != SAI_STATUS_SUCCESS)
-                    {
-                        SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attr.id, status);
-                        break;
-                    }
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        if (!aclResource &&
+            ((status == SAI_STATUS_NOT_SUPPORTED) ||
+             (status == SAI_STATUS_NOT_IMPLEMENTED) ||
+             SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
+             SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status)))
+        {
+            // marked unsupported on merge
+            res.supported = false;
+            SWSS_LOG_NOTICE("Switch attribute %u not supported", attr.id);
+            return;
+        }
+        SWSS_LOG_ERROR("Failed to get switch attribute %u , rv:%d", attr.id, status);
+        return;
+    }
 
-                    cnt.second.availableCounter = attr.value.u32;
-                }
+    res.available = true;
+}
 
-                break;
-            }
+void CrmOrch::queryAclTableAvailableCounters(CrmAvailableQuery &query)
+{
+    SWSS_LOG_ENTER();
 
-            default:
-                SWSS_LOG_ERROR("Failed to get CRM resource type %u. Unknown resource type.\n", (uint32_t)res.first);
-                return;
+    // Both available counters of an ACL table are queried with a single get
+    for (auto &table : query.aclTables)
+    {
+        sai_attribute_t attrs[2];
+        uint32_t count = 0;
+
+        if (table.entry)
+        {
+            attrs[count++].id = SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY;
+        }
+        if (table.counter)
+        {
+            attrs[count++].id = SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER;
         }
+
+        sai_status_t status = sai_acl_api->get_acl_table_attribute(table.id, count, attrs);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to get ACL table 0x%" PRIx64 " available counters, rv:%d", table.id, status);
+            continue;
+        }
+
+        table.available = true;
+        table.availableEntries = table.entry ? attrs[0].value.u32 : 0;
+        table.availableCounters = table.counter ? attrs[count - 1].value.u32 : 0;
     }
 }
 
-void CrmOrch::updateCrmCountersTable()
+void CrmOrch::setAvailableCounters(const CrmAvailableQuery &query)
+{
+    for (const auto &resQuery : query.resources)
+    {
+        auto &res = m_resourcesMap.at(resQuery.type);
+
+        if (!resQuery.supported)
+        {
+            res.resStatus = CrmResourceStatus::CRM_RES_NOT_SUPPORTED;
+        }
+        else if (resQuery.available)
+        {
+            setResAvailableCounter(resQuery.type, res, resQuery.attr);
+        }
+    }
+
+    auto &entryRes = m_resourcesMap.at(CrmResourceType::CRM_ACL_ENTRY);
+    auto &counterRes = m_resourcesMap.at(CrmResourceType::CRM_ACL_COUNTER);
+
+    // ACL tables removed or replaced while they were queried are skipped
+    for (const auto &table : query.aclTables)
+    {
+        if (!table.available)
+        {
+            continue;
+        }
+
+        auto entry = entryRes.countersMap.find(table.key);
+        if (table.entry && entry != entryRes.countersMap.end() && entry->second.id == table.id)
+        {
+            setAvailableCounter(entry->second, table.availableEntries);
+        }
+
+        auto counter = counterRes.countersMap.find(table.key);
+        if (table.counter && counter != counterRes.countersMap.end() && counter->second.id == table.id)
+        {
+            setAvailableCounter(counter->second, table.availableCounters);
+        }
+    }
+}
+
+void CrmOrch::setResAvailableCounter(CrmResourceType type, CrmResourceEntry &res, const sai_attribute_t &attr)
+{
+    if ((type == CrmResourceType::CRM_ACL_TABLE) || (type == CrmResourceType::CRM_ACL_GROUP))
+    {
+        for (uint32_t i = 0; i < attr.value.aclresource.count; i++)
+        {
+            string key = getCrmAclKey(attr.value.aclresource.list[i].stage, attr.value.aclresource.list[i].bind_point);
+            setAvailableCounter(res.countersMap[key], attr.value.aclresource.list[i].avail_num);
+        }
+    }
+    else
+    {
+        setAvailableCounter(res.countersMap[CRM_COUNTERS_TABLE_KEY], attr.value.u32);
+    }
+}
+
+void CrmOrch::setAvailableCounter(CrmResourceCounter &cnt, uint32_t available)
+{
+    if (cnt.availableCounter != available)
+    {
+        cnt.availableCounter = available;
+        cnt.changed = true;
+    }
+}
+
+void CrmOrch::markCountersChanged(CrmResourceEntry &res)
+{
+    for (auto &cnt : res.countersMap)
+    {
+        cnt.second.changed = true;
+    }
+}
+
+void CrmOrch::getCrmCountersUpdates(map<string, vector<FieldValueTuple>> &updates)
 {
     SWSS_LOG_ENTER();
 
-    // Update CRM used counters in COUNTERS_DB
+    // Changed counters of COUNTERS_DB, one write per key
+
+    // CRM used counters
     for (const auto &i : crmUsedCntsTableMap)
     {
         try
         {
-            for (const auto &cnt : m_resourcesMap.at(i.second).countersMap)
+            for (auto &cnt : m_resourcesMap.at(i.second).countersMap)
             {
-                FieldValueTuple attr(i.first, to_string(cnt.second.usedCounter));
-                vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                if (cnt.second.publishedUsed != cnt.second.usedCounter)
+                {
+                    updates[cnt.first].emplace_back(i.first, to_string(cnt.second.usedCounter));
+                    cnt.second.publishedUsed = cnt.second.usedCounter;
+                }
             }
         }
         catch(const out_of_range &e)
@@ -565,16 +812,18 @@ void CrmOrch::updateCrmCountersTable()
         }
     }
 
-    // Update CRM available counters in COUNTERS_DB
+    // CRM available counters
     for (const auto &i : crmAvailCntsTableMap)
     {
         try
         {
-            for (const auto &cnt : m_resourcesMap.at(i.second).countersMap)
+            for (auto &cnt : m_resourcesMap.at(i.second).countersMap)
             {
-                FieldValueTuple attr(i.first, to_string(cnt.second.availableCounter));
-                vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                if (cnt.second.publishedAvailable != cnt.second.availableCounter)
+                {
+                    updates[cnt.first].emplace_back(i.first, to_string(cnt.second.availableCounter));
+                    cnt.second.publishedAvailable = cnt.second.availableCounter;
+                }
             }
         }
         catch(const out_of_range &e)
@@ -592,13 +841,21 @@ void CrmOrch::checkCrmThresholds()
     {
         auto &res = i.second;
 
-        for (const auto &j : i.second.countersMap)
+        for (auto &j : i.second.countersMap)
         {
             auto &cnt = j.second;
             uint64_t utilization = 0;
             uint32_t percentageUtil = 0;
             string threshType = "";
 
+            // Unchanged counters keep their state, unless the resource is
+            // over its threshold, which is reported again on each check
+            if (!cnt.changed && res.exceededLogCounter == 0)
+            {
+                continue;
+            }
+            cnt.changed = false;
+
             if (cnt.usedCounter != 0)
             {
                 uint32_t dvsr = cnt.usedCounter + cnt.availableCounter;
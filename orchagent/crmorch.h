@@ -3,6 +3,7 @@
 #include <thread>
 #include <chrono>
 #include <map>
+#include <mutex>
 #include "orch.h"
 #include "port.h"
 
@@ -68,6 +69,13 @@ private:
         sai_object_id_t id = 0;
         uint32_t availableCounter = 0;
         uint32_t usedCounter = 0;
+
+        // Values last written to COUNTERS_DB, -1 before the first write
+        int64_t publishedAvailable = -1;
+        int64_t publishedUsed = -1;
+
+        // Changed since the last threshold check
+        bool changed = true;
     };
 
     struct CrmResourceEntry
@@ -90,11 +98,52 @@ private:
 
     std::map<CrmResourceType, CrmResourceEntry> m_resourcesMap;
 
+    // Counters are updated by the Orchs of every thread, CrmOrch may run on a worker
+    std::mutex m_mutex;
+
+    // Buffers of the ACL resource list attributes, sized from the last query,
+    // only used by the thread which polls
+    std::map<CrmResourceType, std::vector<sai_acl_resource_t>> m_aclResources;
+
+    // Available counters of a poll, queried from SAI without the lock
+    struct CrmResourceQuery
+    {
+        CrmResourceType type;
+        sai_attribute_t attr = {};
+        bool available = false;
+        bool supported = true;
+    };
+
+    struct CrmAclTableQuery
+    {
+        std::string key;
+        sai_object_id_t id = SAI_NULL_OBJECT_ID;
+        bool entry = false;
+        bool counter = false;
+        bool available = false;
+        uint32_t availableEntries = 0;
+        uint32_t availableCounters = 0;
+    };
+
+    struct CrmAvailableQuery
+    {
+        std::vector<CrmResourceQuery> resources;
+        std::vector<CrmAclTableQuery> aclTables;
+    };
+
     void doTask(Consumer &consumer);
     void handleSetCommand(const std::string& key, const std::vector<swss::FieldValueTuple>& data);
     void doTask(swss::SelectableTimer &timer);
     void getResAvailableCounters();
-    void updateCrmCountersTable();
+    void getAvailableQuery(CrmAvailableQuery &query);
+    void querySwitchAvailableCounters(CrmAvailableQuery &query);
+    void querySwitchAvailableCounter(CrmResourceQuery &res);
+    void queryAclTableAvailableCounters(CrmAvailableQuery &query);
+    void setAvailableCounters(const CrmAvailableQuery &query);
+    void setResAvailableCounter(CrmResourceType type, CrmResourceEntry &res, const sai_attribute_t &attr);
+    void setAvailableCounter(CrmResourceCounter &cnt, uint32_t available);
+    void markCountersChanged(CrmResourceEntry &res);
+    void getCrmCountersUpdates(std::map<std::string, std::vector<swss::FieldValueTuple>> &updates);
     void checkCrmThresholds();
     std::string getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint);
     std::string getCrmAclTableKey(sai_object_id_t id);
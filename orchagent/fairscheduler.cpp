@@ -0,0 +1,115 @@
+#include <algorithm>
+#include "fairscheduler.h"
+
+using namespace std;
+
+size_t FairScheduler::add(const Params &params)
+{
+    Task task = {};
+    task.params = params;
+    task.params.weight = max(params.weight, 1u);
+    m_tasks.push_back(task);
+    return m_tasks.size() - 1;
+}
+
+void FairScheduler::setParams(size_t id, const Params &params)
+{
+    m_tasks[id].params = params;
+    m_tasks[id].params.weight = max(params.weight, 1u);
+}
+
+void FairScheduler::setReady(size_t id, Clock::time_point now)
+{
+    Task &task = m_tasks[id];
+
+    task.ready = true;
+    task.readySince = now;
+    task.charge = max(task.charge, m_vtime);
+    m_ready.push_back(id);
+}
+
+void FairScheduler::notify(size_t id, Clock::time_point now)
+{
+    m_tasks[id].events++;
+
+    if (!m_tasks[id].ready)
+    {
+        setReady(id, now);
+    }
+}
+
+bool FairScheduler::isBefore(const Task &a, const Task &b, Clock::time_point now) const
+{
+    bool aOverdue = a.params.deadline.count() && now - a.readySince >= a.params.deadline;
+    bool bOverdue = b.params.deadline.count() && now - b.readySince >= b.params.deadline;
+    if (aOverdue != bOverdue)
+    {
+        return aOverdue;
+    }
+    if (aOverdue)
+    {
+        return a.readySince + a.params.deadline < b.readySince + b.params.deadline;
+    }
+
+    bool aUrgent = a.params.pri >= m_urgentPri;
+    bool bUrgent = b.params.pri >= m_urgentPri;
+    if (aUrgent != bUrgent)
+    {
+        return aUrgent;
+    }
+
+    if (a.charge != b.charge)
+    {
+        return a.charge < b.charge;
+    }
+    if (a.params.pri != b.params.pri)
+    {
+        return a.params.pri > b.params.pri;
+    }
+    return a.readySince < b.readySince;
+}
+
+bool FairScheduler::next(size_t &id, Clock::time_point now)
+{
+    if (m_ready.empty())
+    {
+        return false;
+    }
+
+    size_t best = 0;
+    for (size_t i = 1; i < m_ready.size(); i++)
+    {
+        if (isBefore(m_tasks[m_ready[i]], m_tasks[m_ready[best]], now))
+        {
+            best = i;
+        }
+    }
+
+    id = m_ready[best];
+    m_ready[best] = m_ready.back();
+    m_ready.pop_back();
+
+    Task &task = m_tasks[id];
+    task.ready = false;
+    if (task.events)
+    {
+        task.events--;
+    }
+    m_vtime = max(m_vtime, task.charge);
+
+    return true;
+}
+
+void FairScheduler::done(size_t id, Clock::duration elapsed, bool pending, Clock::time_point now)
+{
+    Task &task = m_tasks[id];
+
+    auto ns = static_cast<uint64_t>(max<int64_t>(chrono::duration_cast<chrono::nanoseconds>(elapsed).count(), 1));
+    task.charge += max<uint64_t>(ns / task.params.weight, 1);
+    task.pending = pending;
+
+    if (!task.ready && (task.events || task.pending))
+    {
+        setReady(id, now);
+    }
+}
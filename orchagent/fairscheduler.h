@@ -0,0 +1,80 @@
+#ifndef SWSS_FAIRSCHEDULER_H
+#define SWSS_FAIRSCHEDULER_H
+
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+
+/*
+ * Picks the next task to run among the ready ones of a single threaded loop.
+ *
+ * Ready tasks share the loop in proportion to their weight: each task is
+ * charged the time it runs divided by its weight, and the task charged the
+ * least runs next, the one of higher priority first among equals. A task
+ * which becomes ready is charged at least as much as the last task run, so
+ * that being idle earns no credit. Bulk tasks thus keep making progress,
+ * while a task with little work to do runs soon after it becomes ready.
+ *
+ * Two rules take precedence, in this order:
+ * - A task ready for longer than its deadline runs next, the one whose
+ *   deadline expired first among them. This bounds the wait of every task
+ *   whatever the load.
+ * - A task of urgent priority runs before the others.
+ *
+ * A task is ready while it has events not yet consumed by a run, or while
+ * it reports pending work at the end of its last run.
+ */
+class FairScheduler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Params
+    {
+        int pri;
+        unsigned weight;
+        std::chrono::milliseconds deadline;     // 0 for none
+    };
+
+    FairScheduler(int urgentPri) : m_urgentPri(urgentPri) { }
+
+    /* Returns the id of the task, ids are allocated from 0 */
+    size_t add(const Params &params);
+    void setParams(size_t id, const Params &params);
+    const Params &getParams(size_t id) const { return m_tasks[id].params; }
+
+    /* An event of the task was received */
+    void notify(size_t id, Clock::time_point now);
+
+    /* Picks the next task and consumes one of its events, false without ready task */
+    bool next(size_t &id, Clock::time_point now);
+
+    /* The task picked by next() ran for elapsed, with work left or not */
+    void done(size_t id, Clock::duration elapsed, bool pending, Clock::time_point now);
+
+    bool hasReady() const { return !m_ready.empty(); }
+    size_t size() const { return m_tasks.size(); }
+
+private:
+    struct Task
+    {
+        Params params;
+        uint64_t events;
+        bool pending;
+        bool ready;
+        uint64_t charge;        // run time in ns divided by the weight
+        Clock::time_point readySince;
+    };
+
+    int m_urgentPri;
+    std::vector<Task> m_tasks;
+    std::vector<size_t> m_ready;
+
+    /* Charge of the last task run */
+    uint64_t m_vtime = 0;
+
+    void setReady(size_t id, Clock::time_point now);
+    bool isBefore(const Task &a, const Task &b, Clock::time_point now) const;
+};
+
+#endif /* SWSS_FAIRSCHEDULER_H */
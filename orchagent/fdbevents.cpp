@@ -0,0 +1,69 @@
+#include "fdbevents.h"
+
+using namespace std;
+
+void FdbEventCoalescer::add(const FdbEvent &event)
+{
+    m_received++;
+
+    if (event.type == SAI_FDB_EVENT_FLUSHED)
+    {
+        m_events.push_back(event);
+        m_positions.clear();
+        return;
+    }
+
+    FdbKey key{ swss::MacAddress(event.entry.mac_address), event.entry.bv_id };
+
+    size_t *pos = m_positions.find(key);
+    if (pos != nullptr)
+    {
+        m_events[*pos] = event;
+        m_coalesced++;
+        return;
+    }
+
+    m_positions.set(key, m_events.size());
+    m_events.push_back(event);
+}
+
+void FdbEventCoalescer::take(vector<FdbEvent> &events)
+{
+    events.swap(m_events);
+    m_events.clear();
+    m_positions.clear();
+}
+
+void FdbFlushRequests::add(sai_object_id_t bridge_port_id, sai_object_id_t vlan_oid)
+{
+    if (bridge_port_id == SAI_NULL_OBJECT_ID && vlan_oid == SAI_NULL_OBJECT_ID)
+    {
+        m_all = true;
+        return;
+    }
+
+    m_scopes.insert(Scope(bridge_port_id, vlan_oid));
+}
+
+void FdbFlushRequests::take(bool &all, vector<Scope> &scopes)
+{
+    all = m_all;
+    scopes.clear();
+
+    if (!m_all)
+    {
+        for (const auto &scope: m_scopes)
+        {
+            if (scope.first != SAI_NULL_OBJECT_ID && scope.second != SAI_NULL_OBJECT_ID &&
+                (m_scopes.count(Scope(scope.first, SAI_NULL_OBJECT_ID)) ||
+                 m_scopes.count(Scope(SAI_NULL_OBJECT_ID, scope.second))))
+            {
+                continue;
+            }
+            scopes.push_back(scope);
+        }
+    }
+
+    m_all = false;
+    m_scopes.clear();
+}
@@ -0,0 +1,74 @@
+#ifndef SWSS_FDBEVENTS_H
+#define SWSS_FDBEVENTS_H
+
+#include <set>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "sai.h"
+}
+
+#include "fdbtable.h"
+
+/* FDB event of a SAI fdb_event notification */
+struct FdbEvent
+{
+    sai_fdb_event_t type;
+    sai_fdb_entry_t entry;
+    sai_object_id_t bridge_port_id;
+};
+
+/*
+ * Coalesces the FDB events of the notifications drained at once.
+ *
+ * Only the last learn, age or move event of a MAC is kept, in place of the
+ * first event of that MAC, as it alone gives the state of the MAC at the end
+ * of the burst. Flush events are kept in order, and events are not
+ * coalesced across them.
+ */
+class FdbEventCoalescer
+{
+public:
+    void add(const FdbEvent &event);
+
+    /* Moves out the coalesced events, in the order of the first event of each MAC */
+    void take(std::vector<FdbEvent> &events);
+
+    uint64_t getReceived() const { return m_received; }
+    uint64_t getCoalesced() const { return m_coalesced; }
+
+private:
+    std::vector<FdbEvent> m_events;
+
+    /* Position in m_events of the MACs seen since the last flush event */
+    FdbTable<size_t> m_positions;
+
+    uint64_t m_received = 0;
+    uint64_t m_coalesced = 0;
+};
+
+/*
+ * Scopes of the FDB flush requests received at once, as pairs of bridge port
+ * and VLAN object ids where SAI_NULL_OBJECT_ID stands for any. A flush of
+ * all the FDB or of a port or VLAN takes in the narrower flushes it covers.
+ */
+class FdbFlushRequests
+{
+public:
+    typedef std::pair<sai_object_id_t, sai_object_id_t> Scope;
+
+    void addAll() { m_all = true; }
+    void add(sai_object_id_t bridge_port_id, sai_object_id_t vlan_oid);
+
+    bool empty() const { return !m_all && m_scopes.empty(); }
+
+    /* Moves out the flushes to do, an empty list with all set for the whole FDB */
+    void take(bool &all, std::vector<Scope> &scopes);
+
+private:
+    bool m_all = false;
+    std::set<Scope> m_scopes;
+};
+
+#endif /* SWSS_FDBEVENTS_H */
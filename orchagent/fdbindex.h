@@ -0,0 +1,164 @@
+#ifndef SWSS_FDBINDEX_H
+#define SWSS_FDBINDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <unordered_map>
+
+/*
+ * Secondary indexes of the FDB entries by bridge port and by VLAN.
+ *
+ * The entries themselves are kept by FdbOrch, which updates the indexes
+ * along with them. Flushes and the notifications of a port or of a VLAN
+ * then visit the MACs of that port or VLAN only, instead of the whole FDB.
+ * Entry has the VLAN object id in bv_id.
+ *
+ * Each port and VLAN has a flat list of its entries, which costs no
+ * allocation per entry. The owner of an entry keeps its Position in the
+ * lists, returned by insert(), and erase() removes it from there by moving
+ * the last entry of each list in its place. The Position of a moved entry
+ * is updated through the locate function given to erase(), which returns
+ * a reference to the Position kept with that entry.
+ */
+template <typename Entry>
+class FdbIndex
+{
+public:
+    typedef std::vector<Entry> Members;
+
+    struct Position
+    {
+        uint32_t port;
+        uint32_t vlan;
+    };
+
+    Position insert(const Entry &entry, uint64_t port)
+    {
+        Members &onPort = m_byPort[port];
+        Members &inVlan = m_byVlan[entry.bv_id];
+
+        Position pos = { static_cast<uint32_t>(onPort.size()), static_cast<uint32_t>(inVlan.size()) };
+        onPort.push_back(entry);
+        inVlan.push_back(entry);
+        return pos;
+    }
+
+    template <typename Locate>
+    void erase(const Entry &entry, uint64_t port, const Position &pos, Locate locate)
+    {
+        eraseMember(m_byPort, port, entry, pos.port,
+                    [&locate](const Entry &moved, uint32_t at) { locate(moved).port = at; });
+        eraseMember(m_byVlan, entry.bv_id, entry, pos.vlan,
+                    [&locate](const Entry &moved, uint32_t at) { locate(moved).vlan = at; });
+    }
+
+    const Members &byPort(uint64_t port) const
+    {
+        return get(m_byPort, port);
+    }
+
+    const Members &byVlan(uint64_t vlan) const
+    {
+        return get(m_byVlan, vlan);
+    }
+
+    /*
+     * Entries learnt on the port in the VLAN, looked up in the smaller list.
+     * portOf returns the bridge port of an entry of the VLAN.
+     */
+    template <typename PortOf>
+    std::vector<Entry> byPortAndVlan(uint64_t port, uint64_t vlan, PortOf portOf) const
+    {
+        const Members &onPort = byPort(port);
+        const Members &inVlan = byVlan(vlan);
+        std::vector<Entry> entries;
+
+        if (onPort.size() <= inVlan.size())
+        {
+            for (const auto &entry: onPort)
+            {
+                if (entry.bv_id == vlan)
+                {
+                    entries.push_back(entry);
+                }
+            }
+        }
+        else
+        {
+            for (const auto &entry: inVlan)
+            {
+                if (portOf(entry) == port)
+                {
+                    entries.push_back(entry);
+                }
+            }
+        }
+        return entries;
+    }
+
+    size_t ports() const { return m_byPort.size(); }
+    size_t vlans() const { return m_byVlan.size(); }
+
+    size_t memoryUsage() const
+    {
+        size_t bytes = 0;
+        for (const auto &it: m_byPort)
+        {
+            bytes += sizeof(it) + it.second.capacity() * sizeof(Entry);
+        }
+        for (const auto &it: m_byVlan)
+        {
+            bytes += sizeof(it) + it.second.capacity() * sizeof(Entry);
+        }
+        return bytes;
+    }
+
+private:
+    typedef std::unordered_map<uint64_t, Members> Index;
+
+    Index m_byPort;
+    Index m_byVlan;
+
+    static const Members &get(const Index &index, uint64_t id)
+    {
+        static const Members empty;
+        auto it = index.find(id);
+        return it == index.end() ? empty : it->second;
+    }
+
+    template <typename Moved>
+    static void eraseMember(Index &index, uint64_t id, const Entry &entry, uint32_t pos, Moved moved)
+    {
+        auto it = index.find(id);
+        if (it == index.end())
+        {
+            return;
+        }
+
+        Members &members = it->second;
+        if (pos >= members.size() || !(members[pos] == entry))
+        {
+            return;
+        }
+
+        if (pos + 1 != members.size())
+        {
+            members[pos] = members.back();
+            moved(members[pos], pos);
+        }
+        members.pop_back();
+
+        if (members.empty())
+        {
+            index.erase(it);
+        }
+        else if (members.size() * 4 < members.capacity())
+        {
+            /* Gives back the memory of the MACs gone after a flush */
+            members.shrink_to_fit();
+        }
+    }
+};
+
+#endif /* SWSS_FDBINDEX_H */
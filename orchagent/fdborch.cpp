@@ -26,13 +26,23 @@ const int FdbOrch::fdborch_pri = 20;
 FdbOrch::FdbOrch(DBConnector* applDbConnector, vector<table_name_with_pri_t> appFdbTables, TableConnector stateDbFdbConnector, PortsOrch *port) :
     Orch(applDbConnector, appFdbTables),
     m_portsOrch(port),
-    m_fdbStateTable(stateDbFdbConnector.first, stateDbFdbConnector.second)
+    m_fdbStatePipeline(stateDbFdbConnector.first),
+    m_fdbStateTable(&m_fdbStatePipeline, stateDbFdbConnector.second, true),
+    m_entriesRemotes(IpAddress(0x0)),
+    m_entriesEsis(FdbEsi()),
+    gFdbBulker(sai_fdb_api)
 {
     for(auto it: appFdbTables)
     {
         m_appTables.push_back(new Table(applDbConnector, it.first));
     }
 
+    auto fdbConsumer = getExecutor(APP_FDB_TABLE_NAME);
+    if (fdbConsumer != NULL)
+    {
+        fdbConsumer->setBulkSchedule();
+    }
+
     m_portsOrch->attach(this);
     m_flushNotificationsConsumer = new NotificationConsumer(applDbConnector, "FLUSHFDBREQUEST");
     auto flushNotifier = new Notifier(m_flushNotificationsConsumer, this, "FLUSHFDBREQUEST");
@@ -61,61 +71,156 @@ bool FdbOrch::bake()
     return true;
 }
 
+static FdbType getFdbType(const string& type)
+{
+    if (type == "static")
+    {
+        return FDB_TYPE_STATIC;
+    }
+    if (type == "dynamic_local")
+    {
+        return FDB_TYPE_DYNAMIC_LOCAL;
+    }
+    return FDB_TYPE_DYNAMIC;
+}
+
+static const char *getFdbTypeName(FdbType type)
+{
+    switch (type)
+    {
+    case FDB_TYPE_STATIC:
+        return "static";
+    case FDB_TYPE_DYNAMIC_LOCAL:
+        return "dynamic_local";
+    default:
+        return "dynamic";
+    }
+}
+
+// ref: https://github.com/Azure/sonic-swss/blob/master/doc/swss-schema.md#fdb_table
+static string getFdbStateKey(sai_vlan_id_t vlan_id, const MacAddress& mac)
+{
+    const uint8_t *m = mac.getMac();
+    char key[32];
+
+    snprintf(key, sizeof(key), "Vlan%u:%02x:%02x:%02x:%02x:%02x:%02x",
+             vlan_id, m[0], m[1], m[2], m[3], m[4], m[5]);
+    return key;
+}
+
+/* Adds or updates the entry in m_entries, along with its secondary indexes */
+void FdbOrch::setFdbEntry(const FdbEntry& entry, const FdbData& fdbData)
+{
+    FdbKey key{ entry.mac, entry.bv_id };
+    FdbRecord record;
+
+    record.bridge_port_id = fdbData.bridge_port_id;
+    record.vni = fdbData.vni;
+    record.remote_ip = m_entriesRemotes.add(fdbData.remote_ip);
+    record.esi = m_entriesEsis.add(fdbData.esi);
+    record.type = fdbData.type;
+    record.origin = static_cast<uint8_t>(fdbData.origin);
+
+    const FdbRecord *old = m_entries.find(key);
+    if (old != nullptr)
+    {
+        m_entriesIndex.erase(key, old->bridge_port_id, old->index, locateFdbIndex());
+        m_entriesRemotes.release(old->remote_ip);
+        m_entriesEsis.release(old->esi);
+    }
+
+    record.index = m_entriesIndex.insert(key, record.bridge_port_id);
+    m_entries.set(key, record);
+}
+
+/* Position kept in m_entries of an entry moved in m_entriesIndex */
+function<FdbIndex<FdbKey>::Position &(const FdbKey &)> FdbOrch::locateFdbIndex()
+{
+    return [this](const FdbKey &key) -> FdbIndex<FdbKey>::Position & { return m_entries.find(key)->index; };
+}
+
+function<sai_object_id_t(const FdbKey &)> FdbOrch::bridgePortOf() const
+{
+    return [this](const FdbKey &key) { return m_entries.find(key)->bridge_port_id; };
+}
+
+size_t FdbOrch::eraseFdbEntry(const FdbEntry& entry)
+{
+    FdbKey key{ entry.mac, entry.bv_id };
+
+    const FdbRecord *record = m_entries.find(key);
+    if (record == nullptr)
+    {
+        return 0;
+    }
+
+    m_entriesIndex.erase(key, record->bridge_port_id, record->index, locateFdbIndex());
+    m_entriesRemotes.release(record->remote_ip);
+    m_entriesEsis.release(record->esi);
+    m_entries.erase(key);
+    return 1;
+}
+
+FdbData FdbOrch::getFdbData(const FdbRecord& record) const
+{
+    FdbData fdbData;
+
+    fdbData.bridge_port_id = record.bridge_port_id;
+    fdbData.type = record.type;
+    fdbData.origin = static_cast<FdbOrigin>(record.origin);
+    fdbData.remote_ip = m_entriesRemotes.get(record.remote_ip);
+    fdbData.esi = m_entriesEsis.get(record.esi);
+    fdbData.vni = record.vni;
+    return fdbData;
+}
+
 bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
 {
     const FdbEntry& entry = update.entry;
     FdbData fdbdata;
-    FdbData oldFdbData;
-    const Port& port = update.port;
-    const MacAddress& mac = entry.mac;
-    string portName = port.m_alias;
-    Port vlan;
+    string portName = (update.port != nullptr) ? update.port->m_alias : "";
 
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    Port *vlan = m_portsOrch->getPortPtr(entry.bv_id);
+    if (vlan == nullptr)
     {
         SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate \
                          vlan port from bv_id 0x%" PRIx64, entry.bv_id);
         return false;
     }
 
-    // ref: https://github.com/Azure/sonic-swss/blob/master/doc/swss-schema.md#fdb_table
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + mac.to_string();
+    string key = getFdbStateKey(vlan->m_vlan_info.vlan_id, entry.mac);
 
     if (update.add)
     {
         bool mac_move = false;
-        auto it = m_entries.find(entry);
-        if (it != m_entries.end())
+        const FdbRecord *existing = m_entries.find(entry);
+        if (existing != nullptr)
         {
             /* This block is specifically added for MAC_MOVE event
                and not expected to be executed for LEARN event
              */
-            if (port.m_bridge_port_id == it->second.bridge_port_id)
+            if (update.port->m_bridge_port_id == existing->bridge_port_id)
             {
                 SWSS_LOG_INFO("FdbOrch notification: mac %s is duplicate", entry.mac.to_string().c_str());
                 return false;
             }
             mac_move = true;
-            oldFdbData = it->second;
         }
 
-        fdbdata.bridge_port_id = update.port.m_bridge_port_id;
+        fdbdata.bridge_port_id = update.port->m_bridge_port_id;
         fdbdata.type = update.type;
         fdbdata.origin = FDB_ORIGIN_LEARN;
-        fdbdata.remote_ip = "";
-        fdbdata.esi = "";
-        fdbdata.vni = 0;
 
-        m_entries[entry] = fdbdata;
+        setFdbEntry(entry, fdbdata);
         SWSS_LOG_INFO("FdbOrch notification: mac %s was inserted in port %s into bv_id 0x%" PRIx64,
                         entry.mac.to_string().c_str(), portName.c_str(), entry.bv_id);
         SWSS_LOG_INFO("m_entries size=%zu mac=%s port=0x%" PRIx64,
-            m_entries.size(), entry.mac.to_string().c_str(),  m_entries[entry].bridge_port_id);
+            m_entries.size(), entry.mac.to_string().c_str(), fdbdata.bridge_port_id);
 
         // Write to StateDb
         std::vector<FieldValueTuple> fvs;
         fvs.push_back(FieldValueTuple("port", portName));
-        fvs.push_back(FieldValueTuple("type", update.type));
+        fvs.push_back(FieldValueTuple("type", getFdbTypeName(update.type)));
         m_fdbStateTable.set(key, fvs);
 
         if (!mac_move)
@@ -126,13 +231,14 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     }
     else
     {
-        auto it= m_entries.find(entry);
-        if(it != m_entries.end())
+        FdbOrigin oldOrigin = FDB_ORIGIN_INVALID;
+        const FdbRecord *existing = m_entries.find(entry);
+        if (existing != nullptr)
         {
-            oldFdbData = it->second;
+            oldOrigin = static_cast<FdbOrigin>(existing->origin);
         }
 
-        size_t erased = m_entries.erase(entry);
+        size_t erased = eraseFdbEntry(entry);
         SWSS_LOG_DEBUG("FdbOrch notification: mac %s was removed from bv_id 0x%" PRIx64, entry.mac.to_string().c_str(), entry.bv_id);
 
         if (erased == 0)
@@ -140,7 +246,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
             return false;
         }
 
-        if (oldFdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED)
+        if (oldOrigin != FDB_ORIGIN_VXLAN_ADVERTIZED)
         {
             // Remove in StateDb for non advertised mac addresses
             m_fdbStateTable.del(key);
@@ -160,8 +266,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
     FdbUpdate update;
     update.entry.mac = entry->mac_address;
     update.entry.bv_id = entry->bv_id;
-    update.type = "dynamic";
-    Port vlan;
+    Port *vlan = nullptr;
 
     SWSS_LOG_INFO("FDB event:%d, MAC: %s , BVID: 0x%" PRIx64 " , \
                    bridge port ID: 0x%" PRIx64 ".",
@@ -169,8 +274,12 @@ void FdbOrch::update(sai_fdb_event_t        type,
                    entry->bv_id, bridge_port_id);
 
 
-    if (bridge_port_id &&
-        !m_portsOrch->getPortByBridgePortId(bridge_port_id, update.port))
+    if (bridge_port_id)
+    {
+        update.port = m_portsOrch->getPortPtrByBridgePortId(bridge_port_id);
+    }
+
+    if (bridge_port_id && update.port == nullptr)
     {
         if (type == SAI_FDB_EVENT_FLUSHED)
         {
@@ -195,32 +304,30 @@ void FdbOrch::update(sai_fdb_event_t        type,
     {
         SWSS_LOG_INFO("Received LEARN event for bvid=0x%" PRIx64 "mac=%s port=0x%" PRIx64, entry->bv_id, update.entry.mac.to_string().c_str(), bridge_port_id);
 
-        if (!m_portsOrch->getPort(entry->bv_id, vlan))
+        vlan = m_portsOrch->getPortPtr(entry->bv_id);
+        if (vlan == nullptr || update.port == nullptr)
         {
             SWSS_LOG_ERROR("FdbOrch LEARN notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry->bv_id);
             return;
         }
 
         // we already have such entries
-        auto existing_entry = m_entries.find(update.entry);
-        if (existing_entry != m_entries.end())
+        const FdbRecord *existing_entry = m_entries.find(update.entry);
+        if (existing_entry != nullptr)
         {
              SWSS_LOG_INFO("FdbOrch LEARN notification: mac %s is already in bv_id 0x%"
                 PRIx64 "existing-bp 0x%" PRIx64 "new-bp:0x%" PRIx64,
-                update.entry.mac.to_string().c_str(), entry->bv_id, existing_entry->second.bridge_port_id, bridge_port_id);
+                update.entry.mac.to_string().c_str(), entry->bv_id, existing_entry->bridge_port_id, bridge_port_id);
              break;
         }
 
         update.add = true;
-        update.entry.port_name = update.port.m_alias;
-        update.type = "dynamic";
-        update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        update.type = FDB_TYPE_DYNAMIC;
+        updateFdbCount(*update.port, 1);
+        updateFdbCount(*vlan, 1);
 
         storeFdbEntryState(update);
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyFdbChange(update);
 
         break;
     }
@@ -229,48 +336,51 @@ void FdbOrch::update(sai_fdb_event_t        type,
         SWSS_LOG_INFO("Received AGE event for bvid=0x%" PRIx64 " mac=%s port=0x%" PRIx64,
                        entry->bv_id, update.entry.mac.to_string().c_str(), bridge_port_id);
 
-        if (!m_portsOrch->getPort(entry->bv_id, vlan))
+        vlan = m_portsOrch->getPortPtr(entry->bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_NOTICE("FdbOrch AGE notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry->bv_id);
         }
 
-        auto existing_entry = m_entries.find(update.entry);
+        const FdbRecord *existing_entry = m_entries.find(update.entry);
         // we don't have such entries
-        if (existing_entry == m_entries.end())
+        if (existing_entry == nullptr)
         {
              SWSS_LOG_INFO("FdbOrch AGE notification: mac %s is not present in bv_id 0x%" PRIx64 " bp 0x%" PRIx64,
                     update.entry.mac.to_string().c_str(), entry->bv_id, bridge_port_id);
              break;
         }
 
-        if (existing_entry->second.bridge_port_id != bridge_port_id)
+        if (existing_entry->bridge_port_id != bridge_port_id)
         {
             SWSS_LOG_INFO("FdbOrch AGE notification: Stale aging event received for mac-bv_id %s-0x%" PRIx64 " with bp=0x%" PRIx64 " existing bp=0x%" PRIx64,
-                           update.entry.mac.to_string().c_str(), entry->bv_id, bridge_port_id, existing_entry->second.bridge_port_id);
+                           update.entry.mac.to_string().c_str(), entry->bv_id, bridge_port_id, existing_entry->bridge_port_id);
             // We need to get the port for bridge-port in existing fdb
-            if (!m_portsOrch->getPortByBridgePortId(existing_entry->second.bridge_port_id, update.port))
+            Port *existing_port = m_portsOrch->getPortPtrByBridgePortId(existing_entry->bridge_port_id);
+            if (existing_port == nullptr)
             {
-                SWSS_LOG_INFO("FdbOrch AGE notification: Failed to get port by bridge port ID 0x%" PRIx64, existing_entry->second.bridge_port_id);
+                SWSS_LOG_INFO("FdbOrch AGE notification: Failed to get port by bridge port ID 0x%" PRIx64, existing_entry->bridge_port_id);
+            }
+            else
+            {
+                update.port = existing_port;
             }
             // dont return, let it delete just to bring SONiC and SAI in sync
             // return;
         }
 
-        if (existing_entry->second.type == "static")
+        if (existing_entry->type == FDB_TYPE_STATIC)
         {
-            update.type = "static";
+            update.type = FDB_TYPE_STATIC;
 
-            if (vlan.m_members.find(update.port.m_alias) == vlan.m_members.end())
+            string portName = (update.port != nullptr) ? update.port->m_alias : "";
+            if (vlan == nullptr || vlan->m_members.find(portName) == vlan->m_members.end())
             {
-                FdbData fdbData;
+                FdbData fdbData = getFdbData(*existing_entry);
                 fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
                 fdbData.type = update.type;
-                fdbData.origin = existing_entry->second.origin;
-                fdbData.remote_ip = existing_entry->second.remote_ip;
-                fdbData.esi = existing_entry->second.esi;
-                fdbData.vni = existing_entry->second.vni;
-        	    saved_fdb_entries[update.port.m_alias].push_back(
-                        {existing_entry->first.mac, vlan.m_vlan_info.vlan_id, fdbData});
+        	    saved_fdb_entries[portName].push_back(
+                        {update.entry.mac, (vlan != nullptr) ? vlan->m_vlan_info.vlan_id : (unsigned short)0, fdbData});
             }
             else
             {
@@ -290,7 +400,7 @@ void FdbOrch::update(sai_fdb_event_t        type,
                 if (status != SAI_STATUS_SUCCESS)
                 {
                     SWSS_LOG_ERROR("Failed to create FDB %s on %s, rv:%d",
-                        existing_entry->first.mac.to_string().c_str(), update.port.m_alias.c_str(), status);
+                        update.entry.mac.to_string().c_str(), portName.c_str(), status);
                     if (handleSaiCreateStatus(SAI_API_FDB, status) != task_success)
                     {
                         return;
@@ -301,60 +411,57 @@ void FdbOrch::update(sai_fdb_event_t        type,
         }
 
         update.add = false;
-        if (!update.port.m_alias.empty())
+        if (update.port != nullptr)
         {
-            update.port.m_fdb_count--;
-            m_portsOrch->setPort(update.port.m_alias, update.port);
+            updateFdbCount(*update.port, -1);
         }
-        if (!vlan.m_alias.empty())
+        if (vlan != nullptr)
         {
-            vlan.m_fdb_count--;
-            m_portsOrch->setPort(vlan.m_alias, vlan);
+            updateFdbCount(*vlan, -1);
         }
         storeFdbEntryState(update);
 
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyFdbChange(update);
 
         notifyTunnelOrch(update.port);
         break;
     }
     case SAI_FDB_EVENT_MOVE:
     {
-        Port port_old;
-        auto existing_entry = m_entries.find(update.entry);
+        Port *port_old = nullptr;
+        const FdbRecord *existing_entry = m_entries.find(update.entry);
 
         SWSS_LOG_INFO("Received MOVE event for bvid=0x%" PRIx64 " mac=%s port=0x%" PRIx64,
                        entry->bv_id, update.entry.mac.to_string().c_str(), bridge_port_id);
 
-        if (!m_portsOrch->getPort(entry->bv_id, vlan))
+        vlan = m_portsOrch->getPortPtr(entry->bv_id);
+        if (vlan == nullptr || update.port == nullptr)
         {
             SWSS_LOG_ERROR("FdbOrch MOVE notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry->bv_id);
             return;
         }
 
         // We should already have such entry
-        if (existing_entry == m_entries.end())
+        if (existing_entry == nullptr)
         {
              SWSS_LOG_WARN("FdbOrch MOVE notification: mac %s is not found in bv_id 0x%" PRIx64,
                     update.entry.mac.to_string().c_str(), entry->bv_id);
         }
-        else if (!m_portsOrch->getPortByBridgePortId(existing_entry->second.bridge_port_id, port_old))
+        else if ((port_old = m_portsOrch->getPortPtrByBridgePortId(existing_entry->bridge_port_id)) == nullptr)
         {
-            SWSS_LOG_ERROR("FdbOrch MOVE notification: Failed to get port by bridge port ID 0x%" PRIx64, existing_entry->second.bridge_port_id);
+            SWSS_LOG_ERROR("FdbOrch MOVE notification: Failed to get port by bridge port ID 0x%" PRIx64, existing_entry->bridge_port_id);
             return;
         }
 
         update.add = true;
-        if (!port_old.m_alias.empty())
+        if (port_old != nullptr)
         {
-            port_old.m_fdb_count--;
-            m_portsOrch->setPort(port_old.m_alias, port_old);
+            updateFdbCount(*port_old, -1);
         }
-        update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
+        updateFdbCount(*update.port, 1);
         storeFdbEntryState(update);
 
-        notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+        notifyFdbChange(update);
 
         notifyTunnelOrch(port_old);
 
@@ -369,15 +476,15 @@ void FdbOrch::update(sai_fdb_event_t        type,
 
         string vlanName = "-";
         if (entry->bv_id) {
-            Port vlan;
+            Port *vlan = m_portsOrch->getPortPtr(entry->bv_id);
 
-            if (!m_portsOrch->getPort(entry->bv_id, vlan))
+            if (vlan == nullptr)
             {
                 SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan\
                                 port from bv_id 0x%" PRIx64, entry->bv_id);
                 return;
             }
-            vlanName = "Vlan" + to_string(vlan.m_vlan_info.vlan_id);
+            vlanName = "Vlan" + to_string(vlan->m_vlan_info.vlan_id);
         }
 
 
@@ -386,67 +493,37 @@ void FdbOrch::update(sai_fdb_event_t        type,
         {
             SWSS_LOG_INFO("FDB Flush: [ %s , %s ] = { port: - }",
                            update.entry.mac.to_string().c_str(), vlanName.c_str());
-            for (auto itr = m_entries.begin(); itr != m_entries.end();)
-            {
-                /*
-                   TODO: here should only delete the dynamic fdb entries,
-                   but unfortunately in structure FdbEntry currently have
-                   no member to indicate the fdb entry type,
-                   if there is static mac added, here will have issue.
-                */
-                update.entry.mac = itr->first.mac;
-                update.entry.bv_id = itr->first.bv_id;
-                update.add = false;
-                itr++;
-
-                storeFdbEntryState(update);
-
-                for (auto observer: m_observers)
-                {
-                    observer->update(SUBJECT_TYPE_FDB_CHANGE, &update);
-                }
-            }
+            removeFlushedEntries(m_entries.keys(), update);
         }
         else if (entry->bv_id == SAI_NULL_OBJECT_ID)
         {
             /* FLUSH based on port */
             SWSS_LOG_INFO("FDB Flush: [ %s , %s ] = { port: %s }",
                            update.entry.mac.to_string().c_str(),
-                           vlanName.c_str(), update.port.m_alias.c_str());
-
-            for (auto itr = m_entries.begin(); itr != m_entries.end();)
-            {
-                auto next_item = std::next(itr);
-                if (itr->first.port_name == update.port.m_alias)
-                {
-                    update.entry.mac = itr->first.mac;
-                    update.entry.bv_id = itr->first.bv_id;
-                    update.add = false;
-
-                    storeFdbEntryState(update);
+                           vlanName.c_str(), update.port->m_alias.c_str());
 
-                    for (auto observer: m_observers)
-                    {
-                        observer->update(SUBJECT_TYPE_FDB_CHANGE, &update);
-                    }
-                }
-                itr = next_item;
-            }
+            /* Copied, the entries are removed from the index on the way */
+            const auto &onPort = m_entriesIndex.byPort(bridge_port_id);
+            removeFlushedEntries(vector<FdbKey>(onPort.begin(), onPort.end()), update);
         }
         else if (bridge_port_id == SAI_NULL_OBJECT_ID)
         {
-            /* FLUSH based on VLAN - unsupported */
-            SWSS_LOG_ERROR("Unsupported FDB Flush: [ %s , %s ] = { port: - }",
+            /* FLUSH based on VLAN */
+            SWSS_LOG_INFO("FDB Flush: [ %s , %s ] = { port: - }",
                            update.entry.mac.to_string().c_str(),
                            vlanName.c_str());
 
+            const auto &inVlan = m_entriesIndex.byVlan(entry->bv_id);
+            removeFlushedEntries(vector<FdbKey>(inVlan.begin(), inVlan.end()), update);
         }
         else
         {
-            /* FLUSH based on port and VLAN - unsupported */
-            SWSS_LOG_ERROR("Unsupported FDB Flush: [ %s , %s ] = { port: %s }",
+            /* FLUSH based on port and VLAN */
+            SWSS_LOG_INFO("FDB Flush: [ %s , %s ] = { port: %s }",
                            update.entry.mac.to_string().c_str(),
-                           vlanName.c_str(), update.port.m_alias.c_str());
+                           vlanName.c_str(), update.port->m_alias.c_str());
+
+            removeFlushedEntries(m_entriesIndex.byPortAndVlan(bridge_port_id, entry->bv_id, bridgePortOf()), update);
         }
         break;
     }
@@ -454,6 +531,30 @@ void FdbOrch::update(sai_fdb_event_t        type,
     return;
 }
 
+/*
+ * Removes the entries of a flush event, and notifies the observers of these
+ * MACs only. Static entries are not flushed from the ASIC and are kept.
+ */
+void FdbOrch::removeFlushedEntries(const vector<FdbKey>& entries, FdbUpdate& update)
+{
+    for (const auto &fdb: entries)
+    {
+        const FdbRecord *record = m_entries.find(fdb);
+        if (record == nullptr || record->type == FDB_TYPE_STATIC)
+        {
+            continue;
+        }
+
+        update.entry.mac = fdb.mac;
+        update.entry.bv_id = fdb.bv_id;
+        update.add = false;
+
+        storeFdbEntryState(update);
+
+        notifyFdbChange(update);
+    }
+}
+
 void FdbOrch::update(SubjectType type, void *cntx)
 {
     SWSS_LOG_ENTER();
@@ -477,6 +578,7 @@ void FdbOrch::update(SubjectType type, void *cntx)
             break;
     }
 
+    m_fdbStateTable.flush();
     return;
 }
 
@@ -536,140 +638,208 @@ void FdbOrch::doTask(Consumer& consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        // FDB bulk results will be stored in a map
+        std::map<
+                std::pair<
+                        std::string,            // Key
+                        std::string             // Op
+                >,
+                FdbBulkContext
+        >                                       toBulk;
+
+        // Add or remove FDB entries with the FDB bulker
+        while (it != consumer.m_toSync.end())
+        {
+            KeyOpFieldsValuesTuple t = it->second;
 
-        /* format: <VLAN_name>:<MAC_address> */
-        vector<string> keys = tokenize(kfvKey(t), ':', 1);
-        string op = kfvOp(t);
+            /* format: <VLAN_name>:<MAC_address> */
+            vector<string> keys = tokenize(kfvKey(t), ':', 1);
+            string op = kfvOp(t);
 
-        Port vlan;
-        if (!m_portsOrch->getPort(keys[0], vlan))
-        {
-            SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
-            if(op == DEL_COMMAND)
+            Port vlan;
+            if (!m_portsOrch->getPort(keys[0], vlan))
             {
-                /* Delete if it is in saved_fdb_entry */
-                unsigned short vlan_id;
-                try {
-                    vlan_id = (unsigned short) stoi(keys[0].substr(4));
-                } catch(exception &e) {
+                SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
+                if(op == DEL_COMMAND)
+                {
+                    /* Delete if it is in saved_fdb_entry */
+                    unsigned short vlan_id;
+                    try {
+                        vlan_id = (unsigned short) stoi(keys[0].substr(4));
+                    } catch(exception &e) {
+                        it = consumer.m_toSync.erase(it);
+                        continue;
+                    }
+                    deleteFdbEntryFromSavedFDB(MacAddress(keys[1]), vlan_id, origin);
+
                     it = consumer.m_toSync.erase(it);
-                    continue;
                 }
-                deleteFdbEntryFromSavedFDB(MacAddress(keys[1]), vlan_id, origin);
-
-                it = consumer.m_toSync.erase(it);
-            }
-            else
-            {
-                it++;
+                else
+                {
+                    it++;
+                }
+                continue;
             }
-            continue;
-        }
 
-        FdbEntry entry;
-        entry.mac = MacAddress(keys[1]);
-        entry.bv_id = vlan.m_vlan_info.vlan_oid;
+            FdbEntry entry;
+            entry.mac = MacAddress(keys[1]);
+            entry.bv_id = vlan.m_vlan_info.vlan_oid;
 
-        if (op == SET_COMMAND)
-        {
-            string port = "";
-            string type = "dynamic";
-            string remote_ip = "";
-            string esi = "";
-            unsigned int vni = 0;
-            string sticky = "";
-
-            for (auto i : kfvFieldsValues(t))
+            /* The DEL of an FDB entry is bulked before its SET. Process the SET
+             * in the next bulk, once the result of the DEL is known */
+            auto bulked_del = toBulk.find(make_pair(kfvKey(t), DEL_COMMAND));
+            if (bulked_del != toBulk.end() && bulked_del->second.bulked)
             {
-                if (fvField(i) == "port")
-                {
-                    port = fvValue(i);
-                }
-
-                if (fvField(i) == "type")
-                {
-                    type = fvValue(i);
-                }
+                break;
+            }
 
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+            if (op == SET_COMMAND)
+            {
+                string port = "";
+                FdbType type = FDB_TYPE_DYNAMIC;
+                IpAddress remote_ip = 0x0;
+                FdbEsi esi = {};
+                unsigned int vni = 0;
+                string sticky = "";
+
+                for (auto i : kfvFieldsValues(t))
                 {
-                    if (fvField(i) == "remote_vtep")
+                    if (fvField(i) == "port")
                     {
-                        remote_ip = fvValue(i);
-                        // Creating an IpAddress object to validate if remote_ip is valid
-                        // if invalid it will throw the exception and we will ignore the
-                        // event
-                        try {
-                            IpAddress valid_ip = IpAddress(remote_ip);
-                            (void)valid_ip; // To avoid g++ warning
-                        } catch(exception &e) {
-                            SWSS_LOG_NOTICE("Invalid IP address in remote MAC %s", remote_ip.c_str());
-                            remote_ip = "";
-                            break;
-                        }
+                        port = fvValue(i);
                     }
 
-                    if (fvField(i) == "esi")
+                    if (fvField(i) == "type")
                     {
-                        esi = fvValue(i);
+                        /* FDB type is either dynamic or static */
+                        assert(fvValue(i) == "dynamic" || fvValue(i) == "static");
+                        type = getFdbType(fvValue(i));
                     }
 
-                    if (fvField(i) == "vni")
+                    if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
                     {
-                        try {
-                            vni = (unsigned int) stoi(fvValue(i));
-                        } catch(exception &e) {
-                            SWSS_LOG_INFO("Invalid VNI in remote MAC %s", fvValue(i).c_str());
-                            vni = 0;
-                            break;
+                        if (fvField(i) == "remote_vtep")
+                        {
+                            // If remote_ip is invalid, IpAddress will throw the exception
+                            // and we will ignore the event
+                            try {
+                                remote_ip = IpAddress(fvValue(i));
+                            } catch(exception &e) {
+                                SWSS_LOG_NOTICE("Invalid IP address in remote MAC %s", fvValue(i).c_str());
+                                remote_ip = 0x0;
+                                break;
+                            }
+                        }
+
+                        if (fvField(i) == "esi")
+                        {
+                            if (!FdbEsi::parse(fvValue(i), esi))
+                            {
+                                SWSS_LOG_NOTICE("Invalid ESI in remote MAC %s", fvValue(i).c_str());
+                            }
+                        }
+
+                        if (fvField(i) == "vni")
+                        {
+                            try {
+                                vni = (unsigned int) stoi(fvValue(i));
+                            } catch(exception &e) {
+                                SWSS_LOG_INFO("Invalid VNI in remote MAC %s", fvValue(i).c_str());
+                                vni = 0;
+                                break;
+                            }
                         }
                     }
                 }
-            }
 
-            /* FDB type is either dynamic or static */
-            assert(type == "dynamic" || type == "static");
+                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+                {
+                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
 
-            if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
-            {
-                VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+                    if(remote_ip.isZero())
+                    {
+                        it = consumer.m_toSync.erase(it);
+                        continue;
+                    }
+                    port = tunnel_orch->getTunnelPortName(remote_ip.to_string());
+                }
 
-                if(!remote_ip.length())
-                {
+
+                auto& ctx = toBulk.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(kfvKey(t), op),
+                        std::forward_as_tuple()).first->second;
+                ctx.entry = entry;
+
+                FdbData& fdbData = ctx.fdbData;
+                fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
+                fdbData.type = type;
+                fdbData.origin = origin;
+                fdbData.remote_ip = remote_ip;
+                fdbData.esi = esi;
+                fdbData.vni = vni;
+                if (addFdbEntry(ctx, port))
                     it = consumer.m_toSync.erase(it);
-                    continue;
-                }
-                port = tunnel_orch->getTunnelPortName(remote_ip);
+                else
+                    it++;
             }
+            else if (op == DEL_COMMAND)
+            {
+                auto& ctx = toBulk.emplace(std::piecewise_construct,
+                        std::forward_as_tuple(kfvKey(t), op),
+                        std::forward_as_tuple()).first->second;
+                ctx.entry = entry;
+                ctx.origin = origin;
 
+                if (removeFdbEntry(ctx))
+                    it = consumer.m_toSync.erase(it);
+                else
+                    it++;
 
-            FdbData fdbData;
-            fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
-            fdbData.type = type;
-            fdbData.origin = origin;
-            fdbData.remote_ip = remote_ip;
-            fdbData.esi = esi;
-            fdbData.vni = vni;
-            if (addFdbEntry(entry, port, fdbData))
-                it = consumer.m_toSync.erase(it);
+            }
             else
-                it++;
-        }
-        else if (op == DEL_COMMAND)
-        {
-            if (removeFdbEntry(entry, origin))
+            {
+                SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
                 it = consumer.m_toSync.erase(it);
-            else
-                it++;
-
+            }
         }
-        else
+
+        // Flush the FDB bulker, so FDB entries will be written to syncd and ASIC
+        gFdbBulker.flush();
+
+        // Go through the bulker results
+        auto it_prev = consumer.m_toSync.begin();
+        while (it_prev != it)
         {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            string key = it_prev->first;
+            string op = kfvOp(it_prev->second);
+
+            auto found = toBulk.find(make_pair(key, op));
+            if (found == toBulk.end() || !found->second.bulked)
+            {
+                it_prev++;
+                continue;
+            }
+
+            const auto& ctx = found->second;
+
+            if (op == SET_COMMAND)
+            {
+                if (addFdbEntryPost(ctx))
+                    it_prev = consumer.m_toSync.erase(it_prev);
+                else
+                    it_prev++;
+            }
+            else
+            {
+                if (removeFdbEntryPost(ctx))
+                    it_prev = consumer.m_toSync.erase(it_prev);
+                else
+                    it_prev++;
+            }
         }
     }
+
+    m_fdbStateTable.flush();
 }
 
 void FdbOrch::doTask(NotificationConsumer& consumer)
@@ -681,72 +851,219 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
         return;
     }
 
-    sai_status_t status;
-    std::string op;
-    std::string data;
-    std::vector<swss::FieldValueTuple> values;
+    if (&consumer == m_fdbNotificationConsumer)
+    {
+        /* All the queued notifications, so that the events of a MAC are coalesced */
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        consumer.pops(entries);
+
+        for (const auto &entry : entries)
+        {
+            if (kfvOp(entry) != "fdb_event")
+            {
+                continue;
+            }
+
+            uint32_t count;
+            sai_fdb_event_notification_data_t *fdbevent = nullptr;
+
+            sai_deserialize_fdb_event_ntf(kfvKey(entry), count, &fdbevent);
+
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+
+                for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
+                {
+                    if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
+                    {
+                        oid = fdbevent[i].attr[j].value.oid;
+                        break;
+                    }
+                }
+
+                m_fdbEvents.add({ fdbevent[i].event_type, fdbevent[i].fdb_entry, oid });
+            }
+
+            sai_deserialize_free_fdb_event_ntf(count, fdbevent);
+        }
 
-    consumer.pop(op, data, values);
+        vector<FdbEvent> events;
+        m_fdbEvents.take(events);
+        updateFdbEvents(events);
+        return;
+    }
 
     if (&consumer == m_flushNotificationsConsumer)
     {
-        if (op == "ALL")
+        /* All the queued requests, so that the flushes they share are done once */
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        consumer.pops(entries);
+
+        FdbFlushRequests requests;
+        for (const auto &entry : entries)
         {
-            /*
-             * so far only support flush all the FDB entries
-             * flush per port and flush per vlan will be added later.
-             */
-            status = sai_fdb_api->flush_fdb_entries(gSwitchId, 0, NULL);
+            addFlushRequest(kfvOp(entry), kfvKey(entry), requests);
+        }
+
+        if (requests.empty())
+        {
+            return;
+        }
+
+        bool all;
+        vector<FdbFlushRequests::Scope> scopes;
+        requests.take(all, scopes);
+
+        if (all)
+        {
+            sai_status_t status = sai_fdb_api->flush_fdb_entries(gSwitchId, 0, NULL);
             if (status != SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_ERROR("Flush fdb failed, return code %x", status);
             }
-
             return;
         }
-        else if (op == "PORT")
+
+        for (const auto &scope : scopes)
         {
-            /*place holder for flush port fdb*/
-            SWSS_LOG_ERROR("Received unsupported flush port fdb request");
-            return;
+            flushFDBEntries(scope.first, scope.second);
         }
-        else if (op == "VLAN")
+    }
+}
+
+/*
+ * Adds the scopes of a FLUSHFDBREQUEST notification:
+ *     ALL  - the whole FDB
+ *     PORT - comma separated ports, each as <port> or <port>:<vlan>,
+ *            e.g. "Ethernet0,PortChannel1:Vlan100"
+ *     VLAN - comma separated VLANs, e.g. "Vlan100,Vlan200"
+ */
+void FdbOrch::addFlushRequest(const string& op, const string& data, FdbFlushRequests& requests)
+{
+    if (op == "ALL")
+    {
+        requests.addAll();
+        return;
+    }
+
+    if (op != "PORT" && op != "VLAN")
+    {
+        SWSS_LOG_ERROR("Received unknown flush fdb request %s", op.c_str());
+        return;
+    }
+
+    for (const auto &target : tokenize(data, ','))
+    {
+        vector<string> names = tokenize(target, ':');
+        sai_object_id_t bridge_port_id = SAI_NULL_OBJECT_ID;
+        sai_object_id_t vlan_oid = SAI_NULL_OBJECT_ID;
+        Port port;
+
+        if (op == "PORT")
         {
-            /*place holder for flush vlan fdb*/
-            SWSS_LOG_ERROR("Received unsupported flush vlan fdb request");
-            return;
+            if (names.empty() || names.size() > 2 || !m_portsOrch->getPort(names[0], port) ||
+                port.m_bridge_port_id == SAI_NULL_OBJECT_ID)
+            {
+                SWSS_LOG_ERROR("Received flush fdb request of unknown bridge port %s", target.c_str());
+                continue;
+            }
+            bridge_port_id = port.m_bridge_port_id;
+            names.erase(names.begin());
         }
-        else
+
+        if (!names.empty())
         {
-            SWSS_LOG_ERROR("Received unknown flush fdb request");
-            return;
+            if (names.size() > 1 || !m_portsOrch->getPort(names[0], port) || port.m_type != Port::VLAN)
+            {
+                SWSS_LOG_ERROR("Received flush fdb request of unknown vlan %s", target.c_str());
+                continue;
+            }
+            vlan_oid = port.m_vlan_info.vlan_oid;
         }
+        else if (op == "VLAN")
+        {
+            SWSS_LOG_ERROR("Received flush fdb request without vlan");
+            continue;
+        }
+
+        SWSS_LOG_INFO("Received flush fdb request of %s", target.c_str());
+        requests.add(bridge_port_id, vlan_oid);
     }
-    else if (&consumer == m_fdbNotificationConsumer && op == "fdb_event")
-    {
-        uint32_t count;
-        sai_fdb_event_notification_data_t *fdbevent = nullptr;
+}
 
-        sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
+/*
+ * Applies the coalesced events of a burst of FDB notifications. As the last
+ * event of a MAC stands for all its events in the burst, a learn or a move
+ * is applied as a learn or as a move from the port the MAC is on before the
+ * burst. The changes are notified to the observers at once, after STATE_DB
+ * is written in one pipeline flush.
+ */
+void FdbOrch::updateFdbEvents(vector<FdbEvent>& events)
+{
+    FdbBatchUpdate batch;
+    m_batchUpdate = &batch;
 
-        for (uint32_t i = 0; i < count; ++i)
+    for (auto& event: events)
+    {
+        if (event.type == SAI_FDB_EVENT_LEARNED || event.type == SAI_FDB_EVENT_MOVE)
         {
-            sai_object_id_t oid = SAI_NULL_OBJECT_ID;
-
-            for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
+            const FdbRecord *existing = m_entries.find(FdbKey{ MacAddress(event.entry.mac_address), event.entry.bv_id });
+            if (existing == nullptr)
             {
-                if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
-                {
-                    oid = fdbevent[i].attr[j].value.oid;
-                    break;
-                }
+                event.type = SAI_FDB_EVENT_LEARNED;
             }
+            else if (existing->bridge_port_id == event.bridge_port_id)
+            {
+                continue;
+            }
+            else if (existing->type != FDB_TYPE_STATIC)
+            {
+                event.type = SAI_FDB_EVENT_MOVE;
+            }
+        }
+
+        update(event.type, &event.entry, event.bridge_port_id);
+    }
+
+    m_batchUpdate = nullptr;
+    m_fdbStateTable.flush();
 
-            this->update(fdbevent[i].event_type, &fdbevent[i].fdb_entry, oid);
+    if (!batch.updates.empty())
+    {
+        notify(SUBJECT_TYPE_FDB_BATCH_CHANGE, &batch);
+    }
+
+    for (const auto& alias: m_batchTunnelPorts)
+    {
+        Port tunnel;
+        if (m_portsOrch->getPort(alias, tunnel))
+        {
+            notifyTunnelOrch(&tunnel);
         }
+    }
+    m_batchTunnelPorts.clear();
+
+    SWSS_LOG_INFO("Applied %zu FDB events with %zu changes, %" PRIu64 " of %" PRIu64 " events coalesced so far",
+                  events.size(), batch.updates.size(), m_fdbEvents.getCoalesced(), m_fdbEvents.getReceived());
+}
 
-        sai_deserialize_free_fdb_event_ntf(count, fdbevent);
+/* Notifies the change at once, or with the others of the events being applied */
+void FdbOrch::notifyFdbChange(FdbUpdate& update)
+{
+    if (m_batchUpdate != nullptr)
+    {
+        m_batchUpdate->updates.push_back(update);
+        return;
     }
+
+    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+}
+
+/* Counts the FDB entries of a port or a VLAN, port is the PortsOrch Port itself and not a copy */
+void FdbOrch::updateFdbCount(Port& port, int delta)
+{
+    port.m_fdb_count += delta;
 }
 
 /*
@@ -806,18 +1123,14 @@ void FdbOrch::notifyObserversFDBFlush(Port &port, sai_object_id_t& bvid)
     FdbFlushUpdate flushUpdate;
     flushUpdate.port = port;
 
-    for (auto itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+    for (const auto &fdb: m_entriesIndex.byPortAndVlan(port.m_bridge_port_id, bvid, bridgePortOf()))
     {
-        if ((itr->first.port_name == port.m_alias) &&
-            (itr->first.bv_id == bvid))
-        {
-            SWSS_LOG_INFO("Adding MAC learnt on [ port:%s , bvid:0x%" PRIx64 "]\
-                           to ARP flush", port.m_alias.c_str(), bvid);
-            FdbEntry entry;
-            entry.mac = itr->first.mac;
-            entry.bv_id = itr->first.bv_id;
-            flushUpdate.entries.push_back(entry);
-        }
+        SWSS_LOG_INFO("Adding MAC learnt on [ port:%s , bvid:0x%" PRIx64 "]\
+                       to ARP flush", port.m_alias.c_str(), bvid);
+        FdbEntry entry;
+        entry.mac = fdb.mac;
+        entry.bv_id = fdb.bv_id;
+        flushUpdate.entries.push_back(entry);
     }
 
     if (!flushUpdate.entries.empty())
@@ -892,38 +1205,88 @@ void FdbOrch::updateVlanMember(const VlanMemberUpdate& update)
     }
 }
 
+/* Attributes of a new FDB entry, also set on an existing entry on MAC update */
+void FdbOrch::getFdbEntryAttrs(const FdbData& fdbData, sai_object_id_t bridge_port_id,
+        vector<sai_attribute_t>& attrs)
+{
+    sai_attribute_t attr;
+
+    attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
+    if (fdbData.origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+    {
+        attr.value.s32 = SAI_FDB_ENTRY_TYPE_STATIC;
+    }
+    else
+    {
+        attr.value.s32 = (fdbData.type == FDB_TYPE_DYNAMIC) ? SAI_FDB_ENTRY_TYPE_DYNAMIC : SAI_FDB_ENTRY_TYPE_STATIC;
+    }
+    attrs.push_back(attr);
+
+    if ((fdbData.origin == FDB_ORIGIN_VXLAN_ADVERTIZED) && (fdbData.type == FDB_TYPE_DYNAMIC))
+    {
+        attr.id = SAI_FDB_ENTRY_ATTR_ALLOW_MAC_MOVE;
+        attr.value.booldata = true;
+        attrs.push_back(attr);
+    }
+
+    attr.id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+    attr.value.oid = bridge_port_id;
+    attrs.push_back(attr);
+
+    if (fdbData.origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+    {
+        const IpAddress &remote = fdbData.remote_ip;
+        sai_ip_address_t ipaddr;
+        if (remote.isV4())
+        {
+            ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+            ipaddr.addr.ip4 = remote.getV4Addr();
+        }
+        else
+        {
+            ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV6;
+            memcpy(ipaddr.addr.ip6, remote.getV6Addr(), sizeof(ipaddr.addr.ip6));
+        }
+        attr.id = SAI_FDB_ENTRY_ATTR_ENDPOINT_IP;
+        attr.value.ipaddr = ipaddr;
+        attrs.push_back(attr);
+    }
+}
+
 bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         FdbData fdbData)
 {
-    Port vlan;
-    Port port;
+    Port *vlan;
+    Port *port;
 
     SWSS_LOG_ENTER();
     SWSS_LOG_INFO("mac=%s bv_id=0x%" PRIx64 " port_name=%s type=%s origin=%d",
             entry.mac.to_string().c_str(), entry.bv_id, port_name.c_str(),
-            fdbData.type.c_str(), fdbData.origin);
+            getFdbTypeName(fdbData.type), fdbData.origin);
 
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    vlan = m_portsOrch->getPortPtr(entry.bv_id);
+    if (vlan == nullptr)
     {
         SWSS_LOG_NOTICE("addFdbEntry: Failed to locate vlan port from bv_id 0x%" PRIx64, entry.bv_id);
         return false;
     }
 
     /* Retry until port is created */
-    if (!m_portsOrch->getPort(port_name, port) || (port.m_bridge_port_id == SAI_NULL_OBJECT_ID))
+    port = m_portsOrch->getPortPtr(port_name);
+    if (port == nullptr || (port->m_bridge_port_id == SAI_NULL_OBJECT_ID))
     {
         SWSS_LOG_INFO("Saving a fdb entry until port %s becomes active", port_name.c_str());
         saved_fdb_entries[port_name].push_back({entry.mac,
-                vlan.m_vlan_info.vlan_id, fdbData});
+                vlan->m_vlan_info.vlan_id, fdbData});
         return true;
     }
 
     /* Retry until port is member of vlan*/
-    if (vlan.m_members.find(port_name) == vlan.m_members.end())
+    if (vlan->m_members.find(port_name) == vlan->m_members.end())
     {
-        SWSS_LOG_INFO("Saving a fdb entry until port %s becomes vlan %s member", port_name.c_str(), vlan.m_alias.c_str());
+        SWSS_LOG_INFO("Saving a fdb entry until port %s becomes vlan %s member", port_name.c_str(), vlan->m_alias.c_str());
         saved_fdb_entries[port_name].push_back({entry.mac,
-                vlan.m_vlan_info.vlan_id, fdbData});
+                vlan->m_vlan_info.vlan_id, fdbData});
         return true;
     }
 
@@ -933,66 +1296,67 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
-    Port oldPort;
-    string oldType;
+    Port *oldPort = nullptr;
+    FdbType oldType = FDB_TYPE_DYNAMIC;
     FdbOrigin oldOrigin = FDB_ORIGIN_INVALID ;
     bool macUpdate = false;
-    auto it = m_entries.find(entry);
-    if (it != m_entries.end())
+    const FdbRecord *existing = m_entries.find(entry);
+    if (existing != nullptr)
     {
         /* get existing port and type */
-        oldType = it->second.type;
-        oldOrigin = it->second.origin;
+        oldType = existing->type;
+        oldOrigin = static_cast<FdbOrigin>(existing->origin);
 
-        if (!m_portsOrch->getPortByBridgePortId(it->second.bridge_port_id, oldPort))
+        oldPort = m_portsOrch->getPortPtrByBridgePortId(existing->bridge_port_id);
+        if (oldPort == nullptr)
         {
-            SWSS_LOG_ERROR("Existing port 0x%" PRIx64 " details not found", it->second.bridge_port_id);
+            SWSS_LOG_ERROR("Existing port 0x%" PRIx64 " details not found", existing->bridge_port_id);
             return false;
         }
 
-        if ((oldOrigin == fdbData.origin) && (oldType == fdbData.type) && (port.m_bridge_port_id == it->second.bridge_port_id))
+        if ((oldOrigin == fdbData.origin) && (oldType == fdbData.type) && (port->m_bridge_port_id == existing->bridge_port_id))
         {
             /* Duplicate Mac */
             SWSS_LOG_INFO("FdbOrch: mac=%s %s port=%s type=%s origin=%d is duplicate", entry.mac.to_string().c_str(),
-                    vlan.m_alias.c_str(), port_name.c_str(),
-                    fdbData.type.c_str(), fdbData.origin);
+                    vlan->m_alias.c_str(), port_name.c_str(),
+                    getFdbTypeName(fdbData.type), fdbData.origin);
             return true;
         }
         else if (fdbData.origin != oldOrigin)
         {
             /* Mac origin has changed */
-            if ((oldType == "static") && (oldOrigin == FDB_ORIGIN_PROVISIONED))
+            if ((oldType == FDB_TYPE_STATIC) && (oldOrigin == FDB_ORIGIN_PROVISIONED))
             {
                 /* old mac was static and provisioned, it can not be changed by Remote Mac */
                 SWSS_LOG_NOTICE("Already existing static MAC:%s in Vlan:%d. "
                         "Received same MAC from peer:%s; "
                         "Peer mac ignored",
-                        entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id,
-                        fdbData.remote_ip.c_str());
+                        entry.mac.to_string().c_str(), vlan->m_vlan_info.vlan_id,
+                        fdbData.remote_ip.to_string().c_str());
 
                 return true;
             }
-            else if ((oldType == "static") && (oldOrigin ==
-                        FDB_ORIGIN_VXLAN_ADVERTIZED) && (fdbData.type == "dynamic"))
+            else if ((oldType == FDB_TYPE_STATIC) && (oldOrigin ==
+                        FDB_ORIGIN_VXLAN_ADVERTIZED) && (fdbData.type == FDB_TYPE_DYNAMIC))
             {
                 /* old mac was static and received from remote, it can not be changed by dynamic locally provisioned Mac */
                 SWSS_LOG_INFO("Already existing static MAC:%s in Vlan:%d "
                         "from Peer:%s. Now same is provisioned as dynamic; "
                         "Provisioned dynamic mac is ignored",
-                        entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id,
-                        it->second.remote_ip.c_str());
+                        entry.mac.to_string().c_str(), vlan->m_vlan_info.vlan_id,
+                        m_entriesRemotes.get(existing->remote_ip).to_string().c_str());
                 return true;
             }
             else if (oldOrigin == FDB_ORIGIN_VXLAN_ADVERTIZED)
             {
-                if ((oldType == "static") && (fdbData.type == "static"))
+                if ((oldType == FDB_TYPE_STATIC) && (fdbData.type == FDB_TYPE_STATIC))
                 {
                     SWSS_LOG_WARN("You have just overwritten existing static MAC:%s "
                             "in Vlan:%d from Peer:%s, "
                             "If it is a mistake, it will result in inconsistent Traffic Forwarding",
                             entry.mac.to_string().c_str(),
-                            vlan.m_vlan_info.vlan_id,
-                            it->second.remote_ip.c_str());
+                            vlan->m_vlan_info.vlan_id,
+                            m_entriesRemotes.get(existing->remote_ip).to_string().c_str());
                 }
             }
         }
@@ -1012,47 +1376,9 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
 
-    attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
-    if (fdbData.origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
-    {
-        attr.value.s32 = SAI_FDB_ENTRY_TYPE_STATIC;
-    }
-    else
-    {
-        attr.value.s32 = (fdbData.type == "dynamic") ? SAI_FDB_ENTRY_TYPE_DYNAMIC : SAI_FDB_ENTRY_TYPE_STATIC;
-    }
-    attrs.push_back(attr);
-
-    if ((fdbData.origin == FDB_ORIGIN_VXLAN_ADVERTIZED) && (fdbData.type == "dynamic"))
-    {
-        attr.id = SAI_FDB_ENTRY_ATTR_ALLOW_MAC_MOVE;
-        attr.value.booldata = true;
-        attrs.push_back(attr);
-    }
-
-    attr.id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
-    attr.value.oid = port.m_bridge_port_id;
-    attrs.push_back(attr);
+    getFdbEntryAttrs(fdbData, port->m_bridge_port_id, attrs);
 
-    if (fdbData.origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
-    {
-        IpAddress remote = IpAddress(fdbData.remote_ip);
-        sai_ip_address_t ipaddr;
-        if (remote.isV4())
-        {
-            ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
-            ipaddr.addr.ip4 = remote.getV4Addr();
-        }
-        else
-        {
-            ipaddr.addr_family = SAI_IP_ADDR_FAMILY_IPV6;
-            memcpy(ipaddr.addr.ip6, remote.getV6Addr(), sizeof(ipaddr.addr.ip6));
-        }
-        attr.id = SAI_FDB_ENTRY_ATTR_ENDPOINT_IP;
-        attr.value.ipaddr = ipaddr;
-        attrs.push_back(attr);
-    }
-    else if (macUpdate
+    if (macUpdate
             && (oldOrigin == FDB_ORIGIN_VXLAN_ADVERTIZED)
             && (fdbData.origin != oldOrigin))
     {
@@ -1070,7 +1396,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     if (macUpdate && (oldOrigin == FDB_ORIGIN_VXLAN_ADVERTIZED))
     {
         if ((fdbData.origin != oldOrigin)
-           || ((oldType == "dynamic") && (oldType != fdbData.type)))
+           || ((oldType == FDB_TYPE_DYNAMIC) && (oldType != fdbData.type)))
         {
             attr.id = SAI_FDB_ENTRY_ATTR_ALLOW_MAC_MOVE;
             attr.value.booldata = false;
@@ -1082,8 +1408,8 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     if (macUpdate)
     {
         SWSS_LOG_INFO("MAC-Update FDB %s in %s on from-%s:to-%s from-%s:to-%s origin-%d-to-%d",
-                entry.mac.to_string().c_str(), vlan.m_alias.c_str(), oldPort.m_alias.c_str(),
-                port_name.c_str(), oldType.c_str(), fdbData.type.c_str(),
+                entry.mac.to_string().c_str(), vlan->m_alias.c_str(), oldPort->m_alias.c_str(),
+                port_name.c_str(), getFdbTypeName(oldType), getFdbTypeName(fdbData.type),
                 oldOrigin, fdbData.origin);
         for (auto itr : attrs)
         {
@@ -1091,7 +1417,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
             if (status != SAI_STATUS_SUCCESS)
             {
                 SWSS_LOG_ERROR("macUpdate-Failed for attr.id=0x%x for FDB %s in %s on %s, rv:%d",
-                            itr.id, entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str(), status);
+                            itr.id, entry.mac.to_string().c_str(), vlan->m_alias.c_str(), port_name.c_str(), status);
                 task_process_status handle_status = handleSaiSetStatus(SAI_API_FDB, status);
                 if (handle_status != task_success)
                 {
@@ -1099,42 +1425,38 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 }
             }
         }
-        if (oldPort.m_bridge_port_id != port.m_bridge_port_id)
+        if (oldPort->m_bridge_port_id != port->m_bridge_port_id)
         {
-            oldPort.m_fdb_count--;
-            m_portsOrch->setPort(oldPort.m_alias, oldPort);
-            port.m_fdb_count++;
-            m_portsOrch->setPort(port.m_alias, port);
+            updateFdbCount(*oldPort, -1);
+            updateFdbCount(*port, 1);
         }
     }
     else
     {
-        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
+        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", getFdbTypeName(fdbData.type), entry.mac.to_string().c_str(), vlan->m_alias.c_str(), port_name.c_str());
 
         status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
         if (status != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to create %s FDB %s in %s on %s, rv:%d",
-                    fdbData.type.c_str(), entry.mac.to_string().c_str(),
-                    vlan.m_alias.c_str(), port_name.c_str(), status);
+                    getFdbTypeName(fdbData.type), entry.mac.to_string().c_str(),
+                    vlan->m_alias.c_str(), port_name.c_str(), status);
             task_process_status handle_status = handleSaiCreateStatus(SAI_API_FDB, status); //FIXME: it should be based on status. Some could be retried, some not
             if (handle_status != task_success)
             {
                 return parseHandleSaiStatusFailure(handle_status);
             }
         }
-        port.m_fdb_count++;
-        m_portsOrch->setPort(port.m_alias, port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        updateFdbCount(*port, 1);
+        updateFdbCount(*vlan, 1);
     }
 
     FdbData storeFdbData = fdbData;
-    storeFdbData.bridge_port_id = port.m_bridge_port_id;
+    storeFdbData.bridge_port_id = port->m_bridge_port_id;
 
-    m_entries[entry] = storeFdbData;
+    setFdbEntry(entry, storeFdbData);
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+    string key = getFdbStateKey(vlan->m_vlan_info.vlan_id, entry.mac);
 
     if (fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED)
     {
@@ -1142,10 +1464,10 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         // Write to StateDb
         std::vector<FieldValueTuple> fvs;
         fvs.push_back(FieldValueTuple("port", port_name));
-        if (fdbData.type == "dynamic_local")
+        if (fdbData.type == FDB_TYPE_DYNAMIC_LOCAL)
             fvs.push_back(FieldValueTuple("type", "dynamic"));
         else
-            fvs.push_back(FieldValueTuple("type", fdbData.type));
+            fvs.push_back(FieldValueTuple("type", getFdbTypeName(fdbData.type)));
         m_fdbStateTable.set(key, fvs);
     }
     else if (macUpdate && (oldOrigin != FDB_ORIGIN_VXLAN_ADVERTIZED))
@@ -1175,31 +1497,33 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
 
 bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
 {
-    Port vlan;
-    Port port;
+    Port *vlan;
+    Port *port;
 
     SWSS_LOG_ENTER();
 
     SWSS_LOG_INFO("FdbOrch RemoveFDBEntry: mac=%s bv_id=0x%" PRIx64 "origin %d", entry.mac.to_string().c_str(), entry.bv_id, origin);
 
-    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    vlan = m_portsOrch->getPortPtr(entry.bv_id);
+    if (vlan == nullptr)
     {
         SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port from bv_id 0x%" PRIx64, entry.bv_id);
         return false;
     }
 
-    auto it= m_entries.find(entry);
-    if (it == m_entries.end())
+    const FdbRecord *record = m_entries.find(entry);
+    if (record == nullptr)
     {
         SWSS_LOG_INFO("FdbOrch RemoveFDBEntry: FDB entry isn't found. mac=%s bv_id=0x%" PRIx64, entry.mac.to_string().c_str(), entry.bv_id);
 
         /* check whether the entry is in the saved fdb, if so delete it from there. */
-        deleteFdbEntryFromSavedFDB(entry.mac, vlan.m_vlan_info.vlan_id, origin);
+        deleteFdbEntryFromSavedFDB(entry.mac, vlan->m_vlan_info.vlan_id, origin);
         return true;
     }
 
-    FdbData fdbData = it->second;
-    if (!m_portsOrch->getPortByBridgePortId(fdbData.bridge_port_id, port))
+    FdbData fdbData = getFdbData(*record);
+    port = m_portsOrch->getPortPtrByBridgePortId(fdbData.bridge_port_id);
+    if (port == nullptr)
     {
         SWSS_LOG_NOTICE("FdbOrch RemoveFDBEntry: Failed to locate port from bridge_port_id 0x%" PRIx64, fdbData.bridge_port_id);
         return false;
@@ -1218,12 +1542,12 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         /* We may still have the mac in saved-fdb probably due to unavailability
          * of bridge-port. check whether the entry is in the saved fdb,
          * if so delete it from there. */
-        deleteFdbEntryFromSavedFDB(entry.mac, vlan.m_vlan_info.vlan_id, origin);
+        deleteFdbEntryFromSavedFDB(entry.mac, vlan->m_vlan_info.vlan_id, origin);
 
         return true;
     }
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+    string key = getFdbStateKey(vlan->m_vlan_info.vlan_id, entry.mac);
 
     sai_status_t status;
     sai_fdb_entry_t fdb_entry;
@@ -1244,17 +1568,212 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
     }
 
     SWSS_LOG_INFO("Removed mac=%s bv_id=0x%" PRIx64 " port:%s",
-            entry.mac.to_string().c_str(), entry.bv_id, port.m_alias.c_str());
+            entry.mac.to_string().c_str(), entry.bv_id, port->m_alias.c_str());
+
+    updateFdbCount(*port, -1);
+    updateFdbCount(*vlan, -1);
+    (void)eraseFdbEntry(entry);
+
+    // Remove in StateDb
+    if (fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED)
+    {
+        m_fdbStateTable.del(key);
+    }
+
+    gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
+
+    FdbUpdate update;
+    update.entry = entry;
+    update.port = port;
+    update.type = fdbData.type;
+    update.add = false;
+
+    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+
+    notifyTunnelOrch(update.port);
+
+    return true;
+}
+
+/*
+ * Queue the creation of a new FDB entry in the FDB bulker. MAC updates and
+ * entries waiting for their port or VLAN membership go through
+ * addFdbEntry(entry, port_name, fdbData) at once.
+ * Returns false while the entry is queued, see addFdbEntryPost()
+ */
+bool FdbOrch::addFdbEntry(FdbBulkContext& ctx, const string& port_name)
+{
+    SWSS_LOG_ENTER();
+
+    const FdbEntry& entry = ctx.entry;
+    const FdbData& fdbData = ctx.fdbData;
+
+    Port *vlan = m_portsOrch->getPortPtr(entry.bv_id);
+    Port *port = m_portsOrch->getPortPtr(port_name);
+    if (m_entries.find(entry) != nullptr ||
+        vlan == nullptr ||
+        port == nullptr ||
+        port->m_bridge_port_id == SAI_NULL_OBJECT_ID ||
+        vlan->m_members.find(port_name) == vlan->m_members.end())
+    {
+        return addFdbEntry(entry, port_name, fdbData);
+    }
+
+    SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", getFdbTypeName(fdbData.type), entry.mac.to_string().c_str(), vlan->m_alias.c_str(), port_name.c_str());
+
+    ctx.port = port;
+    ctx.fdb_entry.switch_id = gSwitchId;
+    memcpy(ctx.fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
+    ctx.fdb_entry.bv_id = entry.bv_id;
+
+    vector<sai_attribute_t> attrs;
+    getFdbEntryAttrs(fdbData, port->m_bridge_port_id, attrs);
+
+    gFdbBulker.create_entry(&ctx.object_status, &ctx.fdb_entry, (uint32_t)attrs.size(), attrs.data());
+    ctx.bulked = true;
+
+    return false;
+}
+
+bool FdbOrch::addFdbEntryPost(const FdbBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const FdbEntry& entry = ctx.entry;
+    const FdbData& fdbData = ctx.fdbData;
+    Port *port = ctx.port;
+
+    Port *vlan = m_portsOrch->getPortPtr(entry.bv_id);
+    if (vlan == nullptr || port == nullptr)
+    {
+        SWSS_LOG_ERROR("Failed to locate vlan 0x%" PRIx64 " or port of FDB %s",
+                entry.bv_id, entry.mac.to_string().c_str());
+        return false;
+    }
+
+    if (ctx.object_status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create %s FDB %s in %s on %s, rv:%d",
+                getFdbTypeName(fdbData.type), entry.mac.to_string().c_str(),
+                vlan->m_alias.c_str(), port->m_alias.c_str(), ctx.object_status);
+        task_process_status handle_status = handleSaiCreateStatus(SAI_API_FDB, ctx.object_status); //FIXME: it should be based on status. Some could be retried, some not
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+    updateFdbCount(*port, 1);
+    updateFdbCount(*vlan, 1);
+
+    FdbData storeFdbData = fdbData;
+    storeFdbData.bridge_port_id = port->m_bridge_port_id;
+
+    setFdbEntry(entry, storeFdbData);
+
+    if (fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED)
+    {
+        /* State-DB is updated only for Local Mac addresses */
+        string key = getFdbStateKey(vlan->m_vlan_info.vlan_id, entry.mac);
+
+        std::vector<FieldValueTuple> fvs;
+        fvs.push_back(FieldValueTuple("port", port->m_alias));
+        if (fdbData.type == FDB_TYPE_DYNAMIC_LOCAL)
+            fvs.push_back(FieldValueTuple("type", "dynamic"));
+        else
+            fvs.push_back(FieldValueTuple("type", getFdbTypeName(fdbData.type)));
+        m_fdbStateTable.set(key, fvs);
+    }
+
+    gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
+
+    FdbUpdate update;
+    update.entry = entry;
+    update.port = port;
+    update.type = fdbData.type;
+    update.add = true;
+
+    notify(SUBJECT_TYPE_FDB_CHANGE, &update);
+
+    return true;
+}
+
+/*
+ * Queue the removal of an FDB entry in the FDB bulker. Entries which are only
+ * saved or have another origin go through removeFdbEntry(entry, origin) at once.
+ * Returns false while the entry is queued, see removeFdbEntryPost()
+ */
+bool FdbOrch::removeFdbEntry(FdbBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const FdbEntry& entry = ctx.entry;
+
+    const FdbRecord *record = m_entries.find(entry);
+    if (record == nullptr ||
+        record->origin != ctx.origin ||
+        m_portsOrch->getPortPtr(entry.bv_id) == nullptr ||
+        m_portsOrch->getPortPtrByBridgePortId(record->bridge_port_id) == nullptr)
+    {
+        return removeFdbEntry(entry, ctx.origin);
+    }
+
+    SWSS_LOG_INFO("FdbOrch RemoveFDBEntry: mac=%s bv_id=0x%" PRIx64 "origin %d", entry.mac.to_string().c_str(), entry.bv_id, ctx.origin);
+
+    ctx.fdb_entry.switch_id = gSwitchId;
+    memcpy(ctx.fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
+    ctx.fdb_entry.bv_id = entry.bv_id;
+
+    gFdbBulker.remove_entry(&ctx.object_status, &ctx.fdb_entry);
+    ctx.bulked = true;
+
+    return false;
+}
+
+bool FdbOrch::removeFdbEntryPost(const FdbBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const FdbEntry& entry = ctx.entry;
+
+    /* A failed removal keeps the entry and the task, for retry */
+    if (ctx.object_status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("FdbOrch RemoveFDBEntry: Failed to remove FDB entry. mac=%s, bv_id=0x%" PRIx64,
+                       entry.mac.to_string().c_str(), entry.bv_id);
+        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_FDB, ctx.object_status); //FIXME: it should be based on status. Some could be retried. some not
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+
+    const FdbRecord *record = m_entries.find(entry);
+    if (record == nullptr)
+    {
+        return true;
+    }
+    FdbData fdbData = getFdbData(*record);
+
+    Port *vlan = m_portsOrch->getPortPtr(entry.bv_id);
+    Port *port = m_portsOrch->getPortPtrByBridgePortId(fdbData.bridge_port_id);
+    if (vlan == nullptr || port == nullptr)
+    {
+        SWSS_LOG_NOTICE("FdbOrch RemoveFDBEntry: Failed to locate vlan 0x%" PRIx64 " or port from bridge_port_id 0x%" PRIx64,
+                entry.bv_id, fdbData.bridge_port_id);
+        return false;
+    }
+
+    SWSS_LOG_INFO("Removed mac=%s bv_id=0x%" PRIx64 " port:%s",
+            entry.mac.to_string().c_str(), entry.bv_id, port->m_alias.c_str());
 
-    port.m_fdb_count--;
-    m_portsOrch->setPort(port.m_alias, port);
-    vlan.m_fdb_count--;
-    m_portsOrch->setPort(vlan.m_alias, vlan);
-    (void)m_entries.erase(entry);
+    updateFdbCount(*port, -1);
+    updateFdbCount(*vlan, -1);
+    (void)eraseFdbEntry(entry);
 
     // Remove in StateDb
     if (fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED)
     {
+        string key = getFdbStateKey(vlan->m_vlan_info.vlan_id, entry.mac);
         m_fdbStateTable.del(key);
     }
 
@@ -1280,7 +1799,7 @@ void FdbOrch::deleteFdbEntryFromSavedFDB(const MacAddress &mac,
     SavedFdbEntry entry;
     entry.mac = mac;
     entry.vlanId = vlanId;
-    entry.fdbData.type = "static";
+    entry.fdbData.type = FDB_TYPE_STATIC;
     /* Below members are unused during delete compare */
     entry.fdbData.origin = origin;
 
@@ -1322,14 +1841,22 @@ void FdbOrch::deleteFdbEntryFromSavedFDB(const MacAddress &mac,
 }
 
 // Notify Tunnel Orch when the number of MAC entries
-void FdbOrch::notifyTunnelOrch(Port& port)
+void FdbOrch::notifyTunnelOrch(Port* port)
 {
     VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
 
-    if((port.m_type != Port::TUNNEL) ||
-       (port.m_fdb_count != 0))
+    if((port == nullptr) ||
+       (port->m_type != Port::TUNNEL) ||
+       (port->m_fdb_count != 0))
       return;
 
-    tunnel_orch->deleteTunnelPort(port);
+    /* Deleting the tunnel port erases it from the port list, the changes of a batch point to it until notified */
+    if (m_batchUpdate != nullptr)
+    {
+        m_batchTunnelPorts.insert(port->m_alias);
+        return;
+    }
+
+    tunnel_orch->deleteTunnelPort(*port);
 }
 
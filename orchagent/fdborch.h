@@ -1,9 +1,17 @@
 #ifndef SWSS_FDBORCH_H
 #define SWSS_FDBORCH_H
 
+#include <functional>
+
 #include "orch.h"
+#include "ipaddress.h"
+#include "redispipeline.h"
 #include "observer.h"
 #include "portsorch.h"
+#include "bulker.h"
+#include "fdbindex.h"
+#include "fdbtable.h"
+#include "fdbevents.h"
 
 enum FdbOrigin
 {
@@ -13,11 +21,17 @@ enum FdbOrigin
     FDB_ORIGIN_VXLAN_ADVERTIZED = 4
 };
 
+enum FdbType : uint8_t
+{
+    FDB_TYPE_DYNAMIC = 0,
+    FDB_TYPE_STATIC = 1,
+    FDB_TYPE_DYNAMIC_LOCAL = 2
+};
+
 struct FdbEntry
 {
     MacAddress mac;
     sai_object_id_t bv_id;
-    std::string port_name;
 
     bool operator<(const FdbEntry& other) const
     {
@@ -29,14 +43,21 @@ struct FdbEntry
     }
 };
 
+/* port points into the PortsOrch port list, it is null when the port of a removed entry is unknown */
 struct FdbUpdate
 {
     FdbEntry entry;
-    Port port;
-    string type;
+    Port *port = nullptr;
+    FdbType type = FDB_TYPE_DYNAMIC;
     bool add;
 };
 
+/* Changes of the FDB events drained at once, see SUBJECT_TYPE_FDB_BATCH_CHANGE */
+struct FdbBatchUpdate
+{
+    vector<FdbUpdate> updates;
+};
+
 struct FdbFlushUpdate
 {
     vector<FdbEntry> entries;
@@ -45,9 +66,9 @@ struct FdbFlushUpdate
 
 struct FdbData
 {
-    sai_object_id_t bridge_port_id;
-    string type;
-    FdbOrigin origin;
+    sai_object_id_t bridge_port_id = SAI_NULL_OBJECT_ID;
+    FdbType type = FDB_TYPE_DYNAMIC;
+    FdbOrigin origin = FDB_ORIGIN_INVALID;
     /**
       {"dynamic", FDB_ORIGIN_LEARN} => dynamically learnt
       {"dynamic", FDB_ORIGIN_PROVISIONED} => provisioned dynamic with swssconfig in APPDB
@@ -57,10 +78,10 @@ struct FdbData
       {"static", FDB_ORIGIN_ADVERTIZED} => sticky synced from remote device
     */
 
-    /* Remote FDB related info */
-    string remote_ip;
-    string    esi;
-    unsigned int vni;
+    /* Remote FDB related info, zero for a local MAC */
+    IpAddress remote_ip = 0x0;
+    FdbEsi esi = {};
+    unsigned int vni = 0;
 };
 
 struct SavedFdbEntry
@@ -76,6 +97,46 @@ struct SavedFdbEntry
 
 typedef unordered_map<string, vector<SavedFdbEntry>> fdb_entries_by_port_t;
 
+/*
+ * FdbData as kept in FdbOrch::m_entries for each MAC, with the origin coded
+ * on a byte, and the remote VTEP and the ESI as ids in the pools of values
+ * shared by the entries. index is the position of the MAC in the lists of
+ * FdbOrch::m_entriesIndex.
+ */
+struct FdbRecord
+{
+    sai_object_id_t bridge_port_id;
+    uint32_t vni;
+    uint32_t remote_ip;
+    uint32_t esi;
+    FdbType type;
+    uint8_t origin;
+    FdbIndex<FdbKey>::Position index;
+};
+
+struct FdbBulkContext
+{
+    FdbEntry            entry;
+    FdbData             fdbData;
+    Port               *port;               // Port of a bulked creation, in the PortsOrch port list
+    FdbOrigin           origin;             // Origin of a removal
+    sai_fdb_entry_t     fdb_entry;
+    sai_status_t        object_status;      // Bulk create or remove status
+    bool                bulked;             // Queued in the FDB bulker
+
+    FdbBulkContext()
+        : port(nullptr),
+          origin(FDB_ORIGIN_INVALID),
+          object_status(SAI_STATUS_NOT_EXECUTED),
+          bulked(false)
+    {
+    }
+
+    // Disable any copy constructors
+    FdbBulkContext(const FdbBulkContext&) = delete;
+    FdbBulkContext(FdbBulkContext&&) = delete;
+};
+
 class FdbOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -101,24 +162,51 @@ public:
 
 private:
     PortsOrch *m_portsOrch;
-    map<FdbEntry, FdbData> m_entries;
+    FdbTable<FdbRecord> m_entries;
+    FdbIndex<FdbKey> m_entriesIndex;
+    FdbValuePool<IpAddress> m_entriesRemotes;
+    FdbValuePool<FdbEsi> m_entriesEsis;
     fdb_entries_by_port_t saved_fdb_entries;
     vector<Table*> m_appTables;
-    Table m_fdbStateTable;
+    swss::RedisPipeline m_fdbStatePipeline;
+    Table m_fdbStateTable;      // Buffered, flushed at the end of each task
     NotificationConsumer* m_flushNotificationsConsumer;
     NotificationConsumer* m_fdbNotificationConsumer;
 
+    EntityBulker<sai_fdb_api_t> gFdbBulker;
+
+    FdbEventCoalescer m_fdbEvents;
+    FdbBatchUpdate *m_batchUpdate = nullptr;    // Set while applying coalesced events
+    set<string> m_batchTunnelPorts;             // Tunnel ports to delete once the batch is notified
+
     void doTask(Consumer& consumer);
     void doTask(NotificationConsumer& consumer);
 
+    void updateFdbEvents(vector<FdbEvent>&);
+    void notifyFdbChange(FdbUpdate&);
+    void updateFdbCount(Port&, int);
+    void removeFlushedEntries(const vector<FdbKey>&, FdbUpdate&);
+    void addFlushRequest(const string&, const string&, FdbFlushRequests&);
+
     void updateVlanMember(const VlanMemberUpdate&);
     void updatePortOperState(const PortOperStateUpdate&);
 
     bool addFdbEntry(const FdbEntry&, const string&, FdbData fdbData);
+    bool addFdbEntry(FdbBulkContext&, const string&);
+    bool addFdbEntryPost(const FdbBulkContext&);
+    bool removeFdbEntry(FdbBulkContext&);
+    bool removeFdbEntryPost(const FdbBulkContext&);
+    void getFdbEntryAttrs(const FdbData&, sai_object_id_t, vector<sai_attribute_t>&);
     void deleteFdbEntryFromSavedFDB(const MacAddress &mac, const unsigned short &vlanId, FdbOrigin origin, const string portName="");
 
+    void setFdbEntry(const FdbEntry&, const FdbData&);
+    size_t eraseFdbEntry(const FdbEntry&);
+    function<FdbIndex<FdbKey>::Position &(const FdbKey &)> locateFdbIndex();
+    function<sai_object_id_t(const FdbKey &)> bridgePortOf() const;
+    FdbData getFdbData(const FdbRecord&) const;
+
     bool storeFdbEntryState(const FdbUpdate& update);
-    void notifyTunnelOrch(Port& port);
+    void notifyTunnelOrch(Port* port);
 };
 
 #endif /* SWSS_FDBORCH_H */
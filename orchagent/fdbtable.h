@@ -0,0 +1,350 @@
+#ifndef SWSS_FDBTABLE_H
+#define SWSS_FDBTABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <string>
+#include <algorithm>
+#include <tuple>
+#include <vector>
+#include <map>
+
+#include "macaddress.h"
+
+/* Key of an FDB entry, the MAC in a VLAN or bridge */
+struct FdbKey
+{
+    swss::MacAddress mac;
+    uint64_t bv_id;
+
+    bool operator<(const FdbKey &other) const
+    {
+        return std::tie(mac, bv_id) < std::tie(other.mac, other.bv_id);
+    }
+    bool operator==(const FdbKey &other) const
+    {
+        return bv_id == other.bv_id && mac == other.mac;
+    }
+};
+
+/*
+ * Open addressing hash table of the FDB entries, keyed by MAC and bv_id.
+ *
+ * Slots hold the key and the value inline, with linear probing and backward
+ * shift deletion, so an entry takes no allocation of its own and lookups
+ * touch one or two cache lines. Keys are given as any type with mac and bv_id
+ * members, such as FdbEntry. Pointers to values are invalidated by set() and
+ * erase().
+ */
+template <typename Value>
+class FdbTable
+{
+public:
+    template <typename K>
+    Value *find(const K &entry)
+    {
+        size_t pos = 0;
+        return lookup(FdbKey{ entry.mac, entry.bv_id }, pos) ? &m_slots[pos].value : nullptr;
+    }
+
+    template <typename K>
+    const Value *find(const K &entry) const
+    {
+        size_t pos = 0;
+        return lookup(FdbKey{ entry.mac, entry.bv_id }, pos) ? &m_slots[pos].value : nullptr;
+    }
+
+    /* Adds the entry or updates its value, returns the stored value */
+    template <typename K>
+    Value &set(const K &entry, const Value &value)
+    {
+        if ((m_size + 1) * 4 > m_slots.size() * 3)
+        {
+            grow();
+        }
+
+        FdbKey key{ entry.mac, entry.bv_id };
+        size_t pos = 0;
+        if (!lookup(key, pos))
+        {
+            m_slots[pos].key = key;
+            m_used[pos] = 1;
+            m_size++;
+        }
+        m_slots[pos].value = value;
+        return m_slots[pos].value;
+    }
+
+    template <typename K>
+    bool erase(const K &entry)
+    {
+        size_t pos = 0;
+        if (!lookup(FdbKey{ entry.mac, entry.bv_id }, pos))
+        {
+            return false;
+        }
+
+        /* Moves back the following entries which would not be found past the hole */
+        size_t mask = m_slots.size() - 1;
+        size_t next = pos;
+        while (true)
+        {
+            next = (next + 1) & mask;
+            if (!m_used[next])
+            {
+                break;
+            }
+
+            size_t home = hash(m_slots[next].key) & mask;
+            if (((next - home) & mask) >= ((next - pos) & mask))
+            {
+                m_slots[pos] = m_slots[next];
+                pos = next;
+            }
+        }
+        m_used[pos] = 0;
+        m_size--;
+        return true;
+    }
+
+    /* Keys of all the entries, which can be erased while going through them */
+    std::vector<FdbKey> keys() const
+    {
+        std::vector<FdbKey> keys;
+        keys.reserve(m_size);
+        for (size_t i = 0; i < m_slots.size(); i++)
+        {
+            if (m_used[i])
+            {
+                keys.push_back(m_slots[i].key);
+            }
+        }
+        return keys;
+    }
+
+    /* Removes all the entries, keeping the slots allocated */
+    void clear()
+    {
+        std::fill(m_used.begin(), m_used.end(), 0);
+        m_size = 0;
+    }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    size_t memoryUsage() const
+    {
+        return m_slots.capacity() * sizeof(Slot) + m_used.capacity();
+    }
+
+private:
+    struct Slot
+    {
+        FdbKey key;
+        Value value;
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<uint8_t> m_used;
+    size_t m_size = 0;
+
+    static size_t hash(const FdbKey &key)
+    {
+        uint64_t mac = 0;
+        memcpy(&mac, key.mac.getMac(), 6);
+
+        /* splitmix64 finalizer */
+        uint64_t h = mac ^ (key.bv_id * 0x9e3779b97f4a7c15ULL);
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<size_t>(h ^ (h >> 31));
+    }
+
+    /* Position of the key if found, else of the empty slot ending its probe */
+    bool lookup(const FdbKey &key, size_t &pos) const
+    {
+        if (m_slots.empty())
+        {
+            return false;
+        }
+
+        size_t mask = m_slots.size() - 1;
+        for (pos = hash(key) & mask; m_used[pos]; pos = (pos + 1) & mask)
+        {
+            if (m_slots[pos].key == key)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void grow()
+    {
+        std::vector<Slot> slots(m_slots.empty() ? 64 : m_slots.size() * 2);
+        std::vector<uint8_t> used(slots.size(), 0);
+        size_t mask = slots.size() - 1;
+
+        for (size_t i = 0; i < m_slots.size(); i++)
+        {
+            if (!m_used[i])
+            {
+                continue;
+            }
+
+            size_t pos = hash(m_slots[i].key) & mask;
+            while (used[pos])
+            {
+                pos = (pos + 1) & mask;
+            }
+            slots[pos] = m_slots[i];
+            used[pos] = 1;
+        }
+
+        m_slots.swap(slots);
+        m_used.swap(used);
+    }
+};
+
+/* Ethernet Segment Identifier of an EVPN multihomed MAC, all zero when single homed */
+struct FdbEsi
+{
+    uint8_t bytes[10];
+
+    /* Parses the "xx:xx:xx:xx:xx:xx:xx:xx:xx:xx" form, esi is left zero if invalid */
+    static bool parse(const std::string &str, FdbEsi &esi)
+    {
+        FdbEsi parsed = {};
+        if (str.size() != sizeof(parsed.bytes) * 3 - 1)
+        {
+            esi = {};
+            return false;
+        }
+
+        for (size_t i = 0; i < sizeof(parsed.bytes); i++)
+        {
+            int high = hexDigit(str[i * 3]);
+            int low = hexDigit(str[i * 3 + 1]);
+            if (high < 0 || low < 0 || (i + 1 < sizeof(parsed.bytes) && str[i * 3 + 2] != ':'))
+            {
+                esi = {};
+                return false;
+            }
+            parsed.bytes[i] = static_cast<uint8_t>(high << 4 | low);
+        }
+
+        esi = parsed;
+        return true;
+    }
+
+    bool operator<(const FdbEsi &other) const
+    {
+        return memcmp(bytes, other.bytes, sizeof(bytes)) < 0;
+    }
+    bool operator==(const FdbEsi &other) const
+    {
+        return memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+    }
+
+private:
+    static int hexDigit(char c)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f')
+        {
+            return c - 'a' + 10;
+        }
+        if (c >= 'A' && c <= 'F')
+        {
+            return c - 'A' + 10;
+        }
+        return -1;
+    }
+};
+
+/*
+ * Values shared by many FDB entries, such as the remote VTEP or the ESI of
+ * EVPN MACs, stored once and referred to by id. Id 0 is the none value given
+ * to the constructor.
+ */
+template <typename Value>
+class FdbValuePool
+{
+public:
+    explicit FdbValuePool(const Value &none) : m_values(1, none), m_refs(1) { }
+
+    /* Takes a reference on the value */
+    uint32_t add(const Value &value)
+    {
+        if (value == m_values[0])
+        {
+            return 0;
+        }
+
+        auto it = m_ids.find(value);
+        if (it != m_ids.end())
+        {
+            m_refs[it->second]++;
+            return it->second;
+        }
+
+        uint32_t id;
+        if (m_free.empty())
+        {
+            id = static_cast<uint32_t>(m_values.size());
+            m_values.push_back(value);
+            m_refs.push_back(1);
+        }
+        else
+        {
+            id = m_free.back();
+            m_free.pop_back();
+            m_values[id] = value;
+            m_refs[id] = 1;
+        }
+        m_ids[value] = id;
+        return id;
+    }
+
+    /* Drops a reference taken by add() */
+    void release(uint32_t id)
+    {
+        if (id == 0 || id >= m_refs.size() || m_refs[id] == 0 || --m_refs[id])
+        {
+            return;
+        }
+
+        m_ids.erase(m_values[id]);
+        m_values[id] = m_values[0];
+        m_free.push_back(id);
+    }
+
+    const Value &get(uint32_t id) const
+    {
+        return id < m_values.size() ? m_values[id] : m_values[0];
+    }
+
+    size_t size() const { return m_ids.size(); }
+
+    /* Counts each node of m_ids with a header of four words */
+    size_t memoryUsage() const
+    {
+        return m_values.capacity() * sizeof(Value) +
+               (m_refs.capacity() + m_free.capacity()) * sizeof(uint32_t) +
+               m_ids.size() * (sizeof(typename Ids::value_type) + 4 * sizeof(void *));
+    }
+
+private:
+    typedef std::map<Value, uint32_t> Ids;
+
+    std::vector<Value> m_values;
+    std::vector<uint32_t> m_refs;
+    std::vector<uint32_t> m_free;
+    Ids m_ids;
+};
+
+#endif /* SWSS_FDBTABLE_H */
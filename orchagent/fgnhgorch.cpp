@@ -1028,7 +1028,7 @@ bool FgNhgOrch::isRouteFineGrained(sai_object_id_t vrf_id, const IpPrefix &ipPre
     }
 
     FgNhgEntry *fgNhgEntry = 0;
-    set<NextHopKey> next_hop_set = nextHops.getNextHops();
+    auto next_hop_set = nextHops.getNextHops();
     auto prefix_entry = m_fgNhgPrefixes.find(ipPrefix);
     if (prefix_entry == m_fgNhgPrefixes.end())
     {
@@ -1098,7 +1098,7 @@ bool FgNhgOrch::setFgNhg(sai_object_id_t vrf_id, const IpPrefix &ipPrefix, const
      * when we return early with success */
     prevNhgWasFineGrained = true;
     FgNhgEntry *fgNhgEntry = 0;
-    set<NextHopKey> next_hop_set = nextHops.getNextHops();
+    auto next_hop_set = nextHops.getNextHops();
     auto prefix_entry = m_fgNhgPrefixes.find(ipPrefix);
     if (prefix_entry != m_fgNhgPrefixes.end())
     {
@@ -1337,7 +1337,7 @@ vector<FieldValueTuple> FgNhgOrch::generateRouteTableFromNhgKey(NextHopGroupKey
 {
     SWSS_LOG_ENTER();
     vector<FieldValueTuple> fvVector;
-    std::set<NextHopKey> nhks = nhg.getNextHops();
+    auto nhks = nhg.getNextHops();
     string nexthops = nhks.begin()->ip_address.to_string();
     string ifnames = nhks.begin()->alias;
 
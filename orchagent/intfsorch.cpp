@@ -1099,6 +1099,9 @@ bool IntfsOrch::addRouterIntfs(sai_object_id_t vrf_id, Port &port)
 
     SWSS_LOG_NOTICE("Create router interface %s MTU %u", port.m_alias.c_str(), port.m_mtu);
 
+    /* Neighbors and interface addresses may wait for the router interface */
+    Orch::wakeRetries();
+
     if(gMySwitchType == "voq")
     {
         // Sync the interface of local port/LAG to the SYSTEM_INTERFACE table of CHASSIS_APP_DB
@@ -29,6 +29,7 @@ extern "C" {
 #include <signal.h>
 #include "warm_restart.h"
 #include "gearboxutils.h"
+#include "recorder.h"
 
 using namespace std;
 using namespace swss;
@@ -55,14 +56,12 @@ bool gSwssRecord = true;
 bool gLogRotate = false;
 bool gSaiRedisLogRotate = false;
 bool gSyncMode = false;
+bool gOrchWorkers = false;
 sai_redis_communication_mode_t gRedisCommunicationMode = SAI_REDIS_COMMUNICATION_MODE_REDIS_ASYNC;
 string gAsicInstance;
 
 extern bool gIsNatSupported;
 
-ofstream gRecordOfs;
-string gRecordFile;
-
 string gMySwitchType = "";
 int32_t gVoqMySwitchId = -1;
 int32_t gVoqMaxCores = 0;
@@ -72,7 +71,7 @@ string gMyAsicName = "";
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-R record_format] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-w] [-t]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    0: do not record logs" << endl;
@@ -85,7 +84,10 @@ void usage()
     cout << "    -i INST_ID: set the ASIC instance_id in multi-asic platform" << endl;
     cout << "    -s: enable synchronous mode (deprecated, use -z)" << endl;
     cout << "    -z: redis communication mode (redis_async|redis_sync|zmq_sync), default: redis_async" << endl;
-    cout << "    -f swss_rec_filename: swss record log filename(default 'swss.rec')" << endl;
+    cout << "    -w: run orchs independent from the route pipeline on worker threads" << endl;
+    cout << "    -t: publish per table task statistics to STATE_DB ORCH_TASK_STATS_TABLE" << endl;
+    cout << "    -f swss_rec_filename: swss record log filename(default 'swss.rec', 'swss.bin.rec' for binary)" << endl;
+    cout << "    -R record_format: swss record log format (text|binary), default: text" << endl;
     cout << "    -j sairedis_rec_filename: sairedis record log filename(default sairedis.rec)" << endl;
 }
 
@@ -316,10 +318,11 @@ int main(int argc, char **argv)
     sai_status_t status;
 
     string record_location = ".";
-    string swss_rec_filename = "swss.rec";
+    string swss_rec_filename;
+    auto swss_rec_format = SwssRecorder::TEXT;
     string sairedis_rec_filename = "sairedis.rec";
 
-    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hswtz:R:")) != -1)
     {
         switch (opt)
         {
@@ -381,6 +384,14 @@ int main(int argc, char **argv)
             gSyncMode = true;
             SWSS_LOG_NOTICE("Enabling synchronous mode");
             break;
+        case 'w':
+            gOrchWorkers = true;
+            SWSS_LOG_NOTICE("Enabling orch worker threads");
+            break;
+        case 't':
+            Orch::enableTaskStats(true);
+            SWSS_LOG_NOTICE("Enabling orch task statistics");
+            break;
         case 'z':
             sai_deserialize_redis_communication_mode(optarg, gRedisCommunicationMode);
             break;
@@ -391,6 +402,21 @@ int main(int argc, char **argv)
                 swss_rec_filename = optarg;
             }
             break;
+        case 'R':
+            if (!strcmp(optarg, "text"))
+            {
+                swss_rec_format = SwssRecorder::TEXT;
+            }
+            else if (!strcmp(optarg, "binary"))
+            {
+                swss_rec_format = SwssRecorder::BINARY;
+            }
+            else
+            {
+                usage();
+                exit(EXIT_FAILURE);
+            }
+            break;
         case 'j':
             if (optarg)
             {
@@ -420,14 +446,17 @@ int main(int argc, char **argv)
     /* Disable/enable SwSS recording */
     if (gSwssRecord)
     {
-        gRecordFile = record_location + "/" + swss_rec_filename;
-        gRecordOfs.open(gRecordFile, std::ofstream::out | std::ofstream::app);
-        if (!gRecordOfs.is_open())
+        if (swss_rec_filename.empty())
+        {
+            swss_rec_filename = swss_rec_format == SwssRecorder::BINARY ? "swss.bin.rec" : "swss.rec";
+        }
+
+        auto &recorder = SwssRecorder::getInstance();
+        if (!recorder.open(record_location + "/" + swss_rec_filename, swss_rec_format))
         {
-            SWSS_LOG_ERROR("Failed to open SwSS recording file %s", gRecordFile.c_str());
             exit(EXIT_FAILURE);
         }
-        gRecordOfs << getTimestamp() << "|recording started" << endl;
+        recorder.recordText("recording started");
     }
 
     attr.id = SAI_SWITCH_ATTR_PORT_STATE_CHANGE_NOTIFY;
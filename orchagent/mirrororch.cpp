@@ -1,5 +1,6 @@
 #include <linux/if_ether.h>
 
+#include <set>
 #include <unordered_map>
 #include <utility>
 #include <exception>
@@ -157,6 +158,12 @@ void MirrorOrch::update(SubjectType type, void *cntx)
         updateFdb(*update);
         break;
     }
+    case SUBJECT_TYPE_FDB_BATCH_CHANGE:
+    {
+        FdbBatchUpdate *update = static_cast<FdbBatchUpdate *>(cntx);
+        updateFdb(*update);
+        break;
+    }
     case SUBJECT_TYPE_LAG_MEMBER_CHANGE:
     {
         LagMemberUpdate *update = static_cast<LagMemberUpdate *>(cntx);
@@ -1281,7 +1288,7 @@ void MirrorOrch::updateFdb(const FdbUpdate& update)
         }
 
         SWSS_LOG_NOTICE("Updating mirror session %s with monitor port %s",
-                name.c_str(), update.port.m_alias.c_str());
+                name.c_str(), (update.port != nullptr) ? update.port->m_alias.c_str() : "-");
 
         // Get the new monitor port
         if (update.add)
@@ -1289,16 +1296,16 @@ void MirrorOrch::updateFdb(const FdbUpdate& update)
             if (session.status)
             {
                 // Update port if changed
-                if (session.neighborInfo.portId != update.port.m_port_id)
+                if (session.neighborInfo.portId != update.port->m_port_id)
                 {
-                    session.neighborInfo.portId = update.port.m_port_id;
+                    session.neighborInfo.portId = update.port->m_port_id;
                     updateSessionDstPort(name, session);
                 }
             }
             else
             {
                 // Activate session
-                session.neighborInfo.portId = update.port.m_port_id;
+                session.neighborInfo.portId = update.port->m_port_id;
                 activateSession(name, session);
             }
         }
@@ -1311,6 +1318,37 @@ void MirrorOrch::updateFdb(const FdbUpdate& update)
     }
 }
 
+// The function is called when SUBJECT_TYPE_FDB_BATCH_CHANGE is received.
+// Only the updates of the MACs of the sessions pointing to a VLAN are handled,
+// in order, instead of going through the sessions for each update.
+void MirrorOrch::updateFdb(const FdbBatchUpdate& batch)
+{
+    SWSS_LOG_ENTER();
+
+    set<pair<sai_object_id_t, MacAddress>> neighbors;
+    for (const auto& it: m_syncdMirrors)
+    {
+        const auto& session = it.second;
+        if (session.neighborInfo.port.m_type == Port::VLAN)
+        {
+            neighbors.emplace(session.neighborInfo.port.m_vlan_info.vlan_oid, session.neighborInfo.mac);
+        }
+    }
+
+    if (neighbors.empty())
+    {
+        return;
+    }
+
+    for (const auto& update: batch.updates)
+    {
+        if (neighbors.count(make_pair(update.entry.bv_id, update.entry.mac)))
+        {
+            updateFdb(update);
+        }
+    }
+}
+
 void MirrorOrch::updateLagMember(const LagMemberUpdate& update)
 {
     SWSS_LOG_ENTER();
@@ -124,6 +124,7 @@ private:
     void updateNextHop(const NextHopUpdate&);
     void updateNeighbor(const NeighborUpdate&);
     void updateFdb(const FdbUpdate&);
+    void updateFdb(const FdbBatchUpdate&);
     void updateLagMember(const LagMemberUpdate&);
     void updateVlanMember(const VlanMemberUpdate&);
 
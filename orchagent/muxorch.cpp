@@ -1,10 +1,12 @@
 #include <cassert>
 #include <string>
 #include <vector>
+#include <map>
 #include <unordered_map>
 #include <unordered_set>
 #include <stdexcept>
 #include <inttypes.h>
+#include <chrono>
 
 #include "sai.h"
 #include "ipaddress.h"
@@ -20,6 +22,7 @@
 #include "aclorch.h"
 #include "routeorch.h"
 #include "fdborch.h"
+#include "timestamp.h"
 
 /* Global variables */
 extern Directory<Orch*> gDirectory;
@@ -44,6 +47,7 @@ extern sai_router_interface_api_t* sai_router_intfs_api;
 #define MUX_ACL_RULE_NAME "mux_acl_rule"
 #define MUX_HW_STATE_UNKNOWN "unknown"
 #define MUX_HW_STATE_ERROR "error"
+#define MUX_METRICS_TABLE_NAME "MUX_METRICS_TABLE"
 
 const map<std::pair<MuxState, MuxState>, MuxStateChange> muxStateTransition =
 {
@@ -89,13 +93,15 @@ static inline MuxStateChange mux_state_change (MuxState prev, MuxState curr)
     return MuxStateChange::MUX_STATE_UNKNOWN_STATE;
 }
 
-static sai_status_t create_route(IpPrefix &pfx, sai_object_id_t nh)
+/*
+ * Tunnel routes of the neighbors of a MUX cable, created and removed with
+ * one bulk call per switchover. Returns the status of each route.
+ */
+static void create_routes(const vector<IpPrefix> &pfxs, sai_object_id_t nh, vector<sai_status_t> &statuses)
 {
-    sai_route_entry_t route_entry;
-    route_entry.switch_id = gSwitchId;
-    route_entry.vr_id = gVirtualRouterId;
-    copy(route_entry.destination, pfx);
-    subnet(route_entry.destination, route_entry.destination);
+    EntityBulker<sai_route_api_t> bulker(sai_route_api);
+    vector<sai_route_entry_t> route_entries(pfxs.size());
+    statuses.assign(pfxs.size(), SAI_STATUS_NOT_EXECUTED);
 
     sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
@@ -108,54 +114,90 @@ static sai_status_t create_route(IpPrefix &pfx, sai_object_id_t nh)
     attr.value.oid = nh;
     attrs.push_back(attr);
 
-    sai_status_t status = sai_route_api->create_route_entry(&route_entry, (uint32_t)attrs.size(), attrs.data());
-    if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < pfxs.size(); i++)
     {
-        SWSS_LOG_ERROR("Failed to create tunnel route %s,nh %" PRIx64 " rv:%d",
-                pfx.getIp().to_string().c_str(), nh, status);
-        return status;
-    }
+        route_entries[i].switch_id = gSwitchId;
+        route_entries[i].vr_id = gVirtualRouterId;
+        copy(route_entries[i].destination, pfxs[i]);
+        subnet(route_entries[i].destination, route_entries[i].destination);
 
-    if (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-    {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        bulker.create_entry(&statuses[i], &route_entries[i], (uint32_t)attrs.size(), attrs.data());
     }
-    else
+    bulker.flush();
+
+    for (size_t i = 0; i < pfxs.size(); i++)
     {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
-    }
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to create tunnel route %s,nh %" PRIx64 " rv:%d",
+                    pfxs[i].getIp().to_string().c_str(), nh, statuses[i]);
+            continue;
+        }
 
-    SWSS_LOG_NOTICE("Created tunnel route to %s ", pfx.to_string().c_str());
-    return status;
+        if (route_entries[i].destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        }
+        else
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
+        }
+
+        SWSS_LOG_NOTICE("Created tunnel route to %s ", pfxs[i].to_string().c_str());
+    }
 }
 
-static sai_status_t remove_route(IpPrefix &pfx)
+static void remove_routes(const vector<IpPrefix> &pfxs, vector<sai_status_t> &statuses)
 {
-    sai_route_entry_t route_entry;
-    route_entry.switch_id = gSwitchId;
-    route_entry.vr_id = gVirtualRouterId;
-    copy(route_entry.destination, pfx);
-    subnet(route_entry.destination, route_entry.destination);
+    EntityBulker<sai_route_api_t> bulker(sai_route_api);
+    vector<sai_route_entry_t> route_entries(pfxs.size());
+    statuses.assign(pfxs.size(), SAI_STATUS_NOT_EXECUTED);
 
-    sai_status_t status = sai_route_api->remove_route_entry(&route_entry);
-    if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < pfxs.size(); i++)
     {
-        SWSS_LOG_ERROR("Failed to remove tunnel route %s, rv:%d",
-                        pfx.getIp().to_string().c_str(), status);
-        return status;
-    }
+        route_entries[i].switch_id = gSwitchId;
+        route_entries[i].vr_id = gVirtualRouterId;
+        copy(route_entries[i].destination, pfxs[i]);
+        subnet(route_entries[i].destination, route_entries[i].destination);
 
-    if (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-    {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        bulker.remove_entry(&statuses[i], &route_entries[i]);
     }
-    else
+    bulker.flush();
+
+    for (size_t i = 0; i < pfxs.size(); i++)
     {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove tunnel route %s, rv:%d",
+                            pfxs[i].getIp().to_string().c_str(), statuses[i]);
+            continue;
+        }
+
+        if (route_entries[i].destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        }
+        else
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
+        }
+
+        SWSS_LOG_NOTICE("Removed tunnel route to %s ", pfxs[i].to_string().c_str());
     }
+}
+
+static sai_status_t create_route(IpPrefix &pfx, sai_object_id_t nh)
+{
+    vector<sai_status_t> statuses;
+    create_routes({ pfx }, nh, statuses);
+    return statuses[0];
+}
 
-    SWSS_LOG_NOTICE("Removed tunnel route to %s ", pfx.to_string().c_str());
-    return status;
+static sai_status_t remove_route(IpPrefix &pfx)
+{
+    vector<sai_status_t> statuses;
+    remove_routes({ pfx }, statuses);
+    return statuses[0];
 }
 
 static sai_object_id_t create_tunnel(const IpAddress* p_dst_ip, const IpAddress* p_src_ip)
@@ -410,6 +452,9 @@ void MuxCable::setState(string new_state)
 
     st_chg_in_progress_ = true;
 
+    string start_time = getTimestamp();
+    auto start = chrono::steady_clock::now();
+
     if (!(this->*(state_machine_handlers_[it->second]))())
     {
         //Reset back to original state
@@ -419,9 +464,12 @@ void MuxCable::setState(string new_state)
         throw std::runtime_error("Failed to handle state transition");
     }
 
+    auto usecs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    mux_state_orch_->updateMuxMetrics(mux_name_, new_state, start_time, usecs);
+
     st_chg_in_progress_ = false;
     st_chg_failed_ = false;
-    SWSS_LOG_INFO("Changed state to %s", new_state.c_str());
+    SWSS_LOG_INFO("Changed state to %s in %" PRId64 " us", new_state.c_str(), static_cast<int64_t>(usecs));
 
     return;
 }
@@ -546,132 +594,168 @@ void MuxNbrHandler::update(NextHopKey nh, sai_object_id_t tunnelId, bool add, Mu
     }
 }
 
+/*
+ * Switches all the neighbors of the cable at once: the neighbors, the routes
+ * through them, their next hop group members and their tunnel routes are
+ * each programmed with one bulk call for the whole cable.
+ */
 bool MuxNbrHandler::enable(bool update_rt)
 {
-    NeighborEntry neigh;
     MuxCableOrch* mux_cb_orch = gDirectory.get<MuxCableOrch*>();
+    vector<NeighborEntry> neighs;
+    vector<NextHopKey> nh_keys;
+    vector<IpPrefix> pfxs;
 
-    auto it = neighbors_.begin();
-    while (it != neighbors_.end())
+    for (const auto &it : neighbors_)
     {
-        SWSS_LOG_INFO("Enabling neigh %s on %s", it->first.to_string().c_str(), alias_.c_str());
+        SWSS_LOG_INFO("Enabling neigh %s on %s", it.first.to_string().c_str(), alias_.c_str());
 
-        neigh = NeighborEntry(it->first, alias_);
-        if (!gNeighOrch->enableNeighbor(neigh))
-        {
-            SWSS_LOG_INFO("Enabling neigh failed for %s", neigh.ip_address.to_string().c_str());
-            return false;
-        }
+        neighs.push_back(NeighborEntry(it.first, alias_));
+        nh_keys.push_back(NextHopKey(it.first, alias_));
+        pfxs.push_back(it.first.to_string());
+    }
 
-        /* Update NH to point to learned neighbor */
-        it->second = gNeighOrch->getLocalNextHopId(neigh);
+    if (!gNeighOrch->enableNeighbors(neighs))
+    {
+        SWSS_LOG_INFO("Enabling neighs failed for %s", alias_.c_str());
+        return false;
+    }
 
-        /* Reprogram route */
-        NextHopKey nh_key = NextHopKey(it->first, alias_);
-        uint32_t num_routes = 0;
-        if (!gRouteOrch->updateNextHopRoutes(nh_key, num_routes))
-        {
-            SWSS_LOG_INFO("Update route failed for NH %s", nh_key.ip_address.to_string().c_str());
-            return false;
-        }
+    /* Update NH to point to learned neighbor */
+    for (auto &it : neighbors_)
+    {
+        it.second = gNeighOrch->getLocalNextHopId(NextHopKey(it.first, alias_));
+    }
 
-        /* Increment ref count for new NHs */
-        gNeighOrch->increaseNextHopRefCount(nh_key, num_routes);
+    /* Reprogram routes, and increment ref count for new NHs */
+    map<NextHopKey, uint32_t> num_routes;
+    bool rc = gRouteOrch->updateNextHopRoutes(nh_keys, num_routes);
+    for (const auto &it : num_routes)
+    {
+        gNeighOrch->increaseNextHopRefCount(it.first, it.second);
+    }
+    if (!rc)
+    {
+        SWSS_LOG_INFO("Update route failed for neighs on %s", alias_.c_str());
+        return false;
+    }
 
-        /*
-         * Invalidate current nexthop group and update with new NH
-         * Ref count update is not required for tunnel NH IDs (nh_removed)
-         */
-        uint32_t nh_removed, nh_added;
-        if (!gRouteOrch->invalidnexthopinNextHopGroup(nh_key, nh_removed))
-        {
-            SWSS_LOG_ERROR("Removing existing NH failed for %s", nh_key.ip_address.to_string().c_str());
-            return false;
-        }
+    /*
+     * Invalidate current nexthop group and update with new NH
+     * Ref count update is not required for tunnel NH IDs (nh_removed)
+     */
+    map<NextHopKey, uint32_t> nh_removed, nh_added;
+    if (!gRouteOrch->invalidnexthopsinNextHopGroup(nh_keys, nh_removed))
+    {
+        SWSS_LOG_ERROR("Removing existing NH failed for neighs on %s", alias_.c_str());
+        return false;
+    }
 
-        if (!gRouteOrch->validnexthopinNextHopGroup(nh_key, nh_added))
-        {
-            SWSS_LOG_ERROR("Adding NH failed for %s", nh_key.ip_address.to_string().c_str());
-            return false;
-        }
+    /* Increment ref count for ECMP NH members */
+    rc = gRouteOrch->validnexthopsinNextHopGroup(nh_keys, nh_added);
+    for (const auto &it : nh_added)
+    {
+        gNeighOrch->increaseNextHopRefCount(it.first, it.second);
+    }
+    if (!rc)
+    {
+        SWSS_LOG_ERROR("Adding NH failed for neighs on %s", alias_.c_str());
+        return false;
+    }
 
-        /* Increment ref count for ECMP NH members */
-        gNeighOrch->increaseNextHopRefCount(nh_key, nh_added);
+    if (update_rt)
+    {
+        vector<sai_status_t> statuses;
+        remove_routes(pfxs, statuses);
 
-        IpPrefix pfx = it->first.to_string();
-        if (update_rt)
+        /* Routes removed are released even if others failed */
+        for (size_t i = 0; i < pfxs.size(); i++)
         {
-            if (remove_route(pfx) != SAI_STATUS_SUCCESS)
+            if (statuses[i] != SAI_STATUS_SUCCESS)
             {
-                return false;
+                rc = false;
+                continue;
             }
-            mux_cb_orch->removeTunnelRoute(nh_key);
+            mux_cb_orch->removeTunnelRoute(nh_keys[i]);
         }
-
-        it++;
     }
 
-    return true;
+    return rc;
 }
 
 bool MuxNbrHandler::disable(sai_object_id_t tnh)
 {
-    NeighborEntry neigh;
     MuxCableOrch* mux_cb_orch = gDirectory.get<MuxCableOrch*>();
+    vector<NeighborEntry> neighs;
+    vector<NextHopKey> nh_keys;
+    vector<IpPrefix> pfxs;
 
-    auto it = neighbors_.begin();
-    while (it != neighbors_.end())
+    for (auto &it : neighbors_)
     {
-        SWSS_LOG_INFO("Disabling neigh %s on %s", it->first.to_string().c_str(), alias_.c_str());
+        SWSS_LOG_INFO("Disabling neigh %s on %s", it.first.to_string().c_str(), alias_.c_str());
 
         /* Update NH to point to Tunnel nexhtop */
-        it->second = tnh;
+        it.second = tnh;
 
-        /* Reprogram route */
-        NextHopKey nh_key = NextHopKey(it->first, alias_);
-        uint32_t num_routes = 0;
-        if (!gRouteOrch->updateNextHopRoutes(nh_key, num_routes))
-        {
-            SWSS_LOG_INFO("Update route failed for NH %s", nh_key.ip_address.to_string().c_str());
-            return false;
-        }
+        neighs.push_back(NeighborEntry(it.first, alias_));
+        nh_keys.push_back(NextHopKey(it.first, alias_));
+        pfxs.push_back(it.first.to_string());
+    }
 
-        /* Decrement ref count for old NHs */
-        gNeighOrch->decreaseNextHopRefCount(nh_key, num_routes);
+    /* Reprogram routes, and decrement ref count for old NHs */
+    map<NextHopKey, uint32_t> num_routes;
+    bool rc = gRouteOrch->updateNextHopRoutes(nh_keys, num_routes);
+    for (const auto &it : num_routes)
+    {
+        gNeighOrch->decreaseNextHopRefCount(it.first, it.second);
+    }
+    if (!rc)
+    {
+        SWSS_LOG_INFO("Update route failed for neighs on %s", alias_.c_str());
+        return false;
+    }
 
-        /* Invalidate current nexthop group and update with new NH */
-        uint32_t nh_removed, nh_added;
-        if (!gRouteOrch->invalidnexthopinNextHopGroup(nh_key, nh_removed))
-        {
-            SWSS_LOG_ERROR("Removing existing NH failed for %s", nh_key.ip_address.to_string().c_str());
-            return false;
-        }
+    /* Invalidate current nexthop group and update with new NH */
+    map<NextHopKey, uint32_t> nh_removed, nh_added;
+    rc = gRouteOrch->invalidnexthopsinNextHopGroup(nh_keys, nh_removed);
 
-        /* Decrement ref count for ECMP NH members */
-        gNeighOrch->decreaseNextHopRefCount(nh_key, nh_removed);
+    /* Decrement ref count for ECMP NH members */
+    for (const auto &it : nh_removed)
+    {
+        gNeighOrch->decreaseNextHopRefCount(it.first, it.second);
+    }
+    if (!rc)
+    {
+        SWSS_LOG_ERROR("Removing existing NH failed for neighs on %s", alias_.c_str());
+        return false;
+    }
 
-        if (!gRouteOrch->validnexthopinNextHopGroup(nh_key, nh_added))
-        {
-            SWSS_LOG_ERROR("Adding NH failed for %s", nh_key.ip_address.to_string().c_str());
-            return false;
-        }
+    if (!gRouteOrch->validnexthopsinNextHopGroup(nh_keys, nh_added))
+    {
+        SWSS_LOG_ERROR("Adding NH failed for neighs on %s", alias_.c_str());
+        return false;
+    }
 
-        neigh = NeighborEntry(it->first, alias_);
-        if (!gNeighOrch->disableNeighbor(neigh))
-        {
-            SWSS_LOG_INFO("Disabling neigh failed for %s", neigh.ip_address.to_string().c_str());
-            return false;
-        }
+    if (!gNeighOrch->disableNeighbors(neighs))
+    {
+        SWSS_LOG_INFO("Disabling neighs failed for %s", alias_.c_str());
+        return false;
+    }
 
+    for (const auto &nh_key : nh_keys)
+    {
         mux_cb_orch->addTunnelRoute(nh_key);
+    }
+
+    vector<sai_status_t> statuses;
+    create_routes(pfxs, tnh, statuses);
 
-        IpPrefix pfx = it->first.to_string();
-        if (create_route(pfx, it->second) != SAI_STATUS_SUCCESS)
+    for (auto status : statuses)
+    {
+        if (status != SAI_STATUS_SUCCESS)
         {
             return false;
         }
-
-        it++;
     }
 
     return true;
@@ -955,7 +1039,6 @@ void MuxOrch::updateFdb(const FdbUpdate& update)
 
     NeighborEntry neigh;
     MacAddress mac;
-    MuxCable* ptr;
     for (auto nh = mux_nexthop_tb_.begin(); nh != mux_nexthop_tb_.end(); ++nh)
     {
         auto res = neigh_orch_->getNeighborEntry(nh->first, neigh, mac);
@@ -964,28 +1047,76 @@ void MuxOrch::updateFdb(const FdbUpdate& update)
             continue;
         }
 
-        if (nh->second != update.entry.port_name)
+        updateFdbPort(nh, update.port->m_alias);
+    }
+}
+
+/*
+ * Handles the updates of SUBJECT_TYPE_FDB_BATCH_CHANGE going through the mux
+ * neighbors once, with the last learn or move of each MAC
+ */
+void MuxOrch::updateFdb(const FdbBatchUpdate& batch)
+{
+    map<MacAddress, const FdbUpdate *> learnt;
+    for (const auto& update : batch.updates)
+    {
+        if (update.add)
         {
-            if (!nh->second.empty() && isMuxExists(nh->second))
-            {
-                ptr = getMuxCable(nh->second);
-                if (ptr->isIpInSubnet(nh->first.ip_address))
-                {
-                    continue;
-                }
-                nh->second = update.entry.port_name;
-                ptr->updateNeighbor(nh->first, false);
-            }
+            learnt[update.entry.mac] = &update;
+        }
+    }
 
-            if (isMuxExists(update.entry.port_name))
-            {
-                ptr = getMuxCable(update.entry.port_name);
-                ptr->updateNeighbor(nh->first, true);
-            }
+    if (learnt.empty())
+    {
+        return;
+    }
+
+    NeighborEntry neigh;
+    MacAddress mac;
+    for (auto nh = mux_nexthop_tb_.begin(); nh != mux_nexthop_tb_.end(); ++nh)
+    {
+        auto res = neigh_orch_->getNeighborEntry(nh->first, neigh, mac);
+        if (!res)
+        {
+            continue;
+        }
+
+        auto it = learnt.find(mac);
+        if (it != learnt.end())
+        {
+            updateFdbPort(nh, it->second->port->m_alias);
         }
     }
 }
 
+/* The MAC of the mux neighbor was learnt on port_name */
+void MuxOrch::updateFdbPort(NextHopTb::iterator nh, const string& port_name)
+{
+    MuxCable* ptr;
+
+    if (nh->second == port_name)
+    {
+        return;
+    }
+
+    if (!nh->second.empty() && isMuxExists(nh->second))
+    {
+        ptr = getMuxCable(nh->second);
+        if (ptr->isIpInSubnet(nh->first.ip_address))
+        {
+            return;
+        }
+        nh->second = port_name;
+        ptr->updateNeighbor(nh->first, false);
+    }
+
+    if (isMuxExists(port_name))
+    {
+        ptr = getMuxCable(port_name);
+        ptr->updateNeighbor(nh->first, true);
+    }
+}
+
 void MuxOrch::updateNeighbor(const NeighborUpdate& update)
 {
     if (mux_cable_tb_.empty())
@@ -1109,6 +1240,12 @@ void MuxOrch::update(SubjectType type, void *cntx)
             updateFdb(*update);
             break;
         }
+        case SUBJECT_TYPE_FDB_BATCH_CHANGE:
+        {
+            FdbBatchUpdate *update = static_cast<FdbBatchUpdate *>(cntx);
+            updateFdb(*update);
+            break;
+        }
         default:
             /* Received update in which we are not interested
              * Ignore it
@@ -1266,6 +1403,7 @@ MuxCableOrch::MuxCableOrch(DBConnector *db, const std::string& tableName):
               app_tunnel_route_table_(db, APP_TUNNEL_ROUTE_TABLE_NAME)
 {
     mux_table_ = unique_ptr<Table>(new Table(db, APP_HW_MUX_CABLE_TABLE_NAME));
+    getExecutor(tableName)->setLatencySensitiveSchedule();
 }
 
 void MuxCableOrch::updateMuxState(string portName, string muxState)
@@ -1347,9 +1485,27 @@ bool MuxCableOrch::delOperation(const Request& request)
 
 MuxStateOrch::MuxStateOrch(DBConnector *db, const std::string& tableName) :
               Orch2(db, tableName, request_),
-              mux_state_table_(db, STATE_MUX_CABLE_TABLE_NAME)
+              mux_state_table_(db, STATE_MUX_CABLE_TABLE_NAME),
+              mux_metrics_table_(db, MUX_METRICS_TABLE_NAME)
 {
      SWSS_LOG_ENTER();
+
+     getExecutor(tableName)->setLatencySensitiveSchedule();
+}
+
+/*
+ * Publishes the time taken by orchagent to switch the cable to the state:
+ * orch_switch_<state>_start and _end timestamps, and the latency in
+ * orch_switch_<state>_time_us.
+ */
+void MuxStateOrch::updateMuxMetrics(string portName, string muxState, string startTime, int64_t usecs)
+{
+    string prefix = "orch_switch_" + muxState;
+    vector<FieldValueTuple> tuples;
+    tuples.emplace_back(prefix + "_start", startTime);
+    tuples.emplace_back(prefix + "_end", getTimestamp());
+    tuples.emplace_back(prefix + "_time_us", to_string(usecs));
+    mux_metrics_table_.set(portName, tuples);
 }
 
 void MuxStateOrch::updateMuxState(string portName, string muxState)
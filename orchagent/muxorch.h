@@ -192,6 +192,8 @@ private:
 
     void updateNeighbor(const NeighborUpdate&);
     void updateFdb(const FdbUpdate&);
+    void updateFdb(const FdbBatchUpdate&);
+    void updateFdbPort(NextHopTb::iterator, const string&);
 
     bool getMuxPort(const MacAddress&, const string&, string&);
 
@@ -265,11 +267,13 @@ public:
     MuxStateOrch(DBConnector *db, const std::string& tableName);
 
     void updateMuxState(string portName, string muxState);
+    void updateMuxMetrics(string portName, string muxState, string startTime, int64_t usecs);
 
 private:
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
 
     swss::Table mux_state_table_;
+    swss::Table mux_metrics_table_;
     MuxStateRequest request_;
 };
@@ -27,10 +27,14 @@ NeighOrch::NeighOrch(DBConnector *appDb, string tableName, IntfsOrch *intfsOrch,
         m_intfsOrch(intfsOrch),
         m_fdbOrch(fdbOrch),
         m_portsOrch(portsOrch),
-        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME)
+        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME),
+        gNeighBulker(sai_neighbor_api),
+        gNextHopBulker(sai_next_hop_api, gSwitchId)
 {
     SWSS_LOG_ENTER();
 
+    getExecutor(tableName)->setBulkSchedule();
+
     m_fdbOrch->attach(this);
     
     if(gMySwitchType == "voq")
@@ -111,22 +115,22 @@ void NeighOrch::processFDBFlushUpdate(const FdbFlushUpdate& update)
     for (auto entry : update.entries)
     {
         // Get Vlan object
-        Port vlan;
-        if (!m_portsOrch->getPort(entry.bv_id, vlan))
+        Port *vlan = m_portsOrch->getPortPtr(entry.bv_id);
+        if (vlan == nullptr)
         {
             SWSS_LOG_NOTICE("FdbOrch notification: Failed to locate vlan port \
                              from bv_id 0x%" PRIx64 ".", entry.bv_id);
             continue;
         }
         SWSS_LOG_INFO("Flushing ARP for port: %s, VLAN: %s",
-                      vlan.m_alias.c_str(), update.port.m_alias.c_str());
+                      vlan->m_alias.c_str(), update.port.m_alias.c_str());
 
         // If the FDB entry MAC matches with neighbor/ARP entry MAC,
         // and ARP entry incoming interface matches with VLAN name,
         // flush neighbor/arp entry.
         for (const auto &neighborEntry : m_syncdNeighbors)
         {
-            if (neighborEntry.first.alias == vlan.m_alias &&
+            if (neighborEntry.first.alias == vlan->m_alias &&
                 neighborEntry.second.mac == entry.mac)
             {
                 resolveNeighborEntry(neighborEntry.first, neighborEntry.second.mac);
@@ -169,11 +173,9 @@ bool NeighOrch::hasNextHop(const NextHopKey &nexthop)
     return m_syncdNextHops.find(nexthop) != m_syncdNextHops.end();
 }
 
-bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias)
+/* Get the port whose oper status applies to the next hop of the neighbor */
+bool NeighOrch::getNextHopPort(const IpAddress &ipAddress, const string &alias, Port &p)
 {
-    SWSS_LOG_ENTER();
-
-    Port p;
     if (!gPortsOrch->getPort(alias, p))
     {
         SWSS_LOG_ERROR("Neighbor %s seen on port %s which doesn't exist",
@@ -189,6 +191,18 @@ bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias)
             return false;
         }
     }
+    return true;
+}
+
+bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias)
+{
+    SWSS_LOG_ENTER();
+
+    Port p;
+    if (!getNextHopPort(ipAddress, alias, p))
+    {
+        return false;
+    }
 
     NextHopKey nexthop = { ipAddress, alias };
     if(m_intfsOrch->isRemoteSystemPortIntf(alias))
@@ -231,6 +245,37 @@ bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias)
         }
     }
 
+    addNextHopPost(nexthop, alias, p, next_hop_id);
+    return true;
+}
+
+/* Queue the creation of the next hop of a neighbor created by the neighbor bulker */
+void NeighOrch::addNextHop(NeighborBulkContext &ctx)
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_attribute_t> next_hop_attrs;
+
+    sai_attribute_t next_hop_attr;
+    next_hop_attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+    next_hop_attr.value.s32 = SAI_NEXT_HOP_TYPE_IP;
+    next_hop_attrs.push_back(next_hop_attr);
+
+    next_hop_attr.id = SAI_NEXT_HOP_ATTR_IP;
+    next_hop_attr.value.ipaddr = ctx.sai_neighbor_entry.ip_address;
+    next_hop_attrs.push_back(next_hop_attr);
+
+    next_hop_attr.id = SAI_NEXT_HOP_ATTR_ROUTER_INTERFACE_ID;
+    next_hop_attr.value.oid = ctx.sai_neighbor_entry.rif_id;
+    next_hop_attrs.push_back(next_hop_attr);
+
+    gNextHopBulker.create_entry(&ctx.next_hop_id, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
+}
+
+void NeighOrch::addNextHopPost(const NextHopKey &nexthop, const string &alias, const Port &p, sai_object_id_t next_hop_id)
+{
+    const IpAddress &ipAddress = nexthop.ip_address;
+
     SWSS_LOG_NOTICE("Created next hop %s on %s",
                     ipAddress.to_string().c_str(), alias.c_str());
     if (m_neighborToResolve.find(nexthop) != m_neighborToResolve.end())
@@ -271,7 +316,6 @@ bool NeighOrch::addNextHop(const IpAddress &ipAddress, const string &alias)
                 ipAddress.to_string().c_str(), alias.c_str());
         }
     }
-    return true;
 }
 
 bool NeighOrch::setNextHopFlag(const NextHopKey &nexthop, const uint32_t nh_flag)
@@ -356,6 +400,12 @@ bool NeighOrch::ifChangeInformNextHop(const string &alias, bool if_up)
     SWSS_LOG_ENTER();
     bool rc = true;
 
+    if (!if_up)
+    {
+        uint32_t count;
+        return ifChangeInformNextHop(vector<string>{ alias }, false, count);
+    }
+
     for (auto nhop = m_syncdNextHops.begin(); nhop != m_syncdNextHops.end(); ++nhop)
     {
         if (nhop->first.alias != alias)
@@ -385,6 +435,50 @@ bool NeighOrch::ifChangeInformNextHop(const string &alias, bool if_up)
     return rc;
 }
 
+/*
+ * Interfaces going down together, e.g. the ports of one port status
+ * notification: the next hops over all of them are flagged and removed from
+ * their next hop groups in one bulk operation. Returns in count the number
+ * of next hop group members removed.
+ */
+bool NeighOrch::ifChangeInformNextHop(const vector<string> &aliases, bool if_up, uint32_t &count)
+{
+    SWSS_LOG_ENTER();
+
+    count = 0;
+
+    if (if_up)
+    {
+        bool rc = true;
+        for (const auto &alias : aliases)
+        {
+            rc = ifChangeInformNextHop(alias, true) && rc;
+        }
+        return rc;
+    }
+
+    set<string> down(aliases.begin(), aliases.end());
+    vector<NextHopKey> nexthops;
+
+    for (auto &nhop : m_syncdNextHops)
+    {
+        if (!down.count(nhop.first.alias) || (nhop.second.nh_flags & NHFLAGS_IFDOWN))
+        {
+            continue;
+        }
+
+        nhop.second.nh_flags |= NHFLAGS_IFDOWN;
+        nexthops.push_back(nhop.first);
+    }
+
+    if (nexthops.empty())
+    {
+        return true;
+    }
+
+    return gRouteOrch->invalidnexthopsinNextHopGroup(nexthops, count);
+}
+
 bool NeighOrch::removeNextHop(const IpAddress &ipAddress, const string &alias)
 {
     SWSS_LOG_ENTER();
@@ -536,122 +630,226 @@ void NeighOrch::doTask(Consumer &consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
-
-        string key = kfvKey(t);
-        string op = kfvOp(t);
-
-        size_t found = key.find(':');
-        if (found == string::npos)
+        // Neighbor bulk results will be stored in a map
+        std::map<
+                std::pair<
+                        std::string,            // Key
+                        std::string             // Op
+                >,
+                NeighborBulkContext
+        >                                       toBulk;
+
+        // Add or remove neighbors with the neighbor and next hop bulkers
+        while (it != consumer.m_toSync.end())
         {
-            SWSS_LOG_ERROR("Failed to parse key %s", key.c_str());
-            it = consumer.m_toSync.erase(it);
-            continue;
-        }
+            KeyOpFieldsValuesTuple t = it->second;
 
-        string alias = key.substr(0, found);
+            string key = kfvKey(t);
+            string op = kfvOp(t);
 
-        if (alias == "eth0" || alias == "lo" || alias == "docker0")
-        {
-            it = consumer.m_toSync.erase(it);
-            continue;
-        }
-
-        if(gPortsOrch->isInbandPort(alias))
-        {
-            Port ibport;
-            gPortsOrch->getInbandPort(ibport);
-            if(ibport.m_type != Port::VLAN)
+            size_t found = key.find(':');
+            if (found == string::npos)
             {
-                //For "port" type Inband, the neighbors are only remote neighbors.
-                //Hence, this is the neigh learned due to the kernel entry added on
-                //Inband interface for the remote system port neighbors. Skip
+                SWSS_LOG_ERROR("Failed to parse key %s", key.c_str());
                 it = consumer.m_toSync.erase(it);
                 continue;
             }
-            //For "vlan" type inband, may identify the remote neighbors and skip
-        }
 
-        IpAddress ip_address(key.substr(found+1));
+            string alias = key.substr(0, found);
 
-        NeighborEntry neighbor_entry = { ip_address, alias };
-
-        if (op == SET_COMMAND)
-        {
-            Port p;
-            if (!gPortsOrch->getPort(alias, p))
+            if (alias == "eth0" || alias == "lo" || alias == "docker0")
             {
-                SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
-                it++;
+                it = consumer.m_toSync.erase(it);
                 continue;
             }
 
-            if (!p.m_rif_id)
+            if(gPortsOrch->isInbandPort(alias))
             {
-                SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
-                it++;
-                continue;
+                Port ibport;
+                gPortsOrch->getInbandPort(ibport);
+                if(ibport.m_type != Port::VLAN)
+                {
+                    //For "port" type Inband, the neighbors are only remote neighbors.
+                    //Hence, this is the neigh learned due to the kernel entry added on
+                    //Inband interface for the remote system port neighbors. Skip
+                    it = consumer.m_toSync.erase(it);
+                    continue;
+                }
+                //For "vlan" type inband, may identify the remote neighbors and skip
             }
 
-            MacAddress mac_address;
-            for (auto i = kfvFieldsValues(t).begin();
-                 i  != kfvFieldsValues(t).end(); i++)
+            /* The DEL of a neighbor is bulked before its SET. Process the SET
+             * in the next bulk, once the result of the DEL is known */
+            auto bulked_del = toBulk.find(make_pair(key, DEL_COMMAND));
+            if (bulked_del != toBulk.end() && bulked_del->second.bulked)
             {
-                if (fvField(*i) == "neigh")
-                    mac_address = MacAddress(fvValue(*i));
+                break;
             }
 
-            if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end()
-                    || m_syncdNeighbors[neighbor_entry].mac != mac_address)
+            IpAddress ip_address(key.substr(found+1));
+
+            NeighborEntry neighbor_entry = { ip_address, alias };
+
+            if (op == SET_COMMAND)
             {
-                if (addNeighbor(neighbor_entry, mac_address))
+                Port p;
+                if (!gPortsOrch->getPort(alias, p))
                 {
-                    it = consumer.m_toSync.erase(it);
+                    SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
+                    it++;
+                    continue;
                 }
-                else
+
+                if (!p.m_rif_id)
                 {
+                    SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
                     it++;
                     continue;
                 }
+
+                MacAddress mac_address;
+                for (auto i = kfvFieldsValues(t).begin();
+                     i  != kfvFieldsValues(t).end(); i++)
+                {
+                    if (fvField(*i) == "neigh")
+                        mac_address = MacAddress(fvValue(*i));
+                }
+
+                if (m_syncdNeighbors.find(neighbor_entry) == m_syncdNeighbors.end()
+                        || m_syncdNeighbors[neighbor_entry].mac != mac_address)
+                {
+                    auto& ctx = toBulk.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(key, op),
+                            std::forward_as_tuple()).first->second;
+                    ctx.neighbor_entry = neighbor_entry;
+                    ctx.mac = mac_address;
+
+                    if (addNeighbor(ctx))
+                    {
+                        it = consumer.m_toSync.erase(it);
+                    }
+                    else
+                    {
+                        it++;
+                        continue;
+                    }
+                }
+                else
+                {
+                    /* Duplicate entry */
+                    it = consumer.m_toSync.erase(it);
+                }
+
+                /* Remove remaining DEL operation in m_toSync for the same neighbor.
+                 * Since DEL operation is supposed to be executed before SET for the same neighbor
+                 * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
+                 */
+                auto rit = make_reverse_iterator(it);
+                while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+                {
+                    consumer.m_toSync.erase(next(rit).base());
+                    SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+                }
+            }
+            else if (op == DEL_COMMAND)
+            {
+                if (m_syncdNeighbors.find(neighbor_entry) != m_syncdNeighbors.end())
+                {
+                    auto& ctx = toBulk.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(key, op),
+                            std::forward_as_tuple()).first->second;
+                    ctx.neighbor_entry = neighbor_entry;
+
+                    if (removeNeighbor(ctx))
+                    {
+                        it = consumer.m_toSync.erase(it);
+                    }
+                    else
+                    {
+                        it++;
+                    }
+                }
+                else
+                    /* Cannot locate the neighbor */
+                    it = consumer.m_toSync.erase(it);
             }
             else
             {
-                /* Duplicate entry */
+                SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
                 it = consumer.m_toSync.erase(it);
             }
+        }
+
+        // Next hops have to be removed before their neighbors
+        gNextHopBulker.flush();
 
-            /* Remove remaining DEL operation in m_toSync for the same neighbor.
-             * Since DEL operation is supposed to be executed before SET for the same neighbor
-             * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
-             */
-            auto rit = make_reverse_iterator(it);
-            while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+        for (auto& i : toBulk)
+        {
+            auto& ctx = i.second;
+            if (ctx.bulked && i.first.second == DEL_COMMAND &&
+                (ctx.next_hop_status == SAI_STATUS_SUCCESS || ctx.next_hop_status == SAI_STATUS_ITEM_NOT_FOUND))
             {
-                consumer.m_toSync.erase(next(rit).base());
-                SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+                gNeighBulker.remove_entry(&ctx.neighbor_status, &ctx.sai_neighbor_entry);
             }
         }
-        else if (op == DEL_COMMAND)
+
+        // Flush the neighbor bulker, so neighbors will be written to syncd and ASIC
+        gNeighBulker.flush();
+
+        // Next hops are created on top of the new neighbors
+        for (auto& i : toBulk)
         {
-            if (m_syncdNeighbors.find(neighbor_entry) != m_syncdNeighbors.end())
+            auto& ctx = i.second;
+            if (ctx.bulked && i.first.second == SET_COMMAND && ctx.neighbor_status == SAI_STATUS_SUCCESS)
             {
-                if (removeNeighbor(neighbor_entry))
+                addNextHop(ctx);
+            }
+        }
+
+        gNextHopBulker.flush();
+
+        // Go through the bulker results
+        auto it_prev = consumer.m_toSync.begin();
+        while (it_prev != it)
+        {
+            string key = it_prev->first;
+            string op = kfvOp(it_prev->second);
+
+            auto found = toBulk.find(make_pair(key, op));
+            if (found == toBulk.end() || !found->second.bulked)
+            {
+                it_prev++;
+                continue;
+            }
+
+            const auto& ctx = found->second;
+
+            if (op == SET_COMMAND)
+            {
+                if (addNeighborPost(ctx))
                 {
-                    it = consumer.m_toSync.erase(it);
+                    it_prev = consumer.m_toSync.erase(it_prev);
+
+                    /* Remove remaining DEL operation in m_toSync for the same neighbor, see above */
+                    auto rit = make_reverse_iterator(it_prev);
+                    while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+                    {
+                        consumer.m_toSync.erase(next(rit).base());
+                        SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+                    }
                 }
                 else
                 {
-                    it++;
+                    it_prev++;
                 }
             }
             else
-                /* Cannot locate the neighbor */
-                it = consumer.m_toSync.erase(it);
-        }
-        else
-        {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            {
+                if (removeNeighborPost(ctx))
+                    it_prev = consumer.m_toSync.erase(it_prev);
+                else
+                    it_prev++;
+            }
         }
     }
 }
@@ -780,6 +978,9 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
     NeighborUpdate update = { neighborEntry, macAddress, true };
     notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
 
+    /* Routes may wait for the next hop */
+    Orch::wakeRetries();
+
     if(gMySwitchType == "voq")
     {
         //Sync the neighbor to add to the CHASSIS_APP_DB
@@ -924,6 +1125,298 @@ bool NeighOrch::removeNeighbor(const NeighborEntry &neighborEntry, bool disable)
     return true;
 }
 
+/*
+ * Queue the creation of a new neighbor in the neighbor bulker, its next hop is
+ * queued once the neighbor bulker is flushed. Neighbor updates and neighbors
+ * which need more than their neighbor entry and next hop are added at once.
+ * Returns false while the neighbor is queued, see addNeighborPost()
+ */
+bool NeighOrch::addNeighbor(NeighborBulkContext &ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighbor_entry;
+    const MacAddress &macAddress = ctx.mac;
+    IpAddress ip_address = neighborEntry.ip_address;
+    string alias = neighborEntry.alias;
+
+    MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
+
+    /* VOQ neighbors need an encap index and the CHASSIS_APP_DB sync */
+    if (isHwConfigured(neighborEntry) ||
+        gMySwitchType == "voq" ||
+        !mux_orch->isNeighborActive(ip_address, macAddress, alias))
+    {
+        return addNeighbor(neighborEntry, macAddress);
+    }
+
+    sai_object_id_t rif_id = m_intfsOrch->getRouterIntfsId(alias);
+    if (rif_id == SAI_NULL_OBJECT_ID)
+    {
+        SWSS_LOG_INFO("Failed to get rif_id for %s", alias.c_str());
+        return false;
+    }
+
+    /* Do not create a neighbor whose next hop cannot be created */
+    Port p;
+    if (!getNextHopPort(ip_address, alias, p))
+    {
+        return false;
+    }
+
+    ctx.sai_neighbor_entry.rif_id = rif_id;
+    ctx.sai_neighbor_entry.switch_id = gSwitchId;
+    copy(ctx.sai_neighbor_entry.ip_address, ip_address);
+
+    sai_attribute_t neighbor_attr;
+    neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
+    memcpy(neighbor_attr.value.mac, macAddress.getMac(), 6);
+
+    gNeighBulker.create_entry(&ctx.neighbor_status, &ctx.sai_neighbor_entry, 1, &neighbor_attr);
+    ctx.bulked = true;
+
+    return false;
+}
+
+bool NeighOrch::addNeighborPost(const NeighborBulkContext &ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighbor_entry;
+    const MacAddress &macAddress = ctx.mac;
+    const IpAddress &ip_address = neighborEntry.ip_address;
+    const string &alias = neighborEntry.alias;
+
+    sai_status_t status = ctx.neighbor_status;
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        if (status == SAI_STATUS_ITEM_ALREADY_EXISTS)
+        {
+            SWSS_LOG_ERROR("Entry exists: neighbor %s on %s, rv:%d",
+                       macAddress.to_string().c_str(), alias.c_str(), status);
+            /* Returning True so as to skip retry */
+            return true;
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to create neighbor %s on %s, rv:%d",
+                       macAddress.to_string().c_str(), alias.c_str(), status);
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEIGHBOR, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
+        }
+    }
+    SWSS_LOG_NOTICE("Created neighbor ip %s, %s on %s", ip_address.to_string().c_str(),
+            macAddress.to_string().c_str(), alias.c_str());
+    m_intfsOrch->increaseRouterIntfsRefCount(alias);
+
+    if (ip_address.isV4())
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+    }
+    else
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+    }
+
+    bool nextHopCreated = false;
+    if (ctx.next_hop_id != SAI_NULL_OBJECT_ID)
+    {
+        Port p;
+        if (getNextHopPort(ip_address, alias, p))
+        {
+            addNextHopPost(neighborEntry, alias, p, ctx.next_hop_id);
+            nextHopCreated = true;
+        }
+    }
+    else
+    {
+        /*
+         * The next hop bulker does not report why a next hop was not created,
+         * retry it on its own before giving up on the neighbor
+         */
+        nextHopCreated = addNextHop(ip_address, alias);
+    }
+
+    if (!nextHopCreated)
+    {
+        SWSS_LOG_ERROR("Failed to create next hop %s on %s",
+                       ip_address.to_string().c_str(), alias.c_str());
+
+        status = sai_neighbor_api->remove_neighbor_entry(&ctx.sai_neighbor_entry);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
+                           macAddress.to_string().c_str(), alias.c_str(), status);
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEIGHBOR, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
+        }
+        m_intfsOrch->decreaseRouterIntfsRefCount(alias);
+
+        if (ip_address.isV4())
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+        }
+        else
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+        }
+
+        return false;
+    }
+
+    m_syncdNeighbors[neighborEntry] = { macAddress, true };
+
+    NeighborUpdate update = { neighborEntry, macAddress, true };
+    notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+
+    Orch::wakeRetries();
+
+    return true;
+}
+
+/*
+ * Queue the removal of an unreferenced neighbor next hop in the next hop
+ * bulker, the neighbor itself is queued once the next hop bulker is flushed.
+ * Other neighbors are removed at once.
+ * Returns false while the neighbor is queued, see removeNeighborPost()
+ */
+bool NeighOrch::removeNeighbor(NeighborBulkContext &ctx, bool disable)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighbor_entry;
+    IpAddress ip_address = neighborEntry.ip_address;
+    string alias = neighborEntry.alias;
+
+    NextHopKey nexthop = { ip_address, alias };
+    auto nhop = m_syncdNextHops.find(nexthop);
+
+    if (gMySwitchType == "voq" ||
+        !isHwConfigured(neighborEntry) ||
+        nhop == m_syncdNextHops.end() ||
+        nhop->second.ref_count > 0)
+    {
+        return removeNeighbor(neighborEntry, disable);
+    }
+
+    ctx.sai_neighbor_entry.rif_id = m_intfsOrch->getRouterIntfsId(alias);
+    ctx.sai_neighbor_entry.switch_id = gSwitchId;
+    copy(ctx.sai_neighbor_entry.ip_address, ip_address);
+
+    gNextHopBulker.remove_entry(&ctx.next_hop_status, nhop->second.next_hop_id);
+    ctx.bulked = true;
+
+    return false;
+}
+
+bool NeighOrch::removeNeighborPost(const NeighborBulkContext &ctx, bool disable)
+{
+    SWSS_LOG_ENTER();
+
+    const NeighborEntry &neighborEntry = ctx.neighbor_entry;
+    const IpAddress &ip_address = neighborEntry.ip_address;
+    const string &alias = neighborEntry.alias;
+
+    sai_status_t status = ctx.next_hop_status;
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        /* When next hop is not found, we continue to remove neighbor entry. */
+        if (status == SAI_STATUS_ITEM_NOT_FOUND)
+        {
+            SWSS_LOG_ERROR("Failed to locate next hop %s on %s, rv:%d",
+                           ip_address.to_string().c_str(), alias.c_str(), status);
+        }
+        else if (status == SAI_STATUS_NOT_EXECUTED)
+        {
+            /* Stopped by the failure of another next hop in the same bulk */
+            return false;
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to remove next hop %s on %s, rv:%d",
+                           ip_address.to_string().c_str(), alias.c_str(), status);
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
+        }
+    }
+
+    if (status != SAI_STATUS_ITEM_NOT_FOUND)
+    {
+        if (ip_address.isV4())
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        }
+        else
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP);
+        }
+    }
+
+    SWSS_LOG_NOTICE("Removed next hop %s on %s",
+                    ip_address.to_string().c_str(), alias.c_str());
+
+    MacAddress macAddress = m_syncdNeighbors[neighborEntry].mac;
+
+    status = ctx.neighbor_status;
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        if (status == SAI_STATUS_ITEM_NOT_FOUND)
+        {
+            SWSS_LOG_ERROR("Failed to locate neighbor %s on %s, rv:%d",
+                    macAddress.to_string().c_str(), alias.c_str(), status);
+            return true;
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
+                    macAddress.to_string().c_str(), alias.c_str(), status);
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEIGHBOR, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
+        }
+    }
+
+    if (ip_address.isV4())
+    {
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+    }
+    else
+    {
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+    }
+
+    removeNextHop(ip_address, alias);
+    m_intfsOrch->decreaseRouterIntfsRefCount(alias);
+
+    SWSS_LOG_NOTICE("Removed neighbor %s on %s",
+            macAddress.to_string().c_str(), alias.c_str());
+
+    /* Do not delete entry from cache if its disable request */
+    if (disable)
+    {
+        m_syncdNeighbors[neighborEntry].hw_configured = false;
+        return true;
+    }
+
+    m_syncdNeighbors.erase(neighborEntry);
+
+    NeighborUpdate update = { neighborEntry, MacAddress(), false };
+    notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+
+    return true;
+}
+
 bool NeighOrch::isHwConfigured(const NeighborEntry& neighborEntry)
 {
     if (m_syncdNeighbors.find(neighborEntry) == m_syncdNeighbors.end())
@@ -972,6 +1465,124 @@ bool NeighOrch::disableNeighbor(const NeighborEntry& neighborEntry)
     return removeNeighbor(neighborEntry, true);
 }
 
+/*
+ * Programs the neighbors of a MUX cable turning active, with their neighbor
+ * entries then their next hops created by the bulkers, as doTask() does.
+ */
+bool NeighOrch::enableNeighbors(const vector<NeighborEntry>& neighborEntries)
+{
+    SWSS_LOG_ENTER();
+
+    map<NeighborEntry, NeighborBulkContext> toBulk;
+    bool success = true;
+
+    for (const auto& neighborEntry : neighborEntries)
+    {
+        SWSS_LOG_NOTICE("Neighbor enable request for %s ", neighborEntry.ip_address.to_string().c_str());
+
+        auto found = m_syncdNeighbors.find(neighborEntry);
+        if (found == m_syncdNeighbors.end() || found->second.hw_configured)
+        {
+            continue;
+        }
+
+        auto& ctx = toBulk.emplace(std::piecewise_construct,
+                std::forward_as_tuple(neighborEntry),
+                std::forward_as_tuple()).first->second;
+        ctx.neighbor_entry = neighborEntry;
+        ctx.mac = found->second.mac;
+
+        if (!addNeighbor(ctx) && !ctx.bulked)
+        {
+            SWSS_LOG_INFO("Enabling neigh failed for %s", neighborEntry.ip_address.to_string().c_str());
+            success = false;
+        }
+    }
+
+    gNeighBulker.flush();
+
+    for (auto& i : toBulk)
+    {
+        auto& ctx = i.second;
+        if (ctx.bulked && ctx.neighbor_status == SAI_STATUS_SUCCESS)
+        {
+            addNextHop(ctx);
+        }
+    }
+
+    gNextHopBulker.flush();
+
+    for (const auto& i : toBulk)
+    {
+        if (i.second.bulked && !addNeighborPost(i.second))
+        {
+            success = false;
+        }
+    }
+
+    return success;
+}
+
+/*
+ * Removes from the ASIC the neighbors of a MUX cable turning standby, their
+ * next hops then their neighbor entries by the bulkers, and keeps them in
+ * the cache to enable them back.
+ */
+bool NeighOrch::disableNeighbors(const vector<NeighborEntry>& neighborEntries)
+{
+    SWSS_LOG_ENTER();
+
+    map<NeighborEntry, NeighborBulkContext> toBulk;
+    bool success = true;
+
+    for (const auto& neighborEntry : neighborEntries)
+    {
+        SWSS_LOG_NOTICE("Neighbor disable request for %s ", neighborEntry.ip_address.to_string().c_str());
+
+        auto found = m_syncdNeighbors.find(neighborEntry);
+        if (found == m_syncdNeighbors.end() || !found->second.hw_configured)
+        {
+            continue;
+        }
+
+        auto& ctx = toBulk.emplace(std::piecewise_construct,
+                std::forward_as_tuple(neighborEntry),
+                std::forward_as_tuple()).first->second;
+        ctx.neighbor_entry = neighborEntry;
+
+        if (!removeNeighbor(ctx, true) && !ctx.bulked)
+        {
+            SWSS_LOG_INFO("Disabling neigh failed for %s", neighborEntry.ip_address.to_string().c_str());
+            success = false;
+        }
+    }
+
+    // Next hops have to be removed before their neighbors
+    gNextHopBulker.flush();
+
+    for (auto& i : toBulk)
+    {
+        auto& ctx = i.second;
+        if (ctx.bulked &&
+            (ctx.next_hop_status == SAI_STATUS_SUCCESS || ctx.next_hop_status == SAI_STATUS_ITEM_NOT_FOUND))
+        {
+            gNeighBulker.remove_entry(&ctx.neighbor_status, &ctx.sai_neighbor_entry);
+        }
+    }
+
+    gNeighBulker.flush();
+
+    for (const auto& i : toBulk)
+    {
+        if (i.second.bulked && !removeNeighborPost(i.second, true))
+        {
+            success = false;
+        }
+    }
+
+    return success;
+}
+
 sai_object_id_t NeighOrch::addTunnelNextHop(const NextHopKey& nh)
 {
     SWSS_LOG_ENTER();
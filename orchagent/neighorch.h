@@ -11,6 +11,7 @@
 #include "nexthopkey.h"
 #include "producerstatetable.h"
 #include "schema.h"
+#include "bulker.h"
 
 #define NHFLAGS_IFDOWN                  0x1 // nexthop's outbound i/f is down
 
@@ -41,6 +42,29 @@ struct NeighborUpdate
     bool add;
 };
 
+struct NeighborBulkContext
+{
+    NeighborEntry               neighbor_entry;
+    MacAddress                  mac;
+    sai_neighbor_entry_t        sai_neighbor_entry;
+    sai_status_t                neighbor_status;    // Bulk neighbor status
+    sai_status_t                next_hop_status;    // Bulk next hop remove status
+    sai_object_id_t             next_hop_id;        // Bulk next hop create result
+    bool                        bulked;             // Queued in the bulkers
+
+    NeighborBulkContext()
+        : neighbor_status(SAI_STATUS_NOT_EXECUTED),
+          next_hop_status(SAI_STATUS_NOT_EXECUTED),
+          next_hop_id(SAI_NULL_OBJECT_ID),
+          bulked(false)
+    {
+    }
+
+    // Disable any copy constructors
+    NeighborBulkContext(const NeighborBulkContext&) = delete;
+    NeighborBulkContext(NeighborBulkContext&&) = delete;
+};
+
 class NeighOrch : public Orch, public Subject, public Observer
 {
 public:
@@ -61,12 +85,15 @@ public:
 
     bool enableNeighbor(const NeighborEntry&);
     bool disableNeighbor(const NeighborEntry&);
+    bool enableNeighbors(const vector<NeighborEntry>&);
+    bool disableNeighbors(const vector<NeighborEntry>&);
     bool isHwConfigured(const NeighborEntry&);
 
     sai_object_id_t addTunnelNextHop(const NextHopKey&);
     bool removeTunnelNextHop(const NextHopKey&);
 
     bool ifChangeInformNextHop(const string &, bool);
+    bool ifChangeInformNextHop(const vector<string> &, bool, uint32_t &);
     bool isNextHopFlagSet(const NextHopKey &, const uint32_t);
     bool removeOverlayNextHop(const NextHopKey &);
     void update(SubjectType, void *);
@@ -87,11 +114,22 @@ private:
 
     std::set<NextHopKey> m_neighborToResolve;
 
+    EntityBulker<sai_neighbor_api_t>    gNeighBulker;
+    ObjectBulker<sai_next_hop_api_t>    gNextHopBulker;
+
+    bool getNextHopPort(const IpAddress&, const string&, Port&);
+
     bool addNextHop(const IpAddress&, const string&);
+    void addNextHop(NeighborBulkContext&);
+    void addNextHopPost(const NextHopKey&, const string&, const Port&, sai_object_id_t);
     bool removeNextHop(const IpAddress&, const string&);
 
     bool addNeighbor(const NeighborEntry&, const MacAddress&);
+    bool addNeighbor(NeighborBulkContext&);
+    bool addNeighborPost(const NeighborBulkContext&);
     bool removeNeighbor(const NeighborEntry&, bool disable = false);
+    bool removeNeighbor(NeighborBulkContext&, bool disable = false);
+    bool removeNeighborPost(const NeighborBulkContext&, bool disable = false);
 
     bool setNextHopFlag(const NextHopKey &, const uint32_t);
     bool clearNextHopFlag(const NextHopKey &, const uint32_t);
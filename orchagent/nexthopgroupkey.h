@@ -1,54 +1,363 @@
 #ifndef SWSS_NEXTHOPGROUPKEY_H
 #define SWSS_NEXTHOPGROUPKEY_H
 
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <boost/functional/hash.hpp>
+
 #include "nexthopkey.h"
 
+struct NextHopKeyHash
+{
+    size_t operator()(const NextHopKey &nh) const
+    {
+        size_t seed = 0;
+        if (nh.ip_address.isV4())
+        {
+            boost::hash_combine(seed, nh.ip_address.getV4Addr());
+        }
+        else
+        {
+            const uint8_t *ip6 = nh.ip_address.getV6Addr();
+            boost::hash_range(seed, ip6, ip6 + 16);
+        }
+        boost::hash_combine(seed, nh.alias);
+        boost::hash_combine(seed, nh.vni);
+        const uint8_t *mac = nh.mac_address.getMac();
+        boost::hash_range(seed, mac, mac + 6);
+        return seed;
+    }
+};
+
+/*
+ * Interning table of the next hops referred to by next hop group keys.
+ * Each distinct NextHopKey is stored once, groups hold references to the
+ * entries which are counted and released with the last group using them,
+ * so next hops that come and go (EVPN, VNET, transient neighbors) do not
+ * accumulate. Entries are map nodes whose addresses stay valid while they
+ * are referenced, reading the key of a referenced entry does not lock.
+ * Orch worker threads build group keys as well, interning and the last
+ * release are done under the table lock.
+ */
+class NextHopKeyTable
+{
+public:
+    typedef std::pair<const NextHopKey, std::atomic<uint32_t>> Entry;
+    typedef Entry *Id;
+
+    static NextHopKeyTable &getInstance()
+    {
+        static NextHopKeyTable table;
+        return table;
+    }
+
+    /* Returns the entry of the next hop with one more reference */
+    Id intern(const NextHopKey &nh)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto found = m_entries.find(nh);
+        if (found == m_entries.end())
+        {
+            found = m_entries.emplace(std::piecewise_construct,
+                                      std::forward_as_tuple(nh),
+                                      std::forward_as_tuple(0)).first;
+        }
+        found->second++;
+        return &*found;
+    }
+
+    /* One more reference to an entry already referenced by the caller */
+    static void acquire(Id id)
+    {
+        id->second++;
+    }
+
+    void release(Id id)
+    {
+        /* Only the last reference needs the lock, intern() may revive the entry */
+        uint32_t count = id->second.load();
+        while (count > 1)
+        {
+            if (id->second.compare_exchange_weak(count, count - 1))
+            {
+                return;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--id->second == 0)
+        {
+            m_entries.erase(m_entries.find(id->first));
+        }
+    }
+
+    static const NextHopKey &get(Id id)
+    {
+        return id->first;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.size();
+    }
+
+private:
+    NextHopKeyTable() = default;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<NextHopKey, std::atomic<uint32_t>, NextHopKeyHash> m_entries;
+};
+
+/*
+ * Next hop entries of a group in NextHopKey order. Groups of up to
+ * inline_capacity next hops, which covers non-ECMP routes, do not allocate.
+ * References are counted by NextHopGroupKey.
+ */
+class NextHopIdList
+{
+public:
+    typedef NextHopKeyTable::Id Id;
+    static const size_t inline_capacity = 4;
+
+    NextHopIdList() : m_size(0) { }
+
+    const Id *begin() const { return data(); }
+    const Id *end() const { return data() + m_size; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    Id operator[](size_t pos) const { return data()[pos]; }
+
+    void insert(size_t pos, Id id)
+    {
+        if (m_size < inline_capacity)
+        {
+            for (size_t i = m_size; i > pos; i--)
+            {
+                m_inline[i] = m_inline[i - 1];
+            }
+            m_inline[pos] = id;
+        }
+        else
+        {
+            if (m_size == inline_capacity)
+            {
+                m_heap.assign(m_inline, m_inline + m_size);
+            }
+            m_heap.insert(m_heap.begin() + static_cast<std::ptrdiff_t>(pos), id);
+        }
+        m_size++;
+    }
+
+    void erase(size_t pos)
+    {
+        if (m_size <= inline_capacity)
+        {
+            for (size_t i = pos; i + 1 < m_size; i++)
+            {
+                m_inline[i] = m_inline[i + 1];
+            }
+        }
+        else
+        {
+            m_heap.erase(m_heap.begin() + static_cast<std::ptrdiff_t>(pos));
+            if (m_heap.size() == inline_capacity)
+            {
+                std::copy(m_heap.begin(), m_heap.end(), m_inline);
+                std::vector<Id>().swap(m_heap);
+            }
+        }
+        m_size--;
+    }
+
+    void clear()
+    {
+        std::vector<Id>().swap(m_heap);
+        m_size = 0;
+    }
+
+    bool operator==(const NextHopIdList &o) const
+    {
+        return m_size == o.m_size && std::equal(begin(), end(), o.begin());
+    }
+
+private:
+    const Id *data() const
+    {
+        return m_size <= inline_capacity ? m_inline : m_heap.data();
+    }
+
+    size_t m_size;
+    Id m_inline[inline_capacity];
+    std::vector<Id> m_heap;
+};
+
+/*
+ * A next hop group is kept as references to its interned next hops, in
+ * NextHopKey order, with a precomputed hash. Equality and hashing only
+ * compare entry addresses. Groups are ordered as the std::set<NextHopKey>
+ * they replace, so ordered containers of groups keep their iteration order.
+ */
 class NextHopGroupKey
 {
 public:
-    NextHopGroupKey() = default;
+    typedef NextHopKeyTable::Id Id;
+
+    /* Read only view of the next hops of a group, valid as long as the group */
+    class NextHops
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef NextHopKey value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const NextHopKey *pointer;
+            typedef const NextHopKey &reference;
+
+            explicit const_iterator(const Id *id) : m_id(id) { }
+
+            reference operator*() const { return NextHopKeyTable::get(*m_id); }
+            pointer operator->() const { return &**this; }
+
+            const_iterator &operator++()
+            {
+                m_id++;
+                return *this;
+            }
+
+            const_iterator operator++(int)
+            {
+                const_iterator tmp = *this;
+                m_id++;
+                return tmp;
+            }
+
+            bool operator==(const const_iterator &o) const { return m_id == o.m_id; }
+            bool operator!=(const const_iterator &o) const { return m_id != o.m_id; }
+
+        private:
+            const Id *m_id;
+        };
+
+        explicit NextHops(const NextHopGroupKey &nhg) : m_nhg(nhg) { }
+
+        const_iterator begin() const { return const_iterator(m_nhg.m_ids.begin()); }
+        const_iterator end() const { return const_iterator(m_nhg.m_ids.end()); }
+        size_t size() const { return m_nhg.m_ids.size(); }
+        bool empty() const { return m_nhg.m_ids.empty(); }
+        size_t count(const NextHopKey &nh) const { return m_nhg.contains(nh) ? 1 : 0; }
+
+        /* Copy to a set, for callers that edit the next hops */
+        operator std::set<NextHopKey>() const
+        {
+            return std::set<NextHopKey>(begin(), end());
+        }
+
+    private:
+        const NextHopGroupKey &m_nhg;
+    };
+
+    NextHopGroupKey() : m_hash(0), m_overlay_nexthops(false) { }
+
+    NextHopGroupKey(const NextHopGroupKey &o) :
+        m_ids(o.m_ids), m_hash(o.m_hash), m_overlay_nexthops(o.m_overlay_nexthops)
+    {
+        for (auto id : m_ids)
+        {
+            NextHopKeyTable::acquire(id);
+        }
+    }
+
+    NextHopGroupKey(NextHopGroupKey &&o) :
+        m_ids(std::move(o.m_ids)), m_hash(o.m_hash), m_overlay_nexthops(o.m_overlay_nexthops)
+    {
+        o.m_ids.clear();
+        o.m_hash = 0;
+    }
+
+    NextHopGroupKey &operator=(const NextHopGroupKey &o)
+    {
+        if (this != &o)
+        {
+            *this = NextHopGroupKey(o);
+        }
+        return *this;
+    }
+
+    NextHopGroupKey &operator=(NextHopGroupKey &&o)
+    {
+        if (this != &o)
+        {
+            releaseAll();
+            m_ids = std::move(o.m_ids);
+            m_hash = o.m_hash;
+            m_overlay_nexthops = o.m_overlay_nexthops;
+            o.m_ids.clear();
+            o.m_hash = 0;
+        }
+        return *this;
+    }
+
+    ~NextHopGroupKey()
+    {
+        releaseAll();
+    }
 
     /* ip_string@if_alias separated by ',' */
-    NextHopGroupKey(const std::string &nexthops)
+    NextHopGroupKey(const std::string &nexthops) : m_hash(0)
     {
         m_overlay_nexthops = false;
         auto nhv = tokenize(nexthops, NHG_DELIMITER);
         for (const auto &nh : nhv)
         {
-            m_nexthops.insert(nh);
+            add(NextHopKey(nh));
         }
     }
 
     /* ip_string|if_alias|vni|router_mac separated by ',' */
-    NextHopGroupKey(const std::string &nexthops, bool overlay_nh)
+    NextHopGroupKey(const std::string &nexthops, bool overlay_nh) : m_hash(0)
     {
         m_overlay_nexthops = true;
         auto nhv = tokenize(nexthops, NHG_DELIMITER);
         for (const auto &nh_str : nhv)
         {
-            auto nh = NextHopKey(nh_str, overlay_nh);
-            m_nexthops.insert(nh);
+            add(NextHopKey(nh_str, overlay_nh));
         }
     }
 
-    inline const std::set<NextHopKey> &getNextHops() const
+    inline NextHops getNextHops() const
     {
-        return m_nexthops;
+        return NextHops(*this);
     }
 
     inline size_t getSize() const
     {
-        return m_nexthops.size();
+        return m_ids.size();
+    }
+
+    inline size_t getHash() const
+    {
+        return m_hash;
     }
 
     inline bool operator<(const NextHopGroupKey &o) const
     {
-        return m_nexthops < o.m_nexthops;
+        /* Entries are distinct per next hop, same entry means same next hop */
+        return std::lexicographical_compare(m_ids.begin(), m_ids.end(), o.m_ids.begin(), o.m_ids.end(),
+                [](Id a, Id b) { return a != b && NextHopKeyTable::get(a) < NextHopKeyTable::get(b); });
     }
 
     inline bool operator==(const NextHopGroupKey &o) const
     {
-        return m_nexthops == o.m_nexthops;
+        return m_hash == o.m_hash && m_ids == o.m_ids;
     }
 
     inline bool operator!=(const NextHopGroupKey &o) const
@@ -58,33 +367,39 @@ public:
 
     void add(const std::string &ip, const std::string &alias)
     {
-        m_nexthops.emplace(ip, alias);
+        add(NextHopKey(ip, alias));
     }
 
     void add(const std::string &nh)
     {
-        m_nexthops.insert(nh);
+        add(NextHopKey(nh));
     }
 
     void add(const NextHopKey &nh)
     {
-        m_nexthops.insert(nh);
+        size_t pos;
+        if (!lookup(nh, pos))
+        {
+            m_ids.insert(pos, NextHopKeyTable::getInstance().intern(nh));
+            rehash();
+        }
     }
 
     bool contains(const std::string &ip, const std::string &alias) const
     {
         NextHopKey nh(ip, alias);
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return contains(nh);
     }
 
     bool contains(const std::string &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return contains(NextHopKey(nh));
     }
 
     bool contains(const NextHopKey &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        size_t pos;
+        return lookup(nh, pos);
     }
 
     bool contains(const NextHopGroupKey &nhs) const
@@ -101,7 +416,7 @@ public:
 
     bool hasIntfNextHop() const
     {
-        for (const auto &nh : m_nexthops)
+        for (const auto &nh : getNextHops())
         {
             if (nh.isIntfNextHop())
             {
@@ -114,26 +429,33 @@ public:
     void remove(const std::string &ip, const std::string &alias)
     {
         NextHopKey nh(ip, alias);
-        m_nexthops.erase(nh);
+        remove(nh);
     }
 
     void remove(const std::string &nh)
     {
-        m_nexthops.erase(nh);
+        remove(NextHopKey(nh));
     }
 
     void remove(const NextHopKey &nh)
     {
-        m_nexthops.erase(nh);
+        size_t pos;
+        if (lookup(nh, pos))
+        {
+            Id id = m_ids[pos];
+            m_ids.erase(pos);
+            NextHopKeyTable::getInstance().release(id);
+            rehash();
+        }
     }
 
     const std::string to_string() const
     {
         string nhs_str;
 
-        for (auto it = m_nexthops.begin(); it != m_nexthops.end(); ++it)
+        for (auto it = getNextHops().begin(); it != getNextHops().end(); ++it)
         {
-            if (it != m_nexthops.begin())
+            if (it != getNextHops().begin())
             {
                 nhs_str += NHG_DELIMITER;
             }
@@ -154,12 +476,71 @@ public:
 
     void clear()
     {
-        m_nexthops.clear();
+        releaseAll();
+        m_ids.clear();
+        m_hash = 0;
     }
 
 private:
-    std::set<NextHopKey> m_nexthops;
+    NextHopIdList m_ids;
+    size_t m_hash;
     bool m_overlay_nexthops;
+
+    /*
+     * Binary search of the next hop in NextHopKey order. Returns whether it
+     * is in the group, pos is where it is or would be inserted. Next hops
+     * not in the group are not interned.
+     */
+    bool lookup(const NextHopKey &nh, size_t &pos) const
+    {
+        size_t lo = 0;
+        size_t hi = m_ids.size();
+        while (lo < hi)
+        {
+            size_t mid = lo + (hi - lo) / 2;
+            const NextHopKey &key = NextHopKeyTable::get(m_ids[mid]);
+            if (key < nh)
+            {
+                lo = mid + 1;
+            }
+            else if (nh < key)
+            {
+                hi = mid;
+            }
+            else
+            {
+                pos = mid;
+                return true;
+            }
+        }
+        pos = lo;
+        return false;
+    }
+
+    void releaseAll()
+    {
+        for (auto id : m_ids)
+        {
+            NextHopKeyTable::getInstance().release(id);
+        }
+    }
+
+    void rehash()
+    {
+        m_hash = boost::hash_range(m_ids.begin(), m_ids.end());
+    }
 };
 
+namespace std
+{
+    template <>
+    struct hash<NextHopGroupKey>
+    {
+        size_t operator()(const NextHopGroupKey &nhg) const noexcept
+        {
+            return nhg.getHash();
+        }
+    };
+}
+
 #endif /* SWSS_NEXTHOPGROUPKEY_H */
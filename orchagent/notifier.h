@@ -4,8 +4,8 @@
 
 class Notifier : public Executor {
 public:
-    Notifier(swss::NotificationConsumer *select, Orch *orch, const std::string &name)
-        : Executor(select, orch, name)
+    Notifier(swss::NotificationConsumer *select, Orch *orch, const std::string &name, int pri = default_orch_pri)
+        : Executor(select, orch, name, pri)
     {
     }
 
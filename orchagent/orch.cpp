@@ -1,9 +1,12 @@
 #include <fstream>
+#include <algorithm>
 #include <iostream>
 #include <inttypes.h>
 #include <sys/time.h>
 #include "timestamp.h"
 #include "orch.h"
+#include "recorder.h"
+#include "bulker.h"
 
 #include "subscriberstatetable.h"
 #include "portsorch.h"
@@ -17,9 +20,30 @@ using namespace swss;
 extern int gBatchSize;
 
 extern bool gSwssRecord;
-extern ofstream gRecordOfs;
 extern bool gLogRotate;
-extern string gRecordFile;
+
+atomic<uint64_t> Consumer::s_wakeEpoch(0);
+atomic<uint64_t> Consumer::s_progressEpoch(0);
+atomic<bool> Consumer::s_taskStats(false);
+
+/* Consumer running doTask(Consumer&) on this thread, to account SAI failures */
+static thread_local Consumer *t_runningConsumer = nullptr;
+
+/* Single writer counters, see Consumer::TaskStats */
+static inline void statAdd(atomic<uint64_t> &counter, uint64_t value)
+{
+    counter.store(counter.load(memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+static inline uint64_t statGet(const atomic<uint64_t> &counter)
+{
+    return counter.load(memory_order_relaxed);
+}
+
+static inline int64_t steadyMsecs(chrono::steady_clock::time_point time)
+{
+    return chrono::duration_cast<chrono::milliseconds>(time.time_since_epoch()).count();
+}
 
 Orch::Orch(DBConnector *db, const string tableName, int pri)
 {
@@ -52,10 +76,6 @@ Orch::Orch(const vector<TableConnector>& tables)
 
 Orch::~Orch()
 {
-    if (gRecordOfs.is_open())
-    {
-        gRecordOfs.close();
-    }
 }
 
 vector<Selectable *> Orch::getSelectables()
@@ -70,11 +90,12 @@ vector<Selectable *> Orch::getSelectables()
 
 void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
 {
-    SWSS_LOG_ENTER();
-
+    addToSync(KeyOpFieldsValuesTuple(entry));
+}
 
-    string key = kfvKey(entry);
-    string op  = kfvOp(entry);
+void Consumer::addToSync(KeyOpFieldsValuesTuple &&entry)
+{
+    SWSS_LOG_ENTER();
 
     /* Record incoming tasks */
     if (gSwssRecord)
@@ -83,85 +104,36 @@ void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
     }
 
     /*
-    * m_toSync is a multimap which will allow one key with multiple values,
-    * Also, the order of the key-value pairs whose keys compare equivalent
-    * is the order of insertion and does not change. (since C++11)
+    * m_toSync keeps at most one DEL and one SET per key, DEL ordered first:
+    * a DEL overwrites the old tasks of the key, a SET after a DEL is queued
+    * behind it, and a SET on a pending SET is merged into it.
     */
-
-    /* If a new task comes we directly put it into getConsumerTable().m_toSync map */
-    if (m_toSync.find(key) == m_toSync.end())
-    {
-        m_toSync.emplace(key, entry);
-    }
-
-    /* if a DEL task comes, we overwrite the old key */
-    else if (op == DEL_COMMAND)
+    if (!m_parked.empty())
     {
-        m_toSync.erase(key);
-        m_toSync.emplace(key, entry);
+        m_toSync.take(m_parked, kfvKey(entry));
     }
-    else
-    {
-        /*
-        * Now we are trying to add the key-value with SET.
-        * We maintain maximum two values per key.
-        * In case there is one key-value, it should be DEL or SET
-        * In case there are two key-value pairs, it should be DEL then SET
-        * The code logic is following:
-        * We iterate the values with the key, we skip the value with DEL and then
-        * check if that was the only one (I,E, the iter pointer now points to end or next key),
-        * in such case, we insert the key-value with SET.
-        * If there was a SET already (I,E, the pointer still points to the same key), we combine the kfv.
-        */
-        auto ret = m_toSync.equal_range(key);
-        auto iter = ret.first;
-        for (; iter != ret.second; ++iter)
-        {
-            auto old_op = kfvOp(iter->second);
-            if (old_op == SET_COMMAND)
-                break;
-        }
-        if (iter == ret.second)
-        {
-            m_toSync.emplace(key, entry);
-        }
-        else
-        {
-            KeyOpFieldsValuesTuple existing_data = iter->second;
-
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
-
+    m_toSync.add(std::move(entry));
+}
 
-            for (auto it : new_values)
-            {
-                string field = fvField(it);
-                string value = fvValue(it);
+size_t Consumer::addToSync(const std::deque<KeyOpFieldsValuesTuple> &entries)
+{
+    SWSS_LOG_ENTER();
 
-                auto iu = existing_values.begin();
-                while (iu != existing_values.end())
-                {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
-                        iu = existing_values.erase(iu);
-                    else
-                        iu++;
-                }
-                existing_values.push_back(FieldValueTuple(field, value));
-            }
-            iter->second = KeyOpFieldsValuesTuple(key, op, existing_values);
-        }
+    for (auto& entry: entries)
+    {
+        addToSync(entry);
     }
 
+    return entries.size();
 }
 
-size_t Consumer::addToSync(const std::deque<KeyOpFieldsValuesTuple> &entries)
+size_t Consumer::addToSync(std::deque<KeyOpFieldsValuesTuple> &&entries)
 {
     SWSS_LOG_ENTER();
 
     for (auto& entry: entries)
     {
-        addToSync(entry);
+        addToSync(std::move(entry));
     }
 
     return entries.size();
@@ -173,6 +145,8 @@ size_t Consumer::refillToSync(Table* table)
     std::deque<KeyOpFieldsValuesTuple> entries;
     vector<string> keys;
     table->getKeys(keys);
+    /* m_toSync iterates in arrival order, table keys come unordered: add them in key order */
+    sort(keys.begin(), keys.end());
     for (const auto &key: keys)
     {
         KeyOpFieldsValuesTuple kco;
@@ -184,10 +158,10 @@ size_t Consumer::refillToSync(Table* table)
         {
             continue;
         }
-        entries.push_back(kco);
+        entries.push_back(std::move(kco));
     }
 
-    return addToSync(entries);
+    return addToSync(std::move(entries));
 }
 
 size_t Consumer::refillToSync()
@@ -199,7 +173,7 @@ size_t Consumer::refillToSync()
     {
         std::deque<KeyOpFieldsValuesTuple> entries;
         subTable->pops(entries);
-        return addToSync(entries);
+        return addToSync(std::move(entries));
     }
     else
     {
@@ -216,17 +190,339 @@ void Consumer::execute()
     SWSS_LOG_ENTER();
 
     std::deque<KeyOpFieldsValuesTuple> entries;
-    getConsumerTable()->pops(entries);
+    size_t budget = m_schedule.budget;
+    bool popped = m_backlog.empty();
+    bool adaptive = m_minBatchSize < m_maxBatchSize;
+    chrono::steady_clock::time_point begin;
+
+    if (popped)
+    {
+        auto table = getConsumerTable();
+        size_t size = static_cast<size_t>(table->POP_BATCH_SIZE);
+
+        table->pops(entries);
+        m_batchStats.pops++;
+
+        /* A full pop tells that the table may have more */
+        size_t last = entries.size();
+        while (m_batchSize && entries.size() < m_batchSize && last >= size)
+        {
+            std::deque<KeyOpFieldsValuesTuple> more;
+            table->pops(more);
+            m_batchStats.pops++;
+            last = more.size();
+            entries.insert(entries.end(), make_move_iterator(more.begin()), make_move_iterator(more.end()));
+        }
+        m_batchStats.turns++;
+        m_batchStats.popped += entries.size();
+        m_popDue = false;
+
+        if (s_taskStats.load(memory_order_relaxed))
+        {
+            statAdd(m_taskStats.popped, entries.size());
+            m_popTime = chrono::steady_clock::now();
+        }
+        if (adaptive)
+        {
+            begin = chrono::steady_clock::now();
+        }
+
+        if (budget && entries.size() > budget)
+        {
+            m_backlog.insert(m_backlog.end(),
+                             make_move_iterator(entries.begin() + static_cast<ptrdiff_t>(budget)),
+                             make_move_iterator(entries.end()));
+            entries.resize(budget);
+        }
+    }
+    else
+    {
+        /* Events read meanwhile are popped once the backlog is handed over, see readData() */
+        size_t count = budget ? min(budget, m_backlog.size()) : m_backlog.size();
+        auto end = m_backlog.begin() + static_cast<ptrdiff_t>(count);
+        entries.insert(entries.end(), make_move_iterator(m_backlog.begin()), make_move_iterator(end));
+        m_backlog.erase(m_backlog.begin(), end);
+    }
 
-    addToSync(entries);
+    size_t handed = entries.size();
+    size_t total = handed + m_backlog.size();
+    addToSync(std::move(entries));
 
     drain();
+
+    if (popped && adaptive)
+    {
+        auto elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count();
+        adaptBatchSize(total, handed ? static_cast<uint64_t>(elapsed) / handed : 0);
+    }
 }
 
-void Consumer::drain()
+void Consumer::setBatchSize(size_t batch, size_t min, size_t max)
+{
+    m_minBatchSize = min;
+    m_maxBatchSize = std::max(min, max);
+    m_batchSize = batch;
+    if (m_minBatchSize < m_maxBatchSize)
+    {
+        m_batchSize = std::min(std::max(batch, m_minBatchSize), m_maxBatchSize);
+    }
+    m_batchStats.task_cost_ns = 0;
+}
+
+void Consumer::adaptBatchSize(size_t popped, uint64_t taskCostNs)
+{
+    if (m_minBatchSize >= m_maxBatchSize)
+    {
+        return;
+    }
+
+    uint64_t lastCost = m_batchStats.task_cost_ns;
+    if (popped >= m_batchSize)
+    {
+        if (m_batchSize < m_maxBatchSize && (!lastCost || taskCostNs <= lastCost + lastCost / 8))
+        {
+            m_batchSize = min(max<size_t>(m_batchSize * 2, 1), m_maxBatchSize);
+            m_batchStats.grown++;
+        }
+    }
+    else if (popped < m_batchSize / 2 && m_batchSize > m_minBatchSize)
+    {
+        m_batchSize = max(m_batchSize / 2, m_minBatchSize);
+        m_batchStats.shrunk++;
+    }
+
+    if (taskCostNs)
+    {
+        m_batchStats.task_cost_ns = taskCostNs;
+    }
+}
+
+consumer_batch_stats_t Consumer::getBatchStats() const
+{
+    consumer_batch_stats_t stats = m_batchStats;
+    stats.batch_size = m_batchSize;
+    stats.min_batch_size = m_minBatchSize;
+    stats.max_batch_size = m_maxBatchSize;
+    return stats;
+}
+
+void Consumer::runTasks(chrono::steady_clock::time_point since)
 {
-    if (!m_toSync.empty())
+    if (!s_taskStats.load(memory_order_relaxed))
+    {
         m_orch->doTask(*this);
+        return;
+    }
+
+    size_t pending = m_toSync.size();
+    auto begin = chrono::steady_clock::now();
+
+    uint64_t flushNsecs = BulkerFlushTimer::nsecs();
+
+    Consumer *running = t_runningConsumer;
+    t_runningConsumer = this;
+    m_orch->doTask(*this);
+    t_runningConsumer = running;
+
+    auto end = chrono::steady_clock::now();
+    auto elapsed = static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(end - begin).count());
+    statAdd(m_taskStats.dotask_us, elapsed);
+    statAdd(m_taskStats.flush_us, (BulkerFlushTimer::nsecs() - flushNsecs) / 1000);
+    if (elapsed > statGet(m_taskStats.dotask_max_us))
+    {
+        m_taskStats.dotask_max_us.store(elapsed, memory_order_relaxed);
+    }
+
+    if (m_toSync.size() < pending)
+    {
+        size_t completed = pending - m_toSync.size();
+        statAdd(m_taskStats.completed, completed);
+
+        auto latency = chrono::duration_cast<chrono::microseconds>(end - since).count();
+        size_t bucket = 0;
+        for (int64_t bound = 100; bucket < CONSUMER_LATENCY_BUCKETS - 1 && latency > bound; bound *= 10)
+        {
+            bucket++;
+        }
+        statAdd(m_taskStats.latency[bucket], completed);
+    }
+}
+
+void Consumer::updatePendingSince(chrono::steady_clock::time_point since)
+{
+    if (!s_taskStats.load(memory_order_relaxed))
+    {
+        return;
+    }
+
+    if (getPendingTaskCount() == 0)
+    {
+        m_taskStats.pending_since_ms.store(0, memory_order_relaxed);
+    }
+    else if (m_taskStats.pending_since_ms.load(memory_order_relaxed) == 0)
+    {
+        m_taskStats.pending_since_ms.store(steadyMsecs(since), memory_order_relaxed);
+    }
+}
+
+void Consumer::drain()
+{
+    if (isRetryDue())
+    {
+        retryParked();
+    }
+
+    if (m_toSync.empty())
+    {
+        updatePendingSince(m_popTime);
+        return;
+    }
+
+    if (m_popTime == chrono::steady_clock::time_point() && s_taskStats.load(memory_order_relaxed))
+    {
+        /* Tasks added without execute(), e.g. warm restart data */
+        m_popTime = chrono::steady_clock::now();
+    }
+
+    uint64_t wakeEpoch = s_wakeEpoch;
+    uint64_t progressEpoch = s_progressEpoch;
+    size_t pending = m_toSync.size();
+
+    runTasks(m_popTime);
+    m_retryStats.runs++;
+
+    if (m_toSync.size() != pending)
+    {
+        s_progressEpoch++;
+    }
+
+    if (m_toSync.empty())
+    {
+        updatePendingSince(m_popTime);
+        return;
+    }
+
+    if (m_parked.empty())
+    {
+        /* Start a retry cycle, state changes during the run count as well */
+        m_wakeEpoch = wakeEpoch;
+        m_progressEpoch = progressEpoch;
+        m_stalledRetries = 0;
+        m_retryBackoff = chrono::milliseconds(CONSUMER_RETRY_BACKOFF_MIN_MSECS);
+        m_nextRetry = chrono::steady_clock::now() + m_retryBackoff;
+        m_parkTime = m_popTime;
+    }
+
+    m_parked.splice(m_toSync);
+    updatePendingSince(m_popTime);
+}
+
+bool Consumer::isRetryDue() const
+{
+    if (m_parked.empty())
+    {
+        return false;
+    }
+
+    if (s_wakeEpoch != m_wakeEpoch)
+    {
+        return true;
+    }
+
+    /* Progress elsewhere gets a single retry, the back-off applies after */
+    if (m_stalledRetries == 0 && s_progressEpoch != m_progressEpoch)
+    {
+        return true;
+    }
+
+    return chrono::steady_clock::now() >= m_nextRetry;
+}
+
+void Consumer::retryParked()
+{
+    SWSS_LOG_ENTER();
+
+    /*
+     * Run the parked tasks on their own to tell whether they progress, the
+     * new tasks wait in m_parked meanwhile.
+     */
+    m_toSync.swap(m_parked);
+
+    m_wakeEpoch = s_wakeEpoch;
+    m_progressEpoch = s_progressEpoch;
+    size_t parked = m_toSync.size();
+
+    /* Parked tasks are at least as old as the first one parked */
+    runTasks(m_parkTime);
+
+    m_retryStats.runs++;
+    m_retryStats.retries++;
+    m_retryStats.retried_tasks += parked;
+
+    bool progress = (m_toSync.size() != parked);
+    m_toSync.swap(m_parked);
+
+    if (progress)
+    {
+        s_progressEpoch++;
+        m_stalledRetries = 0;
+        m_retryBackoff = chrono::milliseconds(CONSUMER_RETRY_BACKOFF_MIN_MSECS);
+    }
+    else
+    {
+        m_retryStats.stalled++;
+        m_stalledRetries++;
+        m_retryBackoff = min(m_retryBackoff * 2, chrono::milliseconds(CONSUMER_RETRY_BACKOFF_MAX_MSECS));
+    }
+
+    m_nextRetry = chrono::steady_clock::now() + m_retryBackoff;
+}
+
+consumer_retry_stats_t Consumer::getRetryStats() const
+{
+    consumer_retry_stats_t stats = m_retryStats;
+    stats.parked = m_parked.size();
+    return stats;
+}
+
+consumer_task_stats_t Consumer::getTaskStats() const
+{
+    consumer_task_stats_t stats;
+
+    stats.popped = statGet(m_taskStats.popped);
+    stats.completed = statGet(m_taskStats.completed);
+    stats.failed = statGet(m_taskStats.failed);
+    stats.dotask_us = statGet(m_taskStats.dotask_us);
+    stats.dotask_max_us = statGet(m_taskStats.dotask_max_us);
+    stats.flush_us = statGet(m_taskStats.flush_us);
+    for (size_t i = 0; i < CONSUMER_LATENCY_BUCKETS; i++)
+    {
+        stats.latency[i] = statGet(m_taskStats.latency[i]);
+    }
+
+    int64_t since = m_taskStats.pending_since_ms.load(memory_order_relaxed);
+    int64_t now = steadyMsecs(chrono::steady_clock::now());
+    stats.queue_age_ms = (since != 0 && now > since) ? static_cast<uint64_t>(now - since) : 0;
+
+    return stats;
+}
+
+void Consumer::countFailure()
+{
+    Consumer *consumer = t_runningConsumer;
+    if (consumer != nullptr)
+    {
+        statAdd(consumer->m_taskStats.failed, 1);
+    }
+}
+
+string Consumer::getLatencyBucketName(size_t bucket)
+{
+    static const char *names[CONSUMER_LATENCY_BUCKETS] = {
+        "le_100us", "le_1ms", "le_10ms", "le_100ms", "le_1s", "gt_1s"
+    };
+
+    return bucket < CONSUMER_LATENCY_BUCKETS ? names[bucket] : "";
 }
 
 string Consumer::dumpTuple(const KeyOpFieldsValuesTuple &tuple)
@@ -243,6 +539,16 @@ string Consumer::dumpTuple(const KeyOpFieldsValuesTuple &tuple)
 
 void Consumer::dumpPendingTasks(vector<string> &ts)
 {
+    for (auto &tm : m_parked)
+    {
+        ts.push_back(dumpTuple(tm.second));
+    }
+
+    for (auto &tuple : m_backlog)
+    {
+        ts.push_back(dumpTuple(tuple));
+    }
+
     for (auto &tm : m_toSync)
     {
         KeyOpFieldsValuesTuple& tuple = tm.second;
@@ -526,36 +832,108 @@ void Orch::dumpPendingTasks(vector<string> &ts)
     }
 }
 
-void Orch::logfileReopen()
+size_t Orch::getPendingTaskCount() const
 {
-    gRecordOfs.close();
+    size_t count = 0;
+    for (const auto &it : m_consumerMap)
+    {
+        Consumer* consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer != NULL)
+        {
+            count += consumer->getPendingTaskCount();
+        }
+    }
+    return count;
+}
 
-    /*
-     * On log rotate we will use the same file name, we are assuming that
-     * logrotate daemon move filename to filename.1 and we will create new
-     * empty file here.
-     */
+void Orch::getRetryStats(vector<pair<string, consumer_retry_stats_t>> &stats) const
+{
+    for (const auto &it : m_consumerMap)
+    {
+        Consumer* consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer != NULL)
+        {
+            stats.emplace_back(consumer->getDbName() + ":" + consumer->getTableName(),
+                               consumer->getRetryStats());
+        }
+    }
+}
 
-    gRecordOfs.open(gRecordFile);
+void Orch::wakeRetries()
+{
+    Consumer::s_wakeEpoch++;
+}
 
-    if (!gRecordOfs.is_open())
+void Orch::enableTaskStats(bool enable)
+{
+    Consumer::s_taskStats = enable;
+    BulkerFlushTimer::enabled() = enable;
+}
+
+bool Orch::isTaskStatsEnabled()
+{
+    return Consumer::s_taskStats;
+}
+
+void Orch::getTaskStats(vector<pair<string, consumer_task_stats_t>> &stats) const
+{
+    for (const auto &it : m_consumerMap)
     {
-        SWSS_LOG_ERROR("failed to open gRecordOfs file %s: %s", gRecordFile.c_str(), strerror(errno));
-        return;
+        Consumer* consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer != NULL)
+        {
+            stats.emplace_back(consumer->getDbName() + ":" + consumer->getTableName(),
+                               consumer->getTaskStats());
+        }
+    }
+}
+
+size_t Orch::setBatchSize(const string &tableName, size_t batch, size_t min, size_t max)
+{
+    size_t count = 0;
+
+    for (const auto &it : m_consumerMap)
+    {
+        Consumer* consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer != NULL && consumer->getTableName() == tableName)
+        {
+            consumer->setBatchSize(batch, min, max);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void Orch::getBatchStats(vector<pair<string, consumer_batch_stats_t>> &stats) const
+{
+    for (const auto &it : m_consumerMap)
+    {
+        Consumer* consumer = dynamic_cast<Consumer *>(it.second.get());
+        if (consumer != NULL)
+        {
+            stats.emplace_back(consumer->getDbName() + ":" + consumer->getTableName(),
+                               consumer->getBatchStats());
+        }
     }
 }
 
 void Orch::recordTuple(Consumer &consumer, const KeyOpFieldsValuesTuple &tuple)
 {
-    string s = consumer.dumpTuple(tuple);
+    auto &recorder = SwssRecorder::getInstance();
 
-    gRecordOfs << getTimestamp() << "|" << s << endl;
+    recorder.record(consumer.getDbName(), consumer.getTableName(),
+                    consumer.getConsumerTable()->getTableNameSeparator(), tuple);
 
     if (gLogRotate)
     {
         gLogRotate = false;
 
-        logfileReopen();
+        /*
+         * logrotate moved the file to filename.1, the writer reopens the
+         * same file name, which creates a new empty file.
+         */
+        recorder.rotate();
     }
 }
 
@@ -777,10 +1155,12 @@ bool Orch::parseHandleSaiStatusFailure(task_process_status status)
         case task_need_retry:
             return false;
         case task_failed:
+            Consumer::countFailure();
             return true;
         default:
             SWSS_LOG_WARN("task_process_status %d is not expected in parseHandleSaiStatusFailure", status);
     }
+    Consumer::countFailure();
     return true;
 }
 
@@ -815,18 +1195,22 @@ void Orch2::doTask(Consumer &consumer)
         catch (const std::invalid_argument& e)
         {
             SWSS_LOG_ERROR("Parse error: %s", e.what());
+            Consumer::countFailure();
         }
         catch (const std::logic_error& e)
         {
             SWSS_LOG_ERROR("Logic error: %s", e.what());
+            Consumer::countFailure();
         }
         catch (const std::exception& e)
         {
             SWSS_LOG_ERROR("Exception was catched in the request parser: %s", e.what());
+            Consumer::countFailure();
         }
         catch (...)
         {
             SWSS_LOG_ERROR("Unknown exception was catched in the request parser");
+            Consumer::countFailure();
         }
         request_.clear();
 
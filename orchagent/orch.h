@@ -7,6 +7,8 @@
 #include <set>
 #include <memory>
 #include <utility>
+#include <atomic>
+#include <chrono>
 
 extern "C" {
 #include "sai.h"
@@ -20,6 +22,7 @@ extern "C" {
 #include "notificationconsumer.h"
 #include "selectabletimer.h"
 #include "macaddress.h"
+#include "syncmap.h"
 
 const char delimiter           = ':';
 const char list_item_delimiter = ',';
@@ -44,6 +47,39 @@ const char state_db_key_delimiter  = '|';
 
 const int default_orch_pri = 0;
 
+/*
+ * Executors at or above this priority run before the other ready ones, and
+ * are also serviced in the middle of a drain pass of the Orchs, see
+ * OrchDaemon::start(). They may then be executed with nothing left to read,
+ * and must tolerate it.
+ */
+const int urgent_orch_pri = 100;
+
+/*
+ * Scheduling of an Executor among the ready ones of the main loop, see
+ * FairScheduler. Ready Executors share the loop in proportion to their
+ * weight, higher priorities first among equals, and one ready for longer
+ * than its deadline runs next. A Consumer hands at most budget tasks to
+ * doTask(Consumer&) per execute(), 0 for all the tasks popped.
+ */
+struct ExecutorSchedule
+{
+    int pri = default_orch_pri;
+    unsigned weight = 1;
+    size_t budget = 0;
+    std::chrono::milliseconds deadline{1000};
+};
+
+/*
+ * Schedules the Orchs give to their Executors, see Executor::setBulkSchedule()
+ * and Executor::setLatencySensitiveSchedule(). Bulk tables get bounded turns,
+ * so that a burst of millions of routes lets the latency sensitive Executors,
+ * which get more weight and a short deadline, run in between.
+ */
+#define BULK_TABLE_BUDGET 1024
+#define LATENCY_SENSITIVE_WEIGHT 8
+#define LATENCY_SENSITIVE_DEADLINE_MSECS 10
+
 typedef enum
 {
     task_success,
@@ -71,13 +107,53 @@ typedef std::map<std::string, object_reference_map*> type_map;
 typedef std::map<std::string, sai_object_id_t> object_map;
 typedef std::pair<std::string, sai_object_id_t> object_map_pair;
 
-// Use multimap to support multiple OpFieldsValues for the same key (e,g, DEL and SET)
-// The order of the key-value pairs whose keys compare equivalent is the order of
-// insertion and does not change. (since C++11)
-typedef std::multimap<std::string, swss::KeyOpFieldsValuesTuple> SyncMap;
-
 typedef std::pair<std::string, int> table_name_with_pri_t;
 
+typedef struct
+{
+    uint64_t runs;          // doTask(Consumer&) calls
+    uint64_t retries;       // doTask(Consumer&) calls on parked tasks
+    uint64_t retried_tasks; // parked tasks handed again to doTask(Consumer&)
+    uint64_t stalled;       // retries which did not complete any task
+    size_t parked;          // tasks currently parked
+} consumer_retry_stats_t;
+
+/*
+ * Back-off between the retries of parked tasks which keep stalling. Not all
+ * dependencies call Orch::wakeRetries() when they resolve, the cap bounds
+ * the latency they add, well below the select() timeout of the main loop.
+ */
+#define CONSUMER_RETRY_BACKOFF_MIN_MSECS 10
+#define CONSUMER_RETRY_BACKOFF_MAX_MSECS 50
+
+/* Task latency buckets, bounded by 100us, 1ms, 10ms, 100ms, 1s and open ended */
+#define CONSUMER_LATENCY_BUCKETS 6
+
+typedef struct
+{
+    uint64_t popped;        // tasks popped from the table
+    uint64_t completed;     // tasks removed from m_toSync by doTask(Consumer&)
+    uint64_t failed;        // SAI failures handled while running doTask(Consumer&)
+    uint64_t dotask_us;     // time spent in doTask(Consumer&)
+    uint64_t dotask_max_us;
+    uint64_t flush_us;      // time spent in the SAI bulk flushes of doTask(Consumer&)
+    uint64_t queue_age_ms;  // age of the oldest pending task, 0 without pending tasks
+    uint64_t latency[CONSUMER_LATENCY_BUCKETS]; // completed tasks by time since popped
+} consumer_task_stats_t;
+
+typedef struct
+{
+    size_t batch_size;      // tasks popped per turn, 0 for a single pops() call
+    size_t min_batch_size;
+    size_t max_batch_size;
+    uint64_t pops;          // pops() calls on the table
+    uint64_t turns;         // execute() calls which popped the table
+    uint64_t popped;        // tasks popped
+    uint64_t grown;         // adaptive batch size doublings
+    uint64_t shrunk;        // adaptive batch size halvings
+    uint64_t task_cost_ns;  // cost of a task handed on the last adaptive turn
+} consumer_batch_stats_t;
+
 class Orch;
 
 // Design assumption
@@ -87,11 +163,17 @@ class Orch;
 class Executor : public swss::Selectable
 {
 public:
-    Executor(swss::Selectable *selectable, Orch *orch, const std::string &name)
+    /*
+     * The priority is a scheduling hint, the Selectable itself keeps the
+     * default priority so that a Select returns all the ready Executors in
+     * turn, see OrchDaemon::selectExecutor().
+     */
+    Executor(swss::Selectable *selectable, Orch *orch, const std::string &name, int pri = default_orch_pri)
         : m_selectable(selectable)
         , m_orch(orch)
         , m_name(name)
     {
+        m_schedule.pri = pri;
     }
 
     virtual ~Executor() { delete m_selectable; }
@@ -111,14 +193,33 @@ public:
     virtual void execute() { }
     virtual void drain() { }
 
+    /* Work left by execute() for a next turn, without a new event */
+    virtual bool hasPendingWork() const { return false; }
+
     virtual std::string getName() const
     {
         return m_name;
     }
 
+    const ExecutorSchedule &getSchedule() const { return m_schedule; }
+    void setSchedule(const ExecutorSchedule &schedule) { m_schedule = schedule; }
+
+    /* Set by the owning Orch before the Executor is scheduled, the priority is kept */
+    void setBulkSchedule()
+    {
+        m_schedule.budget = BULK_TABLE_BUDGET;
+    }
+
+    void setLatencySensitiveSchedule()
+    {
+        m_schedule.weight = LATENCY_SENSITIVE_WEIGHT;
+        m_schedule.deadline = std::chrono::milliseconds(LATENCY_SENSITIVE_DEADLINE_MSECS);
+    }
+
 protected:
     swss::Selectable *m_selectable;
     Orch *m_orch;
+    ExecutorSchedule m_schedule;
 
     // Name for Executor
     std::string m_name;
@@ -130,7 +231,7 @@ protected:
 class Consumer : public Executor {
 public:
     Consumer(swss::ConsumerTableBase *select, Orch *orch, const std::string &name)
-        : Executor(select, orch, name)
+        : Executor(select, orch, name, select->getPri())
     {
     }
 
@@ -161,15 +262,125 @@ public:
     size_t refillToSync(swss::Table* table);
     void execute();
     void drain();
+    bool hasPendingWork() const override { return !m_backlog.empty() || m_popDue; }
+
+    uint64_t readData() override
+    {
+        /* The table is not popped while the backlog is handed over, the event leaves a pop due */
+        if (!m_backlog.empty())
+        {
+            m_popDue = true;
+        }
+        return Executor::readData();
+    }
 
     /* Store the latest 'golden' status */
     // TODO: hide?
     SyncMap m_toSync;
 
+    /* Number of tasks in m_toSync, parked and in the backlog */
+    size_t getPendingTaskCount() const { return m_toSync.size() + m_parked.size() + m_backlog.size(); }
+
+    consumer_retry_stats_t getRetryStats() const;
+    consumer_task_stats_t getTaskStats() const;
+
+    /*
+     * Tasks popped from the table per turn. Without batch size a turn makes
+     * a single pops() call, which returns up to the pop batch size of the
+     * table (orchagent -b option). With one, pops() is called until the
+     * batch is reached or the table is empty. When min < max the batch size
+     * adapts between them, see adaptBatchSize(). Called by the thread which
+     * runs the Consumer, or under the guard of its Orch.
+     */
+    void setBatchSize(size_t batch, size_t min, size_t max);
+    consumer_batch_stats_t getBatchStats() const;
+
+    /*
+     * Called by execute() after a turn which popped the table, with the
+     * tasks popped and the cost of each task handed to doTask(Consumer&).
+     * The batch doubles while the table has more than a batch to pop and
+     * the cost of a task does not grow by more than 1/8, which tells that
+     * larger batches still amortize SAI bulk calls, and halves when less
+     * than half of a batch was popped.
+     */
+    void adaptBatchSize(size_t popped, uint64_t taskCostNs);
+
+    /* Count a failed task against the Consumer running doTask(Consumer&) on this thread */
+    static void countFailure();
+
+    /* Name of a bucket of consumer_task_stats_t::latency, e.g. "le_100us" */
+    static std::string getLatencyBucketName(size_t bucket);
+
     void addToSync(const swss::KeyOpFieldsValuesTuple &entry);
+    void addToSync(swss::KeyOpFieldsValuesTuple &&entry);
 
     // Returns: the number of entries added to m_toSync
     size_t addToSync(const std::deque<swss::KeyOpFieldsValuesTuple> &entries);
+    size_t addToSync(std::deque<swss::KeyOpFieldsValuesTuple> &&entries);
+
+private:
+    /*
+     * Tasks popped beyond the budget of the schedule, handed to m_toSync on
+     * the next turns. The table is not popped again until the backlog is
+     * empty, m_popDue then tells that events were read meanwhile, so that
+     * the table is popped without waiting for another one.
+     */
+    std::deque<swss::KeyOpFieldsValuesTuple> m_backlog;
+    bool m_popDue = false;
+
+    size_t m_batchSize = 0;
+    size_t m_minBatchSize = 0;
+    size_t m_maxBatchSize = 0;
+    consumer_batch_stats_t m_batchStats = {};
+
+    /*
+     * Tasks left in m_toSync by doTask(Consumer&) are parked here, so that
+     * new tasks are handled without walking them again. New tasks of a
+     * parked key take the parked ones back to m_toSync first to be merged.
+     * Parked tasks are retried by drain() when a dependency changes state
+     * (see Orch::wakeRetries()), once after any other Consumer made progress,
+     * and otherwise with a capped exponential back-off while retries stall.
+     */
+    SyncMap m_parked;
+    uint64_t m_wakeEpoch = 0;
+    uint64_t m_progressEpoch = 0;
+    unsigned m_stalledRetries = 0;
+    std::chrono::milliseconds m_retryBackoff{0};
+    std::chrono::steady_clock::time_point m_nextRetry;
+    consumer_retry_stats_t m_retryStats = {};
+
+    /*
+     * Task statistics, only updated when enabled by Orch::enableTaskStats().
+     * Each Consumer runs on a single thread, the counters are atomics so
+     * that they are read without stopping it, and updated with plain
+     * load/store pairs which cost no more than the integers they replace.
+     */
+    struct TaskStats
+    {
+        std::atomic<uint64_t> popped{0};
+        std::atomic<uint64_t> completed{0};
+        std::atomic<uint64_t> failed{0};
+        std::atomic<uint64_t> dotask_us{0};
+        std::atomic<uint64_t> dotask_max_us{0};
+        std::atomic<uint64_t> flush_us{0};
+        std::atomic<int64_t> pending_since_ms{0};   // steady clock, 0 without pending tasks
+        std::atomic<uint64_t> latency[CONSUMER_LATENCY_BUCKETS] = {};
+    } m_taskStats;
+    std::chrono::steady_clock::time_point m_popTime;
+    std::chrono::steady_clock::time_point m_parkTime;
+
+    /* Bumped by Orch::wakeRetries() and by Consumers completing tasks */
+    static std::atomic<uint64_t> s_wakeEpoch;
+    static std::atomic<uint64_t> s_progressEpoch;
+    static std::atomic<bool> s_taskStats;
+    friend class Orch;
+
+    bool isRetryDue() const;
+    void retryParked();
+
+    /* Run doTask(Consumer&), tasks completed count as popped at 'since' */
+    void runTasks(std::chrono::steady_clock::time_point since);
+    void updatePendingSince(std::chrono::steady_clock::time_point since);
 };
 
 typedef std::map<std::string, std::shared_ptr<Executor>> ConsumerMap;
@@ -218,10 +429,31 @@ public:
     static void recordTuple(Consumer &consumer, const swss::KeyOpFieldsValuesTuple &tuple);
 
     void dumpPendingTasks(std::vector<std::string> &ts);
+
+    /* Number of tasks waiting in the consumers of this Orch */
+    size_t getPendingTaskCount() const;
+
+    /* Retry statistics of the consumers, by DB and table name */
+    void getRetryStats(std::vector<std::pair<std::string, consumer_retry_stats_t>> &stats) const;
+
+    /*
+     * Retry the parked tasks of all Consumers on their next drain, to be
+     * called when an object other tasks may wait on becomes available
+     * (port ready, bridge port, router interface, neighbor, VRF, ...).
+     */
+    static void wakeRetries();
+
+    /* Per table task statistics of all Consumers, disabled by default */
+    static void enableTaskStats(bool enable);
+    static bool isTaskStatsEnabled();
+    void getTaskStats(std::vector<std::pair<std::string, consumer_task_stats_t>> &stats) const;
+
+    /* Set the batch size of the consumers of the table, returns their number */
+    size_t setBatchSize(const std::string &tableName, size_t batch, size_t min, size_t max);
+    void getBatchStats(std::vector<std::pair<std::string, consumer_batch_stats_t>> &stats) const;
 protected:
     ConsumerMap m_consumerMap;
 
-    static void logfileReopen();
     std::string dumpTuple(Consumer &consumer, const swss::KeyOpFieldsValuesTuple &tuple);
     ref_resolve_status resolveFieldRefValue(type_map&, const std::string&, swss::KeyOpFieldsValuesTuple&, sai_object_id_t&, std::string&);
     bool parseIndexRange(const std::string &input, sai_uint32_t &range_low, sai_uint32_t &range_high);
@@ -1,6 +1,8 @@
 #include <unistd.h>
 #include <unordered_map>
+#include <unordered_set>
 #include <limits.h>
+#include <chrono>
 #include "orchdaemon.h"
 #include "logger.h"
 #include <sairedis.h>
@@ -15,11 +17,20 @@ using namespace swss;
 
 /* select() function timeout retry time */
 #define SELECT_TIMEOUT 1000
+/* Interval of the worker and retry statistics update in STATE_DB */
+#define ORCH_STATS_INTERVAL_MSECS 1000
+#define STATE_ORCH_WORKER_TABLE_NAME "ORCH_WORKER_TABLE"
+#define STATE_ORCH_RETRY_TABLE_NAME "ORCH_RETRY_TABLE"
+#define STATE_ORCH_TASK_STATS_TABLE_NAME "ORCH_TASK_STATS_TABLE"
+#define STATE_ORCH_BATCH_TABLE_NAME "ORCH_BATCH_TABLE"
 #define PFC_WD_POLL_MSECS 100
+/* Interval of the checks for urgent events during a drain pass of the Orchs */
+#define URGENT_POLL_INTERVAL_USECS 1000
 
 extern sai_switch_api_t*           sai_switch_api;
 extern sai_object_id_t             gSwitchId;
 extern bool                        gSaiRedisLogRotate;
+extern bool                        gOrchWorkers;
 
 extern void syncd_apply_view();
 /*
@@ -55,6 +66,9 @@ OrchDaemon::~OrchDaemon()
 {
     SWSS_LOG_ENTER();
 
+    /* Workers must not run Orchs being deleted */
+    m_scheduler.stop();
+
     /*
      * Some orchagents call other agents in their destructor.
      * To avoid accessing deleted agent, do deletion in reverse order.
@@ -101,7 +115,7 @@ bool OrchDaemon::init()
         { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri}
     };
 
-    gCrmOrch = new CrmOrch(m_configDb, CFG_CRM_TABLE_NAME);
+    gCrmOrch = new CrmOrch(getWorkerDb(m_configDb), CFG_CRM_TABLE_NAME);
     gPortsOrch = new PortsOrch(m_applDb, ports_tables, m_chassisAppDb);
     TableConnector stateDbFdb(m_stateDb, STATE_FDB_TABLE_NAME);
     gFdbOrch = new FdbOrch(m_applDb, app_fdb_tables, stateDbFdb, gPortsOrch);
@@ -220,21 +234,21 @@ bool OrchDaemon::init()
         CFG_FLEX_COUNTER_TABLE_NAME
     };
 
-    WatermarkOrch *wm_orch = new WatermarkOrch(m_configDb, wm_tables);
+    WatermarkOrch *wm_orch = new WatermarkOrch(getWorkerDb(m_configDb), wm_tables);
 
     vector<string> sflow_tables = {
             APP_SFLOW_TABLE_NAME,
             APP_SFLOW_SESSION_TABLE_NAME,
             APP_SFLOW_SAMPLE_RATE_TABLE_NAME
     };
-    SflowOrch *sflow_orch = new SflowOrch(m_applDb,  sflow_tables);
+    SflowOrch *sflow_orch = new SflowOrch(getWorkerDb(m_applDb),  sflow_tables);
 
     vector<string> debug_counter_tables = {
         CFG_DEBUG_COUNTER_TABLE_NAME,
         CFG_DEBUG_COUNTER_DROP_REASON_TABLE_NAME
     };
 
-    DebugCounterOrch *debug_counter_orch = new DebugCounterOrch(m_configDb, debug_counter_tables, 1000);
+    DebugCounterOrch *debug_counter_orch = new DebugCounterOrch(getWorkerDb(m_configDb), debug_counter_tables, 1000);
 
     const int natorch_base_pri = 50;
 
@@ -247,7 +261,7 @@ bool OrchDaemon::init()
         { APP_NAT_GLOBAL_TABLE_NAME,     natorch_base_pri     }
     };
 
-    gNatOrch = new NatOrch(m_applDb, m_stateDb, nat_tables, gRouteOrch, gNeighOrch);
+    gNatOrch = new NatOrch(getWorkerDb(m_applDb), getWorkerDb(m_stateDb), nat_tables, gRouteOrch, gNeighOrch);
 
     vector<string> mux_tables = {
         CFG_MUX_CABLE_TABLE_NAME,
@@ -345,6 +359,9 @@ bool OrchDaemon::init()
         CFG_PFC_WD_TABLE_NAME
     };
 
+    DBConnector *pfc_wd_config_db = getWorkerDb(m_configDb);
+    size_t orch_count = m_orchList.size();
+
     if (platform == MLNX_PLATFORM_SUBSTRING)
     {
 
@@ -377,7 +394,7 @@ bool OrchDaemon::init()
         static const vector<sai_queue_attr_t> queueAttrIds;
 
         m_orchList.push_back(new PfcWdSwOrch<PfcWdZeroBufferHandler, PfcWdLossyHandler>(
-                    m_configDb,
+                    pfc_wd_config_db,
                     pfc_wd_tables,
                     portStatIds,
                     queueStatIds,
@@ -420,7 +437,7 @@ bool OrchDaemon::init()
         if ((platform == INVM_PLATFORM_SUBSTRING) || (platform == NPS_PLATFORM_SUBSTRING))
         {
             m_orchList.push_back(new PfcWdSwOrch<PfcWdZeroBufferHandler, PfcWdLossyHandler>(
-                        m_configDb,
+                        pfc_wd_config_db,
                         pfc_wd_tables,
                         portStatIds,
                         queueStatIds,
@@ -430,7 +447,7 @@ bool OrchDaemon::init()
         else if (platform == BFN_PLATFORM_SUBSTRING)
         {
             m_orchList.push_back(new PfcWdSwOrch<PfcWdAclHandler, PfcWdLossyHandler>(
-                        m_configDb,
+                        pfc_wd_config_db,
                         pfc_wd_tables,
                         portStatIds,
                         queueStatIds,
@@ -472,7 +489,7 @@ bool OrchDaemon::init()
         };
 
         m_orchList.push_back(new PfcWdSwOrch<PfcWdAclHandler, PfcWdLossyHandler>(
-                    m_configDb,
+                    pfc_wd_config_db,
                     pfc_wd_tables,
                     portStatIds,
                     queueStatIds,
@@ -480,7 +497,43 @@ bool OrchDaemon::init()
                     PFC_WD_POLL_MSECS));
     }
 
+    /* PFC watchdog is only created on some platforms */
+    Orch *pfc_wd_orch = m_orchList.size() > orch_count ? m_orchList.back() : nullptr;
+
     m_orchList.push_back(&CounterCheckOrch::getInstance(m_configDb));
+    m_batchSizeOrch = new BatchSizeOrch(m_configDb);
+    m_orchList.push_back(m_batchSizeOrch);
+
+    if (gOrchWorkers)
+    {
+        /*
+         * Orchs off the port/route/neighbor/FDB pipeline run on workers,
+         * with the Orchs whose state they use as dependencies. CrmOrch is
+         * thread safe and called by Orchs of every thread, it is not one.
+         */
+        m_scheduler.assign(gCrmOrch, "crm");
+
+        m_scheduler.assign(wm_orch, "counters");
+        m_scheduler.addDependency(wm_orch, gPortsOrch);
+        m_scheduler.addDependency(wm_orch, gBufferOrch);
+        m_scheduler.assign(debug_counter_orch, "counters");
+        m_scheduler.addDependency(debug_counter_orch, gPortsOrch);
+
+        m_scheduler.assign(sflow_orch, "sflow");
+        m_scheduler.addDependency(sflow_orch, gPortsOrch);
+
+        m_scheduler.assign(gNatOrch, "nat");
+        m_scheduler.addDependency(gNatOrch, gPortsOrch);
+        m_scheduler.addDependency(gNatOrch, gRouteOrch);
+        m_scheduler.addDependency(gNatOrch, gNeighOrch);
+
+        if (pfc_wd_orch)
+        {
+            m_scheduler.assign(pfc_wd_orch, "pfcwd");
+            m_scheduler.addDependency(pfc_wd_orch, gPortsOrch);
+            m_scheduler.addDependency(pfc_wd_orch, gAclOrch);
+        }
+    }
 
     if (WarmStart::isWarmStart())
     {
@@ -494,6 +547,158 @@ bool OrchDaemon::init()
     return true;
 }
 
+/*
+ * Orchs run on a worker get their own connection, connectors are not thread
+ * safe. The daemon owns the connection, which outlives the Orchs built on it.
+ */
+DBConnector *OrchDaemon::getWorkerDb(DBConnector *db)
+{
+    if (!gOrchWorkers)
+    {
+        return db;
+    }
+
+    m_workerDbs.push_back(make_unique<DBConnector>(db->getDbName(), 0));
+    return m_workerDbs.back().get();
+}
+
+void OrchDaemon::publishRetryStats(Table &table)
+{
+    vector<pair<string, consumer_retry_stats_t>> retryStats;
+
+    /* Consumers of the workers are updated under their guards */
+    for (Orch *o : m_orchList)
+    {
+        m_scheduler.lock(o);
+        o->getRetryStats(retryStats);
+        m_scheduler.unlock(o);
+    }
+
+    for (const auto &it : retryStats)
+    {
+        const auto &stats = it.second;
+        if (!stats.retries && !stats.parked)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> fvs = {
+            { "runs", to_string(stats.runs) },
+            { "retries", to_string(stats.retries) },
+            { "retried_tasks", to_string(stats.retried_tasks) },
+            { "stalled", to_string(stats.stalled) },
+            { "parked", to_string(stats.parked) }
+        };
+        table.set(it.first, fvs);
+    }
+}
+
+void OrchDaemon::publishTaskStats(Table &table)
+{
+    vector<pair<string, consumer_task_stats_t>> taskStats;
+
+    /* Task statistics are atomics, read without stopping the workers */
+    for (Orch *o : m_orchList)
+    {
+        o->getTaskStats(taskStats);
+    }
+
+    for (const auto &it : taskStats)
+    {
+        const auto &stats = it.second;
+        if (!stats.popped && !stats.completed && !stats.queue_age_ms)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> fvs = {
+            { "popped", to_string(stats.popped) },
+            { "completed", to_string(stats.completed) },
+            { "failed", to_string(stats.failed) },
+            { "dotask_us", to_string(stats.dotask_us) },
+            { "dotask_max_us", to_string(stats.dotask_max_us) },
+            { "flush_us", to_string(stats.flush_us) },
+            { "queue_age_ms", to_string(stats.queue_age_ms) }
+        };
+        for (size_t i = 0; i < CONSUMER_LATENCY_BUCKETS; i++)
+        {
+            fvs.emplace_back("latency_" + Consumer::getLatencyBucketName(i), to_string(stats.latency[i]));
+        }
+        table.set(it.first, fvs);
+    }
+}
+
+void OrchDaemon::publishBatchStats(Table &table)
+{
+    vector<pair<string, consumer_batch_stats_t>> batchStats;
+
+    for (Orch *o : m_orchList)
+    {
+        m_scheduler.lock(o);
+        o->getBatchStats(batchStats);
+        m_scheduler.unlock(o);
+    }
+
+    for (const auto &it : batchStats)
+    {
+        const auto &stats = it.second;
+        if (!stats.batch_size && !stats.max_batch_size)
+        {
+            continue;
+        }
+
+        uint64_t avg_batch = stats.turns ? stats.popped / stats.turns : 0;
+        vector<FieldValueTuple> fvs = {
+            { "batch_size", to_string(stats.batch_size) },
+            { "min_batch_size", to_string(stats.min_batch_size) },
+            { "max_batch_size", to_string(stats.max_batch_size) },
+            { "pops", to_string(stats.pops) },
+            { "turns", to_string(stats.turns) },
+            { "popped", to_string(stats.popped) },
+            { "avg_batch", to_string(avg_batch) },
+            { "grown", to_string(stats.grown) },
+            { "shrunk", to_string(stats.shrunk) },
+            { "task_cost_ns", to_string(stats.task_cost_ns) }
+        };
+        table.set(it.first, fvs);
+    }
+}
+
+void OrchDaemon::applyBatchSizes()
+{
+    /* Consumers of the workers read their batch sizes unlocked while they run */
+    for (const auto &request : m_batchSizeOrch->takeRequests())
+    {
+        size_t count = 0;
+
+        for (Orch *o : m_orchList)
+        {
+            m_scheduler.lock(o);
+            count += o->setBatchSize(request.table, request.batch, request.min, request.max);
+            m_scheduler.unlock(o);
+        }
+
+        SWSS_LOG_NOTICE("Set batch size of %s to %zu, min %zu, max %zu, on %zu consumers",
+                        request.table.c_str(), request.batch, request.min, request.max, count);
+    }
+}
+
+void OrchDaemon::publishWorkerStats(Table &table)
+{
+    for (const auto &stats : m_scheduler.getStats())
+    {
+        uint64_t avg_latency = stats.events ? stats.total_latency_us / stats.events : 0;
+        vector<FieldValueTuple> fvs = {
+            { "orchs", to_string(stats.orchs) },
+            { "queue_depth", to_string(stats.queue_depth) },
+            { "events", to_string(stats.events) },
+            { "avg_latency_us", to_string(avg_latency) },
+            { "max_latency_us", to_string(stats.max_latency_us) }
+        };
+        table.set(stats.name, fvs);
+    }
+}
+
 /* Flush redis through sairedis interface */
 void OrchDaemon::flush()
 {
@@ -522,21 +727,138 @@ void OrchDaemon::flush()
     }
 }
 
+/*
+ * A drain pass may take long, e.g. with a burst of routes pending. Urgent
+ * events received meanwhile, such as port oper status changes, are executed
+ * between the Orchs of the pass instead of after it.
+ */
+void OrchDaemon::serviceUrgentExecutors()
+{
+    if (!m_urgentCount)
+    {
+        return;
+    }
+
+    auto now = chrono::steady_clock::now();
+    if (now - m_lastUrgentPoll < chrono::microseconds(URGENT_POLL_INTERVAL_USECS))
+    {
+        return;
+    }
+    m_lastUrgentPoll = now;
+
+    Selectable *s;
+    while (m_urgentSelect.select(&s, 0) == Select::OBJECT)
+    {
+        auto *c = (Executor *)s;
+        c->execute();
+    }
+}
+
+void OrchDaemon::addExecutors(Orch *orch)
+{
+    for (Selectable *selectable : orch->getSelectables())
+    {
+        auto *executor = static_cast<Executor *>(selectable);
+
+        /* Set by the owning Orch, e.g. with Executor::setBulkSchedule() */
+        const ExecutorSchedule &schedule = executor->getSchedule();
+
+        m_select->addSelectable(selectable);
+        m_executorIds[selectable] = m_fairScheduler.add({ schedule.pri, schedule.weight, schedule.deadline });
+        m_executors.push_back(executor);
+
+        if (schedule.pri >= urgent_orch_pri)
+        {
+            m_urgentSelect.addSelectable(selectable);
+            m_urgentCount++;
+        }
+    }
+}
+
+/*
+ * Wait for events on the Executors of the main thread Orchs and pick the one
+ * to run with m_fairScheduler, among all those ready. The Select returns the
+ * ready Executors in turn as they have the same priority, so that they are
+ * all collected once it returns one a second time. Each Executor returned
+ * counts as one event, and runs once for each of them.
+ */
+int OrchDaemon::selectExecutor(Executor **executor, int timeout)
+{
+    Selectable *s;
+    unordered_set<Selectable *> collected;
+
+    if (!m_fairScheduler.hasReady())
+    {
+        int ret = m_select->select(&s, timeout);
+        if (ret != Select::OBJECT)
+        {
+            return ret;
+        }
+
+        m_fairScheduler.notify(m_executorIds.at(s), chrono::steady_clock::now());
+        collected.insert(s);
+    }
+
+    while (m_select->select(&s, 0) == Select::OBJECT)
+    {
+        m_fairScheduler.notify(m_executorIds.at(s), chrono::steady_clock::now());
+        if (!collected.insert(s).second)
+        {
+            break;
+        }
+    }
+
+    size_t id;
+    m_fairScheduler.next(id, chrono::steady_clock::now());
+    *executor = m_executors[id];
+    return Select::OBJECT;
+}
+
 void OrchDaemon::start()
 {
     SWSS_LOG_ENTER();
 
+    /* Orchs running on workers are selected by their worker */
+    vector<Orch *> mainOrchs;
     for (Orch *o : m_orchList)
     {
-        m_select->addSelectables(o->getSelectables());
+        if (m_scheduler.isAssigned(o))
+        {
+            continue;
+        }
+        mainOrchs.push_back(o);
+        addExecutors(o);
     }
 
+    Table workerStatsTable(m_stateDb, STATE_ORCH_WORKER_TABLE_NAME);
+    Table retryStatsTable(m_stateDb, STATE_ORCH_RETRY_TABLE_NAME);
+    Table taskStatsTable(m_stateDb, STATE_ORCH_TASK_STATS_TABLE_NAME);
+    Table batchStatsTable(m_stateDb, STATE_ORCH_BATCH_TABLE_NAME);
+    auto lastStatsUpdate = chrono::steady_clock::now();
+
+    m_scheduler.start();
+
     while (true)
     {
-        Selectable *s;
+        Executor *c;
         int ret;
 
-        ret = m_select->select(&s, SELECT_TIMEOUT);
+        ret = selectExecutor(&c, SELECT_TIMEOUT);
+
+        if (chrono::steady_clock::now() - lastStatsUpdate >= chrono::milliseconds(ORCH_STATS_INTERVAL_MSECS))
+        {
+            if (m_scheduler.hasWorkers())
+            {
+                publishWorkerStats(workerStatsTable);
+            }
+            publishRetryStats(retryStatsTable);
+            publishBatchStats(batchStatsTable);
+            if (Orch::isTaskStatsEnabled())
+            {
+                publishTaskStats(taskStatsTable);
+            }
+            lastStatsUpdate = chrono::steady_clock::now();
+        }
 
         if (ret == Select::ERROR)
         {
@@ -546,6 +868,17 @@ void OrchDaemon::start()
 
         if (ret == Select::TIMEOUT)
         {
+            /* Parked tasks whose back-off expired are retried while idle */
+            m_lastUrgentPoll = chrono::steady_clock::now();
+            for (Orch *o : mainOrchs)
+            {
+                m_scheduler.lockShared();
+                o->doTask();
+                serviceUrgentExecutors();
+                m_scheduler.unlockShared();
+            }
+            applyBatchSizes();
+
             /* Let sairedis to flush all SAI function call to ASIC DB.
              * Normally the redis pipeline will flush when enough request
              * accumulated. Still it is possible that small amount of
@@ -555,15 +888,27 @@ void OrchDaemon::start()
             continue;
         }
 
-        auto *c = (Executor *)s;
+        /* Workers get the shared guards between the runs of the main thread Orchs */
+        m_scheduler.lockShared();
+        auto begin = chrono::steady_clock::now();
         c->execute();
+        auto end = chrono::steady_clock::now();
+        m_scheduler.unlockShared();
+        m_fairScheduler.done(m_executorIds.at(c), end - begin, c->hasPendingWork(), end);
 
-        /* After each iteration, periodically check all m_toSync map to
-         * execute all the remaining tasks that need to be retried. */
+        /* After each iteration, drain the Consumers which got new tasks
+         * and retry the parked tasks which are due, see Consumer::drain() */
 
         /* TODO: Abstract Orch class to have a specific todo list */
-        for (Orch *o : m_orchList)
+        m_lastUrgentPoll = chrono::steady_clock::now();
+        for (Orch *o : mainOrchs)
+        {
+            m_scheduler.lockShared();
             o->doTask();
+            serviceUrgentExecutors();
+            m_scheduler.unlockShared();
+        }
+        applyBatchSizes();
 
         /*
          * Asked to check warm restart readiness.
@@ -572,6 +917,8 @@ void OrchDaemon::start()
          */
         if (gSwitchOrch->checkRestartReady())
         {
+            /* Pending tasks of all Orchs are checked, workers included */
+            m_scheduler.suspend();
             bool ret = warmRestartCheck();
             if (ret)
             {
@@ -596,6 +943,7 @@ void OrchDaemon::start()
                     sleep(UINT_MAX);
                 }
             }
+            m_scheduler.resume();
         }
     }
 }
@@ -628,6 +976,9 @@ bool OrchDaemon::warmRestoreAndSyncUp()
     {
         SWSS_LOG_DEBUG("The current doTask iteration is %d", it);
 
+        /* Retry all the tasks left by the previous iteration */
+        Orch::wakeRetries();
+
         for (Orch *o : m_orchList)
         {
             if (o == gMirrorOrch) {
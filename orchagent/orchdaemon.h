@@ -7,6 +7,7 @@
 #include "select.h"
 
 #include "portsorch.h"
+#include "fairscheduler.h"
 #include "intfsorch.h"
 #include "neighorch.h"
 #include "routeorch.h"
@@ -33,6 +34,8 @@
 #include "natorch.h"
 #include "muxorch.h"
 #include "macsecorch.h"
+#include "batchsizeorch.h"
+#include "orchscheduler.h"
 
 using namespace swss;
 
@@ -57,8 +60,32 @@ private:
 
     std::vector<Orch *> m_orchList;
     Select *m_select;
+    BatchSizeOrch *m_batchSizeOrch = nullptr;
+
+    /* Order in which the ready Executors of the main thread Orchs run */
+    FairScheduler m_fairScheduler{urgent_orch_pri};
+    std::vector<Executor *> m_executors;
+    std::unordered_map<Selectable *, size_t> m_executorIds;
+
+    /* Urgent Executors of the main thread Orchs, polled during drain passes */
+    Select m_urgentSelect;
+    size_t m_urgentCount = 0;
+    std::chrono::steady_clock::time_point m_lastUrgentPoll;
+
+    /* Worker threads and the DB connectors of the Orchs they run */
+    OrchScheduler m_scheduler;
+    std::vector<std::unique_ptr<DBConnector>> m_workerDbs;
 
     void flush();
+    void serviceUrgentExecutors();
+    void addExecutors(Orch *orch);
+    int selectExecutor(Executor **executor, int timeout);
+    DBConnector *getWorkerDb(DBConnector *db);
+    void publishWorkerStats(Table &table);
+    void publishRetryStats(Table &table);
+    void publishTaskStats(Table &table);
+    void publishBatchStats(Table &table);
+    void applyBatchSizes();
 };
 
 #endif /* SWSS_ORCHDAEMON_H */
@@ -0,0 +1,304 @@
+#include <chrono>
+#include <algorithm>
+#include <string.h>
+
+#include "orchscheduler.h"
+#include "select.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+/* select() timeout of the workers, bounds the time stop() waits for them */
+#define WORKER_SELECT_TIMEOUT 1000
+
+OrchScheduler::OrchScheduler() :
+    m_running(false)
+{
+}
+
+OrchScheduler::~OrchScheduler()
+{
+    stop();
+}
+
+void OrchScheduler::assign(Orch *orch, const string &worker)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_running)
+    {
+        SWSS_LOG_THROW("Cannot assign an Orch to worker %s, scheduler is running", worker.c_str());
+    }
+
+    if (m_assignments.find(orch) != m_assignments.end())
+    {
+        SWSS_LOG_THROW("Orch is already assigned to worker %s", m_assignments[orch]->name.c_str());
+    }
+
+    auto it = find_if(m_workers.begin(), m_workers.end(),
+            [&worker](const unique_ptr<Worker> &w) { return w->name == worker; });
+    if (it == m_workers.end())
+    {
+        m_workers.emplace_back(new Worker());
+        it = prev(m_workers.end());
+        (*it)->name = worker;
+        (*it)->stats = { worker, 0, 0, 0, 0, 0 };
+    }
+
+    (*it)->orchs.push_back(orch);
+    (*it)->stats.orchs = (*it)->orchs.size();
+    m_assignments[orch] = it->get();
+}
+
+void OrchScheduler::addDependency(Orch *orch, Orch *dependency)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_assignments.find(orch);
+    if (m_running || it == m_assignments.end())
+    {
+        SWSS_LOG_THROW("Dependencies can only be added to Orchs assigned to a worker before start");
+    }
+
+    it->second->dependencies.push_back(dependency);
+}
+
+bool OrchScheduler::isAssigned(Orch *orch) const
+{
+    return m_assignments.find(orch) != m_assignments.end();
+}
+
+size_t OrchScheduler::getGuard(Orch *orch)
+{
+    auto it = m_guardIds.find(orch);
+    if (it != m_guardIds.end())
+    {
+        return it->second;
+    }
+
+    m_guards.emplace_back();
+    m_guardIds[orch] = m_guards.size() - 1;
+    return m_guards.size() - 1;
+}
+
+void OrchScheduler::start()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_running)
+    {
+        return;
+    }
+
+    for (auto &worker : m_workers)
+    {
+        worker->guards.clear();
+        for (Orch *orch : worker->orchs)
+        {
+            worker->guards.push_back(getGuard(orch));
+        }
+        for (Orch *orch : worker->dependencies)
+        {
+            worker->guards.push_back(getGuard(orch));
+        }
+
+        /* Taking guards in id order on every thread keeps them from deadlocking */
+        sort(worker->guards.begin(), worker->guards.end());
+        worker->guards.erase(unique(worker->guards.begin(), worker->guards.end()), worker->guards.end());
+    }
+
+    /* Guards of the main thread Orchs used by workers */
+    m_sharedGuards.clear();
+    for (auto &worker : m_workers)
+    {
+        for (Orch *orch : worker->dependencies)
+        {
+            if (!isAssigned(orch))
+            {
+                m_sharedGuards.push_back(getGuard(orch));
+            }
+        }
+    }
+    sort(m_sharedGuards.begin(), m_sharedGuards.end());
+    m_sharedGuards.erase(unique(m_sharedGuards.begin(), m_sharedGuards.end()), m_sharedGuards.end());
+
+    m_running = true;
+
+    for (auto &worker : m_workers)
+    {
+        Worker *w = worker.get();
+        w->thread = thread([this, w]() { run(*w); });
+
+        SWSS_LOG_NOTICE("Started worker %s with %zu orchs and %zu guards",
+                w->name.c_str(), w->orchs.size(), w->guards.size());
+    }
+
+    SWSS_LOG_NOTICE("Main thread shares %zu guards with the workers", m_sharedGuards.size());
+}
+
+void OrchScheduler::stop()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_running)
+    {
+        return;
+    }
+
+    m_running = false;
+
+    for (auto &worker : m_workers)
+    {
+        if (worker->thread.joinable())
+        {
+            worker->thread.join();
+        }
+    }
+}
+
+void OrchScheduler::lockGuards(const vector<size_t> &guards)
+{
+    for (auto guard : guards)
+    {
+        m_guards[guard].lock();
+    }
+}
+
+void OrchScheduler::unlockGuards(const vector<size_t> &guards)
+{
+    for (auto it = guards.rbegin(); it != guards.rend(); ++it)
+    {
+        m_guards[*it].unlock();
+    }
+}
+
+void OrchScheduler::lockShared()
+{
+    lockGuards(m_sharedGuards);
+}
+
+void OrchScheduler::unlockShared()
+{
+    unlockGuards(m_sharedGuards);
+}
+
+void OrchScheduler::lock(Orch *orch)
+{
+    auto it = m_guardIds.find(orch);
+    if (it != m_guardIds.end())
+    {
+        m_guards[it->second].lock();
+    }
+}
+
+void OrchScheduler::unlock(Orch *orch)
+{
+    auto it = m_guardIds.find(orch);
+    if (it != m_guardIds.end())
+    {
+        m_guards[it->second].unlock();
+    }
+}
+
+void OrchScheduler::suspend()
+{
+    for (auto &worker : m_workers)
+    {
+        worker->run_mutex.lock();
+    }
+}
+
+void OrchScheduler::resume()
+{
+    for (auto it = m_workers.rbegin(); it != m_workers.rend(); ++it)
+    {
+        (*it)->run_mutex.unlock();
+    }
+}
+
+vector<OrchScheduler::WorkerStats> OrchScheduler::getStats() const
+{
+    vector<WorkerStats> stats;
+
+    for (const auto &worker : m_workers)
+    {
+        lock_guard<mutex> lock(worker->stats_mutex);
+        stats.push_back(worker->stats);
+    }
+
+    return stats;
+}
+
+void OrchScheduler::run(Worker &worker)
+{
+    SWSS_LOG_ENTER();
+
+    Select select;
+    for (Orch *orch : worker.orchs)
+    {
+        select.addSelectables(orch->getSelectables());
+    }
+
+    while (m_running)
+    {
+        Selectable *s;
+        int ret = select.select(&s, WORKER_SELECT_TIMEOUT);
+
+        if (ret == Select::ERROR)
+        {
+            SWSS_LOG_NOTICE("Worker %s error: %s!", worker.name.c_str(), strerror(errno));
+            continue;
+        }
+
+        if (ret == Select::TIMEOUT)
+        {
+            /* Retry the parked tasks whose back-off expired */
+            lock_guard<mutex> run_lock(worker.run_mutex);
+            lockGuards(worker.guards);
+            for (Orch *orch : worker.orchs)
+            {
+                orch->doTask();
+            }
+            unlockGuards(worker.guards);
+            continue;
+        }
+
+        auto begin = chrono::steady_clock::now();
+        size_t depth = 0;
+
+        {
+            lock_guard<mutex> run_lock(worker.run_mutex);
+            lockGuards(worker.guards);
+
+            /* Workers have no FairScheduler, work left over the budget is done at once */
+            auto *c = (Executor *)s;
+            do
+            {
+                c->execute();
+            } while (c->hasPendingWork());
+
+            /* Retry the pending tasks of the worker Orchs, as the main loop does */
+            for (Orch *orch : worker.orchs)
+            {
+                orch->doTask();
+            }
+
+            for (Orch *orch : worker.orchs)
+            {
+                depth += orch->getPendingTaskCount();
+            }
+
+            unlockGuards(worker.guards);
+        }
+
+        auto latency = static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(
+                chrono::steady_clock::now() - begin).count());
+
+        lock_guard<mutex> lock(worker.stats_mutex);
+        worker.stats.queue_depth = depth;
+        worker.stats.events++;
+        worker.stats.total_latency_us += latency;
+        worker.stats.max_latency_us = max(worker.stats.max_latency_us, latency);
+    }
+}
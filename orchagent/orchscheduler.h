@@ -0,0 +1,112 @@
+#ifndef SWSS_ORCHSCHEDULER_H
+#define SWSS_ORCHSCHEDULER_H
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "orch.h"
+
+/*
+ * Runs groups of Orchs on worker threads.
+ *
+ * Orchs not assigned to a worker keep running on the main thread in
+ * OrchDaemon::start(). Each worker has its own Select loop over the
+ * selectables of its Orchs and, like the main loop, runs doTask() of all of
+ * them after every event, so Orchs of a worker keep their relative order.
+ *
+ * Orchagent state is not thread safe. Every Orch assigned to a worker, and
+ * every Orch declared as a dependency of one, is protected by a guard. A
+ * worker holds the guards of its own Orchs and of their dependencies while
+ * it processes an event. Main thread Orchs call into each other freely, so
+ * the main thread holds the guards of the main thread Orchs which workers
+ * depend on while it runs any of its Orchs, and never the guards of the
+ * worker Orchs. Workers with no main thread dependency run concurrently with
+ * the main thread, and workers which share no guard run concurrently with
+ * each other. Guards are always taken in the same order, which avoids
+ * deadlocks.
+ *
+ * An Orch assigned to a worker must be built on DB connectors that are not
+ * used by any other thread. An Orch called by the Orchs of other threads
+ * must not be declared as a dependency but made thread safe, as CrmOrch is.
+ */
+class OrchScheduler
+{
+public:
+    struct WorkerStats
+    {
+        std::string name;
+        size_t orchs;
+        size_t queue_depth;         // tasks left in the worker Orchs after the last event
+        uint64_t events;            // events processed
+        uint64_t total_latency_us;  // time spent on events, waiting for guards included
+        uint64_t max_latency_us;
+    };
+
+    OrchScheduler();
+    ~OrchScheduler();
+
+    OrchScheduler(const OrchScheduler&) = delete;
+    OrchScheduler& operator=(const OrchScheduler&) = delete;
+
+    /* Run the Orch on the named worker, the worker is created on first use */
+    void assign(Orch *orch, const std::string &worker);
+
+    /* The Orch, which must be assigned to a worker, uses the state of another Orch */
+    void addDependency(Orch *orch, Orch *dependency);
+
+    bool isAssigned(Orch *orch) const;
+    bool hasWorkers() const { return !m_workers.empty(); }
+
+    void start();
+    void stop();
+
+    /* Taken by the main thread around each run of one of its Orchs */
+    void lockShared();
+    void unlockShared();
+
+    /* Taken by the main thread to read the state of one Orch, no-op for Orchs without a guard */
+    void lock(Orch *orch);
+    void unlock(Orch *orch);
+
+    /*
+     * Wait for the workers to finish their current event and keep them from
+     * starting a new one, until resume(). Not to be called under lockShared().
+     */
+    void suspend();
+    void resume();
+
+    std::vector<WorkerStats> getStats() const;
+
+private:
+    struct Worker
+    {
+        std::string name;
+        std::vector<Orch *> orchs;
+        std::vector<Orch *> dependencies;
+        std::vector<size_t> guards;
+        std::mutex run_mutex;
+        std::thread thread;
+        mutable std::mutex stats_mutex;
+        WorkerStats stats;
+    };
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::map<Orch *, Worker *> m_assignments;
+    std::map<Orch *, size_t> m_guardIds;
+    std::deque<std::mutex> m_guards;
+    std::vector<size_t> m_sharedGuards;
+    std::atomic<bool> m_running;
+
+    size_t getGuard(Orch *orch);
+    void lockGuards(const std::vector<size_t> &guards);
+    void unlockGuards(const std::vector<size_t> &guards);
+    void run(Worker &worker);
+};
+
+#endif /* SWSS_ORCHSCHEDULER_H */
@@ -695,11 +695,13 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
             this->getCountersDb().get(),
             "PFC_WD_ACTION");
     auto wdNotification = new Notifier(consumer, this, "PFC_WD_ACTION");
+    wdNotification->setLatencySensitiveSchedule();
     Orch::addExecutor(wdNotification);
 
     auto interv = timespec { .tv_sec = COUNTER_CHECK_POLL_TIMEOUT_SEC, .tv_nsec = 0 };
     auto timer = new SelectableTimer(interv);
     auto executor = new ExecutableTimer(timer, this, "PFC_WD_COUNTERS_POLL");
+    executor->setLatencySensitiveSchedule();
     Orch::addExecutor(executor);
     timer->start();
 
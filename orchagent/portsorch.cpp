@@ -29,6 +29,7 @@
 #include "notifier.h"
 #include "fdborch.h"
 #include "subscriberstatetable.h"
+#include "timestamp.h"
 
 extern sai_switch_api_t *sai_switch_api;
 extern sai_bridge_api_t *sai_bridge_api;
@@ -65,6 +66,8 @@ extern string gMyAsicName;
 #define PG_DROP_FLEX_STAT_COUNTER_POLL_MSECS         "10000"
 #define PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS   "1000"
 
+#define PORT_DOWN_METRICS_TABLE_NAME "PORT_DOWN_METRICS_TABLE"
+
 
 static map<string, sai_port_fec_mode_t> fec_mode_map =
 {
@@ -271,6 +274,7 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
 
     m_state_db = shared_ptr<DBConnector>(new DBConnector("STATE_DB", 0));
     m_stateBufferMaximumValueTable = unique_ptr<Table>(new Table(m_state_db.get(), STATE_BUFFER_MAXIMUM_VALUE_TABLE));
+    m_portDownMetricsTable = unique_ptr<Table>(new Table(m_state_db.get(), PORT_DOWN_METRICS_TABLE_NAME));
 
     initGearbox();
 
@@ -334,7 +338,7 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
 
     m_cpuPort = Port("CPU", Port::CPU);
     m_cpuPort.m_port_id = attr.value.oid;
-    m_portList[m_cpuPort.m_alias] = m_cpuPort;
+    setPort(m_cpuPort.m_alias, m_cpuPort);
     m_port_ref_count[m_cpuPort.m_alias] = 0;
 
     /* Get port number */
@@ -423,7 +427,8 @@ PortsOrch::PortsOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
     /* Add port oper status notification support */
     DBConnector *notificationsDb = new DBConnector("ASIC_DB", 0);
     m_portStatusNotificationConsumer = new swss::NotificationConsumer(notificationsDb, "NOTIFICATIONS");
-    auto portStatusNotificatier = new Notifier(m_portStatusNotificationConsumer, this, "PORT_STATUS_NOTIFICATIONS");
+    auto portStatusNotificatier = new Notifier(m_portStatusNotificationConsumer, this, "PORT_STATUS_NOTIFICATIONS", urgent_orch_pri);
+    portStatusNotificatier->setLatencySensitiveSchedule();
     Orch::addExecutor(portStatusNotificatier);
 
     if (gMySwitchType == "voq")
@@ -612,38 +617,113 @@ bool PortsOrch::getPort(sai_object_id_t id, Port &port)
 {
     SWSS_LOG_ENTER();
 
-    for (const auto& portIter: m_portList)
+    Port *p = getPortPtr(id);
+    if (p == nullptr)
+    {
+        return false;
+    }
+
+    port = *p;
+    return true;
+}
+
+Port *PortsOrch::getPortPtr(const string &alias)
+{
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
+Port *PortsOrch::getPortPtr(sai_object_id_t id)
+{
+    auto it = m_portOidIndex.find(id);
+    if (it == m_portOidIndex.end())
+    {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+sai_object_id_t PortsOrch::getPortIndexOid(const Port &port)
+{
+    switch (port.m_type)
+    {
+    case Port::PHY:
+    case Port::SYSTEM:
+        return port.m_port_id;
+    case Port::LAG:
+        return port.m_lag_id;
+    case Port::VLAN:
+        return port.m_vlan_info.vlan_oid;
+    default:
+        return SAI_NULL_OBJECT_ID;
+    }
+}
+
+static void unindexId(unordered_map<sai_object_id_t, Port *> &index, sai_object_id_t id, const Port *port)
+{
+    auto it = index.find(id);
+    if (it != index.end() && it->second == port)
+    {
+        index.erase(it);
+    }
+}
+
+void PortsOrch::indexPort(const string &alias)
+{
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        return;
+    }
+
+    Port &port = it->second;
+    PortIndexIds &ids = m_portIndexIds[&port];
+
+    sai_object_id_t oid = getPortIndexOid(port);
+    if (oid != ids.oid)
     {
-        switch (portIter.second.m_type)
+        unindexId(m_portOidIndex, ids.oid, &port);
+        if (oid != SAI_NULL_OBJECT_ID)
         {
-        case Port::PHY:
-        case Port::SYSTEM:
-            if(portIter.second.m_port_id == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        case Port::LAG:
-            if(portIter.second.m_lag_id == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        case Port::VLAN:
-            if (portIter.second.m_vlan_info.vlan_oid == id)
-            {
-                port = portIter.second;
-                return true;
-            }
-            break;
-        default:
-            continue;
+            m_portOidIndex[oid] = &port;
         }
+        ids.oid = oid;
     }
 
-    return false;
+    if (port.m_bridge_port_id != ids.bridge_port_id)
+    {
+        unindexId(m_bridgePortIdIndex, ids.bridge_port_id, &port);
+        if (port.m_bridge_port_id != SAI_NULL_OBJECT_ID)
+        {
+            m_bridgePortIdIndex[port.m_bridge_port_id] = &port;
+        }
+        ids.bridge_port_id = port.m_bridge_port_id;
+    }
+}
+
+void PortsOrch::unindexPort(const string &alias)
+{
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        return;
+    }
+
+    auto ids = m_portIndexIds.find(&it->second);
+    if (ids == m_portIndexIds.end())
+    {
+        return;
+    }
+
+    unindexId(m_portOidIndex, ids->second.oid, &it->second);
+    unindexId(m_bridgePortIdIndex, ids->second.bridge_port_id, &it->second);
+    m_portIndexIds.erase(ids);
 }
 
 void PortsOrch::increasePortRefCount(const string &alias)
@@ -662,16 +742,25 @@ bool PortsOrch::getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port
 {
     SWSS_LOG_ENTER();
 
-    for (auto &it: m_portList)
+    Port *p = getPortPtrByBridgePortId(bridge_port_id);
+    if (p == nullptr)
     {
-        if (it.second.m_bridge_port_id == bridge_port_id)
-        {
-            port = it.second;
-            return true;
-        }
+        return false;
     }
 
-    return false;
+    port = *p;
+    return true;
+}
+
+Port *PortsOrch::getPortPtrByBridgePortId(sai_object_id_t bridge_port_id)
+{
+    auto it = m_bridgePortIdIndex.find(bridge_port_id);
+    if (it == m_bridgePortIdIndex.end())
+    {
+        return nullptr;
+    }
+
+    return it->second;
 }
 
 bool PortsOrch::addSubPort(Port &port, const string &alias, const bool &adminUp, const uint32_t &mtu)
@@ -755,7 +844,7 @@ bool PortsOrch::addSubPort(Port &port, const string &alias, const bool &adminUp,
 
     parentPort.m_child_ports.insert(p.m_alias);
 
-    m_portList[alias] = p;
+    setPort(alias, p);
     port = p;
     return true;
 }
@@ -786,8 +875,9 @@ bool PortsOrch::removeSubPort(const string &alias)
     {
         SWSS_LOG_WARN("Sub interface %s not associated to parent port %s", alias.c_str(), parentPort.m_alias.c_str());
     }
-    m_portList[parentPort.m_alias] = parentPort;
+    setPort(parentPort.m_alias, parentPort);
 
+    unindexPort(alias);
     m_portList.erase(it);
 
     // Restore hostif vlan tag for the parent port when the last subport is removed
@@ -824,7 +914,7 @@ void PortsOrch::updateChildPortsMtu(const Port &p, const uint32_t mtu)
         }
 
         subp.m_mtu = mtu;
-        m_portList[child_port] = subp;
+        setPort(child_port, subp);
         SWSS_LOG_NOTICE("Sub interface %s inherits mtu change %u from parent port %s", child_port.c_str(), mtu, p.m_alias.c_str());
 
         if (subp.m_rif_id)
@@ -834,9 +924,10 @@ void PortsOrch::updateChildPortsMtu(const Port &p, const uint32_t mtu)
     }
 }
 
-void PortsOrch::setPort(string alias, Port p)
+void PortsOrch::setPort(const string &alias, const Port &p)
 {
     m_portList[alias] = p;
+    indexPort(alias);
 }
 
 void PortsOrch::getCpuPort(Port &port)
@@ -947,15 +1038,15 @@ bool PortsOrch::getPortPfc(sai_object_id_t portId, uint8_t *pfc_bitmask)
 {
     SWSS_LOG_ENTER();
 
-    Port p;
+    Port *p = getPortPtr(portId);
 
-    if (!getPort(portId, p))
+    if (p == nullptr)
     {
         SWSS_LOG_ERROR("Failed to get port object for port id 0x%" PRIx64, portId);
         return false;
     }
 
-    *pfc_bitmask = p.m_pfc_bitmask;
+    *pfc_bitmask = p->m_pfc_bitmask;
 
     return true;
 }
@@ -1003,7 +1094,7 @@ bool PortsOrch::setPortPfc(sai_object_id_t portId, uint8_t pfc_bitmask)
     if (p.m_pfc_bitmask != pfc_bitmask)
     {
         p.m_pfc_bitmask = pfc_bitmask;
-        m_portList[p.m_alias] = p;
+        setPort(p.m_alias, p);
     }
 
     return true;
@@ -1036,7 +1127,7 @@ bool PortsOrch::setPortPfcAsym(Port &port, string pfc_asym)
     }
 
     port.m_pfc_asym = new_pfc_asym;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
 
     attr.id = SAI_PORT_ATTR_PRIORITY_FLOW_CONTROL_MODE;
     attr.value.s32 = (int32_t) port.m_pfc_asym;
@@ -1965,7 +2056,7 @@ bool PortsOrch::createVlanHostIntf(Port& vl, string hostif_name)
         return false;
     }
 
-    m_portList[vl.m_alias] = vl;
+    setPort(vl.m_alias, vl);
 
     return true;
 }
@@ -2122,7 +2213,7 @@ bool PortsOrch::initPort(const string &alias, const int index, const set<int> &l
                 initGearboxPort(p);
 
                 /* Add port to port list */
-                m_portList[alias] = p;
+                setPort(alias, p);
                 m_port_ref_count[alias] = 0;
                 m_portOidToIndex[id] = index;
 
@@ -2332,6 +2423,9 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 addSystemPorts();
                 m_initDone = true;
                 SWSS_LOG_INFO("Get PortInitDone notification from portsyncd.");
+
+                /* Tasks waiting for the ports can be retried */
+                Orch::wakeRetries();
             }
 
             it = consumer.m_toSync.erase(it);
@@ -2553,9 +2647,9 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 it++;
                 continue;
             }
-            else
+            else if (m_pendingPortSet.erase(alias) && allPortsReady())
             {
-                m_pendingPortSet.erase(alias);
+                Orch::wakeRetries();
             }
 
             Port p;
@@ -2572,7 +2666,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                         SWSS_LOG_NOTICE("Set port %s AutoNeg to %u", alias.c_str(), an);
                         p.m_autoneg = an;
                         p.m_an_cfg = true;
-                        m_portList[alias] = p;
+                        setPort(alias, p);
 
                         // Once AN is changed
                         // - no speed specified: need to reapply the port speed or port adv speed accordingly
@@ -2612,7 +2706,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                 {
                     if (speed != p.m_speed)
                     {
-                        m_portList[alias] = p;
+                        setPort(alias, p);
 
                         if (p.m_autoneg)
                         {
@@ -2646,7 +2740,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                                 }
 
                                 p.m_admin_state_up = false;
-                                m_portList[alias] = p;
+                                setPort(alias, p);
 
                                 if (!setPortSpeed(p, speed))
                                 {
@@ -2668,7 +2762,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                             SWSS_LOG_NOTICE("Set port %s speed to %u", alias.c_str(), speed);
                         }
                         p.m_speed = speed;
-                        m_portList[alias] = p;
+                        setPort(alias, p);
                     }
                     else
                     {
@@ -2682,7 +2776,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     if (setPortMtu(p.m_port_id, mtu))
                     {
                         p.m_mtu = mtu;
-                        m_portList[alias] = p;
+                        setPort(alias, p);
                         SWSS_LOG_NOTICE("Set port %s MTU to %u", alias.c_str(), mtu);
                         if (p.m_rif_id)
                         {
@@ -2722,7 +2816,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
 
                                 if (setPortFec(p, p.m_fec_mode))
                                 {
-                                    m_portList[alias] = p;
+                                    setPort(alias, p);
                                     SWSS_LOG_NOTICE("Set port %s fec to %s", alias.c_str(), fec_mode.c_str());
                                 }
                                 else
@@ -2739,7 +2833,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                                 p.m_fec_cfg = true;
                                 if (setPortFec(p, p.m_fec_mode))
                                 {
-                                    m_portList[alias] = p;
+                                    setPort(alias, p);
                                     SWSS_LOG_NOTICE("Set port %s fec to %s", alias.c_str(), fec_mode.c_str());
                                 }
                                 else
@@ -2764,7 +2858,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                         if(setBridgePortLearnMode(p, learn_mode))
                         {
                             p.m_learn_mode = learn_mode;
-                            m_portList[alias] = p;
+                            setPort(alias, p);
                             SWSS_LOG_NOTICE("Set port %s learn mode to %s", alias.c_str(), learn_mode.c_str());
                         }
                         else
@@ -2777,7 +2871,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     else
                     {
                         p.m_learn_mode = learn_mode;
-                        m_portList[alias] = p;
+                        setPort(alias, p);
 
                         SWSS_LOG_NOTICE("Saved to set port %s learn mode %s", alias.c_str(), learn_mode.c_str());
                     }
@@ -2818,7 +2912,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     if (setPortAdminStatus(p, admin_status == "up"))
                     {
                         p.m_admin_state_up = (admin_status == "up");
-                        m_portList[alias] = p;
+                        setPort(alias, p);
                         SWSS_LOG_NOTICE("Set port %s admin status to %s", alias.c_str(), admin_status.c_str());
                     }
                     else
@@ -2881,6 +2975,7 @@ void PortsOrch::doPortTask(Consumer &consumer)
             removePortFromPortListMap(port_id);
 
             /* Delete port from port list */
+            unindexPort(alias);
             m_portList.erase(alias);
         }
         else
@@ -2965,7 +3060,7 @@ void PortsOrch::doVlanTask(Consumer &consumer)
                 if (mtu != 0)
                 {
                     vl.m_mtu = mtu;
-                    m_portList[vlan_alias] = vl;
+                    setPort(vlan_alias, vl);
                     if (vl.m_rif_id)
                     {
                         gIntfsOrch->setRouterIntfsMtu(vl);
@@ -2974,7 +3069,7 @@ void PortsOrch::doVlanTask(Consumer &consumer)
                 if (mac)
                 {
                     vl.m_mac = mac;
-                    m_portList[vlan_alias] = vl;
+                    setPort(vlan_alias, vl);
                     if (vl.m_rif_id)
                     {
                         gIntfsOrch->setRouterIntfsMac(vl);
@@ -3221,13 +3316,13 @@ void PortsOrch::doLagTask(Consumer &consumer)
                 {
                     updatePortOperStatus(l, string_oper_status.at(operation_status));
 
-                    m_portList[alias] = l;
+                    setPort(alias, l);
                 }
 
                 if (mtu != 0)
                 {
                     l.m_mtu = mtu;
-                    m_portList[alias] = l;
+                    setPort(alias, l);
                     if (l.m_rif_id)
                     {
                         gIntfsOrch->setRouterIntfsMtu(l);
@@ -3243,7 +3338,7 @@ void PortsOrch::doLagTask(Consumer &consumer)
                         if(setBridgePortLearnMode(l, learn_mode))
                         {
                             l.m_learn_mode = learn_mode;
-                            m_portList[alias] = l;
+                            setPort(alias, l);
                             SWSS_LOG_NOTICE("Set port %s learn mode to %s", alias.c_str(), learn_mode.c_str());
                         }
                         else
@@ -3256,7 +3351,7 @@ void PortsOrch::doLagTask(Consumer &consumer)
                     else
                     {
                         l.m_learn_mode = learn_mode;
-                        m_portList[alias] = l;
+                        setPort(alias, l);
 
                         SWSS_LOG_NOTICE("Saved to set port %s learn mode %s", alias.c_str(), learn_mode.c_str());
                     }
@@ -3822,9 +3917,12 @@ bool PortsOrch::addBridgePort(Port &port)
                 hostif_vlan_tag[SAI_HOSTIF_VLAN_TAG_KEEP], port.m_alias.c_str());
         return false;
     }
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     SWSS_LOG_NOTICE("Add bridge port %s to default 1Q bridge", port.m_alias.c_str());
 
+    /* FDB entries may wait for the bridge port */
+    Orch::wakeRetries();
+
     return true;
 }
 
@@ -3876,11 +3974,12 @@ bool PortsOrch::removeBridgePort(Port &port)
             return parseHandleSaiStatusFailure(handle_status);
         }
     }
+    m_bridgePortIdIndex.erase(port.m_bridge_port_id);
     port.m_bridge_port_id = SAI_NULL_OBJECT_ID;
 
     SWSS_LOG_NOTICE("Remove bridge port %s from default 1Q bridge", port.m_alias.c_str());
 
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     return true;
 }
 
@@ -3950,7 +4049,7 @@ bool PortsOrch::addVlan(string vlan_alias)
     vlan.m_vlan_info.vlan_oid = vlan_oid;
     vlan.m_vlan_info.vlan_id = vlan_id;
     vlan.m_members = set<string>();
-    m_portList[vlan_alias] = vlan;
+    setPort(vlan_alias, vlan);
     m_port_ref_count[vlan_alias] = 0;
 
     return true;
@@ -4006,6 +4105,7 @@ bool PortsOrch::removeVlan(Port vlan)
     SWSS_LOG_NOTICE("Remove VLAN %s vid:%hu", vlan.m_alias.c_str(),
             vlan.m_vlan_info.vlan_id);
 
+    unindexPort(vlan.m_alias);
     m_portList.erase(vlan.m_alias);
     m_port_ref_count.erase(vlan.m_alias);
 
@@ -4082,9 +4182,9 @@ bool PortsOrch::addVlanMember(Port &vlan, Port &port, string &tagging_mode)
     /* a physical port may join multiple vlans */
     VlanMemberEntry vme = {vlan_member_id, sai_tagging_mode};
     port.m_vlan_members[vlan.m_vlan_info.vlan_id] = vme;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     vlan.m_members.insert(port.m_alias);
-    m_portList[vlan.m_alias] = vlan;
+    setPort(vlan.m_alias, vlan);
 
     VlanMemberUpdate update = { vlan, port, true };
     notify(SUBJECT_TYPE_VLAN_MEMBER_CHANGE, static_cast<void *>(&update));
@@ -4129,9 +4229,9 @@ bool PortsOrch::removeVlanMember(Port &vlan, Port &port)
         }
     }
 
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     vlan.m_members.erase(port.m_alias);
-    m_portList[vlan.m_alias] = vlan;
+    setPort(vlan.m_alias, vlan);
 
     VlanMemberUpdate update = { vlan, port, false };
     notify(SUBJECT_TYPE_VLAN_MEMBER_CHANGE, static_cast<void *>(&update));
@@ -4200,7 +4300,7 @@ bool PortsOrch::addLag(string lag_alias, uint32_t spa_id, int32_t switch_id)
     Port lag(lag_alias, Port::LAG);
     lag.m_lag_id = lag_id;
     lag.m_members = set<string>();
-    m_portList[lag_alias] = lag;
+    setPort(lag_alias, lag);
     m_port_ref_count[lag_alias] = 0;
 
     PortUpdate update = { lag, true };
@@ -4222,7 +4322,7 @@ bool PortsOrch::addLag(string lag_alias, uint32_t spa_id, int32_t switch_id)
         // This will update port list with local port channel name for local port channels
         // and with system lag name for the system lags received from chassis app db
 
-        m_portList[lag_alias] = lag;
+        setPort(lag_alias, lag);
 
         // Sync to SYSTEM_LAG_TABLE of CHASSIS_APP_DB
 
@@ -4269,6 +4369,7 @@ bool PortsOrch::removeLag(Port lag)
 
     SWSS_LOG_NOTICE("Remove LAG %s lid:%" PRIx64, lag.m_alias.c_str(), lag.m_lag_id);
 
+    unindexPort(lag.m_alias);
     m_portList.erase(lag.m_alias);
     m_port_ref_count.erase(lag.m_alias);
 
@@ -4369,10 +4470,10 @@ bool PortsOrch::addLagMember(Port &lag, Port &port, bool enableForwarding)
 
     port.m_lag_id = lag.m_lag_id;
     port.m_lag_member_id = lag_member_id;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     lag.m_members.insert(port.m_alias);
 
-    m_portList[lag.m_alias] = lag;
+    setPort(lag.m_alias, lag);
 
     if (lag.m_bridge_port_id > 0)
     {
@@ -4416,9 +4517,9 @@ bool PortsOrch::removeLagMember(Port &lag, Port &port)
 
     port.m_lag_id = 0;
     port.m_lag_member_id = 0;
-    m_portList[port.m_alias] = port;
+    setPort(port.m_alias, port);
     lag.m_members.erase(port.m_alias);
-    m_portList[lag.m_alias] = lag;
+    setPort(lag.m_alias, lag);
 
     if (lag.m_bridge_port_id > 0)
     {
@@ -4529,7 +4630,7 @@ bool PortsOrch::addTunnel(string tunnel_alias, sai_object_id_t tunnel_id, bool h
     {
         tunnel.m_learn_mode = "disable";
     }
-    m_portList[tunnel_alias] = tunnel;
+    setPort(tunnel_alias, tunnel);
 
     SWSS_LOG_INFO("addTunnel:: %" PRIx64, tunnel_id);
 
@@ -4540,6 +4641,7 @@ bool PortsOrch::removeTunnel(Port tunnel)
 {
     SWSS_LOG_ENTER();
 
+    unindexPort(tunnel.m_alias);
     m_portList.erase(tunnel.m_alias);
 
     return true;
@@ -4709,23 +4811,28 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
         return;
     }
 
-    std::string op;
-    std::string data;
-    std::vector<swss::FieldValueTuple> values;
-
-    consumer.pop(op, data, values);
+    /* All the queued notifications, so that ports going down together are handled together */
+    std::deque<KeyOpFieldsValuesTuple> entries;
+    consumer.pops(entries);
 
     if (&consumer != m_portStatusNotificationConsumer)
     {
         return;
     }
 
-    if (op == "port_state_change")
+    PortDownBatch downPorts = { {}, chrono::steady_clock::now(), getTimestamp() };
+
+    for (const auto &entry : entries)
     {
+        if (kfvOp(entry) != "port_state_change")
+        {
+            continue;
+        }
+
         uint32_t count;
         sai_port_oper_status_notification_t *portoperstatus = nullptr;
 
-        sai_deserialize_port_oper_status_ntf(data, count, &portoperstatus);
+        sai_deserialize_port_oper_status_ntf(kfvKey(entry), count, &portoperstatus);
 
         for (uint32_t i = 0; i < count; i++)
         {
@@ -4734,32 +4841,141 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
 
             SWSS_LOG_NOTICE("Get port state change notification id:%" PRIx64 " status:%d", id, status);
 
-            Port port;
+            /* Updated in place in m_portList */
+            Port *port = getPortPtr(id);
 
-            if (!getPort(id, port))
+            if (port == nullptr)
             {
                 SWSS_LOG_ERROR("Failed to get port object for port id 0x%" PRIx64, id);
                 continue;
             }
 
-            updatePortOperStatus(port, status);
+            if (status == SAI_PORT_OPER_STATUS_DOWN)
+            {
+                if (find(downPorts.ports.begin(), downPorts.ports.end(), port) == downPorts.ports.end())
+                {
+                    downPorts.ports.push_back(port);
+                }
+                continue;
+            }
+
+            /* Changes of a port are applied in order */
+            updatePortsOperStatusDown(downPorts);
 
-            /* update m_portList */
-            m_portList[port.m_alias] = port;
+            updatePortOperStatus(*port, status);
         }
 
         sai_deserialize_free_port_oper_status_ntf(count, portoperstatus);
     }
+
+    updatePortsOperStatusDown(downPorts);
+}
+
+/*
+ * Consecutive port down changes are applied together, and report the time
+ * from the reception of their notifications until their next hop group
+ * members are removed.
+ */
+void PortsOrch::updatePortsOperStatusDown(PortDownBatch &batch)
+{
+    if (batch.ports.empty())
+    {
+        return;
+    }
+
+    uint32_t members = updatePortOperStatus(batch.ports, SAI_PORT_OPER_STATUS_DOWN);
+
+    auto latency = static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(
+            chrono::steady_clock::now() - batch.received).count());
+    m_portDownBatches++;
+    m_portDownMaxLatencyUs = max(m_portDownMaxLatencyUs, latency);
+
+    SWSS_LOG_NOTICE("%zu ports down, %u next hop group members removed %" PRIu64 " us after notification,"
+                    " max %" PRIu64 " us over %" PRIu64 " batches",
+                    batch.ports.size(), members, latency, m_portDownMaxLatencyUs, m_portDownBatches);
+
+    updatePortDownMetrics(batch, latency);
+
+    batch.ports.clear();
+}
+
+/*
+ * Publishes the time taken by orchagent to handle a port down: the
+ * orch_port_down_start and _end timestamps, and the latency in
+ * orch_port_down_time_us, shared by the ports of a batch.
+ */
+void PortsOrch::updatePortDownMetrics(const PortDownBatch &batch, uint64_t usecs)
+{
+    string endTime = getTimestamp();
+
+    for (const Port *port : batch.ports)
+    {
+        vector<FieldValueTuple> tuples;
+        tuples.emplace_back("orch_port_down_start", batch.receivedTime);
+        tuples.emplace_back("orch_port_down_end", endTime);
+        tuples.emplace_back("orch_port_down_time_us", to_string(usecs));
+        tuples.emplace_back("batch_size", to_string(batch.ports.size()));
+        m_portDownMetricsTable->set(port->m_alias, tuples);
+    }
 }
 
 void PortsOrch::updatePortOperStatus(Port &port, sai_port_oper_status_t status)
+{
+    updatePortOperStatus(vector<Port *>{ &port }, status);
+}
+
+/*
+ * Ports changing to the same oper status. Their next hops, and those of their
+ * sub interfaces, are updated in one operation before the observers are
+ * notified. Returns the number of next hop group members removed.
+ */
+uint32_t PortsOrch::updatePortOperStatus(const vector<Port *> &ports, sai_port_oper_status_t status)
+{
+    bool isUp = status == SAI_PORT_OPER_STATUS_UP;
+    vector<Port *> changed;
+    vector<string> aliases;
+
+    for (Port *port : ports)
+    {
+        if (!setPortOperStatus(*port, status))
+        {
+            continue;
+        }
+
+        changed.push_back(port);
+        aliases.push_back(port->m_alias);
+        aliases.insert(aliases.end(), port->m_child_ports.begin(), port->m_child_ports.end());
+    }
+
+    uint32_t members = 0;
+    if (!aliases.empty() && !gNeighOrch->ifChangeInformNextHop(aliases, isUp, members))
+    {
+        SWSS_LOG_WARN("Inform nexthop operation failed for %zu interfaces going %s",
+                aliases.size(), isUp ? "up" : "down");
+    }
+
+    for (Port *port : changed)
+    {
+        PortOperStateUpdate update = {*port, status};
+        notify(SUBJECT_TYPE_PORT_OPER_STATE_CHANGE, static_cast<void *>(&update));
+    }
+
+    return members;
+}
+
+/*
+ * Record the oper status of the port, in STATE_DB and on its host interface.
+ * Returns true when the change is to be propagated to the next hops and the
+ * observers.
+ */
+bool PortsOrch::setPortOperStatus(Port &port, sai_port_oper_status_t status)
 {
     SWSS_LOG_NOTICE("Port %s oper state set from %s to %s",
             port.m_alias.c_str(), oper_status_strings.at(port.m_oper_status).c_str(),
             oper_status_strings.at(status).c_str());
     if (status == port.m_oper_status)
     {
-        return;
+        return false;
     }
 
     if (port.m_type == Port::PHY)
@@ -4770,7 +4986,7 @@ void PortsOrch::updatePortOperStatus(Port &port, sai_port_oper_status_t status)
 
     if(port.m_type == Port::TUNNEL)
     {
-        return;
+        return false;
     }
 
     bool isUp = status == SAI_PORT_OPER_STATUS_UP;
@@ -4782,20 +4998,8 @@ void PortsOrch::updatePortOperStatus(Port &port, sai_port_oper_status_t status)
                     isUp ? "up" : "down");
         }
     }
-    if (!gNeighOrch->ifChangeInformNextHop(port.m_alias, isUp))
-    {
-        SWSS_LOG_WARN("Inform nexthop operation failed for interface %s", port.m_alias.c_str());
-    }
-    for (const auto &child_port : port.m_child_ports)
-    {
-        if (!gNeighOrch->ifChangeInformNextHop(child_port, isUp))
-        {
-            SWSS_LOG_WARN("Inform nexthop operation failed for sub interface %s", child_port.c_str());
-        }
-    }
 
-    PortOperStateUpdate update = {port, status};
-    notify(SUBJECT_TYPE_PORT_OPER_STATE_CHANGE, static_cast<void *>(&update));
+    return true;
 }
 
 /*
@@ -5069,7 +5273,7 @@ bool PortsOrch::updateL3VniStatus(uint16_t vlan_id, bool isUp)
         vlan.m_l3_vni = false;
     }
 
-    m_portList[vlan_alias] = vlan;
+    setPort(vlan_alias, vlan);
 
     SWSS_LOG_INFO("Updated L3Vni status of VLAN %d member count %d", vlan_id, vlan.m_up_member_count);
 
@@ -91,7 +91,11 @@ public:
     void increasePortRefCount(const string &alias);
     void decreasePortRefCount(const string &alias);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
-    void setPort(string alias, Port port);
+    /* Lookups without copying the Port, valid until the port is removed from the port list */
+    Port *getPortPtr(const string &alias);
+    Port *getPortPtr(sai_object_id_t id);
+    Port *getPortPtrByBridgePortId(sai_object_id_t bridge_port_id);
+    void setPort(const string &alias, const Port &port);
     void getCpuPort(Port &port);
     bool getInbandPort(Port &port);
     bool getVlanByVlanId(sai_vlan_id_t vlan_id, Port &vlan);
@@ -160,6 +164,7 @@ private:
     unique_ptr<Table> m_pgPortTable;
     unique_ptr<Table> m_pgIndexTable;
     unique_ptr<Table> m_stateBufferMaximumValueTable;
+    unique_ptr<Table> m_portDownMetricsTable;
     unique_ptr<ProducerTable> m_flexCounterTable;
     unique_ptr<ProducerTable> m_flexCounterGroupTable;
 
@@ -210,6 +215,19 @@ private:
     map<set<int>, sai_object_id_t> m_portListLaneMap;
     map<set<int>, tuple<string, uint32_t, int, string, int>> m_lanesAliasSpeedMap;
     map<string, Port> m_portList;
+    /*
+     * Secondary indexes into m_portList by port/LAG/VLAN object id and by bridge
+     * port id, kept in sync by setPort() and unindexPort(). m_portIndexIds holds
+     * the ids each port is indexed under, to re-index or unindex it in O(1).
+     */
+    struct PortIndexIds
+    {
+        sai_object_id_t oid;
+        sai_object_id_t bridge_port_id;
+    };
+    unordered_map<sai_object_id_t, Port *> m_portOidIndex;
+    unordered_map<sai_object_id_t, Port *> m_bridgePortIdIndex;
+    unordered_map<const Port *, PortIndexIds> m_portIndexIds;
     unordered_map<sai_object_id_t, int> m_portOidToIndex;
     map<string, uint32_t> m_port_ref_count;
     unordered_set<string> m_pendingPortSet;
@@ -228,6 +246,9 @@ private:
 
     void removePortFromLanesMap(string alias);
     void removePortFromPortListMap(sai_object_id_t port_id);
+    static sai_object_id_t getPortIndexOid(const Port &port);
+    void indexPort(const string &alias);
+    void unindexPort(const string &alias);
     void removeDefaultVlanMembers();
     void removeDefaultBridgePorts();
 
@@ -288,6 +309,22 @@ private:
 
     bool getPortOperStatus(const Port& port, sai_port_oper_status_t& status) const;
     void updatePortOperStatus(Port &port, sai_port_oper_status_t status);
+    uint32_t updatePortOperStatus(const vector<Port *> &ports, sai_port_oper_status_t status);
+    bool setPortOperStatus(Port &port, sai_port_oper_status_t status);
+
+    /* Ports of m_portList going down together, and when their notifications were received */
+    struct PortDownBatch
+    {
+        vector<Port *> ports;
+        chrono::steady_clock::time_point received;
+        string receivedTime;
+    };
+    void updatePortsOperStatusDown(PortDownBatch &batch);
+    void updatePortDownMetrics(const PortDownBatch &batch, uint64_t usecs);
+
+    /* Batches of port down changes, and the longest time from notification to next hop removal */
+    uint64_t m_portDownBatches = 0;
+    uint64_t m_portDownMaxLatencyUs = 0;
 
     void getPortSerdesVal(const std::string& s, std::vector<uint32_t> &lane_values);
 
@@ -0,0 +1,337 @@
+#include <sys/time.h>
+#include <string.h>
+#include <time.h>
+#include <chrono>
+
+#include "recorder.h"
+#include "recordformat.h"
+#include "logger.h"
+
+using namespace std;
+using namespace swss;
+
+/* Time the writer sleeps when it missed a wake up */
+#define RECORDER_WRITER_WAIT_MSECS 10
+
+static uint64_t recordTimestamp()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return static_cast<uint64_t>(tv.tv_sec) * 1000000 + static_cast<uint64_t>(tv.tv_usec);
+}
+
+/* Same format as swss::getTimestamp() */
+static void appendTimestamp(string &line, uint64_t timestamp)
+{
+    char buffer[64];
+    time_t sec = static_cast<time_t>(timestamp / 1000000);
+    struct tm tm;
+    localtime_r(&sec, &tm);
+    size_t size = strftime(buffer, 32, "%Y-%m-%d.%T.", &tm);
+    snprintf(&buffer[size], 32, "%06lu", static_cast<unsigned long>(timestamp % 1000000));
+    line += buffer;
+}
+
+SwssRecorder &SwssRecorder::getInstance()
+{
+    static SwssRecorder recorder;
+    return recorder;
+}
+
+SwssRecorder::SwssRecorder(size_t ringSize) :
+    m_head(0),
+    m_tail(0),
+    m_flushed(0),
+    m_format(TEXT),
+    m_open(false),
+    m_stop(false),
+    m_rotate(false),
+    m_writerWaiting(false),
+    m_dropped(0),
+    m_reportedDrops(0)
+{
+    /* Power of two, so that positions wrap with a mask */
+    size_t size = sizeof(RecordHeader);
+    while (size < ringSize)
+    {
+        size <<= 1;
+    }
+    m_ring.resize(size);
+    m_mask = size - 1;
+}
+
+SwssRecorder::~SwssRecorder()
+{
+    close();
+}
+
+bool SwssRecorder::openFile()
+{
+    m_ofs.open(m_file, ofstream::out | ofstream::app | ofstream::binary);
+    if (!m_ofs.is_open())
+    {
+        SWSS_LOG_ERROR("Failed to open SwSS recording file %s: %s", m_file.c_str(), strerror(errno));
+        return false;
+    }
+
+    if (m_format != BINARY)
+    {
+        return true;
+    }
+
+    ifstream in(m_file, ifstream::binary);
+    RecordFileHeader header;
+    if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+    {
+        /* New file */
+        initRecordFileHeader(header);
+        m_ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        m_ofs.flush();
+        return true;
+    }
+
+    if (!isRecordFileHeader(header))
+    {
+        SWSS_LOG_ERROR("SwSS recording file %s is not a binary recording", m_file.c_str());
+        m_ofs.close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SwssRecorder::open(const string &file, Format format)
+{
+    SWSS_LOG_ENTER();
+
+    close();
+
+    m_file = file;
+    m_format = format;
+    if (!openFile())
+    {
+        return false;
+    }
+
+    m_stop = false;
+    m_rotate = false;
+    m_reportedDrops = m_dropped;
+    m_open = true;
+    m_writer = thread(&SwssRecorder::run, this);
+
+    return true;
+}
+
+void SwssRecorder::close()
+{
+    if (!m_open)
+    {
+        return;
+    }
+
+    m_open = false;
+    m_stop = true;
+    {
+        lock_guard<mutex> lock(m_wakeMutex);
+        m_wake.notify_one();
+    }
+    m_writer.join();
+    m_ofs.close();
+}
+
+void SwssRecorder::rotate()
+{
+    m_rotate = true;
+}
+
+void SwssRecorder::flush()
+{
+    size_t head = m_head;
+    while (m_open && (m_flushed < head || m_rotate))
+    {
+        {
+            lock_guard<mutex> lock(m_wakeMutex);
+            m_wake.notify_one();
+        }
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+}
+
+void SwssRecorder::copyIn(size_t pos, const void *data, size_t len)
+{
+    size_t offset = pos & m_mask;
+    size_t first = min(len, m_ring.size() - offset);
+    memcpy(&m_ring[offset], data, first);
+    memcpy(&m_ring[0], static_cast<const char *>(data) + first, len - first);
+}
+
+void SwssRecorder::copyOut(size_t pos, void *data, size_t len) const
+{
+    size_t offset = pos & m_mask;
+    size_t first = min(len, m_ring.size() - offset);
+    memcpy(data, &m_ring[offset], first);
+    memcpy(static_cast<char *>(data) + first, &m_ring[0], len - first);
+}
+
+template <typename Encoder>
+void SwssRecorder::push(size_t size, Encoder &&encode)
+{
+    if (!m_open)
+    {
+        return;
+    }
+
+    lock_guard<mutex> lock(m_producerMutex);
+
+    size_t head = m_head.load(memory_order_relaxed);
+    if (size > m_ring.size() - (head - m_tail.load(memory_order_acquire)))
+    {
+        m_dropped++;
+        return;
+    }
+
+    size_t pos = head;
+    auto write = [this, &pos](const void *data, size_t len) {
+        copyIn(pos, data, len);
+        pos += len;
+    };
+    encode(write);
+    m_head.store(head + size, memory_order_release);
+
+    if (m_writerWaiting)
+    {
+        lock_guard<mutex> wakeLock(m_wakeMutex);
+        m_wake.notify_one();
+    }
+}
+
+void SwssRecorder::record(const string &db, const string &table,
+                          const string &separator, const KeyOpFieldsValuesTuple &tuple)
+{
+    uint64_t timestamp = recordTimestamp();
+    size_t size = recordSize(db, separator, table, tuple);
+
+    push(size, [&](auto &write) {
+        encodeRecord(write, size, timestamp, db, separator, table, tuple);
+    });
+}
+
+void SwssRecorder::recordText(const string &text)
+{
+    uint64_t timestamp = recordTimestamp();
+
+    push(sizeof(RecordHeader) + text.size(), [&](auto &write) {
+        encodeTextRecord(write, timestamp, text);
+    });
+}
+
+void SwssRecorder::write(const char *data, size_t size)
+{
+    if (m_format == BINARY)
+    {
+        m_ofs.write(data, static_cast<streamsize>(size));
+        return;
+    }
+
+    Record record;
+    if (!decodeRecord(data, size, record))
+    {
+        SWSS_LOG_ERROR("Dropping malformed record of %zu bytes", size);
+        return;
+    }
+
+    string line;
+    appendTimestamp(line, record.timestamp);
+    line += "|";
+    if (record.type == RECORD_TUPLE)
+    {
+        line += record.table + record.separator + record.key + "|" + record.op;
+        for (const auto &fv : record.fvs)
+        {
+            line += "|" + fvField(fv) + ":" + fvValue(fv);
+        }
+    }
+    else
+    {
+        line += record.key;
+    }
+    line += "\n";
+
+    m_ofs.write(line.data(), static_cast<streamsize>(line.size()));
+}
+
+void SwssRecorder::run()
+{
+    vector<char> buffer;
+
+    while (true)
+    {
+        size_t head = m_head.load(memory_order_acquire);
+        size_t tail = m_tail.load(memory_order_relaxed);
+
+        if (m_format == BINARY && tail != head)
+        {
+            /* Records are already in the file format */
+            size_t len = head - tail;
+            size_t offset = tail & m_mask;
+            size_t first = min(len, m_ring.size() - offset);
+            m_ofs.write(&m_ring[offset], static_cast<streamsize>(first));
+            m_ofs.write(&m_ring[0], static_cast<streamsize>(len - first));
+
+            tail = head;
+            m_tail.store(tail, memory_order_release);
+        }
+
+        while (tail != head)
+        {
+            RecordHeader header;
+            copyOut(tail, &header, sizeof(header));
+            buffer.resize(header.size);
+            copyOut(tail, buffer.data(), header.size);
+
+            /* Hand the space back before formatting the record */
+            tail += header.size;
+            m_tail.store(tail, memory_order_release);
+
+            write(buffer.data(), buffer.size());
+        }
+
+        uint64_t dropped = m_dropped;
+        if (dropped != m_reportedDrops)
+        {
+            string text = to_string(dropped - m_reportedDrops) + " records dropped";
+            buffer.clear();
+            encodeTextRecord([&buffer](const void *data, size_t len) {
+                buffer.insert(buffer.end(), static_cast<const char *>(data), static_cast<const char *>(data) + len);
+            }, recordTimestamp(), text);
+            write(buffer.data(), buffer.size());
+            m_reportedDrops = dropped;
+        }
+
+        m_ofs.flush();
+        m_flushed = tail;
+
+        if (m_rotate.exchange(false))
+        {
+            /*
+             * logrotate moved the file away, the same name gives a new file.
+             * Records are dropped until the file can be opened.
+             */
+            m_ofs.close();
+            openFile();
+        }
+
+        if (m_stop)
+        {
+            break;
+        }
+
+        unique_lock<mutex> lock(m_wakeMutex);
+        m_writerWaiting = true;
+        if (m_head.load() == tail && !m_stop && !m_rotate)
+        {
+            m_wake.wait_for(lock, chrono::milliseconds(RECORDER_WRITER_WAIT_MSECS));
+        }
+        m_writerWaiting = false;
+    }
+}
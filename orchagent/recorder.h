@@ -0,0 +1,94 @@
+#ifndef SWSS_RECORDER_H
+#define SWSS_RECORDER_H
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "table.h"
+
+/*
+ * Recorder of the tasks received by the Orchs (swss.rec).
+ *
+ * Tasks are serialized in the binary record format of recordformat.h
+ * straight into a ring buffer, and a writer thread drains the ring to the
+ * file, either as is (binary format) or as the historical text lines. The
+ * ring is lock-free between the recording threads and the writer; recording
+ * threads are serialized among themselves as Orchs may run on workers.
+ *
+ * Tasks are dropped rather than stalling the caller when the ring is full,
+ * the writer then records how many were lost.
+ */
+class SwssRecorder
+{
+public:
+    enum Format
+    {
+        TEXT,
+        BINARY
+    };
+
+    static const size_t DEFAULT_RING_SIZE = 16 * 1024 * 1024;
+
+    static SwssRecorder &getInstance();
+
+    explicit SwssRecorder(size_t ringSize = DEFAULT_RING_SIZE);
+    ~SwssRecorder();
+
+    SwssRecorder(const SwssRecorder&) = delete;
+    SwssRecorder& operator=(const SwssRecorder&) = delete;
+
+    /* Append to the file and start the writer thread */
+    bool open(const std::string &file, Format format);
+    void close();
+    bool isOpen() const { return m_open; }
+
+    void record(const std::string &db, const std::string &table,
+                const std::string &separator, const swss::KeyOpFieldsValuesTuple &tuple);
+    void recordText(const std::string &text);
+
+    /* Reopen the file by name on the writer thread, after logrotate moved it */
+    void rotate();
+
+    /* Wait for the writer to write out the records queued so far and to reopen the file */
+    void flush();
+
+    uint64_t getDropped() const { return m_dropped; }
+
+private:
+    std::vector<char> m_ring;
+    size_t m_mask;
+    std::atomic<size_t> m_head;     // written by the recording threads
+    std::atomic<size_t> m_tail;     // written by the writer thread
+    std::atomic<size_t> m_flushed;  // records before it are in the file
+    std::mutex m_producerMutex;
+
+    std::string m_file;
+    Format m_format;
+    std::ofstream m_ofs;
+    std::thread m_writer;
+    std::atomic<bool> m_open;
+    std::atomic<bool> m_stop;
+    std::atomic<bool> m_rotate;
+    std::atomic<bool> m_writerWaiting;
+    std::atomic<uint64_t> m_dropped;
+    uint64_t m_reportedDrops;       // writer thread only
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+
+    template <typename Encoder>
+    void push(size_t size, Encoder &&encode);
+    void copyIn(size_t pos, const void *data, size_t len);
+    void copyOut(size_t pos, void *data, size_t len) const;
+
+    bool openFile();
+    void run();
+    void write(const char *data, size_t size);
+};
+
+#endif /* SWSS_RECORDER_H */
@@ -38,6 +38,8 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, SwitchOrch *switchOrch,
 {
     SWSS_LOG_ENTER();
 
+    getExecutor(tableName)->setBulkSchedule();
+
     sai_attribute_t attr;
     attr.id = SAI_SWITCH_ATTR_NUMBER_OF_ECMP_GROUPS;
 
@@ -94,7 +96,7 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, SwitchOrch *switchOrch,
     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
 
     /* Add default IPv4 route into the m_syncdRoutes */
-    m_syncdRoutes[gVirtualRouterId][default_ip_prefix] = NextHopGroupKey();
+    m_syncdRoutes[gVirtualRouterId].set(default_ip_prefix, NextHopGroupKey());
 
     SWSS_LOG_NOTICE("Create IPv4 default route with packet action drop");
 
@@ -113,7 +115,7 @@ RouteOrch::RouteOrch(DBConnector *db, string tableName, SwitchOrch *switchOrch,
     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
 
     /* Add default IPv6 route into the m_syncdRoutes */
-    m_syncdRoutes[gVirtualRouterId][v6_default_ip_prefix] = NextHopGroupKey();
+    m_syncdRoutes[gVirtualRouterId].set(v6_default_ip_prefix, NextHopGroupKey());
 
     SWSS_LOG_NOTICE("Create IPv6 default route with packet action drop");
 
@@ -231,16 +233,13 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr, sai_object_
         /* Find the prefixes that cover the destination IP */
         if (m_syncdRoutes.find(vrf_id) != m_syncdRoutes.end())
         {
-            for (auto route : m_syncdRoutes.at(vrf_id))
-            {
-                if (route.first.isAddressInSubnet(dstAddr))
-                {
-                    SWSS_LOG_INFO("Prefix %s covers destination address",
-                            route.first.to_string().c_str());
-                    observerEntry->second.routeTable.emplace(
-                            route.first, route.second);
-                }
-            }
+            auto &routeTable = observerEntry->second.routeTable;
+            m_syncdRoutes.at(vrf_id).forEachCovering(dstAddr,
+                    [&routeTable](const IpPrefix &prefix, const NextHopGroupKey &nexthops) {
+                SWSS_LOG_INFO("Prefix %s covers destination address",
+                        prefix.to_string().c_str());
+                routeTable.emplace(prefix, nexthops);
+            });
         }
     }
 
@@ -299,99 +298,179 @@ bool RouteOrch::validnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t&
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
-    count = 0;
+    map<NextHopKey, uint32_t> counts;
+    bool rc = validnexthopsinNextHopGroup({ nexthop }, counts);
+
+    count = counts[nexthop];
+    return rc;
+}
+
+/*
+ * Add the members of the next hops back to all the next hop groups they
+ * belong to, with one bulk call. Returns in counts the number of members
+ * added per next hop.
+ */
+bool RouteOrch::validnexthopsinNextHopGroup(const vector<NextHopKey> &nexthops, map<NextHopKey, uint32_t>& counts)
+{
+    SWSS_LOG_ENTER();
+
+    vector<NextHopGroupEntry *> groups;
+    vector<NextHopKey> member_nexthops;
+    bool rc = true;
+    counts.clear();
 
     for (auto nhopgroup = m_syncdNextHopGroups.begin();
          nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
     {
-
-        if (!(nhopgroup->first.contains(nexthop)))
+        for (const auto &nexthop : nexthops)
         {
-            continue;
+            if (nhopgroup->first.contains(nexthop))
+            {
+                groups.push_back(&nhopgroup->second);
+                member_nexthops.push_back(nexthop);
+            }
         }
+    }
 
+    vector<sai_object_id_t> member_ids(groups.size());
+    for (size_t i = 0; i < groups.size(); i++)
+    {
         vector<sai_attribute_t> nhgm_attrs;
         sai_attribute_t nhgm_attr;
 
         nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
-        nhgm_attr.value.oid = nhopgroup->second.next_hop_group_id;
+        nhgm_attr.value.oid = groups[i]->next_hop_group_id;
         nhgm_attrs.push_back(nhgm_attr);
 
         nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
-        nhgm_attr.value.oid = m_neighOrch->getNextHopId(nexthop);
+        nhgm_attr.value.oid = m_neighOrch->getNextHopId(member_nexthops[i]);
         nhgm_attrs.push_back(nhgm_attr);
 
-        status = sai_next_hop_group_api->create_next_hop_group_member(&nexthop_id, gSwitchId,
-                                                                      (uint32_t)nhgm_attrs.size(),
-                                                                      nhgm_attrs.data());
+        gNextHopGroupMemberBulker.create_entry(&member_ids[i],
+                                                 (uint32_t)nhgm_attrs.size(),
+                                                 nhgm_attrs.data());
+    }
+    gNextHopGroupMemberBulker.flush();
 
-        if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < groups.size(); i++)
+    {
+        /* The bulker does not report why a member was not created */
+        if (member_ids[i] == SAI_NULL_OBJECT_ID)
         {
-            SWSS_LOG_ERROR("Failed to add next hop member to group %" PRIx64 ": %d\n",
-                           nhopgroup->second.next_hop_group_id, status);
-            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP_GROUP, status);
-            if (handle_status != task_success)
-            {
-                return parseHandleSaiStatusFailure(handle_status);
-            }
+            SWSS_LOG_ERROR("Failed to add next hop member to group %" PRIx64 "\n",
+                           groups[i]->next_hop_group_id);
+            rc = false;
+            continue;
         }
 
-        ++count;
+        ++counts[member_nexthops[i]];
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
-        nhopgroup->second.nhopgroup_members[nexthop] = nexthop_id;
+        groups[i]->nhopgroup_members[member_nexthops[i]] = member_ids[i];
     }
 
-    if (!m_fgNhgOrch->validNextHopInNextHopGroup(nexthop))
+    for (const auto &nexthop : nexthops)
     {
-        return false;
+        if (!m_fgNhgOrch->validNextHopInNextHopGroup(nexthop))
+        {
+            rc = false;
+        }
     }
 
-    return true;
+    return rc;
 }
 
 bool RouteOrch::invalidnexthopinNextHopGroup(const NextHopKey &nexthop, uint32_t& count)
 {
     SWSS_LOG_ENTER();
 
-    sai_object_id_t nexthop_id;
-    sai_status_t status;
+    return invalidnexthopsinNextHopGroup({ nexthop }, count);
+}
+
+/*
+ * Remove the members of the next hops from all the next hop groups they
+ * belong to, with one bulk call for all the groups instead of one call per
+ * member, so that an interface going down prunes its ECMP members at once.
+ */
+bool RouteOrch::invalidnexthopsinNextHopGroup(const vector<NextHopKey> &nexthops, uint32_t& count)
+{
+    map<NextHopKey, uint32_t> counts;
+    bool rc = invalidnexthopsinNextHopGroup(nexthops, counts);
+
     count = 0;
+    for (const auto &it : counts)
+    {
+        count += it.second;
+    }
+    return rc;
+}
+
+bool RouteOrch::invalidnexthopsinNextHopGroup(const vector<NextHopKey> &nexthops, map<NextHopKey, uint32_t>& counts)
+{
+    SWSS_LOG_ENTER();
+
+    vector<sai_object_id_t> member_ids;
+    vector<sai_object_id_t> group_ids;
+    vector<NextHopKey> member_nexthops;
+    bool rc = true;
+    counts.clear();
 
     for (auto nhopgroup = m_syncdNextHopGroups.begin();
          nhopgroup != m_syncdNextHopGroups.end(); ++nhopgroup)
     {
-
-        if (!(nhopgroup->first.contains(nexthop)))
+        for (const auto &nexthop : nexthops)
         {
-            continue;
+            if (!(nhopgroup->first.contains(nexthop)))
+            {
+                continue;
+            }
+
+            auto member = nhopgroup->second.nhopgroup_members.find(nexthop);
+            if (member == nhopgroup->second.nhopgroup_members.end() ||
+                member->second == SAI_NULL_OBJECT_ID)
+            {
+                continue;
+            }
+
+            member_ids.push_back(member->second);
+            group_ids.push_back(nhopgroup->second.next_hop_group_id);
+            member_nexthops.push_back(nexthop);
         }
+    }
 
-        nexthop_id = nhopgroup->second.nhopgroup_members[nexthop];
-        status = sai_next_hop_group_api->remove_next_hop_group_member(nexthop_id);
+    vector<sai_status_t> statuses(member_ids.size());
+    for (size_t i = 0; i < member_ids.size(); i++)
+    {
+        gNextHopGroupMemberBulker.remove_entry(&statuses[i], member_ids[i]);
+    }
+    gNextHopGroupMemberBulker.flush();
 
-        if (status != SAI_STATUS_SUCCESS)
+    for (size_t i = 0; i < member_ids.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_ERROR("Failed to remove next hop member %" PRIx64 " from group %" PRIx64 ": %d\n",
-                           nexthop_id, nhopgroup->second.next_hop_group_id, status);
-            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, status);
+                           member_ids[i], group_ids[i], statuses[i]);
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
             if (handle_status != task_success)
             {
-                return parseHandleSaiStatusFailure(handle_status);
+                rc = parseHandleSaiStatusFailure(handle_status) && rc;
+                continue;
             }
         }
 
-        ++count;
+        ++counts[member_nexthops[i]];
         gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
     }
 
-    if (!m_fgNhgOrch->invalidNextHopInNextHopGroup(nexthop))
+    for (const auto &nexthop : nexthops)
     {
-        return false;
+        if (!m_fgNhgOrch->invalidNextHopInNextHopGroup(nexthop))
+        {
+            rc = false;
+        }
     }
 
-    return true;
+    return rc;
 }
 
 void RouteOrch::doTask(Consumer& consumer)
@@ -448,7 +527,7 @@ void RouteOrch::doTask(Consumer& consumer)
                 {
                     /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
                     SWSS_LOG_NOTICE("Start resync routes\n");
-                    for (auto j : m_syncdRoutes)
+                    for (const auto &j : m_syncdRoutes)
                     {
                         string vrf;
 
@@ -457,13 +536,11 @@ void RouteOrch::doTask(Consumer& consumer)
                             vrf = m_vrfOrch->getVRFname(j.first) + ":";
                         }
 
-                        for (auto i : j.second)
-                        {
+                        j.second.forEach([&](const IpPrefix &prefix, const NextHopGroupKey &) {
                             vector<FieldValueTuple> v;
-                            key = vrf + i.first.to_string();
-                            auto x = KeyOpFieldsValuesTuple(key, DEL_COMMAND, v);
+                            auto x = KeyOpFieldsValuesTuple(vrf + prefix.to_string(), DEL_COMMAND, v);
                             consumer.addToSync(x);
-                        }
+                        });
                     }
                     m_resync = true;
                 }
@@ -471,6 +548,8 @@ void RouteOrch::doTask(Consumer& consumer)
                 {
                     SWSS_LOG_NOTICE("Complete resync routes\n");
                     m_resync = false;
+                    /* Routes held during the resync are parked */
+                    Orch::wakeRetries();
                 }
 
                 it = consumer.m_toSync.erase(it);
@@ -505,6 +584,15 @@ void RouteOrch::doTask(Consumer& consumer)
                 ip_prefix = IpPrefix(key);
             }
 
+            /* Routes are kept by subnet, a key with host bits would alias another route */
+            if (!RouteTable::isCanonical(ip_prefix))
+            {
+                SWSS_LOG_ERROR("Route prefix %s has host bits set, ignoring %s",
+                               ip_prefix.to_string().c_str(), op.c_str());
+                it = consumer.m_toSync.erase(it);
+                continue;
+            }
+
             if (op == SET_COMMAND)
             {
                 string ips;
@@ -666,8 +754,8 @@ void RouteOrch::doTask(Consumer& consumer)
                     }
                 }
                 else if (m_syncdRoutes.find(vrf_id) == m_syncdRoutes.end() ||
-                    m_syncdRoutes.at(vrf_id).find(ip_prefix) == m_syncdRoutes.at(vrf_id).end() ||
-                    m_syncdRoutes.at(vrf_id).at(ip_prefix) != nhg)
+                    !m_syncdRoutes.at(vrf_id).contains(ip_prefix) ||
+                    *m_syncdRoutes.at(vrf_id).find(ip_prefix) != nhg)
                 {
                     if (addRoute(ctx, nhg))
                         it = consumer.m_toSync.erase(it);
@@ -755,8 +843,8 @@ void RouteOrch::doTask(Consumer& consumer)
                         it_prev++;
                 }
                 else if (m_syncdRoutes.find(vrf_id) == m_syncdRoutes.end() ||
-                    m_syncdRoutes.at(vrf_id).find(ip_prefix) == m_syncdRoutes.at(vrf_id).end() ||
-                    m_syncdRoutes.at(vrf_id).at(ip_prefix) != nhg)
+                    !m_syncdRoutes.at(vrf_id).contains(ip_prefix) ||
+                    *m_syncdRoutes.at(vrf_id).find(ip_prefix) != nhg)
                 {
                     if (addRoutePost(ctx, nhg))
                         it_prev = consumer.m_toSync.erase(it_prev);
@@ -945,9 +1033,9 @@ const NextHopGroupKey RouteOrch::getSyncdRouteNhgKey(sai_object_id_t vrf_id, con
     if (route_table != m_syncdRoutes.end())
     {
         auto route_entry = route_table->second.find(ipPrefix);
-        if (route_entry != route_table->second.end())
+        if (route_entry)
         {
-            nhg = route_entry->second;
+            nhg = *route_entry;
         }
     }
     return nhg;
@@ -1020,7 +1108,7 @@ bool RouteOrch::addNextHopGroup(const NextHopGroupKey &nexthops)
     }
 
     vector<sai_object_id_t> next_hop_ids;
-    set<NextHopKey> next_hop_set = nexthops.getNextHops();
+    auto next_hop_set = nexthops.getNextHops();
     std::map<sai_object_id_t, NextHopKey> nhopgroup_members_set;
     std::map<sai_object_id_t, set<NextHopKey>> nhopgroup_shared_set;
 
@@ -1226,7 +1314,7 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops)
     m_nextHopGroupCount --;
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP);
 
-    set<NextHopKey> next_hop_set = nexthops.getNextHops();
+    auto next_hop_set = nexthops.getNextHops();
     for (auto it : next_hop_set)
     {
         m_neighOrch->decreaseNextHopRefCount(it);
@@ -1256,48 +1344,80 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops)
 
 bool RouteOrch::updateNextHopRoutes(const NextHopKey& nextHop, uint32_t& numRoutes)
 {
-    numRoutes = 0;
-    sai_route_entry_t route_entry;
-    sai_attribute_t route_attr;
-    sai_object_id_t next_hop_id;
+    map<NextHopKey, uint32_t> counts;
+    bool rc = updateNextHopRoutes(vector<NextHopKey>{ nextHop }, counts);
+
+    numRoutes = counts[nextHop];
+    return rc;
+}
+
+/*
+ * Points the routes whose only next hop is one of the next hops to the
+ * current id of that next hop, with one scan of the routes and one bulk
+ * call, so that a MUX switchover moves all the routes of its neighbors at
+ * once. Returns in numRoutes the number of routes updated per next hop.
+ */
+bool RouteOrch::updateNextHopRoutes(const vector<NextHopKey>& nextHops, map<NextHopKey, uint32_t>& numRoutes)
+{
+    SWSS_LOG_ENTER();
+
+    set<NextHopKey> updated(nextHops.begin(), nextHops.end());
+    vector<sai_route_entry_t> route_entries;
+    vector<IpPrefix> prefixes;
+    vector<NextHopKey> route_nexthops;
+    bool rc = true;
+
+    numRoutes.clear();
+
+    // Skip routes with ecmp nexthops
+    auto isUpdated = [&](const NextHopGroupKey &nexthops) {
+        return nexthops.getSize() == 1 && updated.count(*nexthops.getNextHops().begin());
+    };
 
-    for (auto rt_table : m_syncdRoutes)
+    for (const auto &rt_table : m_syncdRoutes)
     {
-        for (auto rt_entry : rt_table.second)
-        {
-            // Skip routes with ecmp nexthops
-            if (rt_entry.second.getSize() > 1)
-            {
-                continue;
-            }
+        rt_table.second.forEachWithNextHops(isUpdated, [&](const IpPrefix &prefix, const NextHopGroupKey &nexthops) {
+            const NextHopKey &nexthop = *nexthops.getNextHops().begin();
 
-            if (rt_entry.second.contains(nextHop))
-            {
-                SWSS_LOG_INFO("Updating route %s during nexthop status change",
-                               rt_entry.first.to_string().c_str());
-                next_hop_id = m_neighOrch->getNextHopId(nextHop);
+            sai_route_entry_t route_entry;
+            route_entry.vr_id = rt_table.first;
+            route_entry.switch_id = gSwitchId;
+            copy(route_entry.destination, prefix);
 
-                route_entry.vr_id = rt_table.first;
-                route_entry.switch_id = gSwitchId;
-                copy(route_entry.destination, rt_entry.first);
+            route_entries.push_back(route_entry);
+            prefixes.push_back(prefix);
+            route_nexthops.push_back(nexthop);
+        });
+    }
 
-                route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
-                route_attr.value.oid = next_hop_id;
+    vector<sai_status_t> statuses(route_entries.size());
+    for (size_t i = 0; i < route_entries.size(); i++)
+    {
+        SWSS_LOG_INFO("Updating route %s during nexthop status change",
+                       prefixes[i].to_string().c_str());
 
-                sai_status_t status = sai_route_api->set_route_entry_attribute(&route_entry, &route_attr);
-                if (status != SAI_STATUS_SUCCESS)
-                {
-                    SWSS_LOG_ERROR("Failed to update route %s, rv:%d",
-                                    rt_entry.first.to_string().c_str(), status);
-                    return false;
-                }
+        sai_attribute_t route_attr;
+        route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+        route_attr.value.oid = m_neighOrch->getNextHopId(route_nexthops[i]);
 
-                ++numRoutes;
-            }
+        gRouteBulker.set_entry_attribute(&statuses[i], &route_entries[i], &route_attr);
+    }
+    gRouteBulker.flush();
+
+    for (size_t i = 0; i < route_entries.size(); i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to update route %s, rv:%d",
+                            prefixes[i].to_string().c_str(), statuses[i]);
+            rc = false;
+            continue;
         }
+
+        ++numRoutes[route_nexthops[i]];
     }
 
-    return true;
+    return rc;
 }
 
 void RouteOrch::addTempRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
@@ -1306,7 +1426,7 @@ void RouteOrch::addTempRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextH
 
     IpPrefix& ipPrefix = ctx.ip_prefix;
 
-    auto next_hop_set = nextHops.getNextHops();
+    set<NextHopKey> next_hop_set = nextHops.getNextHops();
 
     /* Remove next hops that are not in m_syncdNextHops */
     for (auto it = next_hop_set.begin(); it != next_hop_set.end();)
@@ -1498,15 +1618,15 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
 
                 /* If the current next hop is part of the next hop group to sync,
                  * then return false and no need to add another temporary route. */
-                if (it_route != m_syncdRoutes.at(vrf_id).end() && it_route->second.getSize() == 1)
+                if (it_route && it_route->getSize() == 1)
                 {
                     NextHopKey nexthop;
-                    auto old_nextHops = it_route->second;
+                    auto old_nextHops = *it_route;
 
                     if (old_nextHops.is_overlay_nexthop()) {
-                        nexthop = NextHopKey(it_route->second.to_string(), true);
+                        nexthop = NextHopKey(it_route->to_string(), true);
                     } else {
-                        nexthop = NextHopKey(it_route->second.to_string());
+                        nexthop = NextHopKey(it_route->to_string());
                     }
 
                     if (nextHops.contains(nexthop))
@@ -1542,7 +1662,7 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
      * (group) id. The old next hop (group) is then not used and the reference
      * count will decrease by 1.
      */
-    if (it_route == m_syncdRoutes.at(vrf_id).end())
+    if (!it_route)
     {
         route_attr.id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
         route_attr.value.oid = next_hop_id;
@@ -1560,7 +1680,7 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
     else
     {
         /* Set the packet action to forward when there was no next hop (dropped) */
-        if (it_route->second.getSize() == 0)
+        if (it_route->getSize() == 0)
         {
             route_attr.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
             route_attr.value.s32 = SAI_PACKET_ACTION_FORWARD;
@@ -1659,7 +1779,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
     auto it_route = m_syncdRoutes.at(vrf_id).find(ipPrefix);
     if (isFineGrained)
     {
-        if (it_route == m_syncdRoutes.at(vrf_id).end())
+        if (!it_route)
         {
             /* First time route addition pointing to FG nhg */
             if (*it_status++ != SAI_STATUS_SUCCESS)
@@ -1685,23 +1805,23 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         else
         {
             /* Route already exists */
-            auto nh_entry = m_syncdNextHopGroups.find(it_route->second);
+            auto nh_entry = m_syncdNextHopGroups.find(*it_route);
             if (nh_entry != m_syncdNextHopGroups.end())
             {
                 /* Case where route was pointing to non-fine grained nhs in the past,
                  * and transitioned to Fine Grained ECMP */
-                decreaseNextHopRefCount(it_route->second);
-                if (it_route->second.getSize() > 1
-                    && m_syncdNextHopGroups[it_route->second].ref_count == 0)
+                decreaseNextHopRefCount(*it_route);
+                if (it_route->getSize() > 1
+                    && m_syncdNextHopGroups[*it_route].ref_count == 0)
                 {
-                    m_bulkNhgReducedRefCnt.emplace(it_route->second);
+                    m_bulkNhgReducedRefCnt.emplace(*it_route);
                 }
             }
             SWSS_LOG_INFO("FG Post set route %s with next hop(s) %s",
                     ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
         }
     }
-    else if (it_route == m_syncdRoutes.at(vrf_id).end())
+    else if (!it_route)
     {
         sai_status_t status = *it_status++;
         if (status != SAI_STATUS_SUCCESS)
@@ -1740,7 +1860,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         sai_status_t status;
 
         /* Set the packet action to forward when there was no next hop (dropped) */
-        if (it_route->second.getSize() == 0)
+        if (it_route->getSize() == 0)
         {
             status = *it_status++;
             if (status != SAI_STATUS_SUCCESS)
@@ -1777,12 +1897,12 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         }
         else
         {
-            decreaseNextHopRefCount(it_route->second);
-            auto ol_nextHops = it_route->second;
-            if (it_route->second.getSize() > 1
-                && m_syncdNextHopGroups[it_route->second].ref_count == 0)
+            decreaseNextHopRefCount(*it_route);
+            auto ol_nextHops = *it_route;
+            if (it_route->getSize() > 1
+                && m_syncdNextHopGroups[*it_route].ref_count == 0)
             {
-                m_bulkNhgReducedRefCnt.emplace(it_route->second);
+                m_bulkNhgReducedRefCnt.emplace(*it_route);
             } else if (ol_nextHops.is_overlay_nexthop()){
 
                 SWSS_LOG_NOTICE("Update overlay Nexthop %s", ol_nextHops.to_string().c_str());
@@ -1794,7 +1914,7 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
                 ipPrefix.to_string().c_str(), nextHops.to_string().c_str());
     }
 
-    m_syncdRoutes[vrf_id][ipPrefix] = nextHops;
+    m_syncdRoutes[vrf_id].set(ipPrefix, nextHops);
 
     notifyNextHopChangeObservers(vrf_id, ipPrefix, nextHops, true);
     return true;
@@ -1821,7 +1941,7 @@ bool RouteOrch::removeRoute(RouteBulkContext& ctx)
 
     auto it_route = it_route_table->second.find(ipPrefix);
     size_t creating = gRouteBulker.creating_entries_count(route_entry);
-    if (it_route == it_route_table->second.end() && creating == 0)
+    if (!it_route && creating == 0)
     {
         SWSS_LOG_INFO("Failed to find route entry, vrf_id 0x%" PRIx64 ", prefix %s\n", vrf_id,
                 ipPrefix.to_string().c_str());
@@ -1938,14 +2058,14 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
         /*
          * Decrease the reference count only when the route is pointing to a next hop.
          */
-        decreaseNextHopRefCount(it_route->second);
+        decreaseNextHopRefCount(*it_route);
 
-        auto ol_nextHops = it_route->second;
+        auto ol_nextHops = *it_route;
 
-        if (it_route->second.getSize() > 1
-            && m_syncdNextHopGroups[it_route->second].ref_count == 0)
+        if (it_route->getSize() > 1
+            && m_syncdNextHopGroups[*it_route].ref_count == 0)
         {
-            m_bulkNhgReducedRefCnt.emplace(it_route->second);
+            m_bulkNhgReducedRefCnt.emplace(*it_route);
         } else if (ol_nextHops.is_overlay_nexthop()){
             SWSS_LOG_NOTICE("Remove overlay Nexthop %s", ol_nextHops.to_string().c_str());
             removeOverlayNextHops(vrf_id, ol_nextHops);
@@ -1953,14 +2073,14 @@ bool RouteOrch::removeRoutePost(const RouteBulkContext& ctx)
     }
 
     SWSS_LOG_INFO("Remove route %s with next hop(s) %s",
-            ipPrefix.to_string().c_str(), it_route->second.to_string().c_str());
+            ipPrefix.to_string().c_str(), it_route->to_string().c_str());
 
     if (ipPrefix.isDefaultRoute())
     {
-        it_route_table->second[ipPrefix] = NextHopGroupKey();
+        it_route_table->second.set(ipPrefix, NextHopGroupKey());
 
         /* Notify about default route next hop change */
-        notifyNextHopChangeObservers(vrf_id, ipPrefix, it_route_table->second[ipPrefix], true);
+        notifyNextHopChangeObservers(vrf_id, ipPrefix, NextHopGroupKey(), true);
     }
     else
     {
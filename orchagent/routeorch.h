@@ -12,9 +12,11 @@
 #include "ipaddresses.h"
 #include "ipprefix.h"
 #include "nexthopgroupkey.h"
+#include "routetrie.h"
 #include "bulker.h"
 #include "fgnhgorch.h"
 #include <map>
+#include <unordered_map>
 
 /* Maximum next hop group number */
 #define NHGRP_MAX_SIZE 128
@@ -43,9 +45,7 @@ struct NextHopUpdate
 struct NextHopObserverEntry;
 
 /* NextHopGroupTable: NextHopGroupKey, NextHopGroupEntry */
-typedef std::map<NextHopGroupKey, NextHopGroupEntry> NextHopGroupTable;
-/* RouteTable: destination network, NextHopGroupKey */
-typedef std::map<IpPrefix, NextHopGroupKey> RouteTable;
+typedef std::unordered_map<NextHopGroupKey, NextHopGroupEntry> NextHopGroupTable;
 /* RouteTables: vrf_id, RouteTable */
 typedef std::map<sai_object_id_t, RouteTable> RouteTables;
 /* Host: vrf_id, IpAddress */
@@ -53,9 +53,12 @@ typedef std::pair<sai_object_id_t, IpAddress> Host;
 /* NextHopObserverTable: Host, next hop observer entry */
 typedef std::map<Host, NextHopObserverEntry> NextHopObserverTable;
 
+/* NextHopObserverRouteTable: prefixes covering the observed address, NextHopGroupKey */
+typedef std::map<IpPrefix, NextHopGroupKey> NextHopObserverRouteTable;
+
 struct NextHopObserverEntry
 {
-    RouteTable routeTable;
+    NextHopObserverRouteTable routeTable;
     list<Observer *> observers;
 };
 
@@ -108,9 +111,13 @@ public:
     bool removeNextHopGroup(const NextHopGroupKey&);
 
     bool updateNextHopRoutes(const NextHopKey&, uint32_t&);
+    bool updateNextHopRoutes(const vector<NextHopKey>&, map<NextHopKey, uint32_t>&);
 
     bool validnexthopinNextHopGroup(const NextHopKey&, uint32_t&);
+    bool validnexthopsinNextHopGroup(const vector<NextHopKey>&, map<NextHopKey, uint32_t>&);
     bool invalidnexthopinNextHopGroup(const NextHopKey&, uint32_t&);
+    bool invalidnexthopsinNextHopGroup(const vector<NextHopKey>&, uint32_t&);
+    bool invalidnexthopsinNextHopGroup(const vector<NextHopKey>&, map<NextHopKey, uint32_t>&);
 
     bool createRemoteVtep(sai_object_id_t, const NextHopKey&);
     bool deleteRemoteVtep(sai_object_id_t, const NextHopKey&);
@@ -0,0 +1,579 @@
+#ifndef SWSS_ROUTETRIE_H
+#define SWSS_ROUTETRIE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <deque>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include "ipaddress.h"
+#include "ipprefix.h"
+#include "nexthopgroupkey.h"
+
+/* IPv4 trie key, address bits in host order */
+struct RouteTrieV4Key
+{
+    static const uint8_t width = 32;
+
+    uint32_t addr;
+
+    bool bit(uint8_t pos) const
+    {
+        return (addr >> (width - 1 - pos)) & 1;
+    }
+
+    uint8_t commonPrefixLength(const RouteTrieV4Key &o) const
+    {
+        uint32_t diff = addr ^ o.addr;
+        return diff ? static_cast<uint8_t>(__builtin_clz(diff)) : width;
+    }
+
+    RouteTrieV4Key masked(uint8_t len) const
+    {
+        return { len ? addr & (UINT32_MAX << (width - len)) : 0 };
+    }
+};
+
+/* IPv6 trie key, address bits in host order split in two 64-bit halves */
+struct RouteTrieV6Key
+{
+    static const uint8_t width = 128;
+
+    uint64_t hi;
+    uint64_t lo;
+
+    bool bit(uint8_t pos) const
+    {
+        return pos < 64 ? (hi >> (63 - pos)) & 1 : (lo >> (127 - pos)) & 1;
+    }
+
+    uint8_t commonPrefixLength(const RouteTrieV6Key &o) const
+    {
+        if (hi != o.hi)
+        {
+            return static_cast<uint8_t>(__builtin_clzll(hi ^ o.hi));
+        }
+        if (lo != o.lo)
+        {
+            return static_cast<uint8_t>(64 + __builtin_clzll(lo ^ o.lo));
+        }
+        return width;
+    }
+
+    RouteTrieV6Key masked(uint8_t len) const
+    {
+        if (len == 0)
+        {
+            return { 0, 0 };
+        }
+        if (len <= 64)
+        {
+            return { hi & (UINT64_MAX << (64 - len)), 0 };
+        }
+        return { hi, len == width ? lo : lo & (UINT64_MAX << (width - len)) };
+    }
+};
+
+/*
+ * Path compressed binary trie of prefixes, mapping each prefix to a 32-bit
+ * value. Nodes are kept in a vector and link to their children by index, a
+ * node without value always has two children so the trie holds at most two
+ * nodes per prefix.
+ */
+template <typename Key>
+class PrefixTrie
+{
+public:
+    typedef uint32_t Value;
+    static const uint32_t npos = UINT32_MAX;
+
+    PrefixTrie() : m_root(npos), m_size(0) { }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    /* Returns the value of the prefix, npos if it is not in the trie */
+    Value find(const Key &key, uint8_t len) const
+    {
+        Key k = key.masked(len);
+        uint32_t cur = m_root;
+        while (cur != npos)
+        {
+            const Node &n = m_nodes[cur];
+            if (n.len > len || k.commonPrefixLength(n.key) < n.len)
+            {
+                return npos;
+            }
+            if (n.len == len)
+            {
+                return n.value;
+            }
+            cur = n.child[k.bit(n.len)];
+        }
+        return npos;
+    }
+
+    /* Sets the value of the prefix, returns the value it replaces or npos */
+    Value insert(const Key &key, uint8_t len, Value value)
+    {
+        Key k = key.masked(len);
+        uint32_t parent = npos;
+        bool side = false;
+        uint32_t cur = m_root;
+
+        while (cur != npos)
+        {
+            const Node &n = m_nodes[cur];
+            uint8_t common = std::min(k.commonPrefixLength(n.key), std::min(len, n.len));
+            if (common == n.len)
+            {
+                if (n.len == len)
+                {
+                    Value old = n.value;
+                    m_nodes[cur].value = value;
+                    if (old == npos)
+                    {
+                        m_size++;
+                    }
+                    return old;
+                }
+                parent = cur;
+                side = k.bit(n.len);
+                cur = n.child[side];
+                continue;
+            }
+
+            /* The prefix branches off above node cur, n is invalidated by allocation */
+            uint32_t leaf = allocNode(k, len, value);
+            if (common == len)
+            {
+                m_nodes[leaf].child[m_nodes[cur].key.bit(len)] = cur;
+            }
+            else
+            {
+                uint32_t fork = allocNode(k.masked(common), common, npos);
+                m_nodes[fork].child[k.bit(common)] = leaf;
+                m_nodes[fork].child[m_nodes[cur].key.bit(common)] = cur;
+                leaf = fork;
+            }
+            setLink(parent, side, leaf);
+            m_size++;
+            return npos;
+        }
+
+        setLink(parent, side, allocNode(k, len, value));
+        m_size++;
+        return npos;
+    }
+
+    /* Removes the prefix, returns its value or npos if it is not in the trie */
+    Value erase(const Key &key, uint8_t len)
+    {
+        Key k = key.masked(len);
+        uint32_t grandparent = npos;
+        bool grandparent_side = false;
+        uint32_t parent = npos;
+        bool side = false;
+        uint32_t cur = m_root;
+
+        while (cur != npos)
+        {
+            const Node &n = m_nodes[cur];
+            if (n.len > len || k.commonPrefixLength(n.key) < n.len)
+            {
+                return npos;
+            }
+            if (n.len == len)
+            {
+                break;
+            }
+            grandparent = parent;
+            grandparent_side = side;
+            parent = cur;
+            side = k.bit(n.len);
+            cur = n.child[side];
+        }
+
+        if (cur == npos || m_nodes[cur].value == npos)
+        {
+            return npos;
+        }
+
+        Node &n = m_nodes[cur];
+        Value old = n.value;
+        n.value = npos;
+        m_size--;
+
+        if (n.child[0] != npos && n.child[1] != npos)
+        {
+            return old;
+        }
+
+        uint32_t child = n.child[0] != npos ? n.child[0] : n.child[1];
+        setLink(parent, side, child);
+        freeNode(cur);
+
+        /* A parent without value is left with a single child, splice it out */
+        if (child == npos && parent != npos && m_nodes[parent].value == npos)
+        {
+            setLink(grandparent, grandparent_side, m_nodes[parent].child[!side]);
+            freeNode(parent);
+        }
+
+        return old;
+    }
+
+    /*
+     * Calls f(key, len, value) for the prefixes covering the address, from the
+     * shortest to the longest match. f must not modify the trie.
+     */
+    template <typename F>
+    void forEachCovering(const Key &addr, F f) const
+    {
+        uint32_t cur = m_root;
+        while (cur != npos)
+        {
+            const Node &n = m_nodes[cur];
+            if (addr.commonPrefixLength(n.key) < n.len)
+            {
+                return;
+            }
+            if (n.value != npos)
+            {
+                f(n.key, n.len, n.value);
+            }
+            if (n.len == Key::width)
+            {
+                return;
+            }
+            cur = n.child[addr.bit(n.len)];
+        }
+    }
+
+    /* Calls f(key, len, value) for every prefix. f must not modify the trie. */
+    template <typename F>
+    void forEach(F f) const
+    {
+        std::vector<uint32_t> stack;
+        if (m_root != npos)
+        {
+            stack.push_back(m_root);
+        }
+        while (!stack.empty())
+        {
+            const Node &n = m_nodes[stack.back()];
+            stack.pop_back();
+            if (n.value != npos)
+            {
+                f(n.key, n.len, n.value);
+            }
+            for (auto child : n.child)
+            {
+                if (child != npos)
+                {
+                    stack.push_back(child);
+                }
+            }
+        }
+    }
+
+    void clear()
+    {
+        std::vector<Node>().swap(m_nodes);
+        std::vector<uint32_t>().swap(m_free);
+        m_root = npos;
+        m_size = 0;
+    }
+
+    size_t memoryUsage() const
+    {
+        return m_nodes.capacity() * sizeof(Node) + m_free.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    struct Node
+    {
+        Key key;
+        uint32_t child[2];
+        Value value;
+        uint8_t len;
+    };
+
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_free;
+    uint32_t m_root;
+    size_t m_size;
+
+    uint32_t allocNode(const Key &key, uint8_t len, Value value)
+    {
+        Node n = { key, { npos, npos }, value, len };
+        if (!m_free.empty())
+        {
+            uint32_t idx = m_free.back();
+            m_free.pop_back();
+            m_nodes[idx] = n;
+            return idx;
+        }
+        m_nodes.push_back(n);
+        return static_cast<uint32_t>(m_nodes.size() - 1);
+    }
+
+    void freeNode(uint32_t idx)
+    {
+        m_nodes[idx].child[0] = m_nodes[idx].child[1] = npos;
+        m_nodes[idx].value = npos;
+        m_free.push_back(idx);
+    }
+
+    void setLink(uint32_t parent, bool side, uint32_t child)
+    {
+        if (parent == npos)
+        {
+            m_root = child;
+        }
+        else
+        {
+            m_nodes[parent].child[side] = child;
+        }
+    }
+};
+
+/*
+ * Routes of a VRF. Prefixes are kept in a PrefixTrie per address family and
+ * refer to their next hops by the index of a next hop group shared by all the
+ * routes of the table using it, so a route costs one or two trie nodes.
+ * Prefixes are stored masked, callers only pass canonical prefixes (no host
+ * bits set, see isCanonical()) so that the prefixes given back are the ones
+ * they were set with.
+ */
+class RouteTable
+{
+public:
+    size_t size() const { return m_v4.size() + m_v6.size(); }
+    bool empty() const { return size() == 0; }
+
+    static bool isCanonical(const IpPrefix &prefix)
+    {
+        return prefix.getSubnet().getIp() == prefix.getIp();
+    }
+
+    /*
+     * Returns the next hops of the route, nullptr if there is no such route.
+     * The pointer is valid until the route is changed or removed.
+     */
+    const NextHopGroupKey *find(const IpPrefix &prefix) const
+    {
+        uint32_t group = findGroup(prefix);
+        return group == npos ? nullptr : &m_groups[group].nexthops;
+    }
+
+    bool contains(const IpPrefix &prefix) const
+    {
+        return findGroup(prefix) != npos;
+    }
+
+    void set(const IpPrefix &prefix, const NextHopGroupKey &nexthops)
+    {
+        uint32_t group = acquireGroup(nexthops);
+        uint8_t len = static_cast<uint8_t>(prefix.getMaskLength());
+        uint32_t old = prefix.isV4() ? m_v4.insert(v4Key(prefix.getIp()), len, group)
+                                     : m_v6.insert(v6Key(prefix.getIp()), len, group);
+        if (old != npos)
+        {
+            releaseGroup(old);
+        }
+    }
+
+    bool erase(const IpPrefix &prefix)
+    {
+        uint8_t len = static_cast<uint8_t>(prefix.getMaskLength());
+        uint32_t old = prefix.isV4() ? m_v4.erase(v4Key(prefix.getIp()), len)
+                                     : m_v6.erase(v6Key(prefix.getIp()), len);
+        if (old == npos)
+        {
+            return false;
+        }
+        releaseGroup(old);
+        return true;
+    }
+
+    /* Calls f(prefix, nexthops) for every route. f must not modify the table. */
+    template <typename F>
+    void forEach(F f) const
+    {
+        m_v4.forEach([&](const RouteTrieV4Key &key, uint8_t len, uint32_t group) {
+            f(toPrefix(key, len), m_groups[group].nexthops);
+        });
+        m_v6.forEach([&](const RouteTrieV6Key &key, uint8_t len, uint32_t group) {
+            f(toPrefix(key, len), m_groups[group].nexthops);
+        });
+    }
+
+    /*
+     * Calls f(prefix, nexthops) for the routes whose next hops match
+     * pred(nexthops). pred is called once per next hop group of the table,
+     * and the prefix is only built for the routes passed to f. f must not
+     * modify the table.
+     */
+    template <typename P, typename F>
+    void forEachWithNextHops(P pred, F f) const
+    {
+        std::vector<bool> matches(m_groups.size());
+        bool any = false;
+        for (size_t i = 0; i < m_groups.size(); i++)
+        {
+            if (m_groups[i].refs && pred(m_groups[i].nexthops))
+            {
+                matches[i] = any = true;
+            }
+        }
+        if (!any)
+        {
+            return;
+        }
+
+        m_v4.forEach([&](const RouteTrieV4Key &key, uint8_t len, uint32_t group) {
+            if (matches[group])
+            {
+                f(toPrefix(key, len), m_groups[group].nexthops);
+            }
+        });
+        m_v6.forEach([&](const RouteTrieV6Key &key, uint8_t len, uint32_t group) {
+            if (matches[group])
+            {
+                f(toPrefix(key, len), m_groups[group].nexthops);
+            }
+        });
+    }
+
+    /*
+     * Calls f(prefix, nexthops) for the routes covering the address, the
+     * longest prefix match last. f must not modify the table.
+     */
+    template <typename F>
+    void forEachCovering(const IpAddress &addr, F f) const
+    {
+        if (addr.isV4())
+        {
+            m_v4.forEachCovering(v4Key(addr), [&](const RouteTrieV4Key &key, uint8_t len, uint32_t group) {
+                f(toPrefix(key, len), m_groups[group].nexthops);
+            });
+        }
+        else
+        {
+            m_v6.forEachCovering(v6Key(addr), [&](const RouteTrieV6Key &key, uint8_t len, uint32_t group) {
+                f(toPrefix(key, len), m_groups[group].nexthops);
+            });
+        }
+    }
+
+    /* Bytes used by the tries and the next hop groups, excluding the group next hop lists */
+    size_t memoryUsage() const
+    {
+        return m_v4.memoryUsage() + m_v6.memoryUsage()
+            + m_groups.size() * sizeof(Group)
+            + m_freeGroups.capacity() * sizeof(uint32_t)
+            + m_groupIds.bucket_count() * sizeof(void *)
+            + m_groupIds.size() * (sizeof(NextHopGroupKey) + sizeof(uint32_t) + sizeof(void *));
+    }
+
+private:
+    static const uint32_t npos = UINT32_MAX;
+
+    struct Group
+    {
+        NextHopGroupKey nexthops;
+        uint32_t refs;
+    };
+
+    PrefixTrie<RouteTrieV4Key> m_v4;
+    PrefixTrie<RouteTrieV6Key> m_v6;
+    /* Groups stay in place, references to them survive insertion of others */
+    std::deque<Group> m_groups;
+    std::vector<uint32_t> m_freeGroups;
+    std::unordered_map<NextHopGroupKey, uint32_t> m_groupIds;
+
+    uint32_t findGroup(const IpPrefix &prefix) const
+    {
+        uint8_t len = static_cast<uint8_t>(prefix.getMaskLength());
+        return prefix.isV4() ? m_v4.find(v4Key(prefix.getIp()), len)
+                             : m_v6.find(v6Key(prefix.getIp()), len);
+    }
+
+    uint32_t acquireGroup(const NextHopGroupKey &nexthops)
+    {
+        auto found = m_groupIds.find(nexthops);
+        if (found != m_groupIds.end())
+        {
+            m_groups[found->second].refs++;
+            return found->second;
+        }
+
+        uint32_t group;
+        if (m_freeGroups.empty())
+        {
+            group = static_cast<uint32_t>(m_groups.size());
+            m_groups.push_back({ nexthops, 1 });
+        }
+        else
+        {
+            group = m_freeGroups.back();
+            m_freeGroups.pop_back();
+            m_groups[group] = { nexthops, 1 };
+        }
+        m_groupIds.emplace(nexthops, group);
+        return group;
+    }
+
+    void releaseGroup(uint32_t group)
+    {
+        if (--m_groups[group].refs == 0)
+        {
+            m_groupIds.erase(m_groups[group].nexthops);
+            m_groups[group].nexthops.clear();
+            m_freeGroups.push_back(group);
+        }
+    }
+
+    static RouteTrieV4Key v4Key(const IpAddress &ip)
+    {
+        return { ntohl(ip.getV4Addr()) };
+    }
+
+    static RouteTrieV6Key v6Key(const IpAddress &ip)
+    {
+        const uint8_t *bytes = ip.getV6Addr();
+        RouteTrieV6Key key = { 0, 0 };
+        for (int i = 0; i < 8; i++)
+        {
+            key.hi = (key.hi << 8) | bytes[i];
+            key.lo = (key.lo << 8) | bytes[i + 8];
+        }
+        return key;
+    }
+
+    static IpPrefix toPrefix(const RouteTrieV4Key &key, uint8_t len)
+    {
+        ip_addr_t ip;
+        ip.family = AF_INET;
+        ip.ip_addr.ipv4_addr = htonl(key.addr);
+        return IpPrefix(ip, len);
+    }
+
+    static IpPrefix toPrefix(const RouteTrieV6Key &key, uint8_t len)
+    {
+        ip_addr_t ip;
+        ip.family = AF_INET6;
+        for (int i = 0; i < 8; i++)
+        {
+            ip.ip_addr.ipv6_addr[i] = static_cast<uint8_t>(key.hi >> (56 - 8 * i));
+            ip.ip_addr.ipv6_addr[i + 8] = static_cast<uint8_t>(key.lo >> (56 - 8 * i));
+        }
+        return IpPrefix(ip, len);
+    }
+};
+
+#endif /* SWSS_ROUTETRIE_H */
@@ -0,0 +1,514 @@
+#ifndef SWSS_SYNCMAP_H
+#define SWSS_SYNCMAP_H
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+#include <string>
+#include <iterator>
+#include <utility>
+#include <type_traits>
+#include <unordered_map>
+
+#include "table.h"
+
+/*
+ * Pending task store used by Consumer::m_toSync.
+ *
+ * Each key holds at most one DEL and one SET task, and the DEL of a key is
+ * always iterated right before its SET. Keys are iterated in arrival order,
+ * not in key order like the std::multimap did: producers write a parent
+ * object before its children, and Orchs that find a dependency missing keep
+ * the task for retry, so no Orch relies on the sorted order. Tasks refilled
+ * from a table, which has no arrival order, are added in key order.
+ *
+ * Tasks live in a slab of slots linked in iteration order, and a hash index
+ * maps each key to its DEL/SET slots. The key is only stored in the task
+ * tuple: the index points to the key of one of the slots of the key, and
+ * value_type::first is a reference to it. Slots are recycled through a free list
+ * and are never relocated, so iterators and references stay valid across
+ * insertion and across erasure of other tasks, like they do for the
+ * std::multimap this store replaces. The subset of the multimap interface
+ * used by the Orchs (begin/end, rbegin/rend, erase, find, count, size) is
+ * kept so that doTask(Consumer&) implementations do not need to change.
+ */
+class SyncMap
+{
+public:
+    typedef std::string key_type;
+    typedef swss::KeyOpFieldsValuesTuple mapped_type;
+    typedef size_t size_type;
+
+    /* Same layout as the multimap pair to the Orchs, first refers to the key of the tuple */
+    struct value_type
+    {
+        swss::KeyOpFieldsValuesTuple second;
+        const std::string &first;
+
+        value_type() : first(kfvKey(second)) { }
+        value_type(const value_type &other) : second(other.second), first(kfvKey(second)) { }
+        value_type &operator=(const value_type &) = delete;
+    };
+
+private:
+    static const size_t npos = SIZE_MAX;
+
+    /* Field count product above which merge uses a hashed field index */
+    static const size_t linear_merge_limit = 64;
+
+    struct Slot
+    {
+        value_type value;
+        size_t prev;
+        size_t next;
+    };
+
+    struct KeySlots
+    {
+        size_t del;
+        size_t set;
+    };
+
+    /* The index is keyed by a pointer to the key of a slot, lookups pass a pointer to the searched key */
+    struct KeyHash
+    {
+        size_t operator()(const std::string *key) const { return std::hash<std::string>()(*key); }
+    };
+
+    struct KeyEqual
+    {
+        bool operator()(const std::string *a, const std::string *b) const { return *a == *b; }
+    };
+
+    typedef std::unordered_map<const std::string *, KeySlots, KeyHash, KeyEqual> Index;
+
+    template <bool IsConst>
+    class Iterator
+    {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef SyncMap::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<IsConst, const value_type *, value_type *>::type pointer;
+        typedef typename std::conditional<IsConst, const value_type &, value_type &>::type reference;
+        typedef typename std::conditional<IsConst, const SyncMap *, SyncMap *>::type map_pointer;
+
+        Iterator() : m_map(nullptr), m_pos(npos) { }
+        Iterator(map_pointer map, size_t pos) : m_map(map), m_pos(pos) { }
+
+        /* iterator converts to const_iterator, not the other way around */
+        template <bool OtherConst, typename = typename std::enable_if<IsConst && !OtherConst>::type>
+        Iterator(const Iterator<OtherConst> &other) : m_map(other.m_map), m_pos(other.m_pos) { }
+
+        reference operator*() const { return m_map->m_slots[m_pos].value; }
+        pointer operator->() const { return &m_map->m_slots[m_pos].value; }
+
+        Iterator &operator++()
+        {
+            m_pos = m_map->m_slots[m_pos].next;
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        Iterator &operator--()
+        {
+            m_pos = (m_pos == npos) ? m_map->m_tail : m_map->m_slots[m_pos].prev;
+            return *this;
+        }
+
+        Iterator operator--(int)
+        {
+            Iterator tmp = *this;
+            --(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator &other) const { return m_pos == other.m_pos; }
+        bool operator!=(const Iterator &other) const { return m_pos != other.m_pos; }
+
+    private:
+        friend class SyncMap;
+        template <bool> friend class Iterator;
+
+        map_pointer m_map;
+        size_t m_pos;
+    };
+
+public:
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    SyncMap() : m_head(npos), m_tail(npos), m_size(0) { }
+
+    /* Iterators point into this object, copying would leave them dangling */
+    SyncMap(const SyncMap&) = delete;
+    SyncMap& operator=(const SyncMap&) = delete;
+
+    iterator begin() { return iterator(this, m_head); }
+    iterator end() { return iterator(this, npos); }
+    const_iterator begin() const { return const_iterator(this, m_head); }
+    const_iterator end() const { return const_iterator(this, npos); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    void clear()
+    {
+        m_slots.clear();
+        m_free.clear();
+        m_index.clear();
+        m_head = m_tail = npos;
+        m_size = 0;
+    }
+
+    /* Returns the first pending task of the key, DEL before SET */
+    iterator find(const std::string &key)
+    {
+        auto found = m_index.find(&key);
+        if (found == m_index.end())
+        {
+            return end();
+        }
+        const KeySlots &ks = found->second;
+        return iterator(this, ks.del != npos ? ks.del : ks.set);
+    }
+
+    size_t count(const std::string &key) const
+    {
+        auto found = m_index.find(&key);
+        if (found == m_index.end())
+        {
+            return 0;
+        }
+        return (found->second.del != npos ? 1 : 0) + (found->second.set != npos ? 1 : 0);
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        size_t slot = pos.m_pos;
+        size_t next = m_slots[slot].next;
+
+        auto found = m_index.find(&m_slots[slot].value.first);
+        KeySlots ks = found->second;
+        m_index.erase(found);
+        if (ks.del == slot)
+        {
+            ks.del = npos;
+        }
+        else
+        {
+            ks.set = npos;
+        }
+
+        /* The index entry referred to the key of this slot, move it to the remaining one */
+        if (ks.del != npos || ks.set != npos)
+        {
+            index(ks);
+        }
+
+        release(slot);
+        return iterator(this, next);
+    }
+
+    size_t erase(const std::string &key)
+    {
+        auto found = m_index.find(&key);
+        if (found == m_index.end())
+        {
+            return 0;
+        }
+
+        /* The key may be the one of a slot, unindex before releasing */
+        KeySlots ks = found->second;
+        m_index.erase(found);
+        return releaseKeySlots(ks);
+    }
+
+    /*
+     * Add a task, applying the Consumer merge rules:
+     * - a DEL replaces every pending task of the key
+     * - a SET is queued after a pending DEL of the key
+     * - a SET on a pending SET merges the field values into it, fields of the
+     *   new task overwrite the old ones and are appended after the untouched ones
+     */
+    void add(swss::KeyOpFieldsValuesTuple &&entry)
+    {
+        bool isDel = (kfvOp(entry) == DEL_COMMAND);
+
+        auto found = m_index.find(&kfvKey(entry));
+        if (found != m_index.end() && isDel)
+        {
+            KeySlots ks = found->second;
+            m_index.erase(found);
+            releaseKeySlots(ks);
+            found = m_index.end();
+        }
+
+        if (found == m_index.end())
+        {
+            size_t slot = acquire(std::move(entry));
+            link(slot, m_tail);
+            index(isDel ? KeySlots{ slot, npos } : KeySlots{ npos, slot });
+            return;
+        }
+
+        KeySlots &ks = found->second;
+        if (ks.set == npos)
+        {
+            size_t slot = acquire(std::move(entry));
+            link(slot, ks.del);
+            ks.set = slot;
+        }
+        else
+        {
+            swss::KeyOpFieldsValuesTuple &existing = m_slots[ks.set].value.second;
+            kfvOp(existing) = std::move(kfvOp(entry));
+            mergeFieldValues(kfvFieldsValues(existing), kfvFieldsValues(entry));
+        }
+    }
+
+    void add(const swss::KeyOpFieldsValuesTuple &entry)
+    {
+        add(swss::KeyOpFieldsValuesTuple(entry));
+    }
+
+    void swap(SyncMap &other)
+    {
+        m_slots.swap(other.m_slots);
+        m_free.swap(other.m_free);
+        m_index.swap(other.m_index);
+        std::swap(m_head, other.m_head);
+        std::swap(m_tail, other.m_tail);
+        std::swap(m_size, other.m_size);
+    }
+
+    /* Move the pending tasks of the key from another map, through add() */
+    size_t take(SyncMap &from, const std::string &key)
+    {
+        auto found = from.m_index.find(&key);
+        if (found == from.m_index.end())
+        {
+            return 0;
+        }
+
+        /* Moving the tuples out empties the key the index entry refers to */
+        KeySlots ks = found->second;
+        from.m_index.erase(found);
+        if (ks.del != npos)
+        {
+            add(std::move(from.m_slots[ks.del].value.second));
+        }
+        if (ks.set != npos)
+        {
+            add(std::move(from.m_slots[ks.set].value.second));
+        }
+        return from.releaseKeySlots(ks);
+    }
+
+    /* Move all pending tasks of another map after the ones of this map */
+    void splice(SyncMap &from)
+    {
+        for (size_t slot = from.m_head; slot != npos; slot = from.m_slots[slot].next)
+        {
+            add(std::move(from.m_slots[slot].value.second));
+        }
+        from.clear();
+    }
+
+private:
+    std::deque<Slot> m_slots;
+    std::vector<size_t> m_free;
+    Index m_index;
+    size_t m_head;
+    size_t m_tail;
+    size_t m_size;
+
+    size_t acquire(swss::KeyOpFieldsValuesTuple &&entry)
+    {
+        size_t slot;
+        if (m_free.empty())
+        {
+            slot = m_slots.size();
+            m_slots.emplace_back();
+        }
+        else
+        {
+            slot = m_free.back();
+            m_free.pop_back();
+        }
+
+        m_slots[slot].value.second = std::move(entry);
+        m_size++;
+        return slot;
+    }
+
+    /* Index the slots of a key by the key of its first slot */
+    void index(const KeySlots &ks)
+    {
+        size_t slot = (ks.del != npos) ? ks.del : ks.set;
+        m_index.emplace(&m_slots[slot].value.first, ks);
+    }
+
+    void release(size_t slot)
+    {
+        unlink(slot);
+        /* Drop the task content but keep the slot for reuse */
+        m_slots[slot].value.second = swss::KeyOpFieldsValuesTuple();
+        m_free.push_back(slot);
+        m_size--;
+    }
+
+    size_t releaseKeySlots(KeySlots &ks)
+    {
+        size_t released = 0;
+        if (ks.del != npos)
+        {
+            release(ks.del);
+            ks.del = npos;
+            released++;
+        }
+        if (ks.set != npos)
+        {
+            release(ks.set);
+            ks.set = npos;
+            released++;
+        }
+        return released;
+    }
+
+    /* Link the slot after 'after', or at the head when 'after' is npos */
+    void link(size_t slot, size_t after)
+    {
+        Slot &s = m_slots[slot];
+        s.prev = after;
+        s.next = (after == npos) ? m_head : m_slots[after].next;
+
+        if (s.prev == npos)
+        {
+            m_head = slot;
+        }
+        else
+        {
+            m_slots[s.prev].next = slot;
+        }
+
+        if (s.next == npos)
+        {
+            m_tail = slot;
+        }
+        else
+        {
+            m_slots[s.next].prev = slot;
+        }
+    }
+
+    void unlink(size_t slot)
+    {
+        Slot &s = m_slots[slot];
+
+        if (s.prev == npos)
+        {
+            m_head = s.next;
+        }
+        else
+        {
+            m_slots[s.prev].next = s.next;
+        }
+
+        if (s.next == npos)
+        {
+            m_tail = s.prev;
+        }
+        else
+        {
+            m_slots[s.next].prev = s.prev;
+        }
+
+        s.prev = s.next = npos;
+    }
+
+    /*
+     * Merge 'incoming' into 'existing': fields not present in 'incoming' keep
+     * their order, followed by the fields of 'incoming'. When a field repeats
+     * in 'incoming' its last occurrence wins.
+     *
+     * Field lists are usually short, so a linear scan is used unless the lists
+     * are big enough for a per-key field index to pay off.
+     */
+    static void mergeFieldValues(std::vector<swss::FieldValueTuple> &existing,
+                                 std::vector<swss::FieldValueTuple> &incoming)
+    {
+        std::vector<swss::FieldValueTuple> merged;
+        merged.reserve(existing.size() + incoming.size());
+
+        if (existing.size() * incoming.size() <= linear_merge_limit)
+        {
+            auto lastIndexOf = [&incoming](const std::string &field) -> size_t
+            {
+                for (size_t i = incoming.size(); i > 0; i--)
+                {
+                    if (fvField(incoming[i - 1]) == field)
+                    {
+                        return i - 1;
+                    }
+                }
+                return npos;
+            };
+
+            for (auto &fv : existing)
+            {
+                if (lastIndexOf(fvField(fv)) == npos)
+                {
+                    merged.push_back(std::move(fv));
+                }
+            }
+            for (size_t i = 0; i < incoming.size(); i++)
+            {
+                if (lastIndexOf(fvField(incoming[i])) == i)
+                {
+                    merged.push_back(std::move(incoming[i]));
+                }
+            }
+        }
+        else
+        {
+            std::unordered_map<std::string, size_t> lastIndex;
+            lastIndex.reserve(incoming.size());
+            for (size_t i = 0; i < incoming.size(); i++)
+            {
+                lastIndex[fvField(incoming[i])] = i;
+            }
+
+            for (auto &fv : existing)
+            {
+                if (lastIndex.find(fvField(fv)) == lastIndex.end())
+                {
+                    merged.push_back(std::move(fv));
+                }
+            }
+            for (size_t i = 0; i < incoming.size(); i++)
+            {
+                if (lastIndex[fvField(incoming[i])] == i)
+                {
+                    merged.push_back(std::move(incoming[i]));
+                }
+            }
+        }
+
+        existing.swap(merged);
+    }
+};
+
+#endif /* SWSS_SYNCMAP_H */
@@ -110,6 +110,9 @@ bool VRFOrch::addOperation(const Request& request)
         }
         m_stateVrfObjectTable.hset(vrf_name, "state", "ok");
         SWSS_LOG_NOTICE("VRF '%s' was added", vrf_name.c_str());
+
+        /* Interfaces and routes of the VRF may wait for it */
+        Orch::wakeRetries();
     }
     else
     {
@@ -1,23 +1,174 @@
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <unistd.h>
+#include <time.h>
+#include <stdlib.h>
 
 #include <dbconnector.h>
+#include <redispipeline.h>
 #include <producerstatetable.h>
+#include <table.h>
 #include <schema.h>
 #include <tokenize.h>
 
+#include "recordformat.h"
+
 using namespace std;
 using namespace swss;
 
+#define DEFAULT_BATCH_SIZE 128
+
 static int line_index = 0;
-static DBConnector db("APPL_DB", 0, true);
 
 void usage()
 {
-	cout << "Usage: swssplayer <file>" << endl;
+	cout << "Usage: swssplayer [-t] [-b batch_size] <file>" << endl;
+	cout << "    -t: replay with the timing of the recording (default: as fast as possible)" << endl;
+	cout << "    -b batch_size: operations written per redis pipeline flush (default " << DEFAULT_BATCH_SIZE << ")" << endl;
+	cout << "    <file>: swss.rec recording, text or binary" << endl;
 	/* TODO: Add sample input file */
 }
 
+/*
+ * Replays operations through one redis pipeline per DB, flushed every
+ * batch_size operations instead of a round trip per operation.
+ */
+class Player
+{
+public:
+	Player(size_t batchSize, bool timed) :
+		m_batchSize(batchSize),
+		m_timed(timed),
+		m_pending(0),
+		m_started(false),
+		m_firstTimestamp(0)
+	{
+	}
+
+	~Player()
+	{
+		flush();
+	}
+
+	void apply(const string &dbName, const string &tableName, const string &key,
+		   const string &op, const vector<FieldValueTuple> &fvs)
+	{
+		auto &db = getDb(dbName);
+
+		if (dbName == "APPL_DB")
+		{
+			auto &producer = db.producers[tableName];
+			if (!producer)
+			{
+				producer.reset(new ProducerStateTable(db.pipeline.get(), tableName, true));
+			}
+
+			if (op == SET_COMMAND)
+			{
+				producer->set(key, fvs, SET_COMMAND);
+			}
+			else if (op == DEL_COMMAND)
+			{
+				producer->del(key, DEL_COMMAND);
+			}
+		}
+		else
+		{
+			auto &table = db.tables[tableName];
+			if (!table)
+			{
+				table.reset(new Table(db.pipeline.get(), tableName, true));
+			}
+
+			if (op == SET_COMMAND)
+			{
+				table->set(key, fvs);
+			}
+			else if (op == DEL_COMMAND)
+			{
+				table->del(key);
+			}
+		}
+
+		if (++m_pending >= m_batchSize)
+		{
+			flush();
+		}
+	}
+
+	/* Wait until the time of a record, relative to the first one */
+	void wait(uint64_t timestamp)
+	{
+		if (!m_timed)
+		{
+			return;
+		}
+
+		auto now = chrono::steady_clock::now();
+		if (!m_started)
+		{
+			m_started = true;
+			m_firstTimestamp = timestamp;
+			m_start = now;
+			return;
+		}
+
+		if (timestamp <= m_firstTimestamp)
+		{
+			return;
+		}
+
+		auto due = m_start + chrono::microseconds(timestamp - m_firstTimestamp);
+		if (due > now)
+		{
+			/* Whatever is queued was due before */
+			flush();
+			this_thread::sleep_until(due);
+		}
+	}
+
+	void flush()
+	{
+		for (auto &it : m_dbs)
+		{
+			it.second.pipeline->flush();
+		}
+		m_pending = 0;
+	}
+
+private:
+	struct Db
+	{
+		unique_ptr<DBConnector> connector;
+		unique_ptr<RedisPipeline> pipeline;
+		map<string, unique_ptr<ProducerStateTable>> producers;
+		map<string, unique_ptr<Table>> tables;
+	};
+
+	Db &getDb(const string &dbName)
+	{
+		auto &db = m_dbs[dbName];
+		if (!db.connector)
+		{
+			db.connector.reset(new DBConnector(dbName, 0, true));
+			db.pipeline.reset(new RedisPipeline(db.connector.get(), m_batchSize));
+		}
+		return db;
+	}
+
+	size_t m_batchSize;
+	bool m_timed;
+	size_t m_pending;
+	bool m_started;
+	uint64_t m_firstTimestamp;
+	chrono::steady_clock::time_point m_start;
+	map<string, Db> m_dbs;
+};
+
 vector<FieldValueTuple> processFieldsValuesTuple(string s)
 {
 	vector<FieldValueTuple> result;
@@ -34,46 +185,153 @@ vector<FieldValueTuple> processFieldsValuesTuple(string s)
 	return result;
 }
 
-void processTokens(vector<string> tokens)
+/* Parse the swss::getTimestamp() format, returns 0 when it does not match */
+uint64_t parseTimestamp(const string &s)
 {
+	struct tm tm = {};
+	const char *usec = strptime(s.c_str(), "%Y-%m-%d.%T.", &tm);
+	if (usec == NULL)
+	{
+		return 0;
+	}
+
+	tm.tm_isdst = -1;
+	time_t sec = mktime(&tm);
+	if (sec == -1)
+	{
+		return 0;
+	}
+
+	return static_cast<uint64_t>(sec) * 1000000 + strtoull(usec, NULL, 10);
+}
+
+void processTokens(Player &player, vector<string> tokens)
+{
+	/* Skip text records such as "recording started" */
+	if (tokens.size() < 3)
+	{
+		return;
+	}
+
 	auto key = tokens[1];
 
 	/* Process the key */
 	auto v_key = tokenize(key, ':', 1);
+	if (v_key.size() != 2)
+	{
+		return;
+	}
 	auto table_name = v_key[0];
 	auto key_name = v_key[1];
 
-	ProducerStateTable producer(&db, table_name);
+	player.wait(parseTimestamp(tokens[0]));
 
 	/* Process the operation */
 	auto op = tokens[2];
 	if (op == SET_COMMAND)
 	{
-		auto tuples = processFieldsValuesTuple(tokens[3]);
-		producer.set(key_name, tuples, SET_COMMAND);
+		auto tuples = tokens.size() > 3 ? processFieldsValuesTuple(tokens[3]) : vector<FieldValueTuple>();
+		player.apply("APPL_DB", table_name, key_name, SET_COMMAND, tuples);
 	}
 	else if (op == DEL_COMMAND)
 	{
-		producer.del(key_name, DEL_COMMAND);
+		player.apply("APPL_DB", table_name, key_name, DEL_COMMAND, {});
+	}
+}
+
+void playText(Player &player, ifstream &file)
+{
+	string line;
+
+	while (getline(file, line))
+	{
+		auto tokens = tokenize(line, '|', 3);
+		processTokens(player, tokens);
+
+		line_index++;
+	}
+}
+
+void playBinary(Player &player, ifstream &file)
+{
+	vector<char> buffer;
+	Record record;
+
+	while (readRecord(file, buffer, record))
+	{
+		line_index++;
+
+		if (record.type != RECORD_TUPLE)
+		{
+			continue;
+		}
+
+		player.wait(record.timestamp);
+		player.apply(record.db, record.table, record.key, record.op, record.fvs);
+	}
+
+	if (!file.eof())
+	{
+		cerr << "Stopped at malformed record " << line_index + 1 << endl;
 	}
 }
 
 int main(int argc, char **argv)
 {
-	if (argc != 2)
+	size_t batch_size = DEFAULT_BATCH_SIZE;
+	bool timed = false;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "tb:h")) != -1)
+	{
+		switch (opt)
+		{
+		case 't':
+			timed = true;
+			break;
+		case 'b':
+			batch_size = strtoul(optarg, NULL, 10);
+			if (batch_size == 0)
+			{
+				usage();
+				exit(EXIT_FAILURE);
+			}
+			break;
+		case 'h':
+			usage();
+			exit(EXIT_SUCCESS);
+		default:
+			usage();
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (optind != argc - 1)
 	{
 		usage();
 		exit(EXIT_FAILURE);
 	}
 
-	ifstream file(argv[1]);
-	string line;
-
-	while (getline(file, line))
+	ifstream file(argv[optind], ifstream::binary);
+	if (!file.is_open())
 	{
-		auto tokens = tokenize(line, '|', 3);
-		processTokens(tokens);
+		cerr << "Failed to open " << argv[optind] << endl;
+		exit(EXIT_FAILURE);
+	}
 
-		line_index++;
+	Player player(batch_size, timed);
+
+	RecordFileHeader header;
+	if (file.read(reinterpret_cast<char *>(&header), sizeof(header)) && isRecordFileHeader(header))
+	{
+		playBinary(player, file);
 	}
+	else
+	{
+		file.clear();
+		file.seekg(0);
+		playText(player, file);
+	}
+
+	player.flush();
 }
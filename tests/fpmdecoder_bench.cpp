@@ -0,0 +1,84 @@
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "fpmsyncd/fpm/fpm.h"
+#include "fpmsyncd/routedecoder.h"
+#include "fpmroutemsg.h"
+
+/*
+ * Microbenchmarks, built on demand with "make benchmarks" and not run by
+ * "make check": timings depend on the machine and only compare implementations.
+ */
+using namespace std;
+using namespace swss;
+
+/*
+ * Decodes an FPM byte stream as fpmsyncd receives it and reports the rate.
+ * FPM_CAPTURE names a capture of the FPM connection to replay, a synthetic
+ * full table load is used otherwise.
+ */
+TEST(RouteDecoderBench, Replay)
+{
+    vector<char> stream;
+
+    const char *capture = getenv("FPM_CAPTURE");
+    if (capture)
+    {
+        ifstream in(capture, ifstream::binary);
+        ASSERT_TRUE(in.is_open()) << "Failed to open " << capture;
+        stream.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+    else
+    {
+        char gw[INET_ADDRSTRLEN];
+        char dst[INET_ADDRSTRLEN];
+        for (uint32_t i = 0; i < 200000; i++)
+        {
+            RouteMsg msg(RTM_NEWROUTE, AF_INET, 24);
+            snprintf(dst, sizeof(dst), "%u.%u.%u.0", 1 + (i >> 16), (i >> 8) & 0xff, i & 0xff);
+            snprintf(gw, sizeof(gw), "10.0.%u.1", i & 0x3);
+            msg.addAddr(RTA_DST, dst);
+            msg.addMultipath({ { gw, 10 }, { "10.0.4.1", 11 } });
+            appendFpmMsg(stream, msg);
+        }
+    }
+
+    RouteDecoder decoder;
+    char buf[RouteDecoder::ADDR_STRLEN];
+    string nexthops;
+    size_t messages = 0;
+    size_t bytes = 0;
+
+    auto start = chrono::steady_clock::now();
+    size_t pos = 0;
+    while (stream.size() - pos >= FPM_MSG_HDR_LEN)
+    {
+        fpm_msg_hdr_t *hdr = reinterpret_cast<fpm_msg_hdr_t *>(&stream[pos]);
+        size_t msg_len = fpm_msg_len(hdr);
+        ASSERT_TRUE(fpm_msg_ok(hdr, stream.size() - pos));
+
+        nlmsghdr *nl_hdr = reinterpret_cast<nlmsghdr *>(fpm_msg_data(hdr));
+        if (hdr->msg_type == FPM_MSG_TYPE_NETLINK && decoder.decode(nl_hdr))
+        {
+            bytes += decoder.formatPrefix(buf);
+            nexthops.clear();
+            decoder.formatGateways(nexthops);
+            bytes += nexthops.size();
+            messages++;
+        }
+        pos += msg_len;
+    }
+    auto usecs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    ASSERT_GT(messages, 0);
+    cout << "Decoded " << messages << " route messages (" << bytes << " bytes formatted) in "
+         << usecs << " us, " << (usecs ? messages * 1000000 / static_cast<size_t>(usecs) : 0)
+         << " messages/s" << endl;
+}
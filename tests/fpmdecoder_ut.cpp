@@ -0,0 +1,199 @@
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "fpmsyncd/fpm/fpm.h"
+#include "fpmsyncd/routedecoder.h"
+#include "fpmroutemsg.h"
+
+using namespace std;
+using namespace swss;
+
+static string prefix(const RouteDecoder &decoder)
+{
+    char buf[RouteDecoder::ADDR_STRLEN];
+    return string(buf, decoder.formatPrefix(buf));
+}
+
+static string gateways(const RouteDecoder &decoder)
+{
+    string out;
+    decoder.formatGateways(out);
+    return out;
+}
+
+TEST(RouteDecoder, ipv4_single_nexthop)
+{
+    RouteMsg msg(RTM_NEWROUTE, AF_INET, 24);
+    msg.addAddr(RTA_DST, "192.168.10.0");
+    msg.addAddr(RTA_GATEWAY, "10.0.0.1");
+    msg.addU32(RTA_OIF, 5);
+
+    RouteDecoder decoder;
+    ASSERT_TRUE(decoder.decode(msg.hdr()));
+    EXPECT_EQ(decoder.getMsgType(), RTM_NEWROUTE);
+    EXPECT_EQ(decoder.getRouteType(), RTN_UNICAST);
+    EXPECT_EQ(decoder.getTable(), RT_TABLE_MAIN);
+    EXPECT_FALSE(decoder.hasEncap());
+    EXPECT_EQ(prefix(decoder), "192.168.10.0/24");
+    EXPECT_EQ(gateways(decoder), "10.0.0.1");
+    ASSERT_EQ(decoder.getNextHopCount(), 1);
+    EXPECT_EQ(decoder.getNextHop(0).ifindex, 5);
+}
+
+TEST(RouteDecoder, host_route)
+{
+    /* nl_addr2str() omits the prefix length of host routes */
+    RouteMsg v4(RTM_DELROUTE, AF_INET, 32);
+    v4.addAddr(RTA_DST, "1.2.3.255");
+
+    RouteDecoder decoder;
+    ASSERT_TRUE(decoder.decode(v4.hdr()));
+    EXPECT_EQ(decoder.getMsgType(), RTM_DELROUTE);
+    EXPECT_EQ(prefix(decoder), "1.2.3.255");
+    EXPECT_EQ(decoder.getNextHopCount(), 0);
+
+    RouteMsg v6(RTM_NEWROUTE, AF_INET6, 128);
+    v6.addAddr(RTA_DST, "fc00::1");
+    ASSERT_TRUE(decoder.decode(v6.hdr()));
+    EXPECT_EQ(prefix(decoder), "fc00::1");
+}
+
+TEST(RouteDecoder, default_route)
+{
+    RouteMsg v4(RTM_NEWROUTE, AF_INET, 0);
+    v4.addAddr(RTA_DST, "0.0.0.0");
+    v4.addU32(RTA_OIF, 2);
+
+    RouteDecoder decoder;
+    ASSERT_TRUE(decoder.decode(v4.hdr()));
+    EXPECT_EQ(prefix(decoder), "0.0.0.0/0");
+    EXPECT_EQ(gateways(decoder), "0.0.0.0");
+
+    /* Without RTA_DST */
+    RouteMsg v6(RTM_NEWROUTE, AF_INET6, 0);
+    v6.addU32(RTA_OIF, 2);
+    ASSERT_TRUE(decoder.decode(v6.hdr()));
+    EXPECT_EQ(prefix(decoder), "::/0");
+    EXPECT_EQ(gateways(decoder), "::");
+}
+
+TEST(RouteDecoder, ipv6_multipath)
+{
+    RouteMsg msg(RTM_NEWROUTE, AF_INET6, 64);
+    msg.addAddr(RTA_DST, "2001:db8:1::");
+    msg.addU32(RTA_TABLE, 1001);
+    msg.addMultipath({ { "fe80::1", 10 }, { NULL, 11 }, { "2001:db8::2", 12 } });
+
+    RouteDecoder decoder;
+    ASSERT_TRUE(decoder.decode(msg.hdr()));
+    EXPECT_EQ(decoder.getTable(), 1001);
+    EXPECT_EQ(prefix(decoder), "2001:db8:1::/64");
+    EXPECT_EQ(gateways(decoder), "fe80::1,::,2001:db8::2");
+    ASSERT_EQ(decoder.getNextHopCount(), 3);
+    EXPECT_EQ(decoder.getNextHop(0).ifindex, 10);
+    EXPECT_EQ(decoder.getNextHop(1).ifindex, 11);
+    EXPECT_EQ(decoder.getNextHop(2).ifindex, 12);
+
+    /* The next hops of the previous message are not kept */
+    RouteMsg single(RTM_NEWROUTE, AF_INET, 8);
+    single.addAddr(RTA_DST, "10.0.0.0");
+    single.addAddr(RTA_GATEWAY, "100.64.0.254");
+    ASSERT_TRUE(decoder.decode(single.hdr()));
+    EXPECT_EQ(gateways(decoder), "100.64.0.254");
+}
+
+TEST(RouteDecoder, encap)
+{
+    RouteMsg msg(RTM_NEWROUTE, AF_INET, 24);
+    msg.addAddr(RTA_DST, "20.0.0.0");
+    msg.addAddr(RTA_GATEWAY, "2.2.2.2");
+    uint16_t encap_type = 100;
+    msg.addAttr(RTA_ENCAP_TYPE, &encap_type, sizeof(encap_type));
+
+    RouteDecoder decoder;
+    ASSERT_TRUE(decoder.decode(msg.hdr()));
+    EXPECT_TRUE(decoder.hasEncap());
+
+    RouteMsg blackhole(RTM_NEWROUTE, AF_INET, 24, RTN_BLACKHOLE);
+    blackhole.addAddr(RTA_DST, "20.0.0.0");
+    ASSERT_TRUE(decoder.decode(blackhole.hdr()));
+    EXPECT_FALSE(decoder.hasEncap());
+    EXPECT_EQ(decoder.getRouteType(), RTN_BLACKHOLE);
+}
+
+TEST(RouteDecoder, malformed)
+{
+    RouteDecoder decoder;
+
+    RouteMsg bad_len(RTM_NEWROUTE, AF_INET, 33);
+    EXPECT_FALSE(decoder.decode(bad_len.hdr()));
+
+    RouteMsg link(RTM_NEWLINK, AF_INET, 24);
+    EXPECT_FALSE(decoder.decode(link.hdr()));
+
+    RouteMsg truncated(RTM_NEWROUTE, AF_INET, 24);
+    truncated.hdr()->nlmsg_len = NLMSG_LENGTH(0);
+    EXPECT_FALSE(decoder.decode(truncated.hdr()));
+}
+
+TEST(RouteDecoder, format_address)
+{
+    char buf[RouteDecoder::ADDR_STRLEN];
+    const char *addrs[] = { "0.0.0.0", "9.10.99.100", "255.255.255.255", "172.16.1.200" };
+
+    for (auto addr : addrs)
+    {
+        uint8_t bin[4];
+        ASSERT_EQ(inet_pton(AF_INET, addr, bin), 1);
+        EXPECT_EQ(string(buf, RouteDecoder::formatAddress(AF_INET, bin, sizeof(bin), buf)), addr);
+    }
+
+    uint8_t short_addr[2] = { 1, 2 };
+    EXPECT_EQ(RouteDecoder::formatAddress(AF_INET, short_addr, sizeof(short_addr), buf), 0);
+}
+
+/* Decodes an FPM byte stream as fpmsyncd receives it, message after message */
+TEST(RouteDecoder, replay)
+{
+    const uint32_t routes = 1000;
+    vector<char> stream;
+    char gw[INET_ADDRSTRLEN];
+    char dst[INET_ADDRSTRLEN];
+
+    for (uint32_t i = 0; i < routes; i++)
+    {
+        RouteMsg msg(RTM_NEWROUTE, AF_INET, 24);
+        snprintf(dst, sizeof(dst), "%u.%u.%u.0", 1 + (i >> 16), (i >> 8) & 0xff, i & 0xff);
+        snprintf(gw, sizeof(gw), "10.0.%u.1", i & 0x3);
+        msg.addAddr(RTA_DST, dst);
+        msg.addMultipath({ { gw, 10 }, { "10.0.4.1", 11 } });
+        appendFpmMsg(stream, msg);
+    }
+
+    RouteDecoder decoder;
+    uint32_t messages = 0;
+    size_t pos = 0;
+    while (stream.size() - pos >= FPM_MSG_HDR_LEN)
+    {
+        fpm_msg_hdr_t *hdr = reinterpret_cast<fpm_msg_hdr_t *>(&stream[pos]);
+        ASSERT_TRUE(fpm_msg_ok(hdr, stream.size() - pos));
+        ASSERT_EQ(hdr->msg_type, FPM_MSG_TYPE_NETLINK);
+
+        nlmsghdr *nl_hdr = reinterpret_cast<nlmsghdr *>(fpm_msg_data(hdr));
+        ASSERT_TRUE(decoder.decode(nl_hdr));
+
+        snprintf(dst, sizeof(dst), "%u.%u.%u.0", 1 + (messages >> 16), (messages >> 8) & 0xff, messages & 0xff);
+        snprintf(gw, sizeof(gw), "10.0.%u.1", messages & 0x3);
+        EXPECT_EQ(prefix(decoder), string(dst) + "/24");
+        EXPECT_EQ(gateways(decoder), string(gw) + ",10.0.4.1");
+
+        messages++;
+        pos += fpm_msg_len(hdr);
+    }
+
+    EXPECT_EQ(pos, stream.size());
+    EXPECT_EQ(messages, routes);
+}
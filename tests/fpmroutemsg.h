@@ -0,0 +1,116 @@
+#ifndef SWSS_TESTS_FPMROUTEMSG_H
+#define SWSS_TESTS_FPMROUTEMSG_H
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <string.h>
+#include <utility>
+#include <vector>
+#include "fpmsyncd/fpm/fpm.h"
+#include "fpmsyncd/routedecoder.h"
+
+/* Netlink route message as FRR sends it to the FPM */
+class RouteMsg
+{
+public:
+    RouteMsg(uint16_t type, uint8_t family, uint8_t dst_len, uint8_t rtm_type = RTN_UNICAST)
+    {
+        m_buf.resize(NLMSG_LENGTH(sizeof(struct rtmsg)));
+        hdr()->nlmsg_type = type;
+        struct rtmsg *rtm = static_cast<struct rtmsg *>(NLMSG_DATA(hdr()));
+        rtm->rtm_family = family;
+        rtm->rtm_dst_len = dst_len;
+        rtm->rtm_table = RT_TABLE_MAIN;
+        rtm->rtm_type = rtm_type;
+        update();
+    }
+
+    void addAttr(uint16_t type, const void *data, size_t len)
+    {
+        size_t pos = NLMSG_ALIGN(m_buf.size());
+        m_buf.resize(pos + RTA_SPACE(len));
+        struct rtattr *rta = reinterpret_cast<struct rtattr *>(&m_buf[pos]);
+        rta->rta_type = type;
+        rta->rta_len = static_cast<unsigned short>(RTA_LENGTH(len));
+        memcpy(RTA_DATA(rta), data, len);
+        update();
+    }
+
+    void addAddr(uint16_t type, const char *addr)
+    {
+        uint8_t buf[16];
+        int family = strchr(addr, ':') ? AF_INET6 : AF_INET;
+        ASSERT_EQ(inet_pton(family, addr, buf), 1);
+        addAttr(type, buf, family == AF_INET ? 4 : 16);
+    }
+
+    void addU32(uint16_t type, uint32_t value)
+    {
+        addAttr(type, &value, sizeof(value));
+    }
+
+    /* RTA_MULTIPATH payload of rtnexthops with an optional RTA_GATEWAY */
+    void addMultipath(const std::vector<std::pair<const char *, int>> &nexthops)
+    {
+        std::vector<uint8_t> payload;
+        for (const auto &nh : nexthops)
+        {
+            size_t pos = payload.size();
+            uint8_t gw[16];
+            size_t gw_len = 0;
+            if (nh.first)
+            {
+                gw_len = strchr(nh.first, ':') ? 16 : 4;
+                inet_pton(gw_len == 16 ? AF_INET6 : AF_INET, nh.first, gw);
+            }
+
+            size_t len = sizeof(struct rtnexthop) + (gw_len ? RTA_SPACE(gw_len) : 0);
+            payload.resize(pos + RTNH_ALIGN(len));
+            struct rtnexthop *rtnh = reinterpret_cast<struct rtnexthop *>(&payload[pos]);
+            rtnh->rtnh_len = static_cast<unsigned short>(len);
+            rtnh->rtnh_ifindex = nh.second;
+            if (gw_len)
+            {
+                struct rtattr *rta = RTNH_DATA(rtnh);
+                rta->rta_type = RTA_GATEWAY;
+                rta->rta_len = static_cast<unsigned short>(RTA_LENGTH(gw_len));
+                memcpy(RTA_DATA(rta), gw, gw_len);
+            }
+        }
+        addAttr(RTA_MULTIPATH, payload.data(), payload.size());
+    }
+
+    struct nlmsghdr *hdr()
+    {
+        return reinterpret_cast<struct nlmsghdr *>(m_buf.data());
+    }
+
+    const std::vector<uint8_t> &data() const
+    {
+        return m_buf;
+    }
+
+private:
+    std::vector<uint8_t> m_buf;
+
+    void update()
+    {
+        hdr()->nlmsg_len = static_cast<uint32_t>(m_buf.size());
+    }
+};
+
+/* Appends the message to a byte stream of the FPM connection */
+static inline void appendFpmMsg(std::vector<char> &stream, const RouteMsg &msg)
+{
+    size_t pos = stream.size();
+    size_t msg_len = fpm_data_len_to_msg_len(msg.data().size());
+    stream.resize(pos + msg_len);
+
+    fpm_msg_hdr_t *hdr = reinterpret_cast<fpm_msg_hdr_t *>(&stream[pos]);
+    hdr->version = FPM_PROTO_VERSION;
+    hdr->msg_type = FPM_MSG_TYPE_NETLINK;
+    hdr->msg_len = htons(static_cast<uint16_t>(msg_len));
+    memcpy(fpm_msg_data(hdr), msg.data().data(), msg.data().size());
+}
+
+#endif /* SWSS_TESTS_FPMROUTEMSG_H */
@@ -0,0 +1,247 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+
+#include <chrono>
+#include <thread>
+#include <iostream>
+
+/*
+ * Microbenchmarks, built on demand with "make aclorch_bench" and not run by
+ * "make check": timings depend on the machine and only compare implementations.
+ */
+namespace aclorch_bench
+{
+    using namespace std;
+
+    struct AclOrchBench : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<swss::DBConnector> m_chassis_app_db;
+
+        PolicerOrch *m_policerOrch = nullptr;
+        AclOrch *m_aclOrch = nullptr;
+
+        AclOrchBench()
+        {
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            m_chassis_app_db = make_shared<swss::DBConnector>("CHASSIS_APP_DB", 0);
+        }
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            auto status = ut_helper::initSaiApi(profile);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            sai_attribute_t attr;
+
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            attr.id = SAI_SWITCH_ATTR_SRC_MAC_ADDRESS;
+            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            gMacAddress = attr.value.mac;
+
+            attr.id = SAI_SWITCH_ATTR_DEFAULT_VIRTUAL_ROUTER_ID;
+            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            gVirtualRouterId = attr.value.oid;
+
+            TableConnector stateDbSwitchTable(m_state_db.get(), "SWITCH_CAPABILITY");
+            TableConnector conf_asic_sensors(m_config_db.get(), CFG_ASIC_SENSORS_TABLE_NAME);
+            TableConnector app_switch_table(m_app_db.get(), APP_SWITCH_TABLE_NAME);
+
+            vector<TableConnector> switch_tables = {
+                conf_asic_sensors,
+                app_switch_table
+            };
+
+            ASSERT_EQ(gSwitchOrch, nullptr);
+            gSwitchOrch = new SwitchOrch(m_app_db.get(), switch_tables, stateDbSwitchTable);
+
+            const int portsorch_base_pri = 40;
+
+            vector<table_name_with_pri_t> ports_tables = {
+                { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+                { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+                { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+                { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+                { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+            };
+
+            ASSERT_EQ(gPortsOrch, nullptr);
+            gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables, m_chassis_app_db.get());
+
+            ASSERT_EQ(gCrmOrch, nullptr);
+            gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+            ASSERT_EQ(gVrfOrch, nullptr);
+            gVrfOrch = new VRFOrch(m_app_db.get(), APP_VRF_TABLE_NAME, m_state_db.get(), STATE_VRF_OBJECT_TABLE_NAME);
+
+            ASSERT_EQ(gIntfsOrch, nullptr);
+            gIntfsOrch = new IntfsOrch(m_app_db.get(), APP_INTF_TABLE_NAME, gVrfOrch, m_chassis_app_db.get());
+
+            TableConnector stateDbFdb(m_state_db.get(), STATE_FDB_TABLE_NAME);
+
+            vector<table_name_with_pri_t> app_fdb_tables = {
+                { APP_FDB_TABLE_NAME,        FdbOrch::fdborch_pri},
+                { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri}
+            };
+
+            ASSERT_EQ(gFdbOrch, nullptr);
+            gFdbOrch = new FdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, gPortsOrch);
+
+            ASSERT_EQ(gNeighOrch, nullptr);
+            gNeighOrch = new NeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
+
+            vector<table_name_with_pri_t> fgnhg_tables = {
+                { CFG_FG_NHG,                 15 },
+                { CFG_FG_NHG_PREFIX,          15 },
+                { CFG_FG_NHG_MEMBER,          15 }
+            };
+
+            ASSERT_EQ(gFgNhgOrch, nullptr);
+            gFgNhgOrch = new FgNhgOrch(m_config_db.get(), m_app_db.get(), m_state_db.get(), fgnhg_tables, gNeighOrch, gIntfsOrch, gVrfOrch);
+
+            ASSERT_EQ(gRouteOrch, nullptr);
+            gRouteOrch = new RouteOrch(m_app_db.get(), APP_ROUTE_TABLE_NAME, gSwitchOrch, gNeighOrch, gIntfsOrch, gVrfOrch, gFgNhgOrch);
+
+            m_policerOrch = new PolicerOrch(m_config_db.get(), "POLICER");
+
+            TableConnector stateDbMirrorSession(m_state_db.get(), STATE_MIRROR_SESSION_TABLE_NAME);
+            TableConnector confDbMirrorSession(m_config_db.get(), CFG_MIRROR_SESSION_TABLE_NAME);
+
+            ASSERT_EQ(gMirrorOrch, nullptr);
+            gMirrorOrch = new MirrorOrch(stateDbMirrorSession, confDbMirrorSession,
+                                         gPortsOrch, gRouteOrch, gNeighOrch, gFdbOrch, m_policerOrch);
+
+            doTask(gPortsOrch, m_app_db.get(), APP_PORT_TABLE_NAME,
+                   { { "PortInitDone", EMPTY_PREFIX, { { "", "" } } } });
+
+            TableConnector confDbAclTable(m_config_db.get(), CFG_ACL_TABLE_TABLE_NAME);
+            TableConnector confDbAclRuleTable(m_config_db.get(), CFG_ACL_RULE_TABLE_NAME);
+
+            vector<TableConnector> acl_table_connectors = { confDbAclTable, confDbAclRuleTable };
+
+            m_aclOrch = new AclOrch(acl_table_connectors, gSwitchOrch, gPortsOrch, gMirrorOrch,
+                                    gNeighOrch, gRouteOrch);
+        }
+
+        void TearDown() override
+        {
+            delete m_aclOrch;
+            m_aclOrch = nullptr;
+
+            delete gMirrorOrch;
+            gMirrorOrch = nullptr;
+            delete m_policerOrch;
+            m_policerOrch = nullptr;
+            delete gRouteOrch;
+            gRouteOrch = nullptr;
+            delete gFgNhgOrch;
+            gFgNhgOrch = nullptr;
+            delete gNeighOrch;
+            gNeighOrch = nullptr;
+            delete gFdbOrch;
+            gFdbOrch = nullptr;
+            delete gIntfsOrch;
+            gIntfsOrch = nullptr;
+            delete gVrfOrch;
+            gVrfOrch = nullptr;
+            delete gCrmOrch;
+            gCrmOrch = nullptr;
+            delete gPortsOrch;
+            gPortsOrch = nullptr;
+            delete gSwitchOrch;
+            gSwitchOrch = nullptr;
+
+            auto status = sai_switch_api->remove_switch(gSwitchId);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+            gSwitchId = 0;
+
+            ut_helper::uninitSaiApi();
+        }
+
+        void doTask(Orch *orch, swss::DBConnector *db, const string &table, const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            auto consumer = unique_ptr<Consumer>(new Consumer(
+                new swss::ConsumerStateTable(db, table, 1, 1), orch, table));
+
+            consumer->addToSync(entries);
+            orch->doTask(*consumer);
+        }
+
+        void doAclCounterPoll()
+        {
+            swss::SelectableTimer timer(timespec { .tv_sec = COUNTERS_READ_INTERVAL, .tv_nsec = 0 });
+            static_cast<Orch *>(m_aclOrch)->doTask(timer);
+        }
+    };
+
+    // Times the main loop part of an ACL counters poll against the reads
+    // and writes of the counters thread, which the main loop used to do
+    TEST_F(AclOrchBench, AclCounterPoll_MainLoopStall)
+    {
+        string acl_table_id = "acl_table_1";
+
+        doTask(m_aclOrch, m_config_db.get(), CFG_ACL_TABLE_TABLE_NAME,
+               { { acl_table_id,
+                   SET_COMMAND,
+                   { { ACL_TABLE_DESCRIPTION, "counters" },
+                     { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                     { ACL_TABLE_STAGE, STAGE_INGRESS },
+                     { ACL_TABLE_PORTS, "1,2" } } } });
+        ASSERT_NE(m_aclOrch->getTableById(acl_table_id), SAI_NULL_OBJECT_ID);
+
+        size_t rules = 0;
+
+        for (size_t count : { 100, 1000, 4000 })
+        {
+            deque<KeyOpFieldsValuesTuple> kvfAclRules;
+            for (; rules < count; rules++)
+            {
+                string ip = "10.0." + to_string(rules / 256) + "." + to_string(rules % 256);
+                kvfAclRules.push_back({ acl_table_id + "|rule_" + to_string(rules),
+                                        SET_COMMAND,
+                                        { { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                                          { MATCH_SRC_IP, ip } } });
+            }
+            doTask(m_aclOrch, m_config_db.get(), CFG_ACL_RULE_TABLE_NAME, kvfAclRules);
+
+            // The first poll hands the changed rules over, the next one only wakes the thread
+            for (bool changed : { true, false })
+            {
+                uint64_t polls = m_aclOrch->getCounterPolls();
+
+                auto start = chrono::steady_clock::now();
+                doAclCounterPoll();
+                auto stall = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+                while (m_aclOrch->getCounterPolls() == polls)
+                {
+                    this_thread::sleep_for(chrono::milliseconds(1));
+                }
+
+                cout << count << " rules" << (changed ? " changed" : "") << ": main loop stall " << stall
+                     << " us, counters thread " << m_aclOrch->getCounterPollUsecs() << " us" << endl;
+            }
+        }
+    }
+}
@@ -1,5 +1,8 @@
 #include "ut_helper.h"
 
+#include <chrono>
+#include <thread>
+
 extern sai_object_id_t gSwitchId;
 
 extern SwitchOrch *gSwitchOrch;
@@ -169,6 +172,12 @@ namespace aclorch_test
             static_cast<Orch *>(m_aclOrch)->doTask(*consumer);
         }
 
+        void doAclCounterPoll()
+        {
+            swss::SelectableTimer timer(timespec { .tv_sec = COUNTERS_READ_INTERVAL, .tv_nsec = 0 });
+            static_cast<Orch *>(m_aclOrch)->doTask(timer);
+        }
+
         sai_object_id_t getTableById(const string &table_id)
         {
             return m_aclOrch->getTableById(table_id);
@@ -1170,4 +1179,58 @@ namespace aclorch_test
         }
     }
 
+    // The main loop only hands the rules over to the counters thread,
+    // which writes the counters of every rule at each poll
+    TEST_F(AclOrchTest, AclCounterPoll_CountersThread)
+    {
+        string acl_table_id = "acl_table_1";
+
+        auto orch = createAclOrch();
+
+        auto kvfAclTable = deque<KeyOpFieldsValuesTuple>(
+            { { acl_table_id,
+                SET_COMMAND,
+                { { ACL_TABLE_DESCRIPTION, "counters" },
+                  { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                  { ACL_TABLE_STAGE, STAGE_INGRESS },
+                  { ACL_TABLE_PORTS, "1,2" } } } });
+        orch->doAclTableTask(kvfAclTable);
+        ASSERT_NE(orch->getTableById(acl_table_id), SAI_NULL_OBJECT_ID);
+
+        swss::DBConnector countersDb("COUNTERS_DB", 0);
+        swss::Table countersTable(&countersDb, "COUNTERS");
+        size_t rules = 0;
+
+        for (size_t count : { 100, 1000, 4000 })
+        {
+            deque<KeyOpFieldsValuesTuple> kvfAclRules;
+            for (; rules < count; rules++)
+            {
+                string ip = "10.0." + to_string(rules / 256) + "." + to_string(rules % 256);
+                kvfAclRules.push_back({ acl_table_id + "|rule_" + to_string(rules),
+                                        SET_COMMAND,
+                                        { { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                                          { MATCH_SRC_IP, ip } } });
+            }
+            orch->doAclRuleTask(kvfAclRules);
+
+            // The first poll hands the changed rules over, the next one only wakes the thread
+            for (bool changed : { true, false })
+            {
+                uint64_t polls = orch->m_aclOrch->getCounterPolls();
+
+                orch->doAclCounterPoll();
+                while (orch->m_aclOrch->getCounterPolls() == polls)
+                {
+                    this_thread::sleep_for(chrono::milliseconds(1));
+                }
+                ASSERT_EQ(orch->m_aclOrch->getCounterPolls(), polls + 1) << (changed ? "changed" : "unchanged");
+            }
+
+            vector<string> keys;
+            countersTable.getKeys(keys);
+            ASSERT_EQ(keys.size(), count);
+        }
+    }
+
 } // namespace nsAclOrchTest
@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+#include "bulker.h"
+
+#include <deque>
+#include <chrono>
+#include <iostream>
+
+/*
+ * Microbenchmarks, built on demand with "make benchmarks" and not run by
+ * "make check": timings depend on the machine and only compare implementations.
+ */
+namespace bulker_bench
+{
+    using namespace std;
+
+    // Syncd round trip cost paid by every SAI call, single or bulk
+    const chrono::microseconds sai_round_trip(10);
+    size_t fdb_sai_calls;
+    size_t fdb_entries_created;
+
+    void simulateRoundTrip()
+    {
+        fdb_sai_calls++;
+        auto start = chrono::steady_clock::now();
+        while (chrono::steady_clock::now() - start < sai_round_trip)
+        {
+        }
+    }
+
+    sai_status_t createFdbEntry(const sai_fdb_entry_t *fdb_entry, uint32_t attr_count, const sai_attribute_t *attr_list)
+    {
+        simulateRoundTrip();
+        fdb_entries_created++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createFdbEntries(uint32_t object_count, const sai_fdb_entry_t *fdb_entry, const uint32_t *attr_count,
+            const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        simulateRoundTrip();
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            fdb_entries_created++;
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    chrono::microseconds createFdbEntriesWith(EntityBulker<sai_fdb_api_t> &fdbBulker, uint32_t count)
+    {
+        deque<sai_status_t> object_statuses;
+
+        sai_fdb_entry_t fdb_entry;
+        fdb_entry.switch_id = 0x0;
+        fdb_entry.bv_id = 0x26000000000001;
+        memset(fdb_entry.mac_address, 0, sizeof(fdb_entry.mac_address));
+
+        sai_attribute_t fdb_attrs[2];
+        fdb_attrs[0].id = SAI_FDB_ENTRY_ATTR_TYPE;
+        fdb_attrs[0].value.s32 = SAI_FDB_ENTRY_TYPE_STATIC;
+        fdb_attrs[1].id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+        fdb_attrs[1].value.oid = 0x3a000000000001;
+
+        fdb_sai_calls = 0;
+        fdb_entries_created = 0;
+
+        auto start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < count; i++)
+        {
+            fdb_entry.mac_address[3] = (uint8_t)(i >> 16);
+            fdb_entry.mac_address[4] = (uint8_t)(i >> 8);
+            fdb_entry.mac_address[5] = (uint8_t)i;
+            object_statuses.emplace_back();
+            fdbBulker.create_entry(&object_statuses.back(), &fdb_entry, 2, fdb_attrs);
+        }
+        fdbBulker.flush();
+        auto elapsed = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+        EXPECT_EQ(fdb_entries_created, count);
+        for (auto status : object_statuses)
+        {
+            EXPECT_EQ(status, SAI_STATUS_SUCCESS);
+        }
+        return elapsed;
+    }
+
+    TEST(BulkerBench, FdbBulk)
+    {
+        const uint32_t count = 10000;
+
+        sai_fdb_api_t fdb_api = {};
+        fdb_api.create_fdb_entry = createFdbEntry;
+
+        // Without a bulk API the FDB bulker creates entries one by one
+        EntityBulker<sai_fdb_api_t> singleBulker(&fdb_api);
+        auto singleTime = createFdbEntriesWith(singleBulker, count);
+        ASSERT_EQ(fdb_sai_calls, count);
+
+        // Same bulk with create_fdb_entries() from the SAI
+        EntityBulker<sai_fdb_api_t> bulkBulker(&fdb_api);
+        bulkBulker.create_entries = createFdbEntries;
+        auto bulkTime = createFdbEntriesWith(bulkBulker, count);
+        ASSERT_EQ(fdb_sai_calls, 1);
+
+        cout << "Creating " << count << " FDB entries: per entry "
+             << singleTime.count() << "us, bulk " << bulkTime.count() << "us" << endl;
+
+        ASSERT_LT(bulkTime, singleTime);
+    }
+}
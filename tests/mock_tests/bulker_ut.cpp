@@ -103,4 +103,196 @@ namespace bulker_test
         ASSERT_EQ(ia->first.id, SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION);
         ASSERT_EQ(ia->first.value.s32, SAI_PACKET_ACTION_FORWARD);
     }
+
+    // Per entry SAI calls used by the bulkers when the SAI has no bulk API
+    vector<sai_neighbor_entry_t> created_neighbors;
+    vector<sai_object_id_t> removed_next_hops;
+    sai_object_id_t next_hop_oid;
+    size_t next_hop_calls;
+
+    sai_status_t createNeighborEntry(const sai_neighbor_entry_t *neighbor_entry, uint32_t attr_count, const sai_attribute_t *attr_list)
+    {
+        if (attr_count != 1 || attr_list[0].id != SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS)
+        {
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+        created_neighbors.push_back(*neighbor_entry);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createNextHop(sai_object_id_t *next_hop_id, sai_object_id_t switch_id, uint32_t attr_count, const sai_attribute_t *attr_list)
+    {
+        if (++next_hop_calls == 2)
+        {
+            return SAI_STATUS_INSUFFICIENT_RESOURCES;
+        }
+        *next_hop_id = next_hop_oid++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t removeNextHop(sai_object_id_t next_hop_id)
+    {
+        removed_next_hops.push_back(next_hop_id);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    TEST_F(BulkerTest, BulkerSingleEntryFallback)
+    {
+        sai_neighbor_api_t neighbor_api = {};
+        neighbor_api.create_neighbor_entry = createNeighborEntry;
+        sai_next_hop_api_t next_hop_api = {};
+        next_hop_api.create_next_hop = createNextHop;
+        next_hop_api.remove_next_hop = removeNextHop;
+
+        created_neighbors.clear();
+        removed_next_hops.clear();
+        next_hop_oid = 0x1;
+        next_hop_calls = 0;
+
+        // Neighbors are created one by one, each one gets its own status
+        EntityBulker<sai_neighbor_api_t> neighBulker(&neighbor_api);
+        deque<sai_status_t> object_statuses;
+
+        sai_neighbor_entry_t neighbor_entry;
+        neighbor_entry.switch_id = 0x0;
+        neighbor_entry.rif_id = 0x1;
+        neighbor_entry.ip_address.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+
+        sai_attribute_t neighbor_attr;
+        neighbor_attr.id = SAI_NEIGHBOR_ENTRY_ATTR_DST_MAC_ADDRESS;
+        memset(neighbor_attr.value.mac, 0, sizeof(neighbor_attr.value.mac));
+
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            neighbor_entry.ip_address.addr.ip4 = htonl(0x0a000001 + i);
+            object_statuses.emplace_back();
+            neighBulker.create_entry(&object_statuses.back(), &neighbor_entry, 1, &neighbor_attr);
+        }
+        ASSERT_EQ(neighBulker.creating_entries_count(), 3);
+
+        neighBulker.flush();
+        ASSERT_EQ(created_neighbors.size(), 3);
+        ASSERT_EQ(neighBulker.creating_entries_count(), 0);
+        for (auto status : object_statuses)
+        {
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+        }
+
+        // A next hop failing does not hold back the ones after it
+        ObjectBulker<sai_next_hop_api_t> nextHopBulker(&next_hop_api, 0x0);
+        sai_object_id_t next_hop_ids[3];
+        sai_attribute_t next_hop_attr;
+        next_hop_attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+        next_hop_attr.value.s32 = SAI_NEXT_HOP_TYPE_IP;
+
+        for (auto& next_hop_id : next_hop_ids)
+        {
+            nextHopBulker.create_entry(&next_hop_id, 1, &next_hop_attr);
+        }
+        nextHopBulker.flush();
+        ASSERT_EQ(next_hop_ids[0], 0x1);
+        ASSERT_EQ(next_hop_ids[1], SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(next_hop_ids[2], 0x2);
+
+        sai_status_t remove_statuses[2];
+        nextHopBulker.remove_entry(&remove_statuses[0], next_hop_ids[0]);
+        nextHopBulker.remove_entry(&remove_statuses[1], next_hop_ids[2]);
+        nextHopBulker.flush();
+        ASSERT_EQ(remove_statuses[0], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(remove_statuses[1], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(removed_next_hops, (vector<sai_object_id_t>{ 0x1, 0x2 }));
+    }
+
+    // SAI calls made by the FDB bulker, single or bulk
+    size_t fdb_sai_calls;
+    size_t fdb_entries_created;
+
+    sai_status_t createFdbEntry(const sai_fdb_entry_t *fdb_entry, uint32_t attr_count, const sai_attribute_t *attr_list)
+    {
+        fdb_sai_calls++;
+        fdb_entries_created++;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t createFdbEntries(uint32_t object_count, const sai_fdb_entry_t *fdb_entry, const uint32_t *attr_count,
+            const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        fdb_sai_calls++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            fdb_entries_created++;
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    void createFdbEntriesWith(EntityBulker<sai_fdb_api_t> &fdbBulker, uint32_t count)
+    {
+        deque<sai_status_t> object_statuses;
+
+        sai_fdb_entry_t fdb_entry;
+        fdb_entry.switch_id = 0x0;
+        fdb_entry.bv_id = 0x26000000000001;
+        memset(fdb_entry.mac_address, 0, sizeof(fdb_entry.mac_address));
+
+        sai_attribute_t fdb_attrs[2];
+        fdb_attrs[0].id = SAI_FDB_ENTRY_ATTR_TYPE;
+        fdb_attrs[0].value.s32 = SAI_FDB_ENTRY_TYPE_STATIC;
+        fdb_attrs[1].id = SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID;
+        fdb_attrs[1].value.oid = 0x3a000000000001;
+
+        fdb_sai_calls = 0;
+        fdb_entries_created = 0;
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            fdb_entry.mac_address[4] = (uint8_t)(i >> 8);
+            fdb_entry.mac_address[5] = (uint8_t)i;
+            object_statuses.emplace_back();
+            fdbBulker.create_entry(&object_statuses.back(), &fdb_entry, 2, fdb_attrs);
+        }
+        fdbBulker.flush();
+
+        EXPECT_EQ(fdb_entries_created, count);
+        for (auto status : object_statuses)
+        {
+            EXPECT_EQ(status, SAI_STATUS_SUCCESS);
+        }
+    }
+
+    TEST_F(BulkerTest, FdbBulkCalls)
+    {
+        const uint32_t count = 100;
+
+        sai_fdb_api_t fdb_api = {};
+        fdb_api.create_fdb_entry = createFdbEntry;
+
+        // Without a bulk API the FDB bulker creates entries one by one
+        EntityBulker<sai_fdb_api_t> singleBulker(&fdb_api);
+        createFdbEntriesWith(singleBulker, count);
+        ASSERT_EQ(fdb_sai_calls, count);
+
+        // A single create_fdb_entries() call with the bulk API
+        EntityBulker<sai_fdb_api_t> bulkBulker(&fdb_api);
+        bulkBulker.create_entries = createFdbEntries;
+        createFdbEntriesWith(bulkBulker, count);
+        ASSERT_EQ(fdb_sai_calls, 1);
+    }
+
+    TEST_F(BulkerTest, FlushTimer)
+    {
+        sai_fdb_api_t fdb_api = {};
+        fdb_api.create_fdb_entry = createFdbEntry;
+        EntityBulker<sai_fdb_api_t> fdbBulker(&fdb_api);
+
+        // Flushes are only timed with the task statistics
+        uint64_t nsecs = BulkerFlushTimer::nsecs();
+        createFdbEntriesWith(fdbBulker, 100);
+        ASSERT_EQ(BulkerFlushTimer::nsecs(), nsecs);
+
+        BulkerFlushTimer::enabled() = true;
+        createFdbEntriesWith(fdbBulker, 100);
+        BulkerFlushTimer::enabled() = false;
+        ASSERT_GT(BulkerFlushTimer::nsecs(), nsecs);
+    }
 }
@@ -3,6 +3,8 @@
 #include "mock_table.h"
 
 #include <sstream>
+#include <chrono>
+#include <thread>
 
 extern PortsOrch *gPortsOrch;
 
@@ -322,4 +324,217 @@ namespace consumer_test
         validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
 
     }
+
+    /* Orch completing the tasks of its consumer only once ready */
+    class RetryTestOrch : public Orch
+    {
+    public:
+        RetryTestOrch() : Orch(vector<TableConnector>{}) { }
+
+        using Orch::addExecutor;
+
+        void doTask(Consumer &consumer) override
+        {
+            calls++;
+            seen.clear();
+            auto it = consumer.m_toSync.begin();
+            while (it != consumer.m_toSync.end())
+            {
+                seen.push_back(it->first);
+                if (fail)
+                {
+                    Consumer::countFailure();
+                }
+                if (ready)
+                {
+                    it = consumer.m_toSync.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
+            }
+        }
+
+        bool ready = false;
+        bool fail = false;
+        int calls = 0;
+        vector<string> seen;
+    };
+
+    TEST_F(ConsumerTest, ConsumerRetry_ParkAndWake)
+    {
+        RetryTestOrch orch;
+        Consumer retryConsumer(new swss::ConsumerStateTable(m_config_db.get(), "CFG_RETRY_TABLE", 1, 1), &orch, "CFG_RETRY_TABLE");
+
+        retryConsumer.addToSync(KeyOpFieldsValuesTuple("key1", SET_COMMAND, { { f1, v1a } }));
+        retryConsumer.drain();
+        ASSERT_EQ(orch.calls, 1);
+        ASSERT_TRUE(retryConsumer.m_toSync.empty());
+        ASSERT_EQ(retryConsumer.getPendingTaskCount(), 1);
+        ASSERT_EQ(retryConsumer.getRetryStats().parked, 1);
+
+        /* New tasks are handled without the parked ones */
+        retryConsumer.addToSync(KeyOpFieldsValuesTuple("key2", SET_COMMAND, { { f1, v1a } }));
+        retryConsumer.drain();
+        ASSERT_EQ(orch.seen, vector<string>{ "key2" });
+        ASSERT_EQ(retryConsumer.getPendingTaskCount(), 2);
+
+        /* Stalled retries back off instead of running on every drain */
+        int calls = orch.calls;
+        for (int i = 0; i < 100; i++)
+        {
+            retryConsumer.drain();
+        }
+        ASSERT_LT(orch.calls - calls, 10);
+
+        /* A new task of a parked key is merged into the parked one */
+        retryConsumer.addToSync(KeyOpFieldsValuesTuple("key1", SET_COMMAND, { { f2, v2a } }));
+        ASSERT_EQ(retryConsumer.m_toSync.size(), 1);
+        ASSERT_EQ(retryConsumer.getPendingTaskCount(), 2);
+        ASSERT_EQ(kfvFieldsValues(retryConsumer.m_toSync.begin()->second),
+                  (vector<FieldValueTuple>{ { f1, v1a }, { f2, v2a } }));
+        retryConsumer.drain();
+        ASSERT_EQ(orch.seen, vector<string>{ "key1" });
+
+        /* Waking retries hands all parked tasks back, oldest first */
+        orch.ready = true;
+        Orch::wakeRetries();
+        retryConsumer.drain();
+        ASSERT_EQ(orch.seen, (vector<string>{ "key2", "key1" }));
+        ASSERT_EQ(retryConsumer.getPendingTaskCount(), 0);
+
+        auto stats = retryConsumer.getRetryStats();
+        ASSERT_EQ(stats.parked, 0);
+        ASSERT_GE(stats.retries, 1);
+        ASSERT_EQ(stats.retries - stats.stalled, 1);
+    }
+
+    TEST_F(ConsumerTest, ConsumerRetry_ResolvedWithoutWake)
+    {
+        RetryTestOrch orch;
+        Consumer retryConsumer(new swss::ConsumerStateTable(m_config_db.get(), "CFG_NOWAKE_TABLE", 1, 1), &orch, "CFG_NOWAKE_TABLE");
+
+        retryConsumer.addToSync(KeyOpFieldsValuesTuple("key1", SET_COMMAND, { { f1, v1a } }));
+        retryConsumer.drain();
+        ASSERT_EQ(retryConsumer.getRetryStats().parked, 1);
+
+        /* Let the retries stall long enough for the back-off to reach its cap */
+        auto stallEnd = chrono::steady_clock::now() + chrono::milliseconds(CONSUMER_RETRY_BACKOFF_MAX_MSECS * 6);
+        while (chrono::steady_clock::now() < stallEnd)
+        {
+            retryConsumer.drain();
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+        ASSERT_GE(retryConsumer.getRetryStats().stalled, 4);
+
+        /* The dependency resolves with no Orch::wakeRetries() and no progress elsewhere */
+        orch.ready = true;
+        auto resolved = chrono::steady_clock::now();
+        while (retryConsumer.getPendingTaskCount() != 0 &&
+               chrono::steady_clock::now() - resolved < chrono::seconds(1))
+        {
+            retryConsumer.drain();
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+
+        ASSERT_EQ(retryConsumer.getPendingTaskCount(), 0);
+        ASSERT_LE(chrono::steady_clock::now() - resolved, chrono::milliseconds(CONSUMER_RETRY_BACKOFF_MAX_MSECS * 2));
+    }
+
+    TEST_F(ConsumerTest, ConsumerTaskStats)
+    {
+        RetryTestOrch orch;
+        Consumer statsConsumer(new swss::ConsumerStateTable(m_config_db.get(), "CFG_STATS_TABLE", 1, 1), &orch, "CFG_STATS_TABLE");
+
+        /* Nothing is counted while disabled */
+        statsConsumer.addToSync(KeyOpFieldsValuesTuple("key0", SET_COMMAND, { { f1, v1a } }));
+        orch.ready = true;
+        statsConsumer.drain();
+        ASSERT_EQ(statsConsumer.getTaskStats().completed, 0);
+
+        Orch::enableTaskStats(true);
+
+        orch.ready = false;
+        orch.fail = true;
+        statsConsumer.addToSync(KeyOpFieldsValuesTuple("key1", SET_COMMAND, { { f1, v1a } }));
+        statsConsumer.addToSync(KeyOpFieldsValuesTuple("key2", SET_COMMAND, { { f1, v1a } }));
+        statsConsumer.drain();
+
+        this_thread::sleep_for(chrono::milliseconds(20));
+        auto stats = statsConsumer.getTaskStats();
+        ASSERT_EQ(stats.completed, 0);
+        ASSERT_EQ(stats.failed, 2);
+        ASSERT_GE(stats.queue_age_ms, 20);
+
+        orch.ready = true;
+        orch.fail = false;
+        Orch::wakeRetries();
+        statsConsumer.drain();
+
+        stats = statsConsumer.getTaskStats();
+        ASSERT_EQ(stats.completed, 2);
+        ASSERT_EQ(stats.failed, 2);
+        ASSERT_EQ(stats.queue_age_ms, 0);
+        ASSERT_GE(stats.dotask_us, stats.dotask_max_us);
+
+        /* Parked tasks count from the time they were first handled */
+        uint64_t latencies = 0;
+        for (size_t i = 0; i < CONSUMER_LATENCY_BUCKETS; i++)
+        {
+            latencies += stats.latency[i];
+        }
+        ASSERT_EQ(latencies, 2);
+        ASSERT_EQ(stats.latency[0], 0);
+
+        Orch::enableTaskStats(false);
+    }
+
+    TEST_F(ConsumerTest, ConsumerBatchSize)
+    {
+        RetryTestOrch orch;
+        Consumer batchConsumer(new swss::ConsumerStateTable(m_config_db.get(), "CFG_BATCH_TABLE", 1, 1), &orch, "CFG_BATCH_TABLE");
+
+        /* A fixed batch size does not adapt */
+        batchConsumer.setBatchSize(64, 0, 0);
+        batchConsumer.adaptBatchSize(64, 1000);
+        batchConsumer.adaptBatchSize(0, 1000);
+        ASSERT_EQ(batchConsumer.getBatchStats().batch_size, 64);
+
+        /* The batch grows while full batches are popped at a stable task cost */
+        batchConsumer.setBatchSize(64, 16, 256);
+        batchConsumer.adaptBatchSize(64, 1000);
+        ASSERT_EQ(batchConsumer.getBatchStats().batch_size, 128);
+        batchConsumer.adaptBatchSize(128, 1100);
+        ASSERT_EQ(batchConsumer.getBatchStats().batch_size, 256);
+        batchConsumer.adaptBatchSize(256, 1000);
+        ASSERT_EQ(batchConsumer.getBatchStats().batch_size, 256);
+
+        /* It stops growing when the cost of a task grows */
+        batchConsumer.setBatchSize(64, 16, 256);
+        batchConsumer.adaptBatchSize(64, 1000);
+        batchConsumer.adaptBatchSize(128, 2000);
+        ASSERT_EQ(batchConsumer.getBatchStats().batch_size, 128);
+
+        /* And shrinks down to the minimum when the table runs empty */
+        batchConsumer.adaptBatchSize(10, 1000);
+        batchConsumer.adaptBatchSize(10, 1000);
+        batchConsumer.adaptBatchSize(10, 1000);
+        batchConsumer.adaptBatchSize(0, 0);
+        auto stats = batchConsumer.getBatchStats();
+        ASSERT_EQ(stats.batch_size, 16);
+        ASSERT_EQ(stats.min_batch_size, 16);
+        ASSERT_EQ(stats.max_batch_size, 256);
+        ASSERT_EQ(stats.grown, 3);
+        ASSERT_EQ(stats.shrunk, 3);
+
+        /* Through the Orch, by table name */
+        orch.addExecutor(new Consumer(new swss::ConsumerStateTable(m_config_db.get(), "CFG_BATCH_TABLE", 1, 1), &orch, "CFG_BATCH_TABLE"));
+        ASSERT_EQ(orch.setBatchSize("CFG_BATCH_TABLE", 512, 0, 0), 1);
+        ASSERT_EQ(orch.setBatchSize("CFG_OTHER_TABLE", 512, 0, 0), 0);
+        vector<pair<string, consumer_batch_stats_t>> batchStats;
+        orch.getBatchStats(batchStats);
+        ASSERT_EQ(batchStats.size(), 1);
+        ASSERT_EQ(batchStats[0].second.batch_size, 512);
+    }
 }
@@ -0,0 +1,198 @@
+#include "gtest/gtest.h"
+#include "fairscheduler.h"
+
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+namespace fairscheduler_test
+{
+    using namespace std;
+    using namespace std::chrono;
+
+    typedef FairScheduler::Clock Clock;
+
+    const int urgent_pri = 100;
+
+    FairScheduler::Params params(int pri, unsigned weight, milliseconds deadline = milliseconds(0))
+    {
+        return { pri, weight, deadline };
+    }
+
+    /* Runs the next task for cost, with work left or not, returns its id */
+    size_t runNext(FairScheduler &scheduler, Clock::time_point &now, microseconds cost, bool pending)
+    {
+        size_t id;
+        EXPECT_TRUE(scheduler.next(id, now));
+        now += cost;
+        scheduler.done(id, cost, pending, now);
+        return id;
+    }
+
+    TEST(FairScheduler, EventsAndPendingWork)
+    {
+        FairScheduler scheduler(urgent_pri);
+        auto now = Clock::now();
+        size_t id;
+
+        size_t task = scheduler.add(params(0, 1));
+        EXPECT_FALSE(scheduler.next(id, now));
+
+        /* One run per event */
+        scheduler.notify(task, now);
+        scheduler.notify(task, now);
+        EXPECT_EQ(runNext(scheduler, now, microseconds(10), false), task);
+        EXPECT_EQ(runNext(scheduler, now, microseconds(10), false), task);
+        EXPECT_FALSE(scheduler.hasReady());
+
+        /* Ready without event while it has work left */
+        scheduler.notify(task, now);
+        EXPECT_EQ(runNext(scheduler, now, microseconds(10), true), task);
+        EXPECT_EQ(runNext(scheduler, now, microseconds(10), true), task);
+        EXPECT_EQ(runNext(scheduler, now, microseconds(10), false), task);
+        EXPECT_FALSE(scheduler.next(id, now));
+    }
+
+    TEST(FairScheduler, WeightedShare)
+    {
+        FairScheduler scheduler(urgent_pri);
+        auto now = Clock::now();
+
+        size_t light = scheduler.add(params(0, 1));
+        size_t heavy = scheduler.add(params(0, 3));
+        scheduler.notify(light, now);
+        scheduler.notify(heavy, now);
+
+        vector<size_t> runs(2);
+        for (int i = 0; i < 400; i++)
+        {
+            runs[runNext(scheduler, now, milliseconds(1), true)]++;
+        }
+
+        EXPECT_NEAR(static_cast<double>(runs[heavy]) / static_cast<double>(runs[light]), 3.0, 0.1);
+    }
+
+    TEST(FairScheduler, PriorityAmongEquals)
+    {
+        FairScheduler scheduler(urgent_pri);
+        auto now = Clock::now();
+
+        size_t low = scheduler.add(params(0, 1));
+        size_t high = scheduler.add(params(50, 1));
+        scheduler.notify(low, now);
+        scheduler.notify(high, now);
+
+        EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), high);
+        EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), low);
+        EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), high);
+        EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), low);
+    }
+
+    TEST(FairScheduler, IdleEarnsNoCredit)
+    {
+        FairScheduler scheduler(urgent_pri);
+        auto now = Clock::now();
+
+        size_t busy = scheduler.add(params(0, 1));
+        size_t idle = scheduler.add(params(0, 1));
+
+        scheduler.notify(busy, now);
+        for (int i = 0; i < 100; i++)
+        {
+            EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), busy);
+        }
+
+        /* The task becoming ready runs next, then they alternate */
+        scheduler.notify(idle, now);
+        EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), idle);
+        EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), busy);
+        EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), idle);
+        EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), busy);
+    }
+
+    TEST(FairScheduler, UrgentAndDeadline)
+    {
+        FairScheduler scheduler(urgent_pri);
+        auto now = Clock::now();
+
+        size_t normal = scheduler.add(params(0, 1, milliseconds(10)));
+        size_t urgent = scheduler.add(params(urgent_pri, 1));
+        scheduler.notify(normal, now);
+        scheduler.notify(urgent, now);
+
+        /* The urgent task keeps running until the other one is overdue */
+        for (int i = 0; i < 10; i++)
+        {
+            EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), urgent);
+        }
+        EXPECT_EQ(runNext(scheduler, now, milliseconds(1), false), normal);
+        EXPECT_EQ(runNext(scheduler, now, milliseconds(1), true), urgent);
+    }
+
+    /*
+     * Simulates a burst of 200k routes handled in turns of 1024 routes at 2us
+     * each, while a low priority table gets an event every 5ms. With strict
+     * priorities, as a Select picks the Executors, its events would wait for
+     * the end of the burst.
+     */
+    TEST(FairScheduler, LowPriorityLatencyUnderRouteBurst)
+    {
+        const size_t routes = 200000;
+        const size_t budget = 1024;
+        const auto routeCost = microseconds(2);
+        const auto eventCost = microseconds(50);
+        const auto eventInterval = milliseconds(5);
+
+        FairScheduler scheduler(urgent_pri);
+        size_t route = scheduler.add(params(50, 1, milliseconds(1000)));
+        size_t table = scheduler.add(params(0, 1, milliseconds(1000)));
+
+        auto start = Clock::now();
+        auto now = start;
+        auto nextEvent = start + eventInterval;
+        deque<Clock::time_point> events;
+        vector<int64_t> latencies;
+        size_t left = routes;
+
+        scheduler.notify(route, now);
+        while (left || !events.empty())
+        {
+            while (left && nextEvent <= now)
+            {
+                scheduler.notify(table, nextEvent);
+                events.push_back(nextEvent);
+                nextEvent += eventInterval;
+            }
+
+            size_t id;
+            if (!scheduler.next(id, now))
+            {
+                now = nextEvent;
+                continue;
+            }
+
+            Clock::duration cost;
+            if (id == route)
+            {
+                size_t count = min(budget, left);
+                left -= count;
+                cost = routeCost * count;
+            }
+            else
+            {
+                latencies.push_back(duration_cast<microseconds>(now - events.front()).count());
+                events.pop_front();
+                cost = eventCost;
+            }
+
+            now += cost;
+            scheduler.done(id, cost, id == route && left, now);
+        }
+
+        ASSERT_GT(latencies.size(), 60u);
+        auto worst = *max_element(latencies.begin(), latencies.end());
+        /* An event waits at most for the route turn in progress */
+        EXPECT_LE(worst, duration_cast<microseconds>(routeCost * budget + eventCost).count());
+    }
+}
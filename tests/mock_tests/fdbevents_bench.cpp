@@ -0,0 +1,101 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "fdbevents.h"
+
+#include <map>
+#include <random>
+#include <chrono>
+#include <iostream>
+
+/*
+ * Microbenchmarks, built on demand with "make benchmarks" and not run by
+ * "make check": timings depend on the machine and only compare implementations.
+ */
+namespace fdbevents_bench
+{
+    using namespace std;
+
+    const sai_object_id_t port_base = 0x3a000000000000;
+    const sai_object_id_t vlan_base = 0x26000000000000;
+
+    FdbEvent fdbEvent(sai_fdb_event_t type, uint32_t id, sai_object_id_t vlan, sai_object_id_t port)
+    {
+        FdbEvent event = {};
+        event.type = type;
+        event.entry.mac_address[0] = 0x00;
+        event.entry.mac_address[1] = 0x11;
+        event.entry.mac_address[2] = static_cast<uint8_t>(id >> 24);
+        event.entry.mac_address[3] = static_cast<uint8_t>(id >> 16);
+        event.entry.mac_address[4] = static_cast<uint8_t>(id >> 8);
+        event.entry.mac_address[5] = static_cast<uint8_t>(id);
+        event.entry.bv_id = vlan;
+        event.bridge_port_id = port;
+        return event;
+    }
+
+    /* Learns and moves only, applied as FdbOrch does, MAC and VLAN to bridge port */
+    typedef map<pair<MacAddress, sai_object_id_t>, sai_object_id_t> Fdb;
+
+    void apply(Fdb &fdb, const FdbEvent &event)
+    {
+        fdb[make_pair(MacAddress(event.entry.mac_address), event.entry.bv_id)] = event.bridge_port_id;
+    }
+
+    /*
+     * MAC move storm of 1000 MACs hopping between 8 ports, drained in bursts
+     * of 4096 events, applied one by one against coalesced per MAC first.
+     */
+    TEST(FdbEventsBench, MoveStorm)
+    {
+        const uint32_t macs = 1000;
+        const size_t bursts = 250;
+        const size_t burst = 4096;
+
+        mt19937 rng(3);
+        vector<vector<FdbEvent>> drained(bursts);
+        for (auto &events : drained)
+        {
+            for (size_t i = 0; i < burst; i++)
+            {
+                uint32_t id = static_cast<uint32_t>(rng() % macs);
+                events.push_back(fdbEvent(SAI_FDB_EVENT_MOVE, id, vlan_base + id % 4, port_base + rng() % 8));
+            }
+        }
+
+        Fdb expected;
+        auto start = chrono::steady_clock::now();
+        for (const auto &events : drained)
+        {
+            for (const auto &event : events)
+            {
+                apply(expected, event);
+            }
+        }
+        auto allUsecs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        FdbEventCoalescer coalescer;
+        Fdb coalesced;
+        vector<FdbEvent> events;
+        start = chrono::steady_clock::now();
+        for (const auto &burstEvents : drained)
+        {
+            for (const auto &event : burstEvents)
+            {
+                coalescer.add(event);
+            }
+            coalescer.take(events);
+            for (const auto &event : events)
+            {
+                apply(coalesced, event);
+            }
+        }
+        auto coalescedUsecs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        EXPECT_EQ(coalesced, expected);
+
+        cout << "MAC move storm of " << bursts * burst << " events in bursts of " << burst << ": "
+             << allUsecs << " us applied one by one, "
+             << coalescer.getReceived() - coalescer.getCoalesced() << " applied after coalescing in "
+             << coalescedUsecs << " us" << endl;
+    }
+}
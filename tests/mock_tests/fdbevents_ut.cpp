@@ -0,0 +1,196 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "fdbevents.h"
+
+#include <map>
+#include <random>
+
+namespace fdbevents_test
+{
+    using namespace std;
+
+    const sai_object_id_t port_base = 0x3a000000000000;
+    const sai_object_id_t vlan_base = 0x26000000000000;
+
+    FdbEvent fdbEvent(sai_fdb_event_t type, uint32_t id, sai_object_id_t vlan, sai_object_id_t port)
+    {
+        FdbEvent event = {};
+        event.type = type;
+        event.entry.mac_address[0] = 0x00;
+        event.entry.mac_address[1] = 0x11;
+        event.entry.mac_address[2] = static_cast<uint8_t>(id >> 24);
+        event.entry.mac_address[3] = static_cast<uint8_t>(id >> 16);
+        event.entry.mac_address[4] = static_cast<uint8_t>(id >> 8);
+        event.entry.mac_address[5] = static_cast<uint8_t>(id);
+        event.entry.bv_id = vlan;
+        event.bridge_port_id = port;
+        return event;
+    }
+
+    /* FDB as left by the events, MAC and VLAN to bridge port, as FdbOrch applies them */
+    typedef map<pair<MacAddress, sai_object_id_t>, sai_object_id_t> Fdb;
+
+    void apply(Fdb &fdb, const FdbEvent &event)
+    {
+        auto key = make_pair(MacAddress(event.entry.mac_address), event.entry.bv_id);
+        switch (event.type)
+        {
+        case SAI_FDB_EVENT_LEARNED:
+        case SAI_FDB_EVENT_MOVE:
+            fdb[key] = event.bridge_port_id;
+            break;
+        case SAI_FDB_EVENT_AGED:
+            fdb.erase(key);
+            break;
+        case SAI_FDB_EVENT_FLUSHED:
+            for (auto it = fdb.begin(); it != fdb.end();)
+            {
+                if (event.bridge_port_id == SAI_NULL_OBJECT_ID || it->second == event.bridge_port_id)
+                {
+                    it = fdb.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    TEST(FdbEventCoalescer, LastEventPerMac)
+    {
+        FdbEventCoalescer coalescer;
+        vector<FdbEvent> events;
+
+        coalescer.add(fdbEvent(SAI_FDB_EVENT_LEARNED, 1, vlan_base, port_base + 1));
+        coalescer.add(fdbEvent(SAI_FDB_EVENT_LEARNED, 2, vlan_base, port_base + 1));
+        coalescer.add(fdbEvent(SAI_FDB_EVENT_MOVE, 1, vlan_base, port_base + 2));
+        coalescer.add(fdbEvent(SAI_FDB_EVENT_LEARNED, 1, vlan_base + 1, port_base + 3));
+        coalescer.add(fdbEvent(SAI_FDB_EVENT_AGED, 2, vlan_base, port_base + 1));
+        coalescer.take(events);
+
+        /* In the order of the first event of each MAC */
+        ASSERT_EQ(events.size(), 3u);
+        EXPECT_EQ(events[0].type, SAI_FDB_EVENT_MOVE);
+        EXPECT_EQ(events[0].bridge_port_id, port_base + 2);
+        EXPECT_EQ(events[1].type, SAI_FDB_EVENT_AGED);
+        EXPECT_EQ(events[2].entry.bv_id, vlan_base + 1);
+        EXPECT_EQ(coalescer.getReceived(), 5u);
+        EXPECT_EQ(coalescer.getCoalesced(), 2u);
+
+        /* Not across flush events */
+        coalescer.add(fdbEvent(SAI_FDB_EVENT_LEARNED, 1, vlan_base, port_base + 1));
+        coalescer.add(fdbEvent(SAI_FDB_EVENT_FLUSHED, 0, SAI_NULL_OBJECT_ID, port_base + 1));
+        coalescer.add(fdbEvent(SAI_FDB_EVENT_LEARNED, 1, vlan_base, port_base + 1));
+        coalescer.add(fdbEvent(SAI_FDB_EVENT_MOVE, 1, vlan_base, port_base + 2));
+        coalescer.take(events);
+
+        ASSERT_EQ(events.size(), 3u);
+        EXPECT_EQ(events[0].type, SAI_FDB_EVENT_LEARNED);
+        EXPECT_EQ(events[1].type, SAI_FDB_EVENT_FLUSHED);
+        EXPECT_EQ(events[2].type, SAI_FDB_EVENT_MOVE);
+
+        coalescer.take(events);
+        EXPECT_TRUE(events.empty());
+    }
+
+    /*
+     * MAC move storm: 1000 MACs hopping between 8 ports, with aging and port
+     * flushes, drained in bursts of 4096 events. The FDB left by the coalesced
+     * events must be the one left by all the events.
+     */
+    TEST(FdbEventCoalescer, MoveStorm)
+    {
+        const uint32_t macs = 1000;
+        const size_t bursts = 250;
+        const size_t burst = 4096;
+
+        mt19937 rng(3);
+        FdbEventCoalescer coalescer;
+        Fdb expected;
+        Fdb coalesced;
+        size_t applied = 0;
+        vector<FdbEvent> events;
+
+        for (size_t b = 0; b < bursts; b++)
+        {
+            for (size_t i = 0; i < burst; i++)
+            {
+                uint32_t id = static_cast<uint32_t>(rng() % macs);
+                sai_object_id_t vlan = vlan_base + id % 4;
+                sai_object_id_t port = port_base + rng() % 8;
+                uint32_t draw = static_cast<uint32_t>(rng() % 10000);
+
+                FdbEvent event;
+                if (draw == 0)
+                {
+                    event = fdbEvent(SAI_FDB_EVENT_FLUSHED, 0, SAI_NULL_OBJECT_ID, port);
+                }
+                else if (draw < 1000)
+                {
+                    event = fdbEvent(SAI_FDB_EVENT_AGED, id, vlan, port);
+                }
+                else
+                {
+                    event = fdbEvent(draw < 5000 ? SAI_FDB_EVENT_LEARNED : SAI_FDB_EVENT_MOVE, id, vlan, port);
+                }
+
+                apply(expected, event);
+                coalescer.add(event);
+            }
+
+            coalescer.take(events);
+            for (const auto &event : events)
+            {
+                apply(coalesced, event);
+            }
+            applied += events.size();
+        }
+
+        EXPECT_EQ(coalesced, expected);
+        EXPECT_EQ(coalescer.getReceived(), bursts * burst);
+        EXPECT_EQ(coalescer.getReceived() - coalescer.getCoalesced(), applied);
+        EXPECT_LT(applied, bursts * burst);
+    }
+
+    TEST(FdbFlushRequests, Scopes)
+    {
+        FdbFlushRequests requests;
+        vector<FdbFlushRequests::Scope> scopes;
+        bool all;
+
+        requests.add(port_base + 1, SAI_NULL_OBJECT_ID);
+        requests.add(port_base + 1, vlan_base + 1);
+        requests.add(port_base + 2, vlan_base + 2);
+        requests.add(port_base + 3, vlan_base + 2);
+        requests.add(SAI_NULL_OBJECT_ID, vlan_base + 2);
+        requests.add(port_base + 4, vlan_base + 3);
+        requests.add(port_base + 4, vlan_base + 3);
+        EXPECT_FALSE(requests.empty());
+
+        /* Port and VLAN flushes covered by a port or a VLAN flush are dropped */
+        requests.take(all, scopes);
+        EXPECT_FALSE(all);
+        vector<FdbFlushRequests::Scope> expected = {
+            { SAI_NULL_OBJECT_ID, vlan_base + 2 },
+            { port_base + 1, SAI_NULL_OBJECT_ID },
+            { port_base + 4, vlan_base + 3 },
+        };
+        EXPECT_EQ(scopes, expected);
+        EXPECT_TRUE(requests.empty());
+
+        /* A flush of all the FDB takes in the others */
+        requests.add(port_base + 1, vlan_base + 1);
+        requests.addAll();
+        requests.take(all, scopes);
+        EXPECT_TRUE(all);
+        EXPECT_TRUE(scopes.empty());
+
+        requests.add(SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID);
+        requests.take(all, scopes);
+        EXPECT_TRUE(all);
+    }
+}
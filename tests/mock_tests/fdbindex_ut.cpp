@@ -0,0 +1,161 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "fdbindex.h"
+
+#include <map>
+#include <algorithm>
+
+namespace fdbindex_test
+{
+    using namespace std;
+
+    const sai_object_id_t port_base = 0x3a000000000000;
+    const sai_object_id_t vlan_base = 0x26000000000000;
+
+    FdbEntry fdbEntry(uint32_t id, sai_object_id_t vlan)
+    {
+        FdbEntry entry;
+        uint8_t mac[6] = { 0x00, 0x11, static_cast<uint8_t>(id >> 24), static_cast<uint8_t>(id >> 16),
+                           static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(id) };
+        entry.mac = MacAddress(mac);
+        entry.bv_id = vlan;
+        return entry;
+    }
+
+    /* Entries with their bridge port and their positions in the index, as FdbOrch keeps them */
+    struct Entries
+    {
+        FdbIndex<FdbEntry> index;
+        map<FdbEntry, pair<sai_object_id_t, FdbIndex<FdbEntry>::Position>> entries;
+
+        void insert(const FdbEntry &entry, sai_object_id_t port)
+        {
+            entries[entry] = { port, index.insert(entry, port) };
+        }
+
+        void erase(const FdbEntry &entry)
+        {
+            auto it = entries.find(entry);
+            index.erase(entry, it->second.first, it->second.second,
+                        [this](const FdbEntry &moved) -> FdbIndex<FdbEntry>::Position & { return entries.at(moved).second; });
+            entries.erase(it);
+        }
+
+        vector<FdbEntry> byPortAndVlan(sai_object_id_t port, sai_object_id_t vlan) const
+        {
+            auto found = index.byPortAndVlan(port, vlan, [this](const FdbEntry &e) { return entries.at(e).first; });
+            sort(found.begin(), found.end());
+            return found;
+        }
+
+        /* Every position kept points at its entry */
+        void check() const
+        {
+            for (const auto &it: entries)
+            {
+                const auto &pos = it.second.second;
+                ASSERT_LT(pos.port, index.byPort(it.second.first).size());
+                ASSERT_EQ(index.byPort(it.second.first)[pos.port], it.first);
+                ASSERT_LT(pos.vlan, index.byVlan(it.first.bv_id).size());
+                ASSERT_EQ(index.byVlan(it.first.bv_id)[pos.vlan], it.first);
+            }
+        }
+    };
+
+    TEST(FdbIndex, InsertMoveErase)
+    {
+        Entries fdb;
+        auto a = fdbEntry(1, vlan_base + 1);
+        auto b = fdbEntry(2, vlan_base + 1);
+        auto c = fdbEntry(1, vlan_base + 2);
+
+        fdb.insert(a, port_base + 1);
+        fdb.insert(b, port_base + 1);
+        fdb.insert(c, port_base + 2);
+        fdb.check();
+        EXPECT_EQ(fdb.index.byPort(port_base + 1).size(), 2u);
+        EXPECT_EQ(fdb.index.byPort(port_base + 2).size(), 1u);
+        EXPECT_EQ(fdb.index.byVlan(vlan_base + 1).size(), 2u);
+        EXPECT_EQ(fdb.index.byVlan(vlan_base + 2).size(), 1u);
+        EXPECT_EQ(fdb.byPortAndVlan(port_base + 1, vlan_base + 1).size(), 2u);
+        EXPECT_TRUE(fdb.byPortAndVlan(port_base + 1, vlan_base + 2).empty());
+
+        /* MAC move, a takes the place of b in the VLAN list */
+        fdb.erase(a);
+        fdb.check();
+        fdb.insert(a, port_base + 2);
+        fdb.check();
+        EXPECT_EQ(fdb.index.byPort(port_base + 1).size(), 1u);
+        EXPECT_EQ(fdb.index.byPort(port_base + 2).size(), 2u);
+        EXPECT_EQ(fdb.index.byVlan(vlan_base + 1).size(), 2u);
+        EXPECT_EQ(fdb.byPortAndVlan(port_base + 2, vlan_base + 1), vector<FdbEntry>{ a });
+
+        /* Empty lists are dropped */
+        fdb.erase(a);
+        fdb.erase(b);
+        fdb.erase(c);
+        EXPECT_TRUE(fdb.index.byPort(port_base + 1).empty());
+        EXPECT_TRUE(fdb.index.byVlan(vlan_base + 1).empty());
+        EXPECT_EQ(fdb.index.ports(), 0u);
+        EXPECT_EQ(fdb.index.vlans(), 0u);
+
+        /* Unknown entries are ignored */
+        FdbIndex<FdbEntry>::Position none = { 0, 0 };
+        fdb.index.erase(a, port_base + 3, none, [](const FdbEntry &) -> FdbIndex<FdbEntry>::Position & {
+            throw runtime_error("no entry to move");
+        });
+        EXPECT_EQ(fdb.index.ports(), 0u);
+    }
+
+    /*
+     * MACs of a flapping port, as found by a port flush and by the ARP flush
+     * notification, with the FDB spread over 64 ports and 15 VLANs: the port
+     * list is the smaller one, and then the VLAN list once most MACs of the
+     * VLAN are on the port. Both give the MACs a scan of the FDB gives.
+     */
+    TEST(FdbIndex, PortFlap)
+    {
+        const uint32_t ports = 64;
+        const uint32_t vlans = 15;
+        const uint32_t size = 10000;
+        const sai_object_id_t flapped = port_base + 7;
+        const sai_object_id_t vlan = vlan_base + 7;
+
+        Entries fdb;
+        for (uint32_t i = 0; i < size; i++)
+        {
+            fdb.insert(fdbEntry(i, vlan_base + i % vlans), port_base + i % ports);
+        }
+
+        auto scan = [&]() {
+            vector<FdbEntry> found;
+            for (const auto &it: fdb.entries)
+            {
+                if (it.second.first == flapped && it.first.bv_id == vlan)
+                {
+                    found.push_back(it.first);
+                }
+            }
+            return found;
+        };
+
+        EXPECT_EQ(fdb.index.byPort(flapped).size(), size / ports + (size % ports > 7));
+        EXPECT_LT(fdb.index.byPort(flapped).size(), fdb.index.byVlan(vlan).size());
+        EXPECT_EQ(fdb.byPortAndVlan(flapped, vlan), scan());
+
+        /* The MACs of the VLAN on the other ports go away */
+        for (uint32_t i = 0; i < size; i++)
+        {
+            auto entry = fdbEntry(i, vlan_base + i % vlans);
+            if (entry.bv_id == vlan && port_base + i % ports != flapped)
+            {
+                fdb.erase(entry);
+            }
+        }
+        fdb.check();
+
+        EXPECT_GT(fdb.index.byPort(flapped).size(), fdb.index.byVlan(vlan).size());
+        EXPECT_EQ(fdb.byPortAndVlan(flapped, vlan), scan());
+        EXPECT_FALSE(scan().empty());
+    }
+}
@@ -0,0 +1,91 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "fdbtable.h"
+#include "fdbindex.h"
+
+#include <map>
+#include <chrono>
+#include <iostream>
+
+/*
+ * Microbenchmarks, built on demand with "make benchmarks" and not run by
+ * "make check": timings depend on the machine and only compare implementations.
+ */
+namespace fdbtable_bench
+{
+    using namespace std;
+
+    /* FdbEntry and FdbData as FdbOrch::m_entries kept them before FdbTable */
+    struct LegacyFdbEntry
+    {
+        MacAddress mac;
+        sai_object_id_t bv_id;
+        string port_name;
+
+        bool operator<(const LegacyFdbEntry &other) const
+        {
+            return tie(mac, bv_id) < tie(other.mac, other.bv_id);
+        }
+    };
+
+    struct LegacyFdbData
+    {
+        sai_object_id_t bridge_port_id;
+        string type;
+        FdbOrigin origin;
+        string remote_ip;
+        string esi;
+        unsigned int vni;
+    };
+
+    const sai_object_id_t port_base = 0x3a000000000000;
+    const sai_object_id_t vlan_base = 0x26000000000000;
+
+    FdbKey fdbKey(uint32_t id, sai_object_id_t vlan)
+    {
+        uint8_t mac[6] = { 0x00, 0x11, static_cast<uint8_t>(id >> 24), static_cast<uint8_t>(id >> 16),
+                           static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(id) };
+        return { MacAddress(mac), vlan };
+    }
+
+    /*
+     * Learn cost of 128k local MACs, in the std::map of FdbEntry and FdbData
+     * against the structures FdbOrch keeps now: FdbTable and FdbIndex.
+     */
+    TEST(FdbTableBench, Learn)
+    {
+        const uint32_t macs = 128 * 1024;
+        const uint32_t vlans = 64;
+
+        map<LegacyFdbEntry, LegacyFdbData> legacy;
+        auto start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < macs; i++)
+        {
+            auto key = fdbKey(i, vlan_base + i % vlans);
+            LegacyFdbEntry entry = { key.mac, key.bv_id, "Ethernet" + to_string((i % 32) * 4) };
+            LegacyFdbData data = { port_base + i % 32, "dynamic", FDB_ORIGIN_LEARN, "", "", 0 };
+            legacy[entry] = data;
+        }
+        auto legacyUsecs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        FdbTable<FdbRecord> table;
+        FdbIndex<FdbKey> index;
+        start = chrono::steady_clock::now();
+        for (uint32_t i = 0; i < macs; i++)
+        {
+            auto key = fdbKey(i, vlan_base + i % vlans);
+            FdbRecord record = {};
+            record.bridge_port_id = port_base + i % 32;
+            record.type = FDB_TYPE_DYNAMIC;
+            record.origin = FDB_ORIGIN_LEARN;
+            record.index = index.insert(key, record.bridge_port_id);
+            table.set(key, record);
+        }
+        auto tableUsecs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+        EXPECT_EQ(table.size(), legacy.size());
+
+        cout << "Learn of " << macs << " MACs: std::map " << legacyUsecs << " us, FdbTable and FdbIndex "
+             << tableUsecs << " us" << endl;
+    }
+}
@@ -0,0 +1,259 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "fdbtable.h"
+#include "fdbindex.h"
+
+#include <map>
+#include <random>
+
+namespace fdbtable_test
+{
+    using namespace std;
+
+    /* Allocator counting the bytes held by the std::map baseline */
+    size_t g_mapBytes = 0;
+
+    template <typename T>
+    struct CountingAllocator
+    {
+        typedef T value_type;
+
+        CountingAllocator() = default;
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U> &) { }
+
+        T *allocate(size_t n)
+        {
+            g_mapBytes += n * sizeof(T);
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t n)
+        {
+            g_mapBytes -= n * sizeof(T);
+            ::operator delete(p);
+        }
+
+        template <typename U>
+        bool operator==(const CountingAllocator<U> &) const { return true; }
+        template <typename U>
+        bool operator!=(const CountingAllocator<U> &) const { return false; }
+    };
+
+    /* FdbEntry and FdbData as FdbOrch::m_entries kept them before FdbTable, as footprint baseline */
+    struct LegacyFdbEntry
+    {
+        MacAddress mac;
+        sai_object_id_t bv_id;
+        string port_name;
+
+        bool operator<(const LegacyFdbEntry &other) const
+        {
+            return tie(mac, bv_id) < tie(other.mac, other.bv_id);
+        }
+    };
+
+    struct LegacyFdbData
+    {
+        sai_object_id_t bridge_port_id;
+        string type;
+        FdbOrigin origin;
+        string remote_ip;
+        string esi;
+        unsigned int vni;
+    };
+
+    typedef map<LegacyFdbEntry, LegacyFdbData, less<LegacyFdbEntry>,
+                CountingAllocator<pair<const LegacyFdbEntry, LegacyFdbData>>> LegacyFdbTable;
+
+    const sai_object_id_t vlan_base = 0x26000000000000;
+
+    FdbKey fdbKey(uint32_t id, sai_object_id_t vlan)
+    {
+        uint8_t mac[6] = { 0x00, 0x11, static_cast<uint8_t>(id >> 24), static_cast<uint8_t>(id >> 16),
+                           static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(id) };
+        return { MacAddress(mac), vlan };
+    }
+
+    /* Heap bytes of a string beyond its inline buffer */
+    size_t heapBytes(const string &str)
+    {
+        return str.capacity() > 15 ? str.capacity() + 1 : 0;
+    }
+
+    TEST(FdbTable, MatchesMap)
+    {
+        FdbTable<uint64_t> table;
+        map<FdbKey, uint64_t> reference;
+        mt19937 rng(1);
+
+        for (size_t i = 0; i < 200000; i++)
+        {
+            /* Few distinct keys, so that entries are often updated and erased */
+            auto key = fdbKey(static_cast<uint32_t>(rng() % 4096), vlan_base + rng() % 4);
+            if (rng() % 3)
+            {
+                uint64_t value = rng();
+                table.set(key, value);
+                reference[key] = value;
+            }
+            else
+            {
+                ASSERT_EQ(table.erase(key), reference.erase(key) == 1);
+            }
+        }
+
+        ASSERT_EQ(table.size(), reference.size());
+        for (const auto &it : reference)
+        {
+            const uint64_t *value = table.find(it.first);
+            ASSERT_NE(value, nullptr);
+            EXPECT_EQ(*value, it.second);
+        }
+
+        auto keys = table.keys();
+        ASSERT_EQ(keys.size(), reference.size());
+        for (const auto &key : keys)
+        {
+            EXPECT_TRUE(table.erase(key));
+        }
+        EXPECT_TRUE(table.empty());
+        EXPECT_EQ(table.find(fdbKey(1, vlan_base)), nullptr);
+    }
+
+    TEST(FdbTable, ValuePool)
+    {
+        FdbValuePool<string> pool("");
+
+        EXPECT_EQ(pool.add(""), 0u);
+        uint32_t vtep = pool.add("10.0.0.1");
+        EXPECT_NE(vtep, 0u);
+        EXPECT_EQ(pool.add("10.0.0.1"), vtep);
+        EXPECT_EQ(pool.size(), 1u);
+
+        pool.release(vtep);
+        EXPECT_EQ(pool.get(vtep), "10.0.0.1");
+        pool.release(vtep);
+        EXPECT_EQ(pool.size(), 0u);
+        EXPECT_EQ(pool.get(vtep), "");
+
+        /* Ids are reused */
+        EXPECT_EQ(pool.add("10.0.0.2"), vtep);
+        pool.release(0);
+        EXPECT_EQ(pool.get(0), "");
+    }
+
+    TEST(FdbTable, Esi)
+    {
+        FdbEsi esi;
+        FdbEsi none = {};
+
+        ASSERT_TRUE(FdbEsi::parse("00:11:22:33:44:55:66:77:88:Ab", esi));
+        EXPECT_EQ(esi.bytes[1], 0x11);
+        EXPECT_EQ(esi.bytes[9], 0xab);
+        EXPECT_FALSE(esi == none);
+
+        EXPECT_FALSE(FdbEsi::parse("00:11:22:33:44:55:66:77:88", esi));
+        EXPECT_TRUE(esi == none);
+        EXPECT_FALSE(FdbEsi::parse("00:11:22:33:44:55:66:77:88:g9", esi));
+        EXPECT_FALSE(FdbEsi::parse("00-11-22-33-44-55-66-77-88-99", esi));
+
+        FdbValuePool<FdbEsi> pool(none);
+        EXPECT_EQ(pool.add(none), 0u);
+        ASSERT_TRUE(FdbEsi::parse("00:11:22:33:44:55:66:77:88:99", esi));
+        EXPECT_TRUE(pool.get(pool.add(esi)) == esi);
+    }
+
+    /*
+     * Footprint of 128k MACs on an EVPN leaf, half of them local and half
+     * advertised by 32 remote VTEPs with an ESI. Counts every structure
+     * FdbOrch keeps per MAC: m_entries, m_entriesIndex and the pools of
+     * remote VTEPs and ESIs, against the std::map of FdbEntry and FdbData
+     * with their strings which was all FdbOrch kept before.
+     */
+    TEST(FdbTable, Footprint)
+    {
+        const uint32_t macs = 128 * 1024;
+        const uint32_t vlans = 64;
+
+        g_mapBytes = 0;
+        LegacyFdbTable legacy;
+
+        FdbTable<FdbRecord> table;
+        FdbIndex<FdbKey> index;
+        FdbValuePool<IpAddress> remotes(IpAddress(0x0));
+        FdbValuePool<FdbEsi> esis(FdbEsi{});
+
+        for (uint32_t i = 0; i < macs; i++)
+        {
+            auto key = fdbKey(i, vlan_base + i % vlans);
+            sai_object_id_t port = 0x3a000000000000 + i % 32;
+
+            LegacyFdbEntry entry;
+            entry.mac = key.mac;
+            entry.bv_id = key.bv_id;
+            entry.port_name = "Ethernet" + to_string((i % 32) * 4);
+
+            LegacyFdbData data;
+            data.bridge_port_id = port;
+            data.vni = 0;
+
+            FdbRecord record = {};
+            record.bridge_port_id = port;
+            if (i % 2)
+            {
+                data.type = "dynamic";
+                data.origin = FDB_ORIGIN_LEARN;
+
+                record.type = FDB_TYPE_DYNAMIC;
+                record.origin = FDB_ORIGIN_LEARN;
+            }
+            else
+            {
+                data.type = "static";
+                data.origin = FDB_ORIGIN_VXLAN_ADVERTIZED;
+                data.remote_ip = "10.1.0." + to_string(i / 2 % 32 + 1);
+                data.esi = "00:11:22:33:44:55:66:77:88:" + to_string(i / 2 % 32 + 10);
+                data.vni = 10000 + i % vlans;
+
+                FdbEsi esi;
+                ASSERT_TRUE(FdbEsi::parse(data.esi, esi));
+                record.type = FDB_TYPE_STATIC;
+                record.origin = FDB_ORIGIN_VXLAN_ADVERTIZED;
+                record.remote_ip = remotes.add(IpAddress(data.remote_ip));
+                record.esi = esis.add(esi);
+                record.vni = data.vni;
+            }
+            legacy[entry] = data;
+
+            /* As FdbOrch::setFdbEntry() */
+            record.index = index.insert(key, record.bridge_port_id);
+            table.set(key, record);
+        }
+
+        size_t legacyBytes = g_mapBytes;
+        for (const auto &it : legacy)
+        {
+            legacyBytes += heapBytes(it.first.port_name) + heapBytes(it.second.type) +
+                           heapBytes(it.second.remote_ip) + heapBytes(it.second.esi);
+        }
+
+        ASSERT_EQ(table.size(), legacy.size());
+        EXPECT_EQ(remotes.size(), 32u);
+        EXPECT_EQ(esis.size(), 32u);
+        EXPECT_EQ(index.ports(), 32u);
+        EXPECT_EQ(index.vlans(), vlans);
+        for (uint32_t i = 0; i < macs; i += 97)
+        {
+            auto key = fdbKey(i, vlan_base + i % vlans);
+            const FdbRecord *record = table.find(key);
+            ASSERT_NE(record, nullptr);
+            EXPECT_EQ(record->bridge_port_id, 0x3a000000000000 + i % 32);
+            EXPECT_EQ(index.byPort(record->bridge_port_id)[record->index.port], key);
+            EXPECT_EQ(index.byVlan(key.bv_id)[record->index.vlan], key);
+        }
+
+        size_t bytes = table.memoryUsage() + index.memoryUsage() + remotes.memoryUsage() + esis.memoryUsage();
+        EXPECT_LT(bytes * 3, legacyBytes * 2);
+    }
+}
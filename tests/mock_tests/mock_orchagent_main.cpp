@@ -19,8 +19,7 @@ bool gSairedisRecord = true;
 bool gSwssRecord = true;
 bool gLogRotate = false;
 bool gSaiRedisLogRotate = false;
-ofstream gRecordOfs;
-string gRecordFile;
+bool gOrchWorkers = false;
 string gMySwitchType = "switch";
 int32_t gVoqMySwitchId = 0;
 string gMyHostName = "Linecard1";
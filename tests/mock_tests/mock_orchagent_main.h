@@ -21,8 +21,6 @@ extern bool gSwssRecord;
 extern bool gSairedisRecord;
 extern bool gLogRotate;
 extern bool gSaiRedisLogRotate;
-extern ofstream gRecordOfs;
-extern string gRecordFile;
 
 extern MacAddress gMacAddress;
 extern MacAddress gVxlanMacAddress;
@@ -55,6 +53,7 @@ extern sai_route_api_t *sai_route_api;
 extern sai_neighbor_api_t *sai_neighbor_api;
 extern sai_tunnel_api_t *sai_tunnel_api;
 extern sai_next_hop_api_t *sai_next_hop_api;
+extern sai_fdb_api_t *sai_fdb_api;
 extern sai_hostif_api_t *sai_hostif_api;
 extern sai_buffer_api_t *sai_buffer_api;
 extern sai_queue_api_t *sai_queue_api;
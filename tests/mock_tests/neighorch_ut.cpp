@@ -0,0 +1,397 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+#include "saispy.h"
+#include "muxorch.h"
+
+extern Directory<Orch*> gDirectory;
+
+namespace neighorch_test
+{
+    using namespace std;
+
+    struct NeighOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<swss::DBConnector> m_chassis_app_db;
+
+        sai_next_hop_api_t *m_orig_next_hop_api = nullptr;
+        string m_alias;
+
+        // Next hops whose creation fails, with the number of failures left
+        map<IpAddress, int> m_failures;
+        map<IpAddress, int> m_attempts;
+
+        NeighOrchTest()
+        {
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            m_chassis_app_db = make_shared<swss::DBConnector>("CHASSIS_APP_DB", 0);
+        }
+
+        static void SetUpTestCase()
+        {
+            map<string, string> profile = {
+                { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
+                { "KV_DEVICE_MAC_ADDRESS", "20:03:04:05:06:00" }
+            };
+
+            auto status = ut_helper::initSaiApi(profile);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            sai_attribute_t attr;
+
+            attr.id = SAI_SWITCH_ATTR_INIT_SWITCH;
+            attr.value.booldata = true;
+
+            status = sai_switch_api->create_switch(&gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            attr.id = SAI_SWITCH_ATTR_SRC_MAC_ADDRESS;
+            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            gMacAddress = attr.value.mac;
+
+            attr.id = SAI_SWITCH_ATTR_DEFAULT_VIRTUAL_ROUTER_ID;
+            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+
+            gVirtualRouterId = attr.value.oid;
+        }
+
+        static void TearDownTestCase()
+        {
+            auto status = sai_switch_api->remove_switch(gSwitchId);
+            ASSERT_EQ(status, SAI_STATUS_SUCCESS);
+            gSwitchId = 0;
+
+            ut_helper::uninitSaiApi();
+        }
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+
+            // The next hop bulker takes the SAI functions when NeighOrch is created
+            m_orig_next_hop_api = sai_next_hop_api;
+            sai_next_hop_api = new sai_next_hop_api_t();
+            memcpy(sai_next_hop_api, m_orig_next_hop_api, sizeof(*sai_next_hop_api));
+
+            auto nextHopSpy = SpyOn<SAI_API_NEXT_HOP, SAI_OBJECT_TYPE_NEXT_HOP>(&sai_next_hop_api->create_next_hop);
+            nextHopSpy->callFake([this](sai_object_id_t *oid, sai_object_id_t swoid, uint32_t count, const sai_attribute_t *attrs) -> sai_status_t {
+                    for (uint32_t i = 0; i < count; i++)
+                    {
+                        if (attrs[i].id != SAI_NEXT_HOP_ATTR_IP)
+                        {
+                            continue;
+                        }
+
+                        IpAddress ip(attrs[i].value.ipaddr.addr.ip4);
+                        m_attempts[ip]++;
+                        auto failure = m_failures.find(ip);
+                        if (failure != m_failures.end() && failure->second > 0)
+                        {
+                            failure->second--;
+                            return SAI_STATUS_INSUFFICIENT_RESOURCES;
+                        }
+                    }
+                    return m_orig_next_hop_api->create_next_hop(oid, swoid, count, attrs);
+                }
+            );
+
+            TableConnector stateDbSwitchTable(m_state_db.get(), "SWITCH_CAPABILITY");
+            TableConnector conf_asic_sensors(m_config_db.get(), CFG_ASIC_SENSORS_TABLE_NAME);
+            TableConnector app_switch_table(m_app_db.get(), APP_SWITCH_TABLE_NAME);
+
+            vector<TableConnector> switch_tables = {
+                conf_asic_sensors,
+                app_switch_table
+            };
+
+            ASSERT_EQ(gSwitchOrch, nullptr);
+            gSwitchOrch = new SwitchOrch(m_app_db.get(), switch_tables, stateDbSwitchTable);
+
+            ASSERT_EQ(gCrmOrch, nullptr);
+            gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+            const int portsorch_base_pri = 40;
+
+            vector<table_name_with_pri_t> ports_tables = {
+                { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+                { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+                { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+                { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+                { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+            };
+
+            ASSERT_EQ(gPortsOrch, nullptr);
+            gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables, m_chassis_app_db.get());
+
+            vector<string> buffer_tables = { APP_BUFFER_POOL_TABLE_NAME,
+                                             APP_BUFFER_PROFILE_TABLE_NAME,
+                                             APP_BUFFER_QUEUE_TABLE_NAME,
+                                             APP_BUFFER_PG_TABLE_NAME,
+                                             APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME,
+                                             APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME };
+
+            ASSERT_EQ(gBufferOrch, nullptr);
+            gBufferOrch = new BufferOrch(m_app_db.get(), m_config_db.get(), m_state_db.get(), buffer_tables);
+
+            ASSERT_EQ(gVrfOrch, nullptr);
+            gVrfOrch = new VRFOrch(m_app_db.get(), APP_VRF_TABLE_NAME, m_state_db.get(), STATE_VRF_OBJECT_TABLE_NAME);
+
+            ASSERT_EQ(gIntfsOrch, nullptr);
+            gIntfsOrch = new IntfsOrch(m_app_db.get(), APP_INTF_TABLE_NAME, gVrfOrch, m_chassis_app_db.get());
+
+            TableConnector stateDbFdb(m_state_db.get(), STATE_FDB_TABLE_NAME);
+
+            vector<table_name_with_pri_t> app_fdb_tables = {
+                { APP_FDB_TABLE_NAME,        FdbOrch::fdborch_pri},
+                { APP_VXLAN_FDB_TABLE_NAME,  FdbOrch::fdborch_pri}
+            };
+
+            ASSERT_EQ(gFdbOrch, nullptr);
+            gFdbOrch = new FdbOrch(m_app_db.get(), app_fdb_tables, stateDbFdb, gPortsOrch);
+
+            ASSERT_EQ(gNeighOrch, nullptr);
+            gNeighOrch = new NeighOrch(m_app_db.get(), APP_NEIGH_TABLE_NAME, gIntfsOrch, gFdbOrch, gPortsOrch, m_chassis_app_db.get());
+
+            vector<table_name_with_pri_t> fgnhg_tables = {
+                { CFG_FG_NHG,                 15 },
+                { CFG_FG_NHG_PREFIX,          15 },
+                { CFG_FG_NHG_MEMBER,          15 }
+            };
+
+            ASSERT_EQ(gFgNhgOrch, nullptr);
+            gFgNhgOrch = new FgNhgOrch(m_config_db.get(), m_app_db.get(), m_state_db.get(), fgnhg_tables, gNeighOrch, gIntfsOrch, gVrfOrch);
+
+            ASSERT_EQ(gRouteOrch, nullptr);
+            gRouteOrch = new RouteOrch(m_app_db.get(), APP_ROUTE_TABLE_NAME, gSwitchOrch, gNeighOrch, gIntfsOrch, gVrfOrch, gFgNhgOrch);
+
+            // NeighOrch asks MuxOrch whether a neighbor is active, there is no mux cable here
+            if (gDirectory.get<MuxOrch*>() == nullptr)
+            {
+                vector<string> mux_tables = { CFG_MUX_CABLE_TABLE_NAME, CFG_PEER_SWITCH_TABLE_NAME };
+                gDirectory.set(new MuxOrch(m_config_db.get(), mux_tables, nullptr, gNeighOrch, gFdbOrch));
+            }
+
+            // Bring the ports up and create a router interface on the first one
+            Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+            auto ports = ut_helper::getInitialSaiPorts();
+            for (const auto &it : ports)
+            {
+                portTable.set(it.first, it.second);
+            }
+            portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+            portTable.set("PortInitDone", { { "lanes", "0" } });
+            gPortsOrch->addExistingData(&portTable);
+
+            static_cast<Orch *>(gPortsOrch)->doTask();
+            static_cast<Orch *>(gBufferOrch)->doTask();
+            static_cast<Orch *>(gPortsOrch)->doTask();
+            ASSERT_TRUE(gPortsOrch->allPortsReady());
+
+            m_alias = ports.begin()->first;
+            ASSERT_TRUE(gIntfsOrch->setIntf(m_alias));
+        }
+
+        void TearDown() override
+        {
+            delete gRouteOrch;
+            gRouteOrch = nullptr;
+            delete gFgNhgOrch;
+            gFgNhgOrch = nullptr;
+            delete gNeighOrch;
+            gNeighOrch = nullptr;
+            delete gFdbOrch;
+            gFdbOrch = nullptr;
+            delete gIntfsOrch;
+            gIntfsOrch = nullptr;
+            delete gVrfOrch;
+            gVrfOrch = nullptr;
+            delete gBufferOrch;
+            gBufferOrch = nullptr;
+            delete gPortsOrch;
+            gPortsOrch = nullptr;
+            delete gCrmOrch;
+            gCrmOrch = nullptr;
+            delete gSwitchOrch;
+            gSwitchOrch = nullptr;
+
+            delete sai_next_hop_api;
+            sai_next_hop_api = m_orig_next_hop_api;
+
+            ::testing_db::reset();
+        }
+
+        void addNeighbors(const vector<string> &ips)
+        {
+            auto consumer = static_cast<Consumer *>(gNeighOrch->getExecutor(APP_NEIGH_TABLE_NAME));
+            for (const auto &ip : ips)
+            {
+                consumer->addToSync({ m_alias + ":" + ip, SET_COMMAND,
+                                      { { "neigh", "00:00:00:01:02:03" }, { "family", "IPv4" } } });
+            }
+            static_cast<Orch *>(gNeighOrch)->doTask(*consumer);
+        }
+
+        void addRoute(const string &prefix, const string &nexthops, const string &ifnames)
+        {
+            auto consumer = static_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+            consumer->addToSync({ prefix, SET_COMMAND, { { "nexthop", nexthops }, { "ifname", ifnames } } });
+            static_cast<Orch *>(gRouteOrch)->doTask(*consumer);
+        }
+
+        NextHopKey nextHop(const string &ip)
+        {
+            return NextHopKey(IpAddress(ip), m_alias);
+        }
+
+        bool isResolved(const string &ip)
+        {
+            NeighborEntry neighbor_entry;
+            MacAddress mac;
+            return gNeighOrch->getNeighborEntry(NextHopKey(IpAddress(ip), m_alias), neighbor_entry, mac)
+                && gNeighOrch->hasNextHop(NextHopKey(IpAddress(ip), m_alias));
+        }
+
+        vector<string> pendingTasks()
+        {
+            vector<string> ts;
+            static_cast<Consumer *>(gNeighOrch->getExecutor(APP_NEIGH_TABLE_NAME))->dumpPendingTasks(ts);
+            return ts;
+        }
+    };
+
+    /*
+     * A next hop failing in the middle of a bulk does not hold back the
+     * neighbors after it. A next hop the bulk could not create is retried on
+     * its own, and the neighbor is only left pending if that fails as well.
+     */
+    TEST_F(NeighOrchTest, NextHopFailureInTheMiddleOfABulk)
+    {
+        m_failures[IpAddress("10.0.0.3")] = 2;
+        m_failures[IpAddress("10.0.0.5")] = 1;
+
+        addNeighbors({ "10.0.0.2", "10.0.0.3", "10.0.0.4", "10.0.0.5", "10.0.0.6" });
+
+        EXPECT_TRUE(isResolved("10.0.0.2"));
+        EXPECT_FALSE(isResolved("10.0.0.3"));
+        EXPECT_TRUE(isResolved("10.0.0.4"));
+        EXPECT_TRUE(isResolved("10.0.0.5"));
+        EXPECT_TRUE(isResolved("10.0.0.6"));
+
+        // In the bulk, then on its own
+        EXPECT_EQ(m_attempts[IpAddress("10.0.0.3")], 2);
+        EXPECT_EQ(m_attempts[IpAddress("10.0.0.5")], 2);
+        EXPECT_EQ(m_attempts[IpAddress("10.0.0.6")], 1);
+
+        auto ts = pendingTasks();
+        ASSERT_EQ(ts.size(), 1u);
+        EXPECT_NE(ts[0].find(m_alias + ":10.0.0.3"), string::npos);
+
+        // The neighbor left pending is added on the next retry
+        static_cast<Orch *>(gNeighOrch)->doTask();
+
+        EXPECT_TRUE(isResolved("10.0.0.3"));
+        EXPECT_EQ(m_attempts[IpAddress("10.0.0.3")], 3);
+        EXPECT_TRUE(pendingTasks().empty());
+    }
+
+    /*
+     * A MUX cable turning standby removes its neighbors and their next hops
+     * from the ASIC and keeps them in the cache, turning active programs
+     * them back. Neighbors unknown or already in the requested state are
+     * skipped.
+     */
+    TEST_F(NeighOrchTest, EnableDisableNeighbors)
+    {
+        addNeighbors({ "10.0.0.2", "10.0.0.3" });
+
+        vector<NeighborEntry> neighbors = {
+            NeighborEntry(IpAddress("10.0.0.2"), m_alias),
+            NeighborEntry(IpAddress("10.0.0.3"), m_alias),
+            NeighborEntry(IpAddress("10.0.0.9"), m_alias)
+        };
+
+        ASSERT_TRUE(gNeighOrch->disableNeighbors(neighbors));
+        for (const auto &ip : { "10.0.0.2", "10.0.0.3" })
+        {
+            NeighborEntry neighbor_entry;
+            MacAddress mac;
+            EXPECT_TRUE(gNeighOrch->getNeighborEntry(nextHop(ip), neighbor_entry, mac));
+            EXPECT_FALSE(gNeighOrch->isHwConfigured(NeighborEntry(IpAddress(ip), m_alias)));
+            EXPECT_FALSE(gNeighOrch->hasNextHop(nextHop(ip)));
+        }
+        ASSERT_TRUE(gNeighOrch->disableNeighbors(neighbors));
+
+        ASSERT_TRUE(gNeighOrch->enableNeighbors(neighbors));
+        for (const auto &ip : { "10.0.0.2", "10.0.0.3" })
+        {
+            EXPECT_TRUE(gNeighOrch->isHwConfigured(NeighborEntry(IpAddress(ip), m_alias)));
+            EXPECT_TRUE(isResolved(ip));
+            EXPECT_EQ(gNeighOrch->getNextHopRefCount(nextHop(ip)), 0);
+        }
+        EXPECT_FALSE(gNeighOrch->hasNextHop(nextHop("10.0.0.9")));
+        ASSERT_TRUE(gNeighOrch->enableNeighbors(neighbors));
+    }
+
+    /*
+     * The routes and next hop group members of the neighbors of a MUX cable
+     * are moved with one call for all of them, each call returning what it
+     * did per next hop for the caller to update the next hop ref counts.
+     */
+    TEST_F(NeighOrchTest, NextHopRoutesAndGroups)
+    {
+        addNeighbors({ "10.0.0.2", "10.0.0.3", "10.0.0.4" });
+
+        addRoute("10.1.0.0/16", "10.0.0.2", m_alias);
+        addRoute("10.2.0.0/16", "10.0.0.2", m_alias);
+        addRoute("10.3.0.0/16", "10.0.0.3", m_alias);
+        addRoute("10.4.0.0/16", "10.0.0.2,10.0.0.3", m_alias + "," + m_alias);
+
+        auto nh2 = nextHop("10.0.0.2");
+        auto nh3 = nextHop("10.0.0.3");
+        auto nh4 = nextHop("10.0.0.4");
+        vector<NextHopKey> nexthops = { nh2, nh3, nh4 };
+
+        // Routes, plus the member of the ECMP group
+        int refs2 = gNeighOrch->getNextHopRefCount(nh2);
+        int refs3 = gNeighOrch->getNextHopRefCount(nh3);
+        ASSERT_EQ(refs2, 3);
+        ASSERT_EQ(refs3, 2);
+        ASSERT_EQ(gNeighOrch->getNextHopRefCount(nh4), 0);
+
+        // Routes of the ECMP group are left to the group
+        map<NextHopKey, uint32_t> counts;
+        ASSERT_TRUE(gRouteOrch->updateNextHopRoutes(nexthops, counts));
+        EXPECT_EQ(counts, (map<NextHopKey, uint32_t>{ { nh2, 2 }, { nh3, 1 } }));
+
+        ASSERT_TRUE(gRouteOrch->invalidnexthopsinNextHopGroup(nexthops, counts));
+        EXPECT_EQ(counts, (map<NextHopKey, uint32_t>{ { nh2, 1 }, { nh3, 1 } }));
+        for (const auto &it : counts)
+        {
+            gNeighOrch->decreaseNextHopRefCount(it.first, it.second);
+        }
+        EXPECT_EQ(gNeighOrch->getNextHopRefCount(nh2), refs2 - 1);
+        EXPECT_EQ(gNeighOrch->getNextHopRefCount(nh3), refs3 - 1);
+
+        ASSERT_TRUE(gRouteOrch->validnexthopsinNextHopGroup(nexthops, counts));
+        EXPECT_EQ(counts, (map<NextHopKey, uint32_t>{ { nh2, 1 }, { nh3, 1 } }));
+        for (const auto &it : counts)
+        {
+            gNeighOrch->increaseNextHopRefCount(it.first, it.second);
+        }
+        EXPECT_EQ(gNeighOrch->getNextHopRefCount(nh2), refs2);
+        EXPECT_EQ(gNeighOrch->getNextHopRefCount(nh3), refs3);
+        EXPECT_EQ(gNeighOrch->getNextHopRefCount(nh4), 0);
+
+        // Next hops still referenced are not removed from the ASIC
+        ASSERT_FALSE(gNeighOrch->disableNeighbors({ NeighborEntry(IpAddress("10.0.0.2"), m_alias) }));
+        EXPECT_TRUE(gNeighOrch->hasNextHop(nh2));
+    }
+}
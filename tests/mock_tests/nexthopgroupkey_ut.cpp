@@ -0,0 +1,159 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+
+#include <unordered_set>
+#include <thread>
+
+namespace nexthopgroupkey_test
+{
+    using namespace std;
+
+    /* Next hops carry the alias, gIntfsOrch is not needed to resolve them */
+    string nexthops(const vector<int> &hosts)
+    {
+        string s;
+        for (auto host : hosts)
+        {
+            if (!s.empty())
+            {
+                s += NHG_DELIMITER;
+            }
+            s += "10.0.0." + to_string(host) + "@Ethernet" + to_string(host * 4);
+        }
+        return s;
+    }
+
+    TEST(NextHopGroupKey, OrderIndependent)
+    {
+        NextHopGroupKey a(nexthops({ 1, 2, 3 }));
+        NextHopGroupKey b(nexthops({ 3, 1, 2 }));
+        NextHopGroupKey c(nexthops({ 1, 2 }));
+
+        ASSERT_EQ(a, b);
+        ASSERT_EQ(a.getHash(), b.getHash());
+        ASSERT_NE(a, c);
+        ASSERT_TRUE(c < a);
+        ASSERT_FALSE(a < b || b < a);
+
+        /* String form is in NextHopKey order whatever the insertion order */
+        ASSERT_EQ(b.to_string(), nexthops({ 1, 2, 3 }));
+
+        unordered_set<NextHopGroupKey> groups{ a, b, c };
+        ASSERT_EQ(groups.size(), 2);
+
+        /* Ordered as sets of next hops, whatever their size */
+        NextHopGroupKey d(nexthops({ 2 }));
+        ASSERT_TRUE(a < d);
+        ASSERT_FALSE(d < c);
+        ASSERT_TRUE(set<NextHopKey>(a.getNextHops()) < set<NextHopKey>(d.getNextHops()));
+    }
+
+    TEST(NextHopGroupKey, ReleasedWithTheLastGroup)
+    {
+        NextHopKeyTable &table = NextHopKeyTable::getInstance();
+        size_t interned = table.size();
+
+        {
+            NextHopGroupKey a(nexthops({ 101, 102 }));
+            ASSERT_EQ(table.size(), interned + 2);
+
+            NextHopGroupKey b = a;
+            NextHopGroupKey c(nexthops({ 102, 103 }));
+            ASSERT_EQ(table.size(), interned + 3);
+
+            a.remove("10.0.0.101@Ethernet404");
+            ASSERT_EQ(table.size(), interned + 3);
+            b.clear();
+            ASSERT_EQ(table.size(), interned + 2);
+
+            b = std::move(c);
+            ASSERT_EQ(table.size(), interned + 2);
+            ASSERT_EQ(b, NextHopGroupKey(nexthops({ 102, 103 })));
+        }
+        ASSERT_EQ(table.size(), interned);
+    }
+
+    TEST(NextHopGroupKey, ConcurrentGroups)
+    {
+        NextHopKeyTable &table = NextHopKeyTable::getInstance();
+        size_t interned = table.size();
+
+        auto churn = [](int base) {
+            for (int i = 0; i < 1000; i++)
+            {
+                NextHopGroupKey nhg(nexthops({ 200 + i % 8, 200 + (i + base) % 8 }));
+                NextHopGroupKey copy = nhg;
+                copy.add("10.0.0.250@Ethernet1000");
+                EXPECT_TRUE(copy.contains(nhg));
+            }
+        };
+
+        thread first(churn, 1);
+        thread second(churn, 3);
+        churn(5);
+        first.join();
+        second.join();
+
+        ASSERT_EQ(table.size(), interned);
+    }
+
+    TEST(NextHopGroupKey, ContainsAndNextHops)
+    {
+        NextHopGroupKey nhg(nexthops({ 2, 4 }));
+
+        ASSERT_TRUE(nhg.contains("10.0.0.2", "Ethernet8"));
+        ASSERT_TRUE(nhg.contains(NextHopKey("10.0.0.4@Ethernet16")));
+        ASSERT_FALSE(nhg.contains("10.0.0.2", "Ethernet0"));
+        /* Looking up a next hop never seen before does not intern it */
+        size_t interned = NextHopKeyTable::getInstance().size();
+        ASSERT_FALSE(nhg.contains("10.0.0.250", "Ethernet1000"));
+        ASSERT_EQ(NextHopKeyTable::getInstance().size(), interned);
+
+        ASSERT_TRUE(NextHopGroupKey(nexthops({ 1, 2, 4 })).contains(nhg));
+        ASSERT_FALSE(nhg.contains(NextHopGroupKey(nexthops({ 1, 2 }))));
+
+        auto nhs = nhg.getNextHops();
+        ASSERT_EQ(nhs.size(), 2);
+        ASSERT_EQ(nhs.count(NextHopKey("10.0.0.2@Ethernet8")), 1);
+        ASSERT_EQ(nhs.begin()->alias, "Ethernet8");
+
+        set<NextHopKey> nhset = nhg.getNextHops();
+        ASSERT_EQ(nhset, (set<NextHopKey>{ NextHopKey("10.0.0.2@Ethernet8"), NextHopKey("10.0.0.4@Ethernet16") }));
+    }
+
+    TEST(NextHopGroupKey, AddRemoveBeyondInline)
+    {
+        const size_t count = NextHopIdList::inline_capacity + 2;
+
+        NextHopGroupKey nhg;
+        for (size_t i = count; i > 0; i--)
+        {
+            nhg.add("10.0.0." + to_string(i), "Ethernet" + to_string(i * 4));
+            /* Adding a next hop twice does not change the group */
+            nhg.add("10.0.0." + to_string(i), "Ethernet" + to_string(i * 4));
+        }
+        ASSERT_EQ(nhg.getSize(), count);
+
+        vector<int> hosts;
+        for (size_t i = 1; i <= count; i++)
+        {
+            hosts.push_back(static_cast<int>(i));
+        }
+        ASSERT_EQ(nhg, NextHopGroupKey(nexthops(hosts)));
+        ASSERT_EQ(nhg.to_string(), nexthops(hosts));
+
+        /* Shrink back to inline storage */
+        nhg.remove("10.0.0.1", "Ethernet4");
+        nhg.remove("10.0.0.3@Ethernet12");
+        nhg.remove(NextHopKey("10.0.0.5@Ethernet20"));
+        nhg.remove("10.0.0.5", "Ethernet20");
+        ASSERT_EQ(nhg.getSize(), count - 3);
+        ASSERT_EQ(nhg, NextHopGroupKey(nexthops({ 2, 4, 6 })));
+        ASSERT_EQ(nhg.getHash(), NextHopGroupKey(nexthops({ 6, 4, 2 })).getHash());
+
+        nhg.clear();
+        ASSERT_EQ(nhg.getSize(), 0);
+        ASSERT_EQ(nhg, NextHopGroupKey());
+        ASSERT_EQ(nhg.to_string(), "");
+    }
+}
@@ -0,0 +1,137 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "orchscheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace orchscheduler_test
+{
+    using namespace std;
+    using namespace swss;
+
+    /* Orch counting the expirations of a 5ms timer */
+    class TimerOrch : public Orch
+    {
+    public:
+        TimerOrch() :
+            Orch(vector<TableConnector>{})
+        {
+            auto interv = timespec { .tv_sec = 0, .tv_nsec = 5 * 1000 * 1000 };
+            auto timer = new SelectableTimer(interv);
+            auto executor = new ExecutableTimer(timer, this, "TIMER_ORCH_TIMER");
+            Orch::addExecutor(executor);
+            timer->start();
+        }
+
+        void doTask(Consumer &consumer) override { }
+
+        void doTask(SelectableTimer &timer) override
+        {
+            events++;
+        }
+
+        atomic<uint64_t> events{ 0 };
+    };
+
+    template <typename Pred>
+    bool waitFor(Pred pred)
+    {
+        for (int i = 0; i < 500; i++)
+        {
+            if (pred())
+            {
+                return true;
+            }
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    TEST(OrchScheduler, AssignAndDependencies)
+    {
+        OrchScheduler scheduler;
+        TimerOrch orch;
+        TimerOrch dependency;
+
+        ASSERT_FALSE(scheduler.hasWorkers());
+        ASSERT_THROW(scheduler.addDependency(&orch, &dependency), runtime_error);
+
+        scheduler.assign(&orch, "worker");
+        scheduler.addDependency(&orch, &dependency);
+        ASSERT_TRUE(scheduler.hasWorkers());
+        ASSERT_TRUE(scheduler.isAssigned(&orch));
+        ASSERT_FALSE(scheduler.isAssigned(&dependency));
+        ASSERT_THROW(scheduler.assign(&orch, "other"), runtime_error);
+
+        auto stats = scheduler.getStats();
+        ASSERT_EQ(stats.size(), 1);
+        ASSERT_EQ(stats[0].name, "worker");
+        ASSERT_EQ(stats[0].orchs, 1);
+        ASSERT_EQ(stats[0].events, 0);
+    }
+
+    TEST(OrchScheduler, RunsWorkers)
+    {
+        OrchScheduler scheduler;
+        TimerOrch first;
+        TimerOrch second;
+        TimerOrch mainOrch;
+
+        scheduler.assign(&first, "first");
+        scheduler.assign(&second, "second");
+        scheduler.addDependency(&first, &mainOrch);
+        scheduler.start();
+
+        ASSERT_TRUE(waitFor([&]() { return first.events > 2 && second.events > 2; }));
+
+        /* Main thread running its Orchs only keeps out the workers depending on them */
+        scheduler.lockShared();
+        uint64_t firstEvents = first.events;
+        uint64_t secondEvents = second.events;
+        ASSERT_TRUE(waitFor([&]() { return second.events > secondEvents + 2; }));
+        ASSERT_EQ(first.events, firstEvents);
+        scheduler.unlockShared();
+
+        ASSERT_TRUE(waitFor([&]() { return first.events > firstEvents; }));
+
+        /* Main thread reading the state of a worker Orch only keeps out its worker */
+        scheduler.lock(&second);
+        firstEvents = first.events;
+        secondEvents = second.events;
+        ASSERT_TRUE(waitFor([&]() { return first.events > firstEvents + 2; }));
+        ASSERT_EQ(second.events, secondEvents);
+        scheduler.unlock(&second);
+
+        /* Orchs without a guard do not block */
+        TimerOrch unguarded;
+        scheduler.lock(&unguarded);
+        scheduler.unlock(&unguarded);
+
+        ASSERT_TRUE(waitFor([&]() { return second.events > secondEvents; }));
+
+        scheduler.suspend();
+        firstEvents = first.events;
+        this_thread::sleep_for(chrono::milliseconds(50));
+        ASSERT_EQ(first.events, firstEvents);
+        scheduler.resume();
+
+        ASSERT_TRUE(waitFor([&]() { return first.events > firstEvents; }));
+
+        scheduler.stop();
+
+        /* The timer of the main Orch is never selected by a worker */
+        ASSERT_EQ(mainOrch.events, 0);
+
+        auto stats = scheduler.getStats();
+        ASSERT_EQ(stats.size(), 2);
+        for (const auto &worker : stats)
+        {
+            ASSERT_EQ(worker.orchs, 1);
+            ASSERT_EQ(worker.queue_depth, 0);
+            ASSERT_GT(worker.events, 0);
+            ASSERT_GE(worker.total_latency_us, worker.max_latency_us);
+        }
+    }
+}
@@ -592,4 +592,117 @@ namespace portsorch_test
         ASSERT_FALSE(bridgePortCalledBeforeLagMember); // bridge port created on lag before lag member was created
     }
 
+
+    /*
+    * Lookups by port/LAG/VLAN object id and by bridge port id go through secondary
+    * indexes which must follow creation and removal of LAGs, VLANs and bridge ports.
+    */
+    TEST_F(PortsOrchTest, PortLookupByObjectIdFollowsAddAndRemove)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table lagTable = Table(m_app_db.get(), APP_LAG_TABLE_NAME);
+        Table vlanTable = Table(m_app_db.get(), APP_VLAN_TABLE_NAME);
+        Table vlanMemberTable = Table(m_app_db.get(), APP_VLAN_MEMBER_TABLE_NAME);
+
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        const int portsorch_base_pri = 40;
+
+        vector<table_name_with_pri_t> ports_tables = {
+            { APP_PORT_TABLE_NAME, portsorch_base_pri + 5 },
+            { APP_VLAN_TABLE_NAME, portsorch_base_pri + 2 },
+            { APP_VLAN_MEMBER_TABLE_NAME, portsorch_base_pri },
+            { APP_LAG_TABLE_NAME, portsorch_base_pri + 4 },
+            { APP_LAG_MEMBER_TABLE_NAME, portsorch_base_pri }
+        };
+
+        ASSERT_EQ(gPortsOrch, nullptr);
+        gPortsOrch = new PortsOrch(m_app_db.get(), ports_tables, m_chassis_app_db.get());
+        vector<string> buffer_tables = { APP_BUFFER_POOL_TABLE_NAME,
+                                         APP_BUFFER_PROFILE_TABLE_NAME,
+                                         APP_BUFFER_QUEUE_TABLE_NAME,
+                                         APP_BUFFER_PG_TABLE_NAME,
+                                         APP_BUFFER_PORT_INGRESS_PROFILE_LIST_NAME,
+                                         APP_BUFFER_PORT_EGRESS_PROFILE_LIST_NAME };
+
+        ASSERT_EQ(gBufferOrch, nullptr);
+        gBufferOrch = new BufferOrch(m_app_db.get(), m_config_db.get(), m_state_db.get(), buffer_tables);
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { } });
+
+        lagTable.set("PortChannel0001", { {"admin_status", "up"}, {"mtu", "9100"} });
+        vlanTable.set("Vlan5", { {"admin_status", "up"}, {"mtu", "9100"} });
+        vlanMemberTable.set(
+            std::string("Vlan5") + vlanMemberTable.getTableNameSeparator() + std::string("PortChannel0001"),
+            { {"tagging_mode", "untagged"} }
+        );
+
+        gPortsOrch->addExistingData(&portTable);
+        gPortsOrch->addExistingData(&lagTable);
+        gPortsOrch->addExistingData(&vlanTable);
+        gPortsOrch->addExistingData(&vlanMemberTable);
+
+        static_cast<Orch *>(gPortsOrch)->doTask();
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        for (auto &it : gPortsOrch->getAllPorts())
+        {
+            Port &p = it.second;
+            if (p.m_type == Port::PHY)
+            {
+                ASSERT_EQ(gPortsOrch->getPortPtr(p.m_port_id), &p);
+            }
+        }
+
+        Port lag, vlan;
+        ASSERT_TRUE(gPortsOrch->getPort("PortChannel0001", lag));
+        ASSERT_TRUE(gPortsOrch->getPort("Vlan5", vlan));
+        ASSERT_NE(lag.m_bridge_port_id, SAI_NULL_OBJECT_ID);
+
+        Port *lagPtr = gPortsOrch->getPortPtr(lag.m_lag_id);
+        ASSERT_NE(lagPtr, nullptr);
+        ASSERT_EQ(lagPtr->m_alias, "PortChannel0001");
+        ASSERT_EQ(gPortsOrch->getPortPtrByBridgePortId(lag.m_bridge_port_id), lagPtr);
+        ASSERT_EQ(gPortsOrch->getPortPtr(vlan.m_vlan_info.vlan_oid)->m_alias, "Vlan5");
+
+        Port byBridgePort;
+        ASSERT_TRUE(gPortsOrch->getPortByBridgePortId(lag.m_bridge_port_id, byBridgePort));
+        ASSERT_EQ(byBridgePort.m_lag_id, lag.m_lag_id);
+
+        // Ids changed through setPort are re-indexed, unknown ids are not found
+        const sai_object_id_t newBridgePortId = 0xfeedbeef;
+        Port renumbered = lag;
+        renumbered.m_bridge_port_id = newBridgePortId;
+        gPortsOrch->setPort(lag.m_alias, renumbered);
+        ASSERT_EQ(gPortsOrch->getPortPtrByBridgePortId(lag.m_bridge_port_id), nullptr);
+        ASSERT_EQ(gPortsOrch->getPortPtrByBridgePortId(newBridgePortId), lagPtr);
+        gPortsOrch->setPort(lag.m_alias, lag);
+        ASSERT_EQ(gPortsOrch->getPortPtrByBridgePortId(newBridgePortId), nullptr);
+        ASSERT_EQ(gPortsOrch->getPortPtrByBridgePortId(lag.m_bridge_port_id), lagPtr);
+        ASSERT_EQ(gPortsOrch->getPortPtr(SAI_NULL_OBJECT_ID), nullptr);
+        ASSERT_EQ(gPortsOrch->getPortPtrByBridgePortId(SAI_NULL_OBJECT_ID), nullptr);
+
+        // Remove VLAN member, VLAN and LAG, lookups by the old ids must fail
+        auto vlanMemberConsumer = static_cast<Consumer*>(gPortsOrch->getExecutor(APP_VLAN_MEMBER_TABLE_NAME));
+        vlanMemberConsumer->addToSync(KeyOpFieldsValuesTuple("Vlan5:PortChannel0001", DEL_COMMAND, { }));
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(gPortsOrch->getPortPtrByBridgePortId(lag.m_bridge_port_id), nullptr);
+
+        auto vlanConsumer = static_cast<Consumer*>(gPortsOrch->getExecutor(APP_VLAN_TABLE_NAME));
+        vlanConsumer->addToSync(KeyOpFieldsValuesTuple("Vlan5", DEL_COMMAND, { }));
+        auto lagConsumer = static_cast<Consumer*>(gPortsOrch->getExecutor(APP_LAG_TABLE_NAME));
+        lagConsumer->addToSync(KeyOpFieldsValuesTuple("PortChannel0001", DEL_COMMAND, { }));
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(gPortsOrch->getPortPtr(vlan.m_vlan_info.vlan_oid), nullptr);
+        ASSERT_EQ(gPortsOrch->getPortPtr(lag.m_lag_id), nullptr);
+        ASSERT_FALSE(gPortsOrch->getPort(lag.m_lag_id, byBridgePort));
+    }
+
 }
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include "recorder.h"
+#include "recordformat.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+
+namespace recorder_test
+{
+    using namespace std;
+    using namespace swss;
+
+    static string tempFile(const string &name)
+    {
+        string file = "/tmp/recorder_ut_" + to_string(getpid()) + "_" + name;
+        remove(file.c_str());
+        return file;
+    }
+
+    static vector<string> readLines(const string &file)
+    {
+        vector<string> lines;
+        ifstream in(file);
+        string line;
+        while (getline(in, line))
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    static KeyOpFieldsValuesTuple routeTuple(const string &prefix)
+    {
+        return KeyOpFieldsValuesTuple(prefix, SET_COMMAND,
+                { { "nexthop", "10.0.0.1,10.0.0.3" }, { "ifname", "Ethernet0,Ethernet4" } });
+    }
+
+    TEST(SwssRecorder, TextFormat)
+    {
+        string file = tempFile("text");
+        SwssRecorder recorder;
+
+        ASSERT_TRUE(recorder.open(file, SwssRecorder::TEXT));
+        recorder.recordText("recording started");
+        recorder.record("APPL_DB", "ROUTE_TABLE", ":", routeTuple("1.1.1.0/24"));
+        recorder.record("APPL_DB", "ROUTE_TABLE", ":", KeyOpFieldsValuesTuple("1.1.1.0/24", DEL_COMMAND, {}));
+        recorder.close();
+
+        auto lines = readLines(file);
+        ASSERT_EQ(lines.size(), 3);
+
+        /* Same lines as Consumer::dumpTuple() after a getTimestamp() */
+        ASSERT_EQ(lines[0].find("|recording started"), 26);
+        ASSERT_EQ(lines[1].substr(26), "|ROUTE_TABLE:1.1.1.0/24|SET|nexthop:10.0.0.1,10.0.0.3|ifname:Ethernet0,Ethernet4");
+        ASSERT_EQ(lines[2].substr(26), "|ROUTE_TABLE:1.1.1.0/24|DEL");
+
+        remove(file.c_str());
+    }
+
+    TEST(SwssRecorder, BinaryFormat)
+    {
+        string file = tempFile("binary");
+        SwssRecorder recorder(4096);
+
+        /* More records than the ring holds at once */
+        ASSERT_TRUE(recorder.open(file, SwssRecorder::BINARY));
+        for (int i = 0; i < 1000; i++)
+        {
+            recorder.record("APPL_DB", "ROUTE_TABLE", ":", routeTuple(to_string(i) + ".0.0.0/8"));
+            if (i % 10 == 0)
+            {
+                recorder.flush();
+            }
+        }
+        recorder.close();
+
+        /* Appending keeps the file header */
+        ASSERT_TRUE(recorder.open(file, SwssRecorder::BINARY));
+        recorder.recordText("recording started");
+        recorder.close();
+
+        ifstream in(file, ifstream::binary);
+        RecordFileHeader header;
+        ASSERT_TRUE(in.read(reinterpret_cast<char *>(&header), sizeof(header)));
+        ASSERT_TRUE(isRecordFileHeader(header));
+
+        vector<char> buffer;
+        Record record;
+        uint64_t timestamp = 0;
+        size_t count = 0;
+        while (readRecord(in, buffer, record) && record.type == RECORD_TUPLE)
+        {
+            ASSERT_EQ(record.db, "APPL_DB");
+            ASSERT_EQ(record.table, "ROUTE_TABLE");
+            ASSERT_EQ(record.separator, ":");
+            ASSERT_EQ(record.key, to_string(count) + ".0.0.0/8");
+            ASSERT_EQ(record.op, SET_COMMAND);
+            ASSERT_EQ(record.fvs, kfvFieldsValues(routeTuple("")));
+            ASSERT_GE(record.timestamp, timestamp);
+            timestamp = record.timestamp;
+            count++;
+        }
+
+        ASSERT_EQ(recorder.getDropped(), 0);
+        ASSERT_EQ(count, 1000);
+        ASSERT_EQ(record.type, RECORD_TEXT);
+        ASSERT_EQ(record.key, "recording started");
+        ASSERT_FALSE(readRecord(in, buffer, record));
+
+        /* A text file is not appended to as binary */
+        string textFile = tempFile("not_binary");
+        ofstream(textFile) << "2021-01-01.00:00:00.000000|recording started" << endl;
+        ASSERT_FALSE(recorder.open(textFile, SwssRecorder::BINARY));
+
+        remove(file.c_str());
+        remove(textFile.c_str());
+    }
+
+    TEST(SwssRecorder, DropsWhenFull)
+    {
+        string file = tempFile("drops");
+        SwssRecorder recorder(64);
+
+        ASSERT_TRUE(recorder.open(file, SwssRecorder::TEXT));
+
+        /* Larger than the whole ring */
+        recorder.record("APPL_DB", "ROUTE_TABLE", ":", routeTuple("1.1.1.0/24"));
+        ASSERT_EQ(recorder.getDropped(), 1);
+        recorder.close();
+
+        auto lines = readLines(file);
+        ASSERT_EQ(lines.size(), 1);
+        ASSERT_EQ(lines[0].substr(26), "|1 records dropped");
+
+        remove(file.c_str());
+    }
+
+    TEST(SwssRecorder, Rotate)
+    {
+        string file = tempFile("rotate");
+        string rotated = file + ".1";
+        SwssRecorder recorder;
+
+        ASSERT_TRUE(recorder.open(file, SwssRecorder::TEXT));
+        recorder.recordText("before");
+        recorder.flush();
+
+        ASSERT_EQ(rename(file.c_str(), rotated.c_str()), 0);
+        recorder.rotate();
+        recorder.flush();
+        recorder.recordText("after");
+        recorder.close();
+
+        auto before = readLines(rotated);
+        auto after = readLines(file);
+        ASSERT_EQ(before.size(), 1);
+        ASSERT_EQ(before[0].substr(26), "|before");
+        ASSERT_EQ(after.size(), 1);
+        ASSERT_EQ(after[0].substr(26), "|after");
+
+        remove(file.c_str());
+        remove(rotated.c_str());
+    }
+}
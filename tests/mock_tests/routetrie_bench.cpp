@@ -0,0 +1,169 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "routetrie.h"
+
+#include <map>
+#include <random>
+#include <chrono>
+#include <iostream>
+
+/*
+ * Microbenchmarks, built on demand with "make benchmarks" and not run by
+ * "make check": timings depend on the machine and only compare implementations.
+ */
+namespace routetrie_bench
+{
+    using namespace std;
+
+    /* Allocator counting the bytes held by the std::map baseline */
+    size_t g_mapBytes = 0;
+
+    template <typename T>
+    struct CountingAllocator
+    {
+        typedef T value_type;
+
+        CountingAllocator() = default;
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U> &) { }
+
+        T *allocate(size_t n)
+        {
+            g_mapBytes += n * sizeof(T);
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t n)
+        {
+            g_mapBytes -= n * sizeof(T);
+            ::operator delete(p);
+        }
+
+        template <typename U>
+        bool operator==(const CountingAllocator<U> &) const { return true; }
+        template <typename U>
+        bool operator!=(const CountingAllocator<U> &) const { return false; }
+    };
+
+    /* RouteTable as it was before the trie, kept as benchmark baseline */
+    typedef map<IpPrefix, NextHopGroupKey, less<IpPrefix>,
+                CountingAllocator<pair<const IpPrefix, NextHopGroupKey>>> LegacyRouteTable;
+
+    IpPrefix v4Prefix(uint32_t addr, int len)
+    {
+        ip_addr_t ip;
+        ip.family = AF_INET;
+        ip.ip_addr.ipv4_addr = htonl(len ? addr & (UINT32_MAX << (32 - len)) : 0);
+        return IpPrefix(ip, len);
+    }
+
+    IpPrefix v6Prefix(uint64_t hi, int len)
+    {
+        ip_addr_t ip;
+        ip.family = AF_INET6;
+        memset(ip.ip_addr.ipv6_addr, 0, sizeof(ip.ip_addr.ipv6_addr));
+        uint64_t masked = len ? hi & (UINT64_MAX << (64 - min(len, 64))) : 0;
+        for (int i = 0; i < 8; i++)
+        {
+            ip.ip_addr.ipv6_addr[i] = static_cast<uint8_t>(masked >> (56 - 8 * i));
+        }
+        return IpPrefix(ip, len);
+    }
+
+    NextHopGroupKey nextHopGroup(size_t i)
+    {
+        NextHopGroupKey nhg;
+        nhg.add("10.0.0." + to_string(i % 64 + 1), "Ethernet" + to_string((i % 64) * 4));
+        if (i % 3 == 0)
+        {
+            nhg.add("10.0.1." + to_string(i % 32 + 1), "Ethernet" + to_string((i % 32) * 4 + 256));
+        }
+        return nhg;
+    }
+
+    TEST(RouteTableBench, Scale)
+    {
+        const size_t v4Routes = 1000000;
+        const size_t v6Routes = 200000;
+
+        mt19937 rng(2);
+        vector<IpPrefix> prefixes;
+        prefixes.reserve(v4Routes + v6Routes);
+        for (size_t i = 0; i < v4Routes; i++)
+        {
+            /* Internet like mix, mostly /24 */
+            int len = (i % 10 == 0) ? 16 + static_cast<int>(rng() % 8) : 24;
+            prefixes.push_back(v4Prefix(static_cast<uint32_t>(rng()), len));
+        }
+        for (size_t i = 0; i < v6Routes; i++)
+        {
+            int len = (i % 10 == 0) ? 32 + static_cast<int>(rng() % 16) : 48;
+            uint64_t hi = (0x2000ULL << 48) | (static_cast<uint64_t>(rng()) << 16);
+            prefixes.push_back(v6Prefix(hi, len));
+        }
+
+        vector<NextHopGroupKey> groups;
+        for (size_t i = 0; i < 256; i++)
+        {
+            groups.push_back(nextHopGroup(i));
+        }
+
+        g_mapBytes = 0;
+        LegacyRouteTable legacy;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < prefixes.size(); i++)
+        {
+            legacy[prefixes[i]] = groups[i % groups.size()];
+        }
+        auto legacyTime = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+
+        RouteTable table;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < prefixes.size(); i++)
+        {
+            table.set(prefixes[i], groups[i % groups.size()]);
+        }
+        auto trieTime = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start);
+
+        ASSERT_EQ(table.size(), legacy.size());
+
+        /* Observer attach: every route covering an address, by scan against by trie walk */
+        vector<IpAddress> addrs;
+        for (size_t i = 0; i < 1000; i++)
+        {
+            addrs.push_back(prefixes[rng() % prefixes.size()].getIp());
+        }
+
+        const size_t scans = 10;
+        size_t scanMatches = 0;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < scans; i++)
+        {
+            for (const auto &route : legacy)
+            {
+                scanMatches += route.first.isAddressInSubnet(addrs[i]);
+            }
+        }
+        auto scanTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+        size_t trieMatches = 0;
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < addrs.size(); i++)
+        {
+            table.forEachCovering(addrs[i], [&](const IpPrefix &, const NextHopGroupKey &) {
+                trieMatches += (i < scans);
+            });
+        }
+        auto walkTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+        cout << "RouteTable with " << v4Routes << " IPv4 and " << v6Routes << " IPv6 routes:" << endl
+             << "  memory: std::map " << g_mapBytes / (1024 * 1024) << "MB, trie "
+             << table.memoryUsage() / (1024 * 1024) << "MB" << endl
+             << "  insert: std::map " << legacyTime.count() << "ms, trie " << trieTime.count() << "ms" << endl
+             << "  covering routes lookup: scan " << scanTime.count() / scans << "us, trie "
+             << walkTime.count() / addrs.size() << "us" << endl;
+
+        ASSERT_EQ(trieMatches, scanMatches);
+        ASSERT_LT(table.memoryUsage() * 2, g_mapBytes);
+    }
+}
@@ -0,0 +1,301 @@
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "routetrie.h"
+
+#include <map>
+#include <random>
+
+namespace routetrie_test
+{
+    using namespace std;
+
+    /* Allocator counting the bytes held by the std::map baseline */
+    size_t g_mapBytes = 0;
+
+    template <typename T>
+    struct CountingAllocator
+    {
+        typedef T value_type;
+
+        CountingAllocator() = default;
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U> &) { }
+
+        T *allocate(size_t n)
+        {
+            g_mapBytes += n * sizeof(T);
+            return static_cast<T *>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T *p, size_t n)
+        {
+            g_mapBytes -= n * sizeof(T);
+            ::operator delete(p);
+        }
+
+        template <typename U>
+        bool operator==(const CountingAllocator<U> &) const { return true; }
+        template <typename U>
+        bool operator!=(const CountingAllocator<U> &) const { return false; }
+    };
+
+    /* RouteTable as it was before the trie, kept as reference */
+    typedef map<IpPrefix, NextHopGroupKey, less<IpPrefix>,
+                CountingAllocator<pair<const IpPrefix, NextHopGroupKey>>> LegacyRouteTable;
+
+    IpPrefix v4Prefix(uint32_t addr, int len)
+    {
+        ip_addr_t ip;
+        ip.family = AF_INET;
+        ip.ip_addr.ipv4_addr = htonl(len ? addr & (UINT32_MAX << (32 - len)) : 0);
+        return IpPrefix(ip, len);
+    }
+
+    IpPrefix v6Prefix(uint64_t hi, int len)
+    {
+        ip_addr_t ip;
+        ip.family = AF_INET6;
+        memset(ip.ip_addr.ipv6_addr, 0, sizeof(ip.ip_addr.ipv6_addr));
+        uint64_t masked = len ? hi & (UINT64_MAX << (64 - min(len, 64))) : 0;
+        for (int i = 0; i < 8; i++)
+        {
+            ip.ip_addr.ipv6_addr[i] = static_cast<uint8_t>(masked >> (56 - 8 * i));
+        }
+        return IpPrefix(ip, len);
+    }
+
+    NextHopGroupKey nextHopGroup(size_t i)
+    {
+        NextHopGroupKey nhg;
+        nhg.add("10.0.0." + to_string(i % 64 + 1), "Ethernet" + to_string((i % 64) * 4));
+        if (i % 3 == 0)
+        {
+            nhg.add("10.0.1." + to_string(i % 32 + 1), "Ethernet" + to_string((i % 32) * 4 + 256));
+        }
+        return nhg;
+    }
+
+    map<IpPrefix, NextHopGroupKey> dump(const RouteTable &table)
+    {
+        map<IpPrefix, NextHopGroupKey> routes;
+        table.forEach([&](const IpPrefix &prefix, const NextHopGroupKey &nexthops) {
+            EXPECT_TRUE(routes.emplace(prefix, nexthops).second);
+        });
+        return routes;
+    }
+
+    TEST(RouteTable, SetFindErase)
+    {
+        RouteTable table;
+        IpPrefix p8("10.0.0.0/8");
+        IpPrefix p24("10.1.2.0/24");
+        IpPrefix p32("10.1.2.3/32");
+        IpPrefix v6("fc00::/64");
+        IpPrefix def("0.0.0.0/0");
+
+        table.set(def, NextHopGroupKey());
+        table.set(p24, nextHopGroup(1));
+        table.set(p8, nextHopGroup(2));
+        table.set(p32, nextHopGroup(1));
+        table.set(v6, nextHopGroup(3));
+        ASSERT_EQ(table.size(), 5);
+
+        ASSERT_EQ(*table.find(p24), nextHopGroup(1));
+        ASSERT_EQ(*table.find(p8), nextHopGroup(2));
+        ASSERT_EQ(table.find(def)->getSize(), 0);
+        ASSERT_TRUE(table.find(IpPrefix("10.1.0.0/16")) == nullptr);
+        ASSERT_TRUE(table.find(IpPrefix("fc00::/48")) == nullptr);
+        ASSERT_FALSE(table.contains(IpPrefix("10.1.2.0/25")));
+
+        /* Overwrite keeps the size */
+        table.set(p24, nextHopGroup(2));
+        ASSERT_EQ(table.size(), 5);
+        ASSERT_EQ(*table.find(p24), nextHopGroup(2));
+
+        /* Longest prefix match comes last */
+        vector<IpPrefix> covering;
+        table.forEachCovering(IpAddress("10.1.2.3"), [&](const IpPrefix &prefix, const NextHopGroupKey &) {
+            covering.push_back(prefix);
+        });
+        ASSERT_EQ(covering, (vector<IpPrefix>{ def, p8, p24, p32 }));
+
+        ASSERT_TRUE(table.erase(p24));
+        ASSERT_FALSE(table.erase(p24));
+        ASSERT_FALSE(table.erase(IpPrefix("10.1.0.0/16")));
+        ASSERT_TRUE(table.contains(p32));
+        ASSERT_TRUE(table.contains(p8));
+
+        covering.clear();
+        table.forEachCovering(IpAddress("10.1.2.4"), [&](const IpPrefix &prefix, const NextHopGroupKey &) {
+            covering.push_back(prefix);
+        });
+        ASSERT_EQ(covering, (vector<IpPrefix>{ def, p8 }));
+
+        ASSERT_TRUE(table.erase(p32));
+        ASSERT_TRUE(table.erase(p8));
+        ASSERT_TRUE(table.erase(v6));
+        ASSERT_EQ(table.size(), 1);
+        ASSERT_EQ(dump(table), (map<IpPrefix, NextHopGroupKey>{ { def, NextHopGroupKey() } }));
+    }
+
+    TEST(RouteTable, MatchesMap)
+    {
+        mt19937 rng(1);
+        RouteTable table;
+        map<IpPrefix, NextHopGroupKey> reference;
+
+        /* Nested and overlapping prefixes under a few /8s */
+        auto randomPrefix = [&rng]() {
+            if (rng() % 4 == 0)
+            {
+                uint64_t hi = (0xfc00ULL << 48) | ((rng() % 16ULL) << 40) | ((rng() % 256ULL) << 32);
+                return v6Prefix(hi, static_cast<int>(rng() % 65));
+            }
+            uint32_t addr = static_cast<uint32_t>(((10 + rng() % 3) << 24) | (rng() & 0x0f0fff));
+            return v4Prefix(addr, static_cast<int>(rng() % 33));
+        };
+
+        for (int i = 0; i < 20000; i++)
+        {
+            IpPrefix prefix = randomPrefix();
+            if (rng() % 3 == 0)
+            {
+                ASSERT_EQ(table.erase(prefix), reference.erase(prefix) == 1);
+            }
+            else
+            {
+                auto nhg = nextHopGroup(rng() % 100);
+                table.set(prefix, nhg);
+                reference[prefix] = nhg;
+            }
+            ASSERT_EQ(table.size(), reference.size());
+        }
+
+        ASSERT_EQ(dump(table), reference);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            IpAddress addr = randomPrefix().getIp();
+            vector<IpPrefix> expected;
+            for (const auto &route : reference)
+            {
+                if (route.first.isAddressInSubnet(addr))
+                {
+                    expected.push_back(route.first);
+                }
+            }
+
+            vector<IpPrefix> covering;
+            table.forEachCovering(addr, [&](const IpPrefix &prefix, const NextHopGroupKey &nexthops) {
+                ASSERT_EQ(nexthops, reference.at(prefix));
+                covering.push_back(prefix);
+            });
+
+            sort(covering.begin(), covering.end());
+            ASSERT_EQ(covering, expected);
+        }
+
+        for (const auto &route : reference)
+        {
+            ASSERT_TRUE(table.erase(route.first));
+        }
+        ASSERT_TRUE(table.empty());
+    }
+
+    TEST(RouteTable, CanonicalPrefixes)
+    {
+        /* Host bits would make two APPL_DB keys share a route */
+        ASSERT_TRUE(RouteTable::isCanonical(IpPrefix("10.0.0.0/24")));
+        ASSERT_TRUE(RouteTable::isCanonical(IpPrefix("10.0.0.1/32")));
+        ASSERT_TRUE(RouteTable::isCanonical(IpPrefix("0.0.0.0/0")));
+        ASSERT_FALSE(RouteTable::isCanonical(IpPrefix("10.0.0.1/24")));
+        ASSERT_TRUE(RouteTable::isCanonical(IpPrefix("2001:db8::/32")));
+        ASSERT_FALSE(RouteTable::isCanonical(IpPrefix("2001:db8::1/64")));
+    }
+
+    TEST(RouteTable, NextHopsFilter)
+    {
+        RouteTable table;
+        NextHopGroupKey single;
+        single.add("10.0.0.1", "Ethernet0");
+        NextHopGroupKey ecmp = single;
+        ecmp.add("10.0.0.2", "Ethernet4");
+
+        table.set(v4Prefix(0x0a010000, 16), single);
+        table.set(v4Prefix(0x0a020000, 16), ecmp);
+        table.set(v6Prefix(0x20010db800000000ULL, 32), single);
+
+        size_t evaluated = 0;
+        map<IpPrefix, NextHopGroupKey> routes;
+        table.forEachWithNextHops(
+            [&](const NextHopGroupKey &nexthops) {
+                evaluated++;
+                return nexthops.getSize() == 1;
+            },
+            [&](const IpPrefix &prefix, const NextHopGroupKey &nexthops) {
+                routes.emplace(prefix, nexthops);
+            });
+
+        /* Once per group, not per route */
+        ASSERT_EQ(evaluated, 2);
+        ASSERT_EQ(routes, (map<IpPrefix, NextHopGroupKey>{
+            { v4Prefix(0x0a010000, 16), single },
+            { v6Prefix(0x20010db800000000ULL, 32), single } }));
+    }
+
+    TEST(RouteTable, Footprint)
+    {
+        const size_t v4Routes = 100000;
+        const size_t v6Routes = 20000;
+
+        mt19937 rng(2);
+        vector<IpPrefix> prefixes;
+        prefixes.reserve(v4Routes + v6Routes);
+        for (size_t i = 0; i < v4Routes; i++)
+        {
+            /* Internet like mix, mostly /24 */
+            int len = (i % 10 == 0) ? 16 + static_cast<int>(rng() % 8) : 24;
+            prefixes.push_back(v4Prefix(static_cast<uint32_t>(rng()), len));
+        }
+        for (size_t i = 0; i < v6Routes; i++)
+        {
+            int len = (i % 10 == 0) ? 32 + static_cast<int>(rng() % 16) : 48;
+            uint64_t hi = (0x2000ULL << 48) | (static_cast<uint64_t>(rng()) << 16);
+            prefixes.push_back(v6Prefix(hi, len));
+        }
+
+        vector<NextHopGroupKey> groups;
+        for (size_t i = 0; i < 256; i++)
+        {
+            groups.push_back(nextHopGroup(i));
+        }
+
+        g_mapBytes = 0;
+        LegacyRouteTable legacy;
+        RouteTable table;
+        for (size_t i = 0; i < prefixes.size(); i++)
+        {
+            legacy[prefixes[i]] = groups[i % groups.size()];
+            table.set(prefixes[i], groups[i % groups.size()]);
+        }
+        ASSERT_EQ(table.size(), legacy.size());
+
+        /* Covering routes by trie walk are the ones found by a scan */
+        for (size_t i = 0; i < 100; i++)
+        {
+            IpAddress addr = prefixes[rng() % prefixes.size()].getIp();
+            size_t scanMatches = 0;
+            for (const auto &route : legacy)
+            {
+                scanMatches += route.first.isAddressInSubnet(addr);
+            }
+            size_t trieMatches = 0;
+            table.forEachCovering(addr, [&](const IpPrefix &, const NextHopGroupKey &) {
+                trieMatches++;
+            });
+            ASSERT_EQ(trieMatches, scanMatches);
+        }
+
+        ASSERT_LT(table.memoryUsage() * 2, g_mapBytes);
+    }
+}
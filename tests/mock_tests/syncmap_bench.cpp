@@ -0,0 +1,127 @@
+#include "gtest/gtest.h"
+#include "syncmap.h"
+
+#include <map>
+#include <deque>
+#include <chrono>
+#include <iostream>
+
+/*
+ * Microbenchmarks, built on demand with "make benchmarks" and not run by
+ * "make check": timings depend on the machine and only compare implementations.
+ */
+namespace syncmap_bench
+{
+    using namespace std;
+    using namespace swss;
+
+    typedef multimap<string, KeyOpFieldsValuesTuple> LegacySyncMap;
+
+    /* Consumer::addToSync as implemented on top of std::multimap, kept as benchmark baseline */
+    void legacyAddToSync(LegacySyncMap &toSync, const KeyOpFieldsValuesTuple &entry)
+    {
+        string key = kfvKey(entry);
+        string op  = kfvOp(entry);
+
+        if (toSync.find(key) == toSync.end())
+        {
+            toSync.emplace(key, entry);
+        }
+        else if (op == DEL_COMMAND)
+        {
+            toSync.erase(key);
+            toSync.emplace(key, entry);
+        }
+        else
+        {
+            auto ret = toSync.equal_range(key);
+            auto iter = ret.first;
+            for (; iter != ret.second; ++iter)
+            {
+                if (kfvOp(iter->second) == SET_COMMAND)
+                    break;
+            }
+            if (iter == ret.second)
+            {
+                toSync.emplace(key, entry);
+            }
+            else
+            {
+                KeyOpFieldsValuesTuple existing_data = iter->second;
+
+                auto new_values = kfvFieldsValues(entry);
+                auto existing_values = kfvFieldsValues(existing_data);
+
+                for (auto it : new_values)
+                {
+                    string field = fvField(it);
+                    string value = fvValue(it);
+
+                    auto iu = existing_values.begin();
+                    while (iu != existing_values.end())
+                    {
+                        if (field == fvField(*iu))
+                            iu = existing_values.erase(iu);
+                        else
+                            iu++;
+                    }
+                    existing_values.push_back(FieldValueTuple(field, value));
+                }
+                iter->second = KeyOpFieldsValuesTuple(key, op, existing_values);
+            }
+        }
+    }
+
+    deque<KeyOpFieldsValuesTuple> routeFlapWorkload(size_t prefixes, size_t flaps)
+    {
+        deque<KeyOpFieldsValuesTuple> entries;
+
+        for (size_t f = 0; f <= flaps; f++)
+        {
+            for (size_t i = 0; i < prefixes; i++)
+            {
+                string key = "10." + to_string((i >> 16) & 0xff) + "." + to_string((i >> 8) & 0xff)
+                             + "." + to_string(i & 0xff) + "/32";
+                string nh = "10.0.0." + to_string(f % 64);
+
+                if (f != 0)
+                {
+                    entries.emplace_back(key, DEL_COMMAND, vector<FieldValueTuple>());
+                }
+                entries.emplace_back(key, SET_COMMAND, vector<FieldValueTuple>{ { "nexthop", nh }, { "ifname", "Ethernet0" } });
+                entries.emplace_back(key, SET_COMMAND, vector<FieldValueTuple>{ { "nexthop", nh + ",10.0.1.1" }, { "ifname", "Ethernet0,Ethernet4" } });
+            }
+        }
+
+        return entries;
+    }
+
+    /* Every prefix flaps (DEL + SET with a new next hop) several times before the consumer drains it */
+    TEST(SyncMapBench, RouteFlap)
+    {
+        const size_t prefixes = 200000;
+        const size_t flaps = 4;
+
+        auto workload = routeFlapWorkload(prefixes, flaps);
+
+        LegacySyncMap legacy;
+        auto start = chrono::steady_clock::now();
+        for (const auto &entry : workload)
+        {
+            legacyAddToSync(legacy, entry);
+        }
+        auto legacyTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+        SyncMap m;
+        start = chrono::steady_clock::now();
+        for (auto &entry : workload)
+        {
+            m.add(move(entry));
+        }
+        auto syncMapTime = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+        ASSERT_EQ(m.size(), legacy.size());
+        cout << "addToSync of " << workload.size() << " route flap entries: multimap "
+             << legacyTime.count() << "us, SyncMap " << syncMapTime.count() << "us" << endl;
+    }
+}
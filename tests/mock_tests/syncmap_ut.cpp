@@ -0,0 +1,201 @@
+#include "gtest/gtest.h"
+#include "syncmap.h"
+
+#include <deque>
+
+namespace syncmap_test
+{
+    using namespace std;
+    using namespace swss;
+
+    /*
+     * Route flap workload: every prefix is set, then flaps (DEL + SET with a
+     * new next hop) several times before the consumer gets to drain it.
+     */
+    deque<KeyOpFieldsValuesTuple> routeFlapWorkload(size_t prefixes, size_t flaps)
+    {
+        deque<KeyOpFieldsValuesTuple> entries;
+
+        for (size_t f = 0; f <= flaps; f++)
+        {
+            for (size_t i = 0; i < prefixes; i++)
+            {
+                string key = "10." + to_string((i >> 16) & 0xff) + "." + to_string((i >> 8) & 0xff)
+                             + "." + to_string(i & 0xff) + "/32";
+                string nh = "10.0.0." + to_string(f % 64);
+
+                if (f != 0)
+                {
+                    entries.emplace_back(key, DEL_COMMAND, vector<FieldValueTuple>());
+                }
+                entries.emplace_back(key, SET_COMMAND, vector<FieldValueTuple>{ { "nexthop", nh }, { "ifname", "Ethernet0" } });
+                entries.emplace_back(key, SET_COMMAND, vector<FieldValueTuple>{ { "nexthop", nh + ",10.0.1.1" }, { "ifname", "Ethernet0,Ethernet4" } });
+            }
+        }
+
+        return entries;
+    }
+
+    KeyOpFieldsValuesTuple makeEntry(const string &key, const string &op, const vector<FieldValueTuple> &fvs)
+    {
+        return KeyOpFieldsValuesTuple(key, op, fvs);
+    }
+
+    TEST(SyncMap, DelThenSetOrder)
+    {
+        SyncMap m;
+
+        m.add(makeEntry("b", SET_COMMAND, { { "f1", "v1" } }));
+        m.add(makeEntry("a", DEL_COMMAND, { }));
+        m.add(makeEntry("a", SET_COMMAND, { { "f1", "v1" } }));
+        m.add(makeEntry("b", DEL_COMMAND, { }));
+
+        ASSERT_EQ(m.size(), 3);
+        ASSERT_EQ(m.count("a"), 2);
+        ASSERT_EQ(m.count("b"), 1);
+
+        /* Keys in arrival order, a DEL of a key overwrites its pending tasks */
+        auto it = m.begin();
+        ASSERT_EQ(it->first, "a");
+        ASSERT_EQ(kfvOp(it->second), DEL_COMMAND);
+        ++it;
+        ASSERT_EQ(it->first, "a");
+        ASSERT_EQ(kfvOp(it->second), SET_COMMAND);
+        ++it;
+        ASSERT_EQ(it->first, "b");
+        ASSERT_EQ(kfvOp(it->second), DEL_COMMAND);
+        ++it;
+        ASSERT_TRUE(it == m.end());
+    }
+
+    TEST(SyncMap, MergeFields)
+    {
+        SyncMap m;
+
+        m.add(makeEntry("k", SET_COMMAND, { { "f1", "v1a" }, { "f2", "v2a" } }));
+        m.add(makeEntry("k", SET_COMMAND, { { "f1", "v1b" }, { "f3", "v3a" }, { "f1", "v1c" } }));
+
+        ASSERT_EQ(m.size(), 1);
+        ASSERT_EQ(m.begin()->second, makeEntry("k", SET_COMMAND, { { "f2", "v2a" }, { "f3", "v3a" }, { "f1", "v1c" } }));
+
+        /* Big field lists take the hashed merge path, result must be the same */
+        vector<FieldValueTuple> oldFvs, newFvs, expFvs;
+        for (int i = 0; i < 32; i++)
+        {
+            oldFvs.emplace_back("f" + to_string(i), "old");
+            if (i % 2)
+            {
+                newFvs.emplace_back("f" + to_string(i), "new");
+            }
+            else
+            {
+                expFvs.emplace_back("f" + to_string(i), "old");
+            }
+        }
+        for (auto &fv : newFvs)
+        {
+            expFvs.push_back(fv);
+        }
+
+        m.add(makeEntry("big", SET_COMMAND, oldFvs));
+        m.add(makeEntry("big", SET_COMMAND, newFvs));
+
+        ASSERT_EQ(m.find("big")->second, makeEntry("big", SET_COMMAND, expFvs));
+    }
+
+    TEST(SyncMap, EraseKeepsIterators)
+    {
+        SyncMap m;
+
+        m.add(makeEntry("a", SET_COMMAND, { { "f", "v" } }));
+        m.add(makeEntry("b", DEL_COMMAND, { }));
+        m.add(makeEntry("b", SET_COMMAND, { { "f", "v" } }));
+        m.add(makeEntry("c", SET_COMMAND, { { "f", "v" } }));
+
+        /* Erase the DEL in front of a SET through a reverse iterator, as NeighOrch does */
+        auto it = m.find("b");
+        ++it;
+        auto rit = make_reverse_iterator(it);
+        while (rit != m.rend() && rit->first == "b" && kfvOp(rit->second) == DEL_COMMAND)
+        {
+            m.erase(next(rit).base());
+        }
+        ASSERT_EQ(m.count("b"), 1);
+        ASSERT_EQ(kfvOp(it->second), SET_COMMAND);
+
+        /* Tasks added while iterating do not invalidate the iterator */
+        it = m.begin();
+        m.add(makeEntry("d", DEL_COMMAND, { }));
+        ASSERT_EQ(it->first, "a");
+
+        size_t erased = 0;
+        while (it != m.end())
+        {
+            m.erase(it++);
+            erased++;
+        }
+        ASSERT_EQ(erased, 4);
+        ASSERT_TRUE(m.empty());
+        ASSERT_TRUE(m.find("a") == m.end());
+    }
+
+    TEST(SyncMap, TakeAndEraseKeepIndex)
+    {
+        SyncMap m, parked;
+
+        parked.add(makeEntry("a", DEL_COMMAND, { }));
+        parked.add(makeEntry("a", SET_COMMAND, { { "f1", "v1" } }));
+        parked.add(makeEntry("b", SET_COMMAND, { { "f1", "v1" } }));
+
+        /* Taken tasks go through the merge rules, the source forgets the key */
+        m.add(makeEntry("a", SET_COMMAND, { { "f2", "v2" } }));
+        ASSERT_EQ(m.take(parked, "a"), 2);
+        ASSERT_EQ(parked.count("a"), 0);
+        ASSERT_EQ(parked.count("b"), 1);
+        ASSERT_EQ(m.count("a"), 2);
+        ASSERT_EQ(m.find("a")->first, "a");
+        ASSERT_EQ(kfvOp(m.find("a")->second), DEL_COMMAND);
+
+        /* Erasing the DEL the index refers to keeps the SET reachable by key */
+        m.erase(m.find("a"));
+        ASSERT_EQ(m.count("a"), 1);
+        ASSERT_EQ(m.find("a")->second, makeEntry("a", SET_COMMAND, { { "f1", "v1" } }));
+
+        /* Erasing by a key owned by the map itself */
+        ASSERT_EQ(m.erase(m.begin()->first), 1);
+        ASSERT_TRUE(m.empty());
+        ASSERT_TRUE(m.find("a") == m.end());
+
+        m.splice(parked);
+        ASSERT_TRUE(parked.empty());
+        ASSERT_EQ(m.find("b")->first, "b");
+    }
+
+    TEST(SyncMap, RouteFlap)
+    {
+        const size_t prefixes = 1000;
+        const size_t flaps = 4;
+
+        SyncMap m;
+        for (auto &entry : routeFlapWorkload(prefixes, flaps))
+        {
+            m.add(move(entry));
+        }
+
+        /* A DEL and a merged SET per prefix, in arrival order of the prefixes */
+        ASSERT_EQ(m.size(), prefixes * 2);
+        auto workload = routeFlapWorkload(prefixes, 0);
+        string nh = "10.0.0." + to_string(flaps % 64);
+        auto it = m.begin();
+        for (size_t i = 0; i < prefixes; i++)
+        {
+            const string &key = kfvKey(workload[i * 2]);
+            ASSERT_EQ(it->first, key);
+            ASSERT_EQ(kfvOp(it->second), DEL_COMMAND);
+            ++it;
+            ASSERT_EQ(it->second, makeEntry(key, SET_COMMAND, { { "nexthop", nh + ",10.0.1.1" }, { "ifname", "Ethernet0,Ethernet4" } }));
+            ++it;
+        }
+        ASSERT_TRUE(it == m.end());
+    }
+}
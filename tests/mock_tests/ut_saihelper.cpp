@@ -74,6 +74,7 @@ namespace ut_helper
         sai_api_query(SAI_API_NEIGHBOR, (void **)&sai_neighbor_api);
         sai_api_query(SAI_API_TUNNEL, (void **)&sai_tunnel_api);
         sai_api_query(SAI_API_NEXT_HOP, (void **)&sai_next_hop_api);
+        sai_api_query(SAI_API_FDB, (void **)&sai_fdb_api);
         sai_api_query(SAI_API_ACL, (void **)&sai_acl_api);
         sai_api_query(SAI_API_HOSTIF, (void **)&sai_hostif_api);
         sai_api_query(SAI_API_BUFFER, (void **)&sai_buffer_api);
@@ -97,6 +98,7 @@ namespace ut_helper
         sai_neighbor_api = nullptr;
         sai_tunnel_api = nullptr;
         sai_next_hop_api = nullptr;
+        sai_fdb_api = nullptr;
         sai_acl_api = nullptr;
         sai_hostif_api = nullptr;
         sai_buffer_api = nullptr;
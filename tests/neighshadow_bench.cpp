@@ -0,0 +1,53 @@
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include "neighsyncd/neighshadow.h"
+
+/*
+ * Microbenchmarks, built on demand with "make benchmarks" and not run by
+ * "make check": timings depend on the machine and only compare implementations.
+ */
+using namespace std;
+using namespace swss;
+
+static NeighShadow::Key ipv4Key(int ifindex, uint32_t ip)
+{
+    uint32_t addr = htonl(ip);
+    return NeighShadow::Key(ifindex, AF_INET, &addr, sizeof(addr));
+}
+
+/*
+ * Replays a refresh storm over 100k neighbors: each of them is learnt, then
+ * refreshed several times with a few MAC moves, and reports the rate.
+ */
+TEST(NeighShadowBench, RefreshStorm)
+{
+    const uint32_t neighbors = 100000;
+    const int rounds = 10;
+    NeighShadow shadow;
+    uint8_t mac[6] = { 0x00, 0x11, 0x22, 0x00, 0x00, 0x00 };
+
+    auto start = chrono::steady_clock::now();
+    size_t published = 0;
+    for (int round = 0; round <= rounds; round++)
+    {
+        for (uint32_t i = 0; i < neighbors; i++)
+        {
+            /* One neighbor in 1000 moves every round */
+            uint32_t id = i % 1000 ? i : i + static_cast<uint32_t>(round);
+            mac[3] = static_cast<uint8_t>(id >> 16);
+            mac[4] = static_cast<uint8_t>(id >> 8);
+            mac[5] = static_cast<uint8_t>(id);
+            published += shadow.set(ipv4Key(1 + static_cast<int>(i % 64), 0x0a000000 + i), mac, sizeof(mac));
+        }
+    }
+    auto usecs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    size_t events = neighbors * (rounds + 1);
+    EXPECT_EQ(published, neighbors + (neighbors / 1000) * rounds);
+    EXPECT_EQ(shadow.getSuppressed(), events - published);
+    cout << "Processed " << events << " neighbor events, " << published << " published, in "
+         << usecs << " us, " << (usecs ? events * 1000000 / static_cast<size_t>(usecs) : 0)
+         << " events/s" << endl;
+}
@@ -0,0 +1,94 @@
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include "neighsyncd/neighshadow.h"
+
+using namespace std;
+using namespace swss;
+
+static NeighShadow::Key ipv4Key(int ifindex, uint32_t ip)
+{
+    uint32_t addr = htonl(ip);
+    return NeighShadow::Key(ifindex, AF_INET, &addr, sizeof(addr));
+}
+
+static const uint8_t MAC1[] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 };
+static const uint8_t MAC2[] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x66 };
+
+TEST(NeighShadow, suppress_refresh)
+{
+    NeighShadow shadow;
+    auto key = ipv4Key(5, 0x0a000001);
+
+    EXPECT_TRUE(shadow.set(key, MAC1, sizeof(MAC1)));
+    EXPECT_FALSE(shadow.set(key, MAC1, sizeof(MAC1)));
+    EXPECT_FALSE(shadow.set(key, MAC1, sizeof(MAC1)));
+
+    /* MAC move */
+    EXPECT_TRUE(shadow.set(key, MAC2, sizeof(MAC2)));
+
+    /* Same IP on another interface, or same address as IPv6 */
+    EXPECT_TRUE(shadow.set(ipv4Key(6, 0x0a000001), MAC2, sizeof(MAC2)));
+    uint32_t addr = htonl(0x0a000001);
+    EXPECT_TRUE(shadow.set(NeighShadow::Key(5, AF_INET6, &addr, sizeof(addr)), MAC2, sizeof(MAC2)));
+
+    EXPECT_EQ(shadow.getPublished(), 4);
+    EXPECT_EQ(shadow.getSuppressed(), 2);
+    EXPECT_EQ(shadow.size(), 3);
+}
+
+TEST(NeighShadow, delete)
+{
+    NeighShadow shadow;
+    auto key = ipv4Key(5, 0x0a000001);
+
+    /* Unknown neighbors are deleted, they may have been published before a restart */
+    EXPECT_TRUE(shadow.del(key, false));
+
+    /* Repeated failures are published once */
+    EXPECT_FALSE(shadow.del(key, false));
+    EXPECT_TRUE(shadow.set(key, MAC1, sizeof(MAC1)));
+    EXPECT_TRUE(shadow.del(key, false));
+    EXPECT_FALSE(shadow.del(key, false));
+
+    /* Removal by the kernel forgets the neighbor */
+    EXPECT_FALSE(shadow.del(key, true));
+    EXPECT_EQ(shadow.size(), 0);
+    EXPECT_TRUE(shadow.del(key, true));
+
+    /* Non Ethernet addresses are not shadowed */
+    uint8_t ipoib[20] = {};
+    EXPECT_TRUE(shadow.set(key, ipoib, sizeof(ipoib)));
+    EXPECT_TRUE(shadow.set(key, ipoib, sizeof(ipoib)));
+    EXPECT_EQ(shadow.size(), 0);
+}
+
+/*
+ * Refresh storm over 10k neighbors: each of them is learnt, then refreshed
+ * several times with a few MAC moves. Only the learns and moves are published.
+ */
+TEST(NeighShadow, refresh_storm)
+{
+    const uint32_t neighbors = 10000;
+    const int rounds = 10;
+    NeighShadow shadow;
+    uint8_t mac[6] = { 0x00, 0x11, 0x22, 0x00, 0x00, 0x00 };
+
+    size_t published = 0;
+    for (int round = 0; round <= rounds; round++)
+    {
+        for (uint32_t i = 0; i < neighbors; i++)
+        {
+            /* One neighbor in 1000 moves every round */
+            uint32_t id = i % 1000 ? i : i + static_cast<uint32_t>(round);
+            mac[3] = static_cast<uint8_t>(id >> 16);
+            mac[4] = static_cast<uint8_t>(id >> 8);
+            mac[5] = static_cast<uint8_t>(id);
+            published += shadow.set(ipv4Key(1 + static_cast<int>(i % 64), 0x0a000000 + i), mac, sizeof(mac));
+        }
+    }
+
+    size_t events = neighbors * (rounds + 1);
+    EXPECT_EQ(published, neighbors + (neighbors / 1000) * rounds);
+    EXPECT_EQ(shadow.getSuppressed(), events - published);
+    EXPECT_EQ(shadow.size(), neighbors);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "fpmsyncd/routecoalescer.h"
+
+using namespace std;
+using namespace swss;
+
+static const vector<FieldValueTuple> NEXTHOP1 = {
+    { "nexthop", "10.0.0.1" },
+    { "ifname", "Ethernet0" }
+};
+
+static const vector<FieldValueTuple> NEXTHOP2 = {
+    { "nexthop", "10.0.0.2" },
+    { "ifname", "Ethernet4" }
+};
+
+static vector<KeyOpFieldsValuesTuple> flush(RouteCoalescer &coalescer, size_t writes)
+{
+    vector<KeyOpFieldsValuesTuple> kfvs;
+    EXPECT_EQ(coalescer.flush(kfvs), writes);
+    EXPECT_EQ(kfvs.size(), writes);
+    EXPECT_EQ(coalescer.getPendingCount(), 0);
+    return kfvs;
+}
+
+TEST(RouteCoalescer, set_set)
+{
+    RouteCoalescer coalescer(nullptr);
+    coalescer.set("10.1.0.0/16", NEXTHOP1);
+    coalescer.set("10.1.0.0/16", NEXTHOP2);
+    EXPECT_EQ(coalescer.getPendingCount(), 1);
+
+    auto kfvs = flush(coalescer, 1);
+    EXPECT_EQ(kfvKey(kfvs[0]), "10.1.0.0/16");
+    EXPECT_EQ(kfvOp(kfvs[0]), SET_COMMAND);
+    EXPECT_EQ(kfvFieldsValues(kfvs[0]), NEXTHOP2);
+}
+
+TEST(RouteCoalescer, set_del)
+{
+    RouteCoalescer coalescer(nullptr);
+    coalescer.set("10.1.0.0/16", NEXTHOP1);
+    coalescer.del("10.1.0.0/16");
+
+    auto kfvs = flush(coalescer, 1);
+    EXPECT_EQ(kfvKey(kfvs[0]), "10.1.0.0/16");
+    EXPECT_EQ(kfvOp(kfvs[0]), DEL_COMMAND);
+    EXPECT_TRUE(kfvFieldsValues(kfvs[0]).empty());
+}
+
+TEST(RouteCoalescer, del_set)
+{
+    RouteCoalescer coalescer(nullptr);
+    coalescer.del("10.1.0.0/16");
+    coalescer.set("10.1.0.0/16", NEXTHOP1);
+    coalescer.set("10.1.0.0/16", NEXTHOP2);
+
+    /* The delete removes the fields of the previous route */
+    auto kfvs = flush(coalescer, 2);
+    EXPECT_EQ(kfvKey(kfvs[0]), "10.1.0.0/16");
+    EXPECT_EQ(kfvOp(kfvs[0]), DEL_COMMAND);
+    EXPECT_EQ(kfvKey(kfvs[1]), "10.1.0.0/16");
+    EXPECT_EQ(kfvOp(kfvs[1]), SET_COMMAND);
+    EXPECT_EQ(kfvFieldsValues(kfvs[1]), NEXTHOP2);
+}
+
+TEST(RouteCoalescer, first_arrival_order)
+{
+    RouteCoalescer coalescer(nullptr);
+    coalescer.set("10.3.0.0/16", NEXTHOP1);
+    coalescer.set("10.1.0.0/16", NEXTHOP1);
+    coalescer.del("10.2.0.0/16");
+    coalescer.set("10.3.0.0/16", NEXTHOP2);
+    coalescer.set("10.2.0.0/16", NEXTHOP2);
+    coalescer.del("10.1.0.0/16");
+
+    auto kfvs = flush(coalescer, 4);
+    vector<pair<string, string>> writes;
+    for (const auto &kfv : kfvs)
+    {
+        writes.emplace_back(kfvKey(kfv), kfvOp(kfv));
+    }
+
+    vector<pair<string, string>> expected = {
+        { "10.3.0.0/16", SET_COMMAND },
+        { "10.1.0.0/16", DEL_COMMAND },
+        { "10.2.0.0/16", DEL_COMMAND },
+        { "10.2.0.0/16", SET_COMMAND }
+    };
+    EXPECT_EQ(writes, expected);
+
+    /* A new batch starts empty, in its own arrival order */
+    coalescer.set("10.1.0.0/16", NEXTHOP1);
+    coalescer.set("10.3.0.0/16", NEXTHOP1);
+
+    kfvs = flush(coalescer, 2);
+    EXPECT_EQ(kfvKey(kfvs[0]), "10.1.0.0/16");
+    EXPECT_EQ(kfvKey(kfvs[1]), "10.3.0.0/16");
+}
+
+TEST(RouteCoalescer, counters)
+{
+    RouteCoalescer coalescer(nullptr);
+    EXPECT_EQ(coalescer.getUpdates(), 0);
+    EXPECT_EQ(coalescer.getSuppressed(), 0);
+
+    coalescer.set("10.1.0.0/16", NEXTHOP1);
+    coalescer.set("10.1.0.0/16", NEXTHOP2);
+    coalescer.del("10.1.0.0/16");
+    coalescer.set("10.2.0.0/16", NEXTHOP1);
+    EXPECT_EQ(coalescer.getUpdates(), 4);
+    EXPECT_EQ(coalescer.getSuppressed(), 2);
+
+    /* The counters add up across batches */
+    flush(coalescer, 2);
+    coalescer.set("10.1.0.0/16", NEXTHOP1);
+    EXPECT_EQ(coalescer.getUpdates(), 5);
+    EXPECT_EQ(coalescer.getSuppressed(), 2);
+
+    coalescer.del("10.1.0.0/16");
+    EXPECT_EQ(coalescer.getUpdates(), 6);
+    EXPECT_EQ(coalescer.getSuppressed(), 3);
+
+    flush(coalescer, 1);
+    flush(coalescer, 0);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "warmrestart/warmRestartDelta.h"
+
+using namespace std;
+using namespace swss;
+
+static const vector<FieldValueTuple> ROUTE = {
+    { "nexthop", "10.1.1.1,10.1.1.2" },
+    { "ifname", "Ethernet0,Ethernet4" }
+};
+
+static vector<KeyOpFieldsValuesTuple> reconcile(WarmStartDelta &delta)
+{
+    vector<KeyOpFieldsValuesTuple> kfvs;
+    delta.reconcile(kfvs);
+    return kfvs;
+}
+
+TEST(WarmStartDelta, digest)
+{
+    auto digest = WarmStartDelta::digestFV(ROUTE);
+
+    /* Order of the fields and of the comma separated values */
+    EXPECT_EQ(WarmStartDelta::digestFV({ { "ifname", "Ethernet0,Ethernet4" },
+                                         { "nexthop", "10.1.1.1,10.1.1.2" } }), digest);
+    EXPECT_EQ(WarmStartDelta::digestFV({ { "ifname", "Ethernet4,Ethernet0" },
+                                         { "nexthop", "10.1.1.2,10.1.1.1" } }), digest);
+
+    /* Different values, or values swapped between fields */
+    EXPECT_NE(WarmStartDelta::digestFV({ { "nexthop", "10.1.1.1,10.1.1.3" },
+                                         { "ifname", "Ethernet0,Ethernet4" } }), digest);
+    EXPECT_NE(WarmStartDelta::digestFV({ { "nexthop", "10.1.1.1" },
+                                         { "ifname", "Ethernet0,Ethernet4" } }), digest);
+    EXPECT_NE(WarmStartDelta::digestFV({ { "nexthop", "Ethernet0,Ethernet4" },
+                                         { "ifname", "10.1.1.1,10.1.1.2" } }), digest);
+    EXPECT_NE(WarmStartDelta::digestFV({ { "a", "x,y" } }), WarmStartDelta::digestFV({ { "a", "xy" } }));
+    EXPECT_NE(WarmStartDelta::digestFV({ { "a", "x" }, { "b", "y" } }),
+              WarmStartDelta::digestFV({ { "a", "y" }, { "b", "x" } }));
+}
+
+TEST(WarmStartDelta, matching_refresh)
+{
+    WarmStartDelta delta;
+    delta.restore("10.0.0.0/24", ROUTE);
+    EXPECT_EQ(delta.restoredCount(), 1);
+
+    delta.refresh(KeyOpFieldsValuesTuple("10.0.0.0/24", SET_COMMAND,
+                                         { { "ifname", "Ethernet4,Ethernet0" },
+                                           { "nexthop", "10.1.1.2,10.1.1.1" } }));
+
+    EXPECT_TRUE(reconcile(delta).empty());
+    EXPECT_EQ(delta.restoredCount(), 0);
+}
+
+TEST(WarmStartDelta, differing_then_matching_refresh)
+{
+    WarmStartDelta delta;
+    delta.restore("10.0.0.0/24", ROUTE);
+
+    delta.refresh(KeyOpFieldsValuesTuple("10.0.0.0/24", SET_COMMAND,
+                                         { { "nexthop", "10.1.1.9" }, { "ifname", "Ethernet0" } }));
+    delta.refresh(KeyOpFieldsValuesTuple("10.0.0.0/24", SET_COMMAND, ROUTE));
+
+    EXPECT_TRUE(reconcile(delta).empty());
+}
+
+TEST(WarmStartDelta, differing_refresh)
+{
+    WarmStartDelta delta;
+    delta.restore("10.0.0.0/24", ROUTE);
+
+    vector<FieldValueTuple> fv = { { "nexthop", "10.1.1.9" }, { "ifname", "Ethernet0" } };
+    delta.refresh(KeyOpFieldsValuesTuple("10.0.0.0/24", SET_COMMAND, fv));
+    delta.refresh(KeyOpFieldsValuesTuple("99.0.0.0/8", SET_COMMAND, fv));
+
+    auto kfvs = reconcile(delta);
+    ASSERT_EQ(kfvs.size(), 2);
+
+    map<string, KeyOpFieldsValuesTuple> writes;
+    for (auto &kfv : kfvs)
+    {
+        writes[kfvKey(kfv)] = kfv;
+    }
+    EXPECT_EQ(kfvOp(writes["10.0.0.0/24"]), SET_COMMAND);
+    EXPECT_EQ(kfvFieldsValues(writes["10.0.0.0/24"]), fv);
+    EXPECT_EQ(kfvOp(writes["99.0.0.0/8"]), SET_COMMAND);
+}
+
+TEST(WarmStartDelta, delete)
+{
+    WarmStartDelta delta;
+    delta.restore("10.0.0.0/24", ROUTE);
+
+    /* Delete of a restored key, and of a key set and deleted during the restart */
+    delta.refresh(KeyOpFieldsValuesTuple("10.0.0.0/24", DEL_COMMAND, {}));
+    delta.refresh(KeyOpFieldsValuesTuple("99.0.0.0/8", SET_COMMAND, ROUTE));
+    delta.refresh(KeyOpFieldsValuesTuple("99.0.0.0/8", DEL_COMMAND, {}));
+
+    auto kfvs = reconcile(delta);
+    ASSERT_EQ(kfvs.size(), 1);
+    EXPECT_EQ(kfvKey(kfvs[0]), "10.0.0.0/24");
+    EXPECT_EQ(kfvOp(kfvs[0]), DEL_COMMAND);
+}
+
+TEST(WarmStartDelta, stale)
+{
+    WarmStartDelta delta;
+    delta.restore("10.0.0.0/24", ROUTE);
+    delta.restore("10.0.1.0/24", ROUTE);
+
+    delta.refresh(KeyOpFieldsValuesTuple("10.0.0.0/24", SET_COMMAND, ROUTE));
+
+    auto kfvs = reconcile(delta);
+    ASSERT_EQ(kfvs.size(), 1);
+    EXPECT_EQ(kfvKey(kfvs[0]), "10.0.1.0/24");
+    EXPECT_EQ(kfvOp(kfvs[0]), DEL_COMMAND);
+}
@@ -0,0 +1,226 @@
+#include "warmRestartDelta.h"
+#include "logger.h"
+
+
+using namespace swss;
+
+
+void WarmStartDelta::clear(void)
+{
+    m_restoredMap.clear();
+    m_refreshMap.clear();
+}
+
+
+void WarmStartDelta::reserve(size_t count)
+{
+    m_restoredMap.reserve(count);
+}
+
+
+void WarmStartDelta::restore(const std::string &key, const std::vector<FieldValueTuple> &fv)
+{
+    m_restoredMap[key] = { digestFV(fv), false };
+}
+
+
+size_t WarmStartDelta::restoredCount(void) const
+{
+    return m_restoredMap.size();
+}
+
+
+/*
+ * Compare the refreshed state with the restored one as it arrives. Entries
+ * refreshed with their restored content need no reconciliation, so they are
+ * not kept.
+ */
+void WarmStartDelta::refresh(const KeyOpFieldsValuesTuple &kfv)
+{
+    const std::string &key = kfvKey(kfv);
+
+    auto restored = m_restoredMap.find(key);
+    if (restored != m_restoredMap.end())
+    {
+        restored->second.refreshed = true;
+
+        if (kfvOp(kfv) == SET_COMMAND &&
+            digestFV(kfvFieldsValues(kfv)) == restored->second.digest)
+        {
+            m_refreshMap.erase(key);
+            return;
+        }
+    }
+
+    m_refreshMap[key] = kfv;
+}
+
+
+/*
+ * In essence, all we are doing is comparing the restored elements (old state)
+ * with the refreshed/new ones generated by the application once it completes
+ * its restart cycle. If a state-diff is found between these two, we will be
+ * honoring the refreshed one received from the application.
+ *
+ * Refreshed entries matching their restored counterpart were already dropped
+ * by refresh(), only the deltas are left.
+ */
+void WarmStartDelta::reconcile(std::vector<KeyOpFieldsValuesTuple> &kfvs)
+{
+    /*
+     * If a restored element has not been refreshed, we must push a delete
+     * operation for this entry.
+     */
+    for (auto &restored : m_restoredMap)
+    {
+        if (!restored.second.refreshed)
+        {
+            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
+                            restored.first.c_str());
+
+            kfvs.emplace_back(restored.first, DEL_COMMAND, std::vector<FieldValueTuple>());
+        }
+    }
+
+    /*
+     * Iterate through all the entries in the refreshMap, which correspond to
+     * updated, deleted or brand-new entries to be pushed down to AppDB.
+     */
+    for (auto &kfv : m_refreshMap)
+    {
+        auto &refreshedKey = kfvKey(kfv.second);
+        auto &refreshedOp  = kfvOp(kfv.second);
+        auto &refreshedFV  = kfvFieldsValues(kfv.second);
+        bool restored      = m_restoredMap.count(refreshedKey) != 0;
+
+        /*
+         * During warm-reboot, apps could receive an 'add' and a 'delete' for an
+         * entry that does not exist in AppDB. In these cases we must prevent the
+         * 'delete' from being pushed down to AppDB, so we are handling this case
+         * differently than the 'add' one.
+         */
+        if (refreshedOp == DEL_COMMAND)
+        {
+            if (restored)
+            {
+                SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
+                                refreshedKey.c_str());
+
+                kfvs.push_back(std::move(kfv.second));
+            }
+            else
+            {
+                SWSS_LOG_NOTICE("Warm-Restart reconciliation: discarding non-existing"
+                                " entry %s\n",
+                                refreshedKey.c_str());
+            }
+        }
+        else
+        {
+            SWSS_LOG_NOTICE("Warm-Restart reconciliation: %s entry %s",
+                            restored ? "updating" : "introducing new",
+                            printKFV(refreshedKey, refreshedFV).c_str());
+
+            kfvs.push_back(std::move(kfv.second));
+        }
+    }
+
+    clear();
+}
+
+
+/*
+ * Mix the bits of a 64 bits hash (splitmix64 finalizer), so that sums of
+ * mixed hashes stay well distributed.
+ */
+static inline uint64_t mixHash(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+
+/* 64 bits FNV-1a hash */
+static inline uint64_t hashBytes(const char *data, size_t len)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+
+/*
+ * Fields, and the comma separated items of a value, are combined by adding
+ * their mixed hashes, so that their order does not change the digest.
+ */
+uint64_t WarmStartDelta::digestFV(const std::vector<FieldValueTuple> &fv)
+{
+    uint64_t digest = mixHash(fv.size());
+
+    for (auto &fieldValue : fv)
+    {
+        const std::string &value = fvValue(fieldValue);
+        uint64_t valueDigest = 0;
+        size_t pos = 0;
+
+        while (true)
+        {
+            size_t end = value.find(',', pos);
+            if (end == std::string::npos)
+            {
+                end = value.size();
+            }
+
+            valueDigest += mixHash(hashBytes(value.data() + pos, end - pos));
+
+            if (end == value.size())
+            {
+                break;
+            }
+            pos = end + 1;
+        }
+
+        const std::string &field = fvField(fieldValue);
+        digest += mixHash(hashBytes(field.data(), field.size()) ^ mixHash(valueDigest + value.size()));
+    }
+
+    return digest;
+}
+
+
+/*
+ * Helper method to print KFVs in a friendly fashion.
+ *
+ * Example:
+ *
+ * 192.168.1.0/30 { nexthop: 10.2.2.1,10.1.2.1 | ifname: Ethernet116,Ethernet112 }
+ */
+const std::string WarmStartDelta::printKFV(const std::string                  &key,
+                                           const std::vector<FieldValueTuple> &fv)
+{
+    std::string res;
+
+    res = key + " { ";
+
+    for (size_t i = 0; i < fv.size(); ++i)
+    {
+        res += fv[i].first + ": " +  fv[i].second;
+
+        if (i != fv.size() - 1)
+        {
+            res += " | ";
+        }
+    }
+
+    res += " } ";
+
+    return res;
+}
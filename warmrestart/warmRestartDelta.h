@@ -0,0 +1,75 @@
+#ifndef __WARMRESTART_DELTA__
+#define __WARMRESTART_DELTA__
+
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "table.h"
+
+
+namespace swss {
+
+
+/*
+ * Restored AppDB state of a warm restarting application, and the refreshed
+ * state differing from it. Only a digest of each restored entry is kept, the
+ * refreshed state is compared with it as it arrives.
+ */
+class WarmStartDelta {
+  public:
+
+    /*
+     * kfvMap type to be utilized to store all the new/refresh state coming
+     * from the restarting applications.
+     */
+    using kfvMap = std::unordered_map<std::string, KeyOpFieldsValuesTuple>;
+
+    /* Restored AppDB entry */
+    struct RestoredEntry
+    {
+        uint64_t digest;
+        bool     refreshed;
+    };
+
+    void clear(void);
+
+    void reserve(size_t count);
+
+    void restore(const std::string &key, const std::vector<FieldValueTuple> &fv);
+
+    size_t restoredCount(void) const;
+
+    void refresh(const KeyOpFieldsValuesTuple &kfv);
+
+    /*
+     * Move the writes reconciling AppDB with the refreshed state to kfvs:
+     * deletes of the restored entries never refreshed, then the refreshed
+     * entries differing from the restored ones. The state is cleared.
+     */
+    void reconcile(std::vector<KeyOpFieldsValuesTuple> &kfvs);
+
+    static const std::string printKFV(const std::string                  &key,
+                                      const std::vector<FieldValueTuple> &fv);
+
+    /*
+     * Digest of field-value-tuples, equal when both fields and values match
+     * regardless of the order of the fields and of comma separated values.
+     *
+     * Example: {nexthop: 10.1.1.1,10.1.1.2 | ifname: eth1,eth2}
+     *          {ifname: eth2,eth1 | nexthop: 10.1.1.2,10.1.1.1}
+     */
+    static uint64_t digestFV(const std::vector<FieldValueTuple> &fv);
+
+  private:
+
+    std::unordered_map<std::string, RestoredEntry>
+                              m_restoredMap;       // buffer struct to hold old state digests
+    kfvMap                    m_refreshMap;        // buffer struct to hold new state differing from old state
+};
+
+
+}
+
+#endif
@@ -1,19 +1,44 @@
 #include <cassert>
 #include <sstream>
+#include <chrono>
+#include <inttypes.h>
+#include <string.h>
+#include <hiredis/hiredis.h>
 
 #include "warmRestartHelper.h"
+#include "redisreply.h"
+#include "schema.h"
 
 
 using namespace swss;
 
 
+/* Entries read from AppDB per pipelined round trip during restoration */
+#define WARM_RESTORE_CHUNK_SIZE    1000
+
+/* Restoration progress is reported to StateDB every that many chunks */
+#define WARM_RESTORE_REPORT_CHUNKS 100
+
+
+static uint64_t elapsedMsecs(std::chrono::steady_clock::time_point start)
+{
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+
 WarmStartHelper::WarmStartHelper(RedisPipeline      *pipeline,
                                  ProducerStateTable *syncTable,
                                  const std::string  &syncTableName,
                                  const std::string  &dockerName,
                                  const std::string  &appName) :
-    m_restorationTable(pipeline, syncTableName, false),
     m_syncTable(syncTable),
+    m_restorationTable(pipeline, syncTableName, false),
+    m_restorationDb(pipeline->getDBConnector()->newConnector(0)),
+    m_stateDb("STATE_DB", 0),
+    m_stateWarmRestartTable(&m_stateDb, STATE_WARM_RESTART_TABLE_NAME),
+    m_state(WarmStart::WSUNKNOWN),
+    m_enabled(false),
     m_syncTableName(syncTableName),
     m_dockName(dockerName),
     m_appName(appName)
@@ -65,8 +90,7 @@ bool WarmStartHelper::checkAndStart(void)
     }
 
     /* Cleaning state from previous (unsuccessful) warm-restart attempts */
-    m_restorationVector.clear();
-    m_refreshMap.clear();
+    m_delta.clear();
 
     /* Keeping track of warm-reboot active/inactive state */
     m_enabled = enabled;
@@ -98,19 +122,44 @@ uint32_t WarmStartHelper::getRestartTimer(void) const
  * are expected to call this method to upload their associated redisDB state into
  * a temporary buffer, which will eventually serve to resolve any conflict between
  * 'old' and 'new' state.
+ *
+ * Entries are read in pipelined chunks, and only a digest of each of them is
+ * kept.
  */
 bool WarmStartHelper::runRestoration()
 {
     SWSS_LOG_NOTICE("Warm-Restart: Initiating AppDB restoration process for %s "
                     "application.", m_appName.c_str());
 
-    m_restorationTable.getContent(m_restorationVector);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::string> keys;
+    m_restorationTable.getKeys(keys);
+
+    m_delta.clear();
+    m_delta.reserve(keys.size());
+
+    for (size_t begin = 0; begin < keys.size(); begin += WARM_RESTORE_CHUNK_SIZE)
+    {
+        restoreChunk(keys, begin, std::min(begin + WARM_RESTORE_CHUNK_SIZE, keys.size()));
+
+        if ((begin / WARM_RESTORE_CHUNK_SIZE + 1) % WARM_RESTORE_REPORT_CHUNKS == 0)
+        {
+            reportStats({ { "restored_entries", std::to_string(m_delta.restoredCount()) },
+                          { "restore_total_entries", std::to_string(keys.size()) } });
+        }
+    }
+
+    uint64_t msecs = elapsedMsecs(start);
+    reportStats({ { "restored_entries", std::to_string(m_delta.restoredCount()) },
+                  { "restore_total_entries", std::to_string(keys.size()) },
+                  { "restore_time_ms", std::to_string(msecs) } });
 
     /*
      * If there's no AppDB state to restore, then alert callee right away to avoid
      * iterating through the 'reconciliation' process.
      */
-    if (!m_restorationVector.size())
+    if (!m_delta.restoredCount())
     {
         SWSS_LOG_NOTICE("Warm-Restart: No records received from AppDB for %s "
                         "application.", m_appName.c_str());
@@ -121,9 +170,9 @@ bool WarmStartHelper::runRestoration()
     }
 
     SWSS_LOG_NOTICE("Warm-Restart: Received %zu records from AppDB for %s "
-                    "application.",
-                    m_restorationVector.size(),
-                    m_appName.c_str());
+                    "application in %" PRIu64 " ms.",
+                    m_delta.restoredCount(),
+                    m_appName.c_str(), msecs);
 
     setState(WarmStart::RESTORED);
 
@@ -134,245 +183,129 @@ bool WarmStartHelper::runRestoration()
 }
 
 
-void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
-{
-    const std::string key = kfvKey(kfv);
-
-    m_refreshMap[key] = kfv;
-}
-
-
 /*
- * The reconciliation process takes place here. In essence, all we are doing
- * is comparing the restored elements (old state) with the refreshed/new ones
- * generated by the application once it completes its restart cycle. If a
- * state-diff is found between these two, we will be honoring the refreshed
- * one received from the application, and will proceed to push it down to AppDB.
+ * Read the entries of keys[begin, end) with one pipelined round trip, and
+ * keep their digests.
  */
-void WarmStartHelper::reconcile(void)
+void WarmStartHelper::restoreChunk(const std::vector<std::string> &keys, size_t begin, size_t end)
 {
-    SWSS_LOG_NOTICE("Warm-Restart: Initiating reconciliation process for %s "
-                    "application.", m_appName.c_str());
-
-    assert(getState() == WarmStart::RESTORED);
+    redisContext *ctx = m_restorationDb->getContext();
 
-    for (auto &restoredElem : m_restorationVector)
+    for (size_t i = begin; i < end; i++)
     {
-        std::string restoredKey  = kfvKey(restoredElem);
-        auto restoredFV          = kfvFieldsValues(restoredElem);
+        std::string key = m_restorationTable.getKeyName(keys[i]);
+        const char *argv[] = { "HGETALL", key.c_str() };
+        size_t argvlen[] = { strlen("HGETALL"), key.size() };
 
-        auto iter = m_refreshMap.find(restoredKey);
-
-        /*
-         * If the restored element is not found in the refreshMap, we must
-         * push a delete operation for this entry.
-         */
-        if (iter == m_refreshMap.end())
+        if (redisAppendCommandArgv(ctx, 2, argv, argvlen) != REDIS_OK)
         {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
-
-            m_syncTable->del(restoredKey);
-            continue;
+            SWSS_LOG_THROW("Warm-Restart: Failed to read %s from AppDB: %s", key.c_str(), ctx->errstr);
         }
+    }
 
-        /*
-         * If an explicit delete request is sent by the application, process it
-         * right away.
-         */
-        else if (kfvOp(iter->second) == DEL_COMMAND)
+    std::vector<FieldValueTuple> fv;
+    for (size_t i = begin; i < end; i++)
+    {
+        redisReply *r = NULL;
+        if (redisGetReply(ctx, reinterpret_cast<void **>(&r)) != REDIS_OK || !r)
         {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
-                            printKFV(restoredKey, restoredFV).c_str());
-
-            m_syncTable->del(restoredKey);
+            SWSS_LOG_THROW("Warm-Restart: Failed to read %s from AppDB: %s", keys[i].c_str(), ctx->errstr);
         }
 
-        /*
-         * If a matching entry is found in refreshMap, proceed to compare it
-         * with its restored counterpart.
-         */
-        else
+        RedisReply reply(r);
+        if (r->type != REDIS_REPLY_ARRAY)
         {
-            auto refreshedKey = kfvKey(iter->second);
-            auto refreshedFV  = kfvFieldsValues(iter->second);
-
-            if (compareAllFV(restoredFV, refreshedFV))
-            {
-                SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
-                                printKFV(refreshedKey, refreshedFV).c_str());
-
-                m_syncTable->set(refreshedKey, refreshedFV);
-            }
-            else
-            {
-                SWSS_LOG_INFO("Warm-Restart reconciliation: no changes needed for "
-                              "existing entry %s",
-                              printKFV(refreshedKey, refreshedFV).c_str());
-            }
+            SWSS_LOG_THROW("Warm-Restart: Unexpected reply type %d for %s", r->type, keys[i].c_str());
         }
 
-        /* Deleting the just-processed restored entry from the refreshMap */
-        m_refreshMap.erase(restoredKey);
-    }
-
-    /*
-     * Iterate through all the entries left in the refreshMap, which correspond
-     * to brand-new entries to be pushed down to AppDB.
-     */
-    for (auto &kfv : m_refreshMap)
-    {
-        auto refreshedKey = kfvKey(kfv.second);
-        auto refreshedOp  = kfvOp(kfv.second);
-        auto refreshedFV  = kfvFieldsValues(kfv.second);
-
-        /*
-         * During warm-reboot, apps could receive an 'add' and a 'delete' for an
-         * entry that does not exist in AppDB. In these cases we must prevent the
-         * 'delete' from being pushed down to AppDB, so we are handling this case
-         * differently than the 'add' one.
-         */
-        if(refreshedOp == DEL_COMMAND)
+        fv.clear();
+        for (size_t j = 0; j + 1 < r->elements; j += 2)
         {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: discarding non-existing"
-                            " entry %s\n",
-                            refreshedKey.c_str());
+            fv.emplace_back(std::string(r->element[j]->str, r->element[j]->len),
+                            std::string(r->element[j + 1]->str, r->element[j + 1]->len));
         }
-        else
-        {
-            SWSS_LOG_NOTICE("Warm-Restart reconciliation: introducing new entry %s",
-                            printKFV(refreshedKey, refreshedFV).c_str());
 
-            m_syncTable->set(refreshedKey, refreshedFV);
+        /* Entry removed since the keys were listed */
+        if (fv.empty())
+        {
+            continue;
         }
-    }
 
-    /* Clearing pending kfv's from refreshMap */
-    m_refreshMap.clear();
-
-    /* Clearing restoration vector */
-    m_restorationVector.clear();
-
-    setState(WarmStart::RECONCILED);
-
-    SWSS_LOG_NOTICE("Warm-Restart: Concluded reconciliation process for %s "
-                    "application.", m_appName.c_str());
+        m_delta.restore(keys[i], fv);
+    }
 }
 
 
 /*
- * Compare all field-value-tuples within two vectors.
- *
- * Example: v1 {nexthop: 10.1.1.1, ifname: eth1}
- *          v2 {nexthop: 10.1.1.2, ifname: eth2}
- *
- * Returns:
- *
- *    'false' : If the content of both 'fields' and 'values' fully match
- *    'true'  : No full-match is found
+ * Refreshed state is compared with the restored one as it arrives, see
+ * WarmStartDelta::refresh().
  */
-bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &v1,
-                                   const std::vector<FieldValueTuple> &v2)
+void WarmStartHelper::insertRefreshMap(const KeyOpFieldsValuesTuple &kfv)
 {
-    std::unordered_map<std::string, std::string> v1Map((v1.begin()), v1.end());
-
-     /* Iterate though all v2 tuples to check if their content match v1 ones */
-    for (auto &v2fv : v2)
-    {
-        auto v1Iter = v1Map.find(v2fv.first);
-        /*
-         * The sizes of both tuple-vectors should always match within any
-         * given application. In other words, all fields within v1 should be
-         * also present in v2.
-         *
-         * To make this possible, every application should continue relying on a
-         * uniform schema to create/generate information. For example, fpmsyncd
-         * will be always expected to push FieldValueTuples with "nexthop" and
-         * "ifname" fields; neighsyncd is expected to make use of "family" and
-         * "neigh" fields, etc. The existing reconciliation logic will rely on
-         * this assumption.
-         */
-        assert(v1Iter != v1Map.end());
-
-        if (compareOneFV(v1Map[fvField(*v1Iter)], fvValue(v2fv)))
-        {
-            return true;
-        }
-    }
-
-    return false;
+    m_delta.refresh(kfv);
 }
 
 
 /*
- * Compare the values of a single field-value within two different KFVs.
- *
- * Example: s1 {nexthop: 10.1.1.1, 10.1.1.2}
- *          s2 {nexthop: 10.1.1.2, 10.1.1.1}
- *
- * Example: s1 {Ethernet1, Ethernet2}
- *          s2 {Ethernet2, Ethernet1}
- *
- * Returns:
+ * The reconciliation process takes place here. In essence, all we are doing
+ * is comparing the restored elements (old state) with the refreshed/new ones
+ * generated by the application once it completes its restart cycle. If a
+ * state-diff is found between these two, we will be honoring the refreshed
+ * one received from the application, and will proceed to push it down to AppDB.
  *
- *    'false' : If the content of both strings fully matches
- *    'true'  : No full-match is found
+ * Refreshed entries matching their restored counterpart were already dropped
+ * by insertRefreshMap(), only the deltas are left to push, see
+ * WarmStartDelta::reconcile().
  */
-bool WarmStartHelper::compareOneFV(const std::string &s1, const std::string &s2)
+void WarmStartHelper::reconcile(void)
 {
-    if (s1.size() != s2.size())
-    {
-        return true;
-    }
+    SWSS_LOG_NOTICE("Warm-Restart: Initiating reconciliation process for %s "
+                    "application.", m_appName.c_str());
 
-    std::vector<std::string> splitValuesS1 = tokenize(s1, ',');
-    std::vector<std::string> splitValuesS2 = tokenize(s2, ',');
+    assert(getState() == WarmStart::RESTORED);
 
-    if (splitValuesS1.size() != splitValuesS2.size())
-    {
-        return true;
-    }
+    auto start = std::chrono::steady_clock::now();
+    size_t sets = 0;
+    size_t dels = 0;
 
-    std::sort(splitValuesS1.begin(), splitValuesS1.end());
-    std::sort(splitValuesS2.begin(), splitValuesS2.end());
+    std::vector<KeyOpFieldsValuesTuple> kfvs;
+    m_delta.reconcile(kfvs);
 
-    for (size_t i = 0; i < splitValuesS1.size(); i++)
+    for (auto &kfv : kfvs)
     {
-        if (splitValuesS1[i] != splitValuesS2[i])
+        if (kfvOp(kfv) == DEL_COMMAND)
         {
-            return true;
+            m_syncTable->del(kfvKey(kfv));
+            dels++;
+        }
+        else
+        {
+            m_syncTable->set(kfvKey(kfv), kfvFieldsValues(kfv));
+            sets++;
         }
     }
 
-    return false;
-}
+    setState(WarmStart::RECONCILED);
 
+    uint64_t msecs = elapsedMsecs(start);
+    reportStats({ { "reconcile_sets", std::to_string(sets) },
+                  { "reconcile_dels", std::to_string(dels) },
+                  { "reconcile_time_ms", std::to_string(msecs) } });
 
-/*
- * Helper method to print KFVs in a friendly fashion.
- *
- * Example:
- *
- * 192.168.1.0/30 { nexthop: 10.2.2.1,10.1.2.1 | ifname: Ethernet116,Ethernet112 }
- */
-const std::string WarmStartHelper::printKFV(const std::string                  &key,
-                                            const std::vector<FieldValueTuple> &fv)
-{
-    std::string res;
+    SWSS_LOG_NOTICE("Warm-Restart: Concluded reconciliation process for %s "
+                    "application in %" PRIu64 " ms, %zu entries set, %zu deleted.",
+                    m_appName.c_str(), msecs, sets, dels);
+}
 
-    res = key + " { ";
 
-    for (size_t i = 0; i < fv.size(); ++i)
-    {
-        res += fv[i].first + ": " +  fv[i].second;
-
-        if (i != fv.size() - 1)
-        {
-            res += " | ";
-        }
-    }
+void WarmStartHelper::reportStats(const std::vector<FieldValueTuple> &fv)
+{
+    m_stateWarmRestartTable.set(m_appName, fv);
+}
 
-    res += " } ";
 
-    return res;
+const std::string WarmStartHelper::printKFV(const std::string                  &key,
+                                            const std::vector<FieldValueTuple> &fv)
+{
+    return WarmStartDelta::printKFV(key, fv);
 }
@@ -4,8 +4,10 @@
 
 #include <vector>
 #include <map>
+#include <memory>
 #include <unordered_map>
 #include <algorithm>
+#include <atomic>
 
 #include "dbconnector.h"
 #include "producerstatetable.h"
@@ -13,6 +15,7 @@
 #include "table.h"
 #include "tokenize.h"
 #include "warm_restart.h"
+#include "warmRestartDelta.h"
 
 
 namespace swss {
@@ -36,7 +39,7 @@ class WarmStartHelper {
      * kfvMap type to be utilized to store all the new/refresh state coming
      * from the restarting applications.
      */
-    using kfvMap = std::unordered_map<std::string, KeyOpFieldsValuesTuple>;
+    using kfvMap = WarmStartDelta::kfvMap;
 
     void setState(WarmStart::WarmStartState state);
 
@@ -61,17 +64,19 @@ class WarmStartHelper {
 
   private:
 
-    bool compareAllFV(const std::vector<FieldValueTuple> &left,
-                      const std::vector<FieldValueTuple> &right);
+    void restoreChunk(const std::vector<std::string> &keys, size_t begin, size_t end);
 
-    bool compareOneFV(const std::string &v1, const std::string &v2);
+    void reportStats(const std::vector<FieldValueTuple> &fv);
 
     ProducerStateTable       *m_syncTable;         // producer-table to sync/push state to
     Table                     m_restorationTable;  // redis table to import current-state from
-    kfvVector                 m_restorationVector; // buffer struct to hold old state
-    kfvMap                    m_refreshMap;        // buffer struct to hold new state
-    WarmStart::WarmStartState m_state;             // cached value of warmStart's FSM state
-    bool                      m_enabled;           // warm-reboot enabled/disabled status
+    std::unique_ptr<DBConnector> m_restorationDb;  // connection to read restored entries in chunks
+    WarmStartDelta            m_delta;             // restored state digests, and new state differing from them
+    DBConnector               m_stateDb;           // StateDB, to report restoration and reconciliation progress
+    Table                     m_stateWarmRestartTable;
+    std::atomic<WarmStart::WarmStartState>
+                              m_state;             // cached value of warmStart's FSM state, read by inProgress() on any thread
+    std::atomic<bool>         m_enabled;           // warm-reboot enabled/disabled status
     std::string               m_syncTableName;     // producer-table-name to sync/push state to
     std::string               m_dockName;          // sonic-docker requesting warmStart services
     std::string               m_appName;           // sonic-app requesting warmStart services